@@ -0,0 +1,317 @@
+/** @file
+ * Interfejs klasy przechowującej statystyki obszaru
+ *
+ * @author Szymon Czyżmański 417797
+ * @date 11.04.2020
+ */
+
+#ifndef AREA_H
+#define AREA_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+/**
+ * Typ struktury opisującej punkt artykulacji obszaru.
+ */
+typedef struct area_cut area_cut_t;
+
+/**
+ * Struktura opisująca punkt artykulacji obszaru, czyli pole, którego usunięcie
+ * dzieli obszar na co najmniej dwie części.
+ */
+struct area_cut {
+    uint32_t x;     /**< Numer kolumny pola. */
+    uint32_t y;     /**< Numer wiersza pola. */
+    unsigned split; /**< Liczba obszarów, na które rozpadnie się obszar po
+                     *   usunięciu z niego pola, równa stopniowi pola w drzewie
+                     *   bloków i punktów artykulacji obszaru. */
+};
+
+/**
+ * Typ struktury przechowującej statystyki obszaru.
+ */
+typedef struct area area_t;
+
+/**
+ * Struktura przechowująca statystyki obszaru. Jest przydzielana z puli
+ * statystyk obszarów gry tylko polom będącym korzeniami obszarów i zwracana do
+ * niej, gdy pole przestaje być korzeniem.
+ */
+struct area {
+    uint64_t size;         /**< Liczba pól obszaru. */
+    uint64_t liberties;    /**< Liczba wolnych pól sąsiadujących z co najmniej
+                            *   jednym polem obszaru. */
+    struct field *prev;    /**< Wskaźnik na korzeń poprzedniego obszaru na liście
+                            *   obszarów właściciela lub NULL. */
+    union {
+        struct field *next; /**< Wskaźnik na korzeń następnego obszaru na liście
+                             *   obszarów właściciela lub NULL. */
+        area_t *link;      /**< Wskaźnik na następną strukturę na liście wolnych
+                            *   struktur puli lub NULL, używany tylko wtedy,
+                            *   gdy struktura nie opisuje żadnego obszaru. */
+    };
+    area_cut_t *cuts;      /**< Tablica punktów artykulacji obszaru posortowana
+                            *   według wierszy i kolumn lub NULL. */
+    uint32_t min_x;        /**< Najmniejszy numer kolumny pola obszaru. */
+    uint32_t max_x;        /**< Największy numer kolumny pola obszaru. */
+    uint32_t min_y;        /**< Najmniejszy numer wiersza pola obszaru. */
+    uint32_t max_y;        /**< Największy numer wiersza pola obszaru. */
+    uint32_t cuts_num;     /**< Liczba elementów tablicy @p cuts. */
+    bool liberties_valid;  /**< Wartość @p true, jeżeli wartość @p liberties
+                            *   jest aktualna, a @p false, jeżeli musi zostać
+                            *   wyznaczona ponownie po połączeniu obszarów lub
+                            *   ich podziale w wyniku złotego ruchu. */
+    bool cuts_valid;       /**< Wartość @p true, jeżeli tablica @p cuts jest
+                            *   aktualna, a @p false, jeżeli musi zostać
+                            *   wyznaczona ponownie po zmianie obszaru. */
+};
+
+/** @brief Inicjuje statystyki obszaru składającego się z jednego pola.
+ * Inicjuje strukturę wskazywaną przez @p a tak, aby opisywała obszar składający
+ * się tylko z pola (@p x, @p y), sąsiadującego z @p liberties wolnymi polami.
+ * Zakłada, że struktura nie przechowuje tablicy punktów artykulacji.
+ * @param[in,out] a     – wskaźnik na strukturę przechowującą statystyki obszaru,
+ * @param[in] x         – numer kolumny pola,
+ * @param[in] y         – numer wiersza pola,
+ * @param[in] liberties – liczba wolnych pól sąsiadujących z polem (@p x, @p y).
+ */
+static inline void area_init(area_t *a, uint32_t x, uint32_t y, uint64_t liberties) {
+    a->size = 1;
+    a->min_x = a->max_x = x;
+    a->min_y = a->max_y = y;
+    a->liberties = liberties;
+    a->liberties_valid = true;
+    a->prev = NULL;
+    a->next = NULL;
+    a->cuts = NULL;
+    a->cuts_num = 0;
+    a->cuts_valid = false;
+}
+
+/** @brief Podaje liczbę pól obszaru.
+ * @param[in] a         – wskaźnik na strukturę przechowującą statystyki obszaru.
+ * @return Liczba pól obszaru opisywanego przez @p a.
+ */
+static inline uint64_t area_size(area_t *a) {
+    return a->size;
+}
+
+/** @brief Dołącza pole do obszaru.
+ * Zwiększa o 1 liczbę pól obszaru opisywanego przez @p a i rozszerza jego
+ * prostokąt ograniczający tak, aby zawierał pole (@p x, @p y).
+ * @param[in,out] a     – wskaźnik na strukturę przechowującą statystyki obszaru,
+ * @param[in] x         – numer kolumny dołączanego pola,
+ * @param[in] y         – numer wiersza dołączanego pola.
+ */
+static inline void area_include(area_t *a, uint32_t x, uint32_t y) {
+    a->size++;
+
+    if (x < a->min_x) {
+        a->min_x = x;
+    }
+    if (x > a->max_x) {
+        a->max_x = x;
+    }
+    if (y < a->min_y) {
+        a->min_y = y;
+    }
+    if (y > a->max_y) {
+        a->max_y = y;
+    }
+}
+
+/** @brief Łączy statystyki dwóch obszarów.
+ * Dodaje liczbę pól obszaru opisywanego przez @p b do liczby pól obszaru
+ * opisywanego przez @p a i rozszerza prostokąt ograniczający obszaru @p a
+ * o prostokąt ograniczający obszaru @p b. Oznacza liczbę wolnych pól sąsiadujących
+ * z połączonym obszarem jako nieaktualną, ponieważ oba obszary mogą mieć wspólnych
+ * wolnych sąsiadów.
+ * @param[in,out] a     – wskaźnik na strukturę przechowującą statystyki obszaru,
+ *                        do którego dołączany jest drugi obszar,
+ * @param[in] b         – wskaźnik na strukturę przechowującą statystyki
+ *                        dołączanego obszaru.
+ */
+static inline void area_join(area_t *a, area_t *b) {
+    a->size += b->size;
+
+    if (b->min_x < a->min_x) {
+        a->min_x = b->min_x;
+    }
+    if (b->max_x > a->max_x) {
+        a->max_x = b->max_x;
+    }
+    if (b->min_y < a->min_y) {
+        a->min_y = b->min_y;
+    }
+    if (b->max_y > a->max_y) {
+        a->max_y = b->max_y;
+    }
+
+    a->liberties_valid = false;
+}
+
+/** @brief Sprawdza, czy liczba wolnych sąsiadów obszaru jest aktualna.
+ * @param[in] a         – wskaźnik na strukturę przechowującą statystyki obszaru.
+ * @return Wartość @p true, jeżeli liczba wolnych pól sąsiadujących z obszarem
+ * opisywanym przez @p a jest aktualna, a @p false w przeciwnym przypadku.
+ */
+static inline bool area_liberties_valid(area_t *a) {
+    return a->liberties_valid;
+}
+
+/** @brief Podaje liczbę wolnych pól sąsiadujących z obszarem.
+ * @param[in] a         – wskaźnik na strukturę przechowującą statystyki obszaru.
+ * @return Liczba wolnych pól sąsiadujących z obszarem opisywanym przez @p a,
+ * o ile jest ona aktualna.
+ */
+static inline uint64_t area_liberties(area_t *a) {
+    return a->liberties;
+}
+
+/** @brief Aktualizuje liczbę wolnych pól sąsiadujących z obszarem.
+ * Przypisuje składowej @p liberties obszaru opisywanego przez @p a wartość
+ * zmiennej @p liberties będącej parametrem procedury i oznacza ją jako aktualną.
+ * @param[in,out] a     – wskaźnik na strukturę przechowującą statystyki obszaru,
+ * @param[in] liberties – liczba wolnych pól sąsiadujących z obszarem.
+ */
+static inline void area_set_liberties(area_t *a, uint64_t liberties) {
+    a->liberties = liberties;
+    a->liberties_valid = true;
+}
+
+/** @brief Unieważnia liczbę wolnych pól sąsiadujących z obszarem.
+ * @param[in,out] a     – wskaźnik na strukturę przechowującą statystyki obszaru.
+ */
+static inline void area_invalidate_liberties(area_t *a) {
+    a->liberties_valid = false;
+}
+
+/** @brief Podaje następną strukturę na liście wolnych struktur puli.
+ * @param[in] a         – wskaźnik na wolną strukturę przechowującą statystyki
+ *                        obszaru.
+ * @return Wskaźnik na następną wolną strukturę lub NULL.
+ */
+static inline area_t *area_link(area_t *a) {
+    return a->link;
+}
+
+/** @brief Aktualizuje następną strukturę na liście wolnych struktur puli.
+ * @param[in,out] a     – wskaźnik na wolną strukturę przechowującą statystyki
+ *                        obszaru,
+ * @param[in] link      – wskaźnik na następną wolną strukturę lub NULL.
+ */
+static inline void area_set_link(area_t *a, area_t *link) {
+    a->link = link;
+}
+
+/** @brief Podaje korzeń poprzedniego obszaru na liście obszarów właściciela.
+ * @param[in] a         – wskaźnik na strukturę przechowującą statystyki obszaru.
+ * @return Wskaźnik na korzeń poprzedniego obszaru lub NULL.
+ */
+static inline struct field *area_prev(area_t *a) {
+    return a->prev;
+}
+
+/** @brief Podaje korzeń następnego obszaru na liście obszarów właściciela.
+ * @param[in] a         – wskaźnik na strukturę przechowującą statystyki obszaru.
+ * @return Wskaźnik na korzeń następnego obszaru lub NULL.
+ */
+static inline struct field *area_next(area_t *a) {
+    return a->next;
+}
+
+/** @brief Aktualizuje korzeń poprzedniego obszaru na liście obszarów właściciela.
+ * @param[in,out] a     – wskaźnik na strukturę przechowującą statystyki obszaru,
+ * @param[in] prev      – wskaźnik na korzeń poprzedniego obszaru lub NULL.
+ */
+static inline void area_set_prev(area_t *a, struct field *prev) {
+    a->prev = prev;
+}
+
+/** @brief Aktualizuje korzeń następnego obszaru na liście obszarów właściciela.
+ * @param[in,out] a     – wskaźnik na strukturę przechowującą statystyki obszaru,
+ * @param[in] next      – wskaźnik na korzeń następnego obszaru lub NULL.
+ */
+static inline void area_set_next(area_t *a, struct field *next) {
+    a->next = next;
+}
+
+/** @brief Porównuje położenie dwóch punktów artykulacji.
+ * @param[in] a         – wskaźnik na pierwszy punkt artykulacji,
+ * @param[in] b         – wskaźnik na drugi punkt artykulacji.
+ * @return Liczba ujemna, zero lub liczba dodatnia, jeżeli pierwsze pole leży
+ * odpowiednio przed, w tym samym miejscu lub za drugim polem w kolejności
+ * wierszy i kolumn.
+ */
+static inline int area_cut_compare(const void *a, const void *b) {
+    const area_cut_t *c1 = a, *c2 = b;
+
+    if (c1->y != c2->y) {
+        return c1->y < c2->y ? -1 : 1;
+    }
+    else {
+        return (c1->x > c2->x) - (c1->x < c2->x);
+    }
+}
+
+/** @brief Sprawdza, czy tablica punktów artykulacji obszaru jest aktualna.
+ * @param[in] a         – wskaźnik na strukturę przechowującą statystyki obszaru.
+ * @return Wartość @p true, jeżeli tablica punktów artykulacji obszaru opisywanego
+ * przez @p a jest aktualna, a @p false w przeciwnym przypadku.
+ */
+static inline bool area_cuts_valid(area_t *a) {
+    return a->cuts_valid;
+}
+
+/** @brief Zapamiętuje punkty artykulacji obszaru.
+ * Sortuje tablicę @p cuts, przejmuje ją na własność i oznacza jako aktualną.
+ * @param[in,out] a     – wskaźnik na strukturę przechowującą statystyki obszaru,
+ *                        która nie przechowuje tablicy punktów artykulacji,
+ * @param[in,out] cuts  – zaalokowana tablica punktów artykulacji lub NULL,
+ * @param[in] cuts_num  – liczba elementów tablicy @p cuts.
+ */
+static inline void area_set_cuts(area_t *a, area_cut_t *cuts, uint32_t cuts_num) {
+    if (cuts_num > 0) {
+        qsort(cuts, cuts_num, sizeof(area_cut_t), area_cut_compare);
+    }
+
+    a->cuts = cuts;
+    a->cuts_num = cuts_num;
+    a->cuts_valid = true;
+}
+
+/** @brief Unieważnia punkty artykulacji obszaru.
+ * Zwalnia tablicę punktów artykulacji obszaru opisywanego przez @p a.
+ * @param[in,out] a     – wskaźnik na strukturę przechowującą statystyki obszaru.
+ */
+static inline void area_invalidate_cuts(area_t *a) {
+    free(a->cuts);
+    a->cuts = NULL;
+    a->cuts_num = 0;
+    a->cuts_valid = false;
+}
+
+/** @brief Podaje liczbę obszarów powstałych po usunięciu punktu artykulacji.
+ * Wyszukuje binarnie pole (@p x, @p y) w aktualnej tablicy punktów artykulacji
+ * obszaru opisywanego przez @p a.
+ * @param[in] a         – wskaźnik na strukturę przechowującą statystyki obszaru,
+ * @param[in] x         – numer kolumny pola będącego punktem artykulacji,
+ * @param[in] y         – numer wiersza pola będącego punktem artykulacji.
+ * @return Liczba obszarów, na które rozpadnie się obszar po usunięciu pola,
+ * lub 1, jeżeli pole nie jest punktem artykulacji obszaru.
+ */
+static inline unsigned area_cut_split(area_t *a, uint32_t x, uint32_t y) {
+    area_cut_t key = {x, y, 0};
+    area_cut_t *cut = NULL;
+
+    if (a->cuts_num > 0) {
+        cut = bsearch(&key, a->cuts, a->cuts_num, sizeof(area_cut_t),
+                      area_cut_compare);
+    }
+
+    return cut == NULL ? 1 : cut->split;
+}
+
+#endif // AREA_H
@@ -0,0 +1,240 @@
+/** @file
+ * Implementacja modułu obsługującego tryb binarny
+ *
+ * @author Szymon Czyżmański 417797
+ * @date 21.05.2020
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "bin_mode.h"
+#include "reader.h"
+#include "writer.h"
+
+/**
+ * Długość pola zawierającego długość treści rekordu.
+ */
+#define BIN_LENGTH_LEN 4
+/**
+ * Długość zapisu jednego argumentu polecenia.
+ */
+#define BIN_ARGUMENT_LEN 4
+/**
+ * Największa liczba argumentów polecenia.
+ */
+#define BIN_MAX_ARGUMENTS 4
+/**
+ * Największa długość treści poprawnego rekordu.
+ */
+#define BIN_MAX_PAYLOAD_LEN (1 + BIN_MAX_ARGUMENTS * BIN_ARGUMENT_LEN)
+/**
+ * Największa liczba znaków pomijanych jednym wywołaniem funkcji
+ * @ref reader_next_bytes podczas pomijania zbyt długiego rekordu.
+ */
+#define BIN_SKIP_CHUNK (1 << 16)
+
+/** @brief Odczytuje liczbę zapisaną w porządku little-endian.
+ * @param[in] data – wskaźnik na pierwszy z czterech bajtów zapisu liczby.
+ * @return Odczytana liczba.
+ */
+static inline uint32_t bin_decode(const char *data) {
+    const unsigned char *bytes = (const unsigned char *) data;
+
+    return (uint32_t) bytes[0] | (uint32_t) bytes[1] << 8
+           | (uint32_t) bytes[2] << 16 | (uint32_t) bytes[3] << 24;
+}
+
+/** @brief Zapisuje liczbę w porządku little-endian.
+ * @param[out] data – wskaźnik na bufor, do którego ma zostać zapisana liczba,
+ * @param[in] value – zapisywana liczba,
+ * @param[in] len   – liczba bajtów zapisu.
+ */
+static inline void bin_encode(unsigned char *data, uint64_t value, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        data[i] = (unsigned char) (value >> (8 * i));
+    }
+}
+
+/** @brief Podaje liczbę argumentów polecenia.
+ * @param[in] opcode – kod polecenia.
+ * @return Liczba argumentów polecenia lub -1, jeżeli kod jest niepoprawny.
+ */
+static int bin_arguments_num(unsigned char opcode) {
+    switch (opcode) {
+        case BIN_MOVE:
+        case BIN_GOLDEN_MOVE:
+            return 3;
+        case BIN_BUSY_FIELDS:
+        case BIN_FREE_FIELDS:
+        case BIN_GOLDEN_POSSIBLE:
+            return 1;
+        case BIN_SAME_AREA:
+            return 4;
+        case BIN_BOARD:
+            return 0;
+        default:
+            return -1;
+    }
+}
+
+/** @brief Wypisuje odpowiedź na rekord.
+ * @param[in,out] w  – wskaźnik na strukturę przechowującą stan modułu
+ *                     wypisującego,
+ * @param[in] record – numer rekordu,
+ * @param[in] opcode – kod polecenia,
+ * @param[in] ok     – wartość @p true, jeżeli polecenie zostało wykonane,
+ *                     a @p false, jeżeli wystąpił błąd,
+ * @param[in] value  – wynik polecenia.
+ */
+static void bin_reply(writer_t *w, uint32_t record, unsigned char opcode,
+                      bool ok, uint64_t value) {
+    unsigned char reply[BIN_REPLY_LEN] = {0};
+
+    bin_encode(reply, record, 4);
+    reply[4] = opcode;
+    reply[5] = ok ? 0 : 1;
+    bin_encode(reply + 8, value, 8);
+
+    writer_put_string(w, WRITER_OUT, (const char *) reply, BIN_REPLY_LEN);
+}
+
+/** @brief Wykonuje polecenie zapisane w rekordzie.
+ * @param[in,out] w   – wskaźnik na strukturę przechowującą stan modułu
+ *                      wypisującego,
+ * @param[in,out] g   – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in] record  – numer rekordu,
+ * @param[in] payload – wskaźnik na treść rekordu,
+ * @param[in] len     – długość treści rekordu.
+ */
+static void bin_execute(writer_t *w, gamma_t *g, uint32_t record,
+                        const char *payload, uint32_t len) {
+    unsigned char opcode = len > 0 ? (unsigned char) payload[0] : 0;
+    int arguments_num = bin_arguments_num(opcode);
+    uint32_t arguments[BIN_MAX_ARGUMENTS];
+
+    if (arguments_num < 0
+        || len != 1 + (uint32_t) arguments_num * BIN_ARGUMENT_LEN) {
+        bin_reply(w, record, opcode, false, 0);
+        return;
+    }
+
+    for (int i = 0; i < arguments_num; i++) {
+        arguments[i] = bin_decode(payload + 1 + i * BIN_ARGUMENT_LEN);
+    }
+
+    switch (opcode) {
+        case BIN_MOVE:
+            bin_reply(w, record, opcode, true,
+                      gamma_move(g, arguments[0], arguments[1], arguments[2]));
+            break;
+        case BIN_GOLDEN_MOVE:
+            bin_reply(w, record, opcode, true,
+                      gamma_golden_move(g, arguments[0], arguments[1], arguments[2]));
+            break;
+        case BIN_BUSY_FIELDS:
+            bin_reply(w, record, opcode, true, gamma_busy_fields(g, arguments[0]));
+            break;
+        case BIN_FREE_FIELDS:
+            bin_reply(w, record, opcode, true, gamma_free_fields(g, arguments[0]));
+            break;
+        case BIN_GOLDEN_POSSIBLE:
+            bin_reply(w, record, opcode, true,
+                      gamma_golden_possible(g, arguments[0]));
+            break;
+        case BIN_SAME_AREA:
+            bin_reply(w, record, opcode, true,
+                      gamma_same_area(g, arguments[0], arguments[1],
+                                      arguments[2], arguments[3]));
+            break;
+        default: {
+            char *board = gamma_board(g);
+
+            if (board == NULL) {
+                bin_reply(w, record, opcode, false, 0);
+            }
+            else {
+                size_t board_len = strlen(board);
+                bin_reply(w, record, opcode, true, board_len);
+                writer_put_string(w, WRITER_OUT, board, board_len);
+                free(board);
+            }
+        }
+    }
+}
+
+/** @brief Pomija treść zbyt długiego rekordu.
+ * @param[in,out] r – wskaźnik na strukturę przechowującą stan czytnika,
+ * @param[in] len   – długość treści rekordu.
+ * @return Wartość @p READER_DATA, jeżeli pominięto całą treść rekordu,
+ * a w przeciwnym przypadku wynik nieudanego wywołania funkcji
+ * @ref reader_next_bytes.
+ */
+static reader_status_t bin_skip(reader_t *r, uint32_t len) {
+    reader_status_t status = READER_DATA;
+    const char *data;
+
+    while (len > 0 && status == READER_DATA) {
+        uint32_t chunk = len < BIN_SKIP_CHUNK ? len : BIN_SKIP_CHUNK;
+        status = reader_next_bytes(r, chunk, &data);
+        len -= chunk;
+    }
+
+    return status;
+}
+
+bool bin_mode_launch(gamma_t *g) {
+    reader_t reader;
+    writer_t writer;
+    reader_status_t status = READER_DATA;
+    uint32_t record = 0;
+
+    if (!reader_init(&reader, fileno(stdin))) {
+        reader_free(&reader);
+        return false;
+    }
+    else if (!writer_init(&writer, fileno(stdout), fileno(stderr))) {
+        reader_free(&reader);
+        return false;
+    }
+
+    while (status == READER_DATA) {
+        const char *data;
+
+        if (!reader_ready(&reader, BIN_LENGTH_LEN)) {
+            writer_flush(&writer);
+        }
+
+        status = reader_next_bytes(&reader, BIN_LENGTH_LEN, &data);
+
+        if (status == READER_DATA) {
+            uint32_t len = bin_decode(data);
+            record++;
+
+            if (len > BIN_MAX_PAYLOAD_LEN) {
+                status = bin_skip(&reader, len);
+
+                if (status == READER_DATA) {
+                    bin_reply(&writer, record, 0, false, 0);
+                }
+            }
+            else {
+                if (!reader_ready(&reader, len)) {
+                    writer_flush(&writer);
+                }
+
+                status = reader_next_bytes(&reader, len, &data);
+
+                if (status == READER_DATA) {
+                    bin_execute(&writer, g, record, data, len);
+                }
+            }
+        }
+    }
+
+    writer_free(&writer);
+    reader_free(&reader);
+
+    return status != READER_ERROR;
+}
@@ -0,0 +1,69 @@
+/** @file
+ * Interfejs modułu obsługującego tryb binarny
+ *
+ * Polecenia w trybie binarnym są rekordami poprzedzonymi długością. Rekord
+ * zaczyna się od 32-bitowej liczby bez znaku zapisanej w porządku
+ * little-endian, określającej długość treści rekordu. Treść składa się
+ * z jednobajtowego kodu polecenia, wyliczonego w @ref bin_opcode, oraz
+ * argumentów polecenia, każdy zapisany jako 32-bitowa liczba bez znaku
+ * w porządku little-endian, w kolejności takiej jak w trybie wsadowym.
+ *
+ * Na każdy rekord program odpowiada rekordem o stałej długości
+ * @ref BIN_REPLY_LEN, zawierającym kolejno: numer rekordu liczony od 1
+ * (4 bajty), kod polecenia (1 bajt), status, czyli 0 w przypadku powodzenia
+ * lub 1 w przypadku błędu (1 bajt), dwa bajty zerowe oraz wynik polecenia
+ * (8 bajtów). Liczby są zapisane w porządku little-endian. Wynikiem polecenia
+ * @ref bin_opcode::BIN_BOARD jest długość napisu opisującego planszę, a sam
+ * napis jest wypisywany bezpośrednio za odpowiedzią.
+ *
+ * @author Szymon Czyżmański 417797
+ * @date 21.05.2020
+ */
+
+#ifndef BIN_MODE_H
+#define BIN_MODE_H
+
+#include "gamma.h"
+
+/**
+ * Długość odpowiedzi na jeden rekord.
+ */
+#define BIN_REPLY_LEN 16
+
+/**
+ * Typ wyliczeniowy określający kod polecenia w trybie binarnym.
+ */
+typedef enum bin_opcode bin_opcode_t;
+
+/**
+ * Wyliczenia określające kody poleceń w trybie binarnym. Są one równe znakom
+ * oznaczającym te same polecenia w trybie wsadowym.
+ */
+enum bin_opcode {
+    BIN_MOVE = 'm',            /**< Wywołanie @ref gamma_move, 3 argumenty. */
+    BIN_GOLDEN_MOVE = 'g',     /**< Wywołanie @ref gamma_golden_move,
+                                *   3 argumenty. */
+    BIN_BUSY_FIELDS = 'b',     /**< Wywołanie @ref gamma_busy_fields,
+                                *   1 argument. */
+    BIN_FREE_FIELDS = 'f',     /**< Wywołanie @ref gamma_free_fields,
+                                *   1 argument. */
+    BIN_GOLDEN_POSSIBLE = 'q', /**< Wywołanie @ref gamma_golden_possible,
+                                *   1 argument. */
+    BIN_SAME_AREA = 's',       /**< Wywołanie @ref gamma_same_area,
+                                *   4 argumenty. */
+    BIN_BOARD = 'p'            /**< Wywołanie @ref gamma_board, bez argumentów. */
+};
+
+/** @brief Uruchamia tryb binarny.
+ * Wczytuje rekordy ze standardowego wejścia do jego końca, wykonuje zapisane
+ * w nich polecenia i wypisuje odpowiedzi na standardowe wyjście. Odpowiedzi
+ * są buforowane i wypisywane, zanim program zacznie czekać na kolejne dane.
+ * Rekord o niepoprawnym kodzie polecenia, długości lub argumentach otrzymuje
+ * odpowiedź ze statusem błędu. Niepełny rekord na końcu wejścia jest pomijany.
+ * @param[in,out] g – wskaźnik na strukturę przechowującą stan gry.
+ * @return Wartość @p true, jeżeli nie nastąpił żaden krytyczny błąd,
+ * a @p false, gdy nie udało się zaalokować pamięci.
+ */
+bool bin_mode_launch(gamma_t *g);
+
+#endif // BIN_MODE_H
@@ -0,0 +1,181 @@
+/** @file
+ * Implementacja modułu wykonującego polecenia dotyczące istniejącej gry,
+ * wspólnego dla trybu wsadowego i trybu wielu gier
+ *
+ * @author Szymon Czyżmański 417797
+ * @date 22.05.2020
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+
+#include "command.h"
+#include "generator.h"
+#include "territory.h"
+
+/**
+ * Długość bufora na raport o wydajności generowania ruchów.
+ */
+#define STATS_BUFFER_SIZE 160
+
+void command_print_error(writer_t *w, unsigned line_num) {
+    writer_reserve(w, WRITER_ERR, COMMAND_REPLY_MAX_LEN);
+    writer_put_string(w, WRITER_ERR, ERROR_PREFIX, sizeof(ERROR_PREFIX) - 1);
+    writer_put_number(w, WRITER_ERR, line_num, '\n');
+}
+
+void command_print_result(writer_t *w, const uint32_t *id, uint64_t value) {
+    writer_reserve(w, WRITER_OUT, COMMAND_REPLY_MAX_LEN);
+
+    if (id != NULL) {
+        writer_put_number(w, WRITER_OUT, *id, ' ');
+    }
+
+    writer_put_number(w, WRITER_OUT, value, '\n');
+}
+
+/** @brief Wypisuje wynik i raport o wydajności generowania ruchów.
+ * Wypisuje na standardowe wyjście łączną liczbę wygenerowanych ruchów i złotych
+ * ruchów, a na standardowe wyjście diagnostyczne raport o ich liczbie, czasie
+ * generowania oraz liczbie ruchów i złotych ruchów na sekundę.
+ * @param[in,out] w    – wskaźnik na strukturę przechowującą stan modułu
+ *                       wypisującego,
+ * @param[in] id       – wskaźnik na identyfikator gry lub NULL,
+ * @param[in] line_num – numer linii, w której wystąpiło polecenie,
+ * @param[in] stats    – wskaźnik na strukturę przechowującą statystyki
+ *                       wygenerowanych ruchów.
+ */
+static void command_print_stats(writer_t *w, const uint32_t *id,
+                                unsigned line_num,
+                                const generator_stats_t *stats) {
+    char report[STATS_BUFFER_SIZE];
+    double seconds = (stats->elapsed_ns > 0 ? stats->elapsed_ns : 1) / 1e9;
+    int len = snprintf(report, sizeof(report),
+                       "STATS %u: %" PRIu64 " moves, %" PRIu64 " golden moves, "
+                       "%.6f s, %.1f moves/s, %.1f golden moves/s\n",
+                       line_num, stats->moves, stats->golden_moves, seconds,
+                       stats->moves / seconds, stats->golden_moves / seconds);
+
+    command_print_result(w, id, stats->moves + stats->golden_moves);
+
+    if (len > 0) {
+        writer_put_string(w, WRITER_ERR, report,
+                          (size_t) len < sizeof(report) ? (size_t) len
+                                                        : sizeof(report) - 1);
+    }
+}
+
+/** @brief Wypisuje planszę.
+ * @param[in,out] w    – wskaźnik na strukturę przechowującą stan modułu
+ *                       wypisującego,
+ * @param[in] g        – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in] id       – wskaźnik na identyfikator gry, wypisywany w osobnym
+ *                       wierszu przed planszą, lub NULL,
+ * @param[in] line_num – numer linii, w której wystąpiło polecenie.
+ */
+static void command_print_board(writer_t *w, gamma_t *g, const uint32_t *id,
+                                unsigned line_num) {
+    char *board = gamma_board(g);
+
+    if (board == NULL) {
+        command_print_error(w, line_num);
+    }
+    else {
+        size_t board_len = strlen(board);
+
+        if (id != NULL) {
+            writer_reserve(w, WRITER_OUT, COMMAND_REPLY_MAX_LEN + board_len);
+            writer_put_number(w, WRITER_OUT, *id, '\n');
+        }
+
+        writer_put_string(w, WRITER_OUT, board, board_len);
+        free(board);
+    }
+}
+
+void command_execute_game(writer_t *w, gamma_t *g, const uint32_t *id,
+                          unsigned line_num, char command,
+                          const uint32_t arguments[], unsigned threads) {
+    switch (command) {
+        case GAMMA_MOVE: {
+            uint32_t player = arguments[0], x = arguments[1], y = arguments[2];
+            command_print_result(w, id, gamma_move(g, player, x, y) ? 1 : 0);
+            break;
+        }
+        case GAMMA_GOLDEN_MOVE: {
+            uint32_t player = arguments[0], x = arguments[1], y = arguments[2];
+            command_print_result(w, id,
+                                 gamma_golden_move(g, player, x, y) ? 1 : 0);
+            break;
+        }
+        case GAMMA_BUSY_FIELDS: {
+            uint32_t player = arguments[0];
+            command_print_result(w, id, gamma_busy_fields(g, player));
+            break;
+        }
+        case GAMMA_FREE_FIELDS: {
+            uint32_t player = arguments[0];
+            command_print_result(w, id, gamma_free_fields(g, player));
+            break;
+        }
+        case GAMMA_GOLDEN_POSSIBLE: {
+            uint32_t player = arguments[0];
+            command_print_result(w, id, gamma_golden_possible(g, player) ? 1 : 0);
+            break;
+        }
+        case GAMMA_SAME_AREA: {
+            uint32_t x1 = arguments[0], y1 = arguments[1];
+            uint32_t x2 = arguments[2], y2 = arguments[3];
+            command_print_result(w, id,
+                                 gamma_same_area(g, x1, y1, x2, y2) ? 1 : 0);
+            break;
+        }
+        case GENERATE_RANDOM: {
+            generator_stats_t stats;
+
+            if (generator_random_moves(g, arguments[0], arguments[1], &stats)) {
+                command_print_stats(w, id, line_num, &stats);
+            }
+            else {
+                command_print_error(w, line_num);
+            }
+
+            break;
+        }
+        case GENERATE_FILL: {
+            uint32_t x1 = arguments[0], y1 = arguments[1];
+            uint32_t x2 = arguments[2], y2 = arguments[3];
+            generator_stats_t stats;
+
+            if (generator_fill(g, x1, y1, x2, y2, arguments[4], &stats)) {
+                command_print_stats(w, id, line_num, &stats);
+            }
+            else {
+                command_print_error(w, line_num);
+            }
+
+            break;
+        }
+        case TERRITORY_PLAYER: {
+            uint64_t territory = territory_player(g, arguments[0], threads);
+
+            if (territory == UINT64_MAX) {
+                command_print_error(w, line_num);
+            }
+            else {
+                command_print_result(w, id, territory);
+            }
+
+            break;
+        }
+        case GAMMA_BOARD: {
+            command_print_board(w, g, id, line_num);
+            break;
+        }
+        default: {
+            command_print_error(w, line_num);
+        }
+    }
+}
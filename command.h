@@ -0,0 +1,108 @@
+/** @file
+ * Interfejs modułu wykonującego polecenia dotyczące istniejącej gry,
+ * wspólnego dla trybu wsadowego i trybu wielu gier
+ *
+ * @author Szymon Czyżmański 417797
+ * @date 22.05.2020
+ */
+
+#ifndef COMMAND_H
+#define COMMAND_H
+
+#include <stdint.h>
+
+#include "gamma.h"
+#include "writer.h"
+
+/**
+ * Znak oznaczający komendę powodującą wywołanie funkcji @ref gamma_move.
+ */
+#define GAMMA_MOVE 'm'
+/**
+ * Znak oznaczający komendę powodującą wywołanie funkcji @ref gamma_golden_move.
+ */
+#define GAMMA_GOLDEN_MOVE 'g'
+/**
+ * Znak oznaczający komendę powodującą wywołanie funkcji @ref gamma_busy_fields.
+ */
+#define GAMMA_BUSY_FIELDS 'b'
+/**
+ * Znak oznaczający komendę powodującą wywołanie funkcji @ref gamma_free_fields.
+ */
+#define GAMMA_FREE_FIELDS 'f'
+/**
+ * Znak oznaczający komendę powodującą wywołanie funkcji @ref gamma_golden_possible.
+ */
+#define GAMMA_GOLDEN_POSSIBLE 'q'
+/**
+ * Znak oznaczający komendę powodującą wywołanie funkcji @ref gamma_board.
+ */
+#define GAMMA_BOARD 'p'
+/**
+ * Znak oznaczający komendę powodującą wywołanie funkcji @ref gamma_same_area.
+ */
+#define GAMMA_SAME_AREA 's'
+/**
+ * Znak oznaczający komendę powodującą wywołanie funkcji
+ * @ref generator_random_moves.
+ */
+#define GENERATE_RANDOM 'r'
+/**
+ * Znak oznaczający komendę powodującą wywołanie funkcji @ref generator_fill.
+ */
+#define GENERATE_FILL 'w'
+/**
+ * Znak oznaczający komendę powodującą wywołanie funkcji @ref territory_player.
+ */
+#define TERRITORY_PLAYER 't'
+
+/**
+ * Początek komunikatu o błędzie.
+ */
+#define ERROR_PREFIX "ERROR "
+/**
+ * Największa długość wiersza z wynikiem polecenia innego niż
+ * @ref GAMMA_BOARD lub z komunikatem o błędzie.
+ */
+#define COMMAND_REPLY_MAX_LEN 64
+
+/** @brief Wypisuje na standardowe wyjście diagnostyczne informację o błędzie.
+ * Wypisuje komunikat informujący o tym, że polecenie w linii o numerze
+ * @p line_num było niepoprawne lub wynikiem funkcji wywołanej wskutek
+ * wykonania polecenia była wartość NULL.
+ * @param[in,out] w    – wskaźnik na strukturę przechowującą stan modułu
+ *                       wypisującego,
+ * @param[in] line_num – numer linii, w której wystąpił błąd.
+ */
+void command_print_error(writer_t *w, unsigned line_num);
+
+/** @brief Wypisuje na standardowe wyjście wynik polecenia.
+ * @param[in,out] w – wskaźnik na strukturę przechowującą stan modułu
+ *                    wypisującego,
+ * @param[in] id    – wskaźnik na identyfikator gry, który ma poprzedzać wynik,
+ *                    lub NULL,
+ * @param[in] value – wynik polecenia.
+ */
+void command_print_result(writer_t *w, const uint32_t *id, uint64_t value);
+
+/** @brief Wykonuje polecenie dotyczące istniejącej gry.
+ * Wykonuje polecenie występujące w linii @p line_num, określone przez
+ * @p command, z argumentami @p arguments. Wyniki wypisuje na standardowe
+ * wyjście, poprzedzając je identyfikatorem gry, jeżeli @p id jest różne
+ * od NULL, a komunikaty o błędach wypisuje na standardowe wyjście
+ * diagnostyczne. Nieznane polecenie powoduje wypisanie komunikatu o błędzie.
+ * @param[in,out] w     – wskaźnik na strukturę przechowującą stan modułu
+ *                        wypisującego,
+ * @param[in,out] g     – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in] id        – wskaźnik na identyfikator gry lub NULL,
+ * @param[in] line_num  – numer linii, w której wystąpiło polecenie,
+ * @param[in] command   – znak określający polecenie,
+ * @param[in] arguments – argumenty polecenia,
+ * @param[in] threads   – limit wątków polecenia @ref TERRITORY_PLAYER,
+ *                        przekazywany funkcji @ref territory_player.
+ */
+void command_execute_game(writer_t *w, gamma_t *g, const uint32_t *id,
+                          unsigned line_num, char command,
+                          const uint32_t arguments[], unsigned threads);
+
+#endif // COMMAND_H
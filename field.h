@@ -12,6 +12,7 @@
 #include <inttypes.h>
 
 #include "player.h"
+#include "area.h"
 
 /**
  * Znak reprezentujący wolne pole.
@@ -26,25 +27,22 @@
 #define FIELD_MAX_WIDTH 11
 
 /**
- * Typ wyliczeniowy pozwalający na przechowywanie informacji o statusie pola.
+ * Maska bitowa kierunku, w którym leży sąsiad pola o numerze @p dir.
+ * Kierunki są numerowane kolejno: lewo, prawo, dół, góra, a kierunkiem
+ * przeciwnym do kierunku @p dir jest kierunek @p dir ^ 1.
  */
-typedef enum status status_t;
+#define FIELD_DIR_BIT(dir) ((uint8_t) (1u << (dir)))
 
 /**
- * Wyliczenia pozwalajace na przechowywanie informacji o statusie
- * pola, zmieniającym się w wyniku wykonywania przeszukiwania w głąb (DFS)
- * sprawdzającym legalność złotego ruchu.
- */
-enum status {
-    UNCHECKED, /**< Domyślny status pola. */
-    COUNTED,   /**< Pole zostało sprawdzone podczas liczenia niepołączonych
-                *   składowych danego obszaru gracza, któremu jest zabierane
-                *   pole, mogących powstać w wyniku wykonywania złotego ruchu
-                *   przez przeciwnika. */
-    MODIFIED   /**< Pole zostało uwzględnione podczas modyfikowania obszaru
-                *   z którego zostało zabrane graczowi pole w wyniku wykonania
-                *   złotego ruchu przez przeciwnika. */
-};
+ * Flaga pola niebędącego korzeniem obszaru, którego składowa @ref field::parent
+ * wskazuje na rodzica.
+ */
+#define FIELD_CHILD 0x1
+
+/**
+ * Flaga pola będącego punktem artykulacji obszaru.
+ */
+#define FIELD_CUT 0x2
 
 /**
  * Typ struktury przechowującej stan pola (@p x, @p y).
@@ -61,21 +59,37 @@ struct field {
                       *   @p height z funkcji @ref gamma_new. */
     player_t *owner; /**< Wskaźnik do właściciela pola, gracza posiadającego pionek
                       *   na tym polu. */
-    field_t *parent; /**< Wskaźnik do rodzica, pewnego pola znajdującego się w tym
-                      *   samym obszarze co pole (@p x, @p y) lub NULL, jeśli
-                      *   pole (@p x, @p y) jest korzeniem obszaru gracza
-                      *   wskazywanego przez @p owner. Pozwala na implementację
-                      *   operacji na obszarach zajętych przez tego gracza przy
-                      *   pomocy struktury Find-Union. */
-    uint32_t rank;   /**< Ranga pola, wartość wykorzystywana przy operacji łączenia
-                      *   dwóch obszarów zajętych przez gracza wskazywanego przez
-                      *   @p owner w jeden. Pozwala na implementację operacji na
-                      *   obszarach zajętych przez tego gracza przy pomocy struktury
-                      *   Find-Union. */
-    status_t status; /**< Status pola, jedna z wartości zdefiniowanych w wyliczeniu
-                      *   @ref status. Pozwala na odróżnienie, które pola zostały
-                      *   już uwzględnione w trakcie przeszukiwania w głąb (DFS)
-                      *   w implementacji funkcji @ref gamma_golden_move. */
+    union {
+        field_t *parent; /**< Wskaźnik do rodzica, pewnego pola znajdującego się
+                          *   w tym samym obszarze co pole (@p x, @p y), ważny,
+                          *   jeżeli pole ma flagę @ref FIELD_CHILD. Pozwala na
+                          *   implementację operacji na obszarach zajętych przez
+                          *   gracza wskazywanego przez @p owner przy pomocy
+                          *   struktury Find-Union. */
+        area_t *area;    /**< Wskaźnik na statystyki obszaru lub NULL, ważny,
+                          *   jeżeli pole nie ma flagi @ref FIELD_CHILD, czyli
+                          *   jest korzeniem obszaru lub wolnym polem. Liczba pól
+                          *   obszaru jest wykorzystywana przy operacji łączenia
+                          *   dwóch obszarów zajętych przez gracza wskazywanego
+                          *   przez @p owner w jeden według rozmiaru. */
+    };
+    uint32_t visit;  /**< Znacznik odwiedzin, numer epoki przeszukiwania w głąb
+                      *   (DFS), w której pole zostało ostatnio odwiedzone. Pole
+                      *   jest odwiedzone w danym przeszukiwaniu wtedy i tylko
+                      *   wtedy, gdy znacznik jest równy numerowi bieżącej epoki,
+                      *   dzięki czemu po zakończeniu przeszukiwania nie trzeba
+                      *   przywracać stanu odwiedzonych pól. */
+    uint8_t free;    /**< Maska bitowa kierunków, w których leżą wolne pola
+                      *   sąsiadujące z tym polem, zgodna z @ref FIELD_DIR_BIT. */
+    uint8_t busy;    /**< Maska bitowa kierunków, w których leżą zajęte pola
+                      *   sąsiadujące z tym polem, zgodna z @ref FIELD_DIR_BIT. */
+    uint8_t same;    /**< Maska bitowa kierunków, w których leżą pola sąsiadujące
+                      *   z tym polem należące do jego właściciela, zgodna
+                      *   z @ref FIELD_DIR_BIT. */
+    uint8_t flags;   /**< Maska flag pola @ref FIELD_CHILD oraz @ref FIELD_CUT.
+                      *   Flaga @ref FIELD_CUT jest aktualna tylko wtedy, gdy
+                      *   punkty artykulacji obszaru zawierającego pole są
+                      *   aktualne. */
 };
 
 /** @brief Inicjuje strukturę przechowującą stan pola (@p x, @p y).
@@ -92,9 +106,12 @@ static inline void field_init(field_t *f, uint32_t x, uint32_t y) {
     f->x = x;
     f->y = y;
     f->owner = NULL;
-    f->parent = NULL;
-    f->rank = 0;
-    f->status = UNCHECKED;
+    f->area = NULL;
+    f->visit = 0;
+    f->free = 0;
+    f->busy = 0;
+    f->same = 0;
+    f->flags = 0;
 }
 
 /** @brief Podaje współrzędną @p x pola (@p x, @p y).
@@ -153,60 +170,202 @@ static inline bool field_is_free(field_t *f) {
  * wskazywanego przez @p f.
  * @param[in] f         – wskaźnik na strukturę przechowującą stan pola.
  * @return Wskaźnik @p parent na strukturę pola będącego rodzicem pola
- * wskazywanego przez @p f.
+ * wskazywanego przez @p f lub NULL, jeżeli pole nie ma flagi @ref FIELD_CHILD.
  */
 static inline field_t *field_parent(field_t *f) {
-    return f->parent;
+    return (f->flags & FIELD_CHILD) ? f->parent : NULL;
 }
 
 /** @brief Aktualizuje rodzica pola.
  * Przypisuje wskaźnikowi @p parent, będącego składową struktury pola wskazywanej
- * przez @p f, wartość wskaźnika @p parent będącego parametrem procedury.
+ * przez @p f, wartość wskaźnika @p parent będącego parametrem procedury
+ * i ustawia flagę @ref FIELD_CHILD. Dla @p parent równego NULL usuwa tę flagę
+ * i przypisuje składowej @p area wartość NULL, ponieważ obie składowe zajmują
+ * tę samą pamięć.
  * @param[in,out] f     – wskaźnik na strukturę przechowującą stan pola,
  * @param[in] parent    – wskaźnik na strukturę przechowującą stan pola,
- *                        które ma się stać rodzicem pola wskazywanego przez @p f.
+ *                        które ma się stać rodzicem pola wskazywanego przez @p f,
+ *                        lub NULL.
  */
 static inline void field_set_parent(field_t *f, field_t *parent) {
-    f->parent = parent;
+    if (parent != NULL) {
+        f->flags |= FIELD_CHILD;
+        f->parent = parent;
+    }
+    else {
+        f->flags &= (uint8_t) ~FIELD_CHILD;
+        f->area = NULL;
+    }
 }
 
-/** @brief Podaje rangę pola.
- * Podaje wartość @p rank pola wskazywanego przez @p f.
+/** @brief Podaje statystyki obszaru, którego korzeniem jest pole.
+ * Podaje wartość @p area pola wskazywanego przez @p f.
  * @param[in] f         – wskaźnik na strukturę przechowującą stan pola.
- * @return Wartość @p rank pola wskazywanego przez @p f.
+ * @return Wskaźnik na strukturę przechowującą statystyki obszaru, jeżeli pole
+ * wskazywane przez @p f jest korzeniem obszaru, a NULL w przeciwnym przypadku.
+ */
+static inline area_t *field_area(field_t *f) {
+    return (f->flags & FIELD_CHILD) ? NULL : f->area;
+}
+
+/** @brief Aktualizuje statystyki obszaru, którego korzeniem jest pole.
+ * Przypisuje składowej @p area pola wskazywanego przez @p f wartość zmiennej
+ * @p area będącej parametrem procedury. Zakłada, że pole nie ma flagi
+ * @ref FIELD_CHILD.
+ * @param[in,out] f     – wskaźnik na strukturę przechowującą stan pola,
+ * @param[in] area      – wskaźnik na strukturę przechowującą statystyki obszaru
+ *                        lub NULL.
+ */
+static inline void field_set_area(field_t *f, area_t *area) {
+    f->area = area;
+}
+
+/** @brief Sprawdza, czy pole zostało odwiedzone w danej epoce.
+ * Sprawdza, czy znacznik odwiedzin @p visit pola wskazywanego przez @p f
+ * jest równy numerowi epoki @p epoch.
+ * @param[in] f         – wskaźnik na strukturę przechowującą stan pola,
+ * @param[in] epoch     – numer epoki przeszukiwania.
+ * @return Wartość @p true, jeżeli pole zostało odwiedzone w epoce @p epoch,
+ * a @p false w przeciwnym przypadku.
  */
-static inline uint32_t field_rank(field_t *f) {
-    return f->rank;
+static inline bool field_visited(field_t *f, uint32_t epoch) {
+    return f->visit == epoch;
 }
 
-/** @brief Aktualizuje rangę pola.
- * Przypisuje składowej @p rank pola wskazywanego przez @p f wartość zmiennej
- * @p rank będącej paramatrem procedury.
+/** @brief Oznacza pole jako odwiedzone w danej epoce.
+ * Przypisuje składowej @p visit pola wskazywanego przez @p f wartość zmiennej
+ * @p epoch będącej paramatrem procedury.
  * @param[in,out] f     – wskaźnik na strukturę przechowującą stan pola,
- * @param[in] rank      – ranga, liczba całkowita nieujemna.
+ * @param[in] epoch     – numer epoki przeszukiwania.
+ */
+static inline void field_set_visited(field_t *f, uint32_t epoch) {
+    f->visit = epoch;
+}
+
+/** @brief Podaje znacznik odwiedzin pola.
+ * @param[in] f         – wskaźnik na strukturę przechowującą stan pola.
+ * @return Numer epoki przeszukiwania, w której pole zostało ostatnio odwiedzone.
  */
-static inline void field_set_rank(field_t *f, uint32_t rank) {
-    f->rank = rank;
+static inline uint32_t field_visit(field_t *f) {
+    return f->visit;
 }
 
-/** @brief Podaje status pola.
- * Podaje wartość @p status pola wskazywanego przez @p f.
+/** @brief Sprawdza, czy pole jest punktem artykulacji obszaru.
  * @param[in] f         – wskaźnik na strukturę przechowującą stan pola.
- * @return Wartość @p status pola wskazywanego przez @p f, jedna z wartości
- * wyliczenia @ref status.
+ * @return Wartość @p true, jeżeli pole wskazywane przez @p f ma flagę
+ * @ref FIELD_CUT, a @p false w przeciwnym przypadku.
  */
-static inline status_t field_status(field_t *f) {
-    return f->status;
+static inline bool field_cut(field_t *f) {
+    return (f->flags & FIELD_CUT) != 0;
 }
 
-/** @brief Aktualizuje status pola.
- * Przypisuje składowej @p status pola wskazywanego przez @p f wartość zmiennej
- * @p status będącej paramatrem procedury.
+/** @brief Aktualizuje informację, czy pole jest punktem artykulacji obszaru.
+ * Ustawia lub usuwa flagę @ref FIELD_CUT pola wskazywanego przez @p f.
  * @param[in,out] f     – wskaźnik na strukturę przechowującą stan pola,
- * @param[in] status    – status pola, jedna z wartości wyliczenia @ref status.
+ * @param[in] cut       – wartość @p true, jeżeli pole jest punktem artykulacji
+ *                        obszaru, a @p false w przeciwnym przypadku.
+ */
+static inline void field_set_cut(field_t *f, bool cut) {
+    if (cut) {
+        f->flags |= FIELD_CUT;
+    }
+    else {
+        f->flags &= (uint8_t) ~FIELD_CUT;
+    }
+}
+
+/** @brief Podaje maskę kierunków wolnych sąsiadów pola.
+ * Podaje wartość @p free pola wskazywanego przez @p f.
+ * @param[in] f         – wskaźnik na strukturę przechowującą stan pola.
+ * @return Maska bitowa kierunków, w których leżą wolne pola sąsiadujące z polem
+ * wskazywanym przez @p f.
+ */
+static inline uint8_t field_free_mask(field_t *f) {
+    return f->free;
+}
+
+/** @brief Podaje maskę kierunków zajętych sąsiadów pola.
+ * Podaje wartość @p busy pola wskazywanego przez @p f.
+ * @param[in] f         – wskaźnik na strukturę przechowującą stan pola.
+ * @return Maska bitowa kierunków, w których leżą zajęte pola sąsiadujące z polem
+ * wskazywanym przez @p f.
+ */
+static inline uint8_t field_busy_mask(field_t *f) {
+    return f->busy;
+}
+
+/** @brief Podaje maskę kierunków sąsiadów pola należących do jego właściciela.
+ * Podaje wartość @p same pola wskazywanego przez @p f.
+ * @param[in] f         – wskaźnik na strukturę przechowującą stan pola.
+ * @return Maska bitowa kierunków, w których leżą pola sąsiadujące z polem
+ * wskazywanym przez @p f, należące do jego właściciela.
+ */
+static inline uint8_t field_same_mask(field_t *f) {
+    return f->same;
+}
+
+/** @brief Inicjuje maskę kierunków wolnych sąsiadów pola.
+ * Przypisuje składowej @p free pola wskazywanego przez @p f wartość zmiennej
+ * @p free będącej paramatrem procedury.
+ * @param[in,out] f     – wskaźnik na strukturę przechowującą stan pola,
+ * @param[in] free      – maska bitowa kierunków, w których leżą sąsiedzi pola
+ *                        znajdujący się na planszy.
+ */
+static inline void field_set_free_mask(field_t *f, uint8_t free) {
+    f->free = free;
+}
+
+/** @brief Aktualizuje maskę kierunków zajętych sąsiadów pola.
+ * Przypisuje składowej @p busy pola wskazywanego przez @p f wartość zmiennej
+ * @p busy będącej paramatrem procedury.
+ * @param[in,out] f     – wskaźnik na strukturę przechowującą stan pola,
+ * @param[in] busy      – maska bitowa kierunków, w których leżą zajęte pola
+ *                        sąsiadujące z polem wskazywanym przez @p f.
+ */
+static inline void field_set_busy_mask(field_t *f, uint8_t busy) {
+    f->busy = busy;
+}
+
+/** @brief Aktualizuje maskę kierunków sąsiadów pola należących do jego właściciela.
+ * Przypisuje składowej @p same pola wskazywanego przez @p f wartość zmiennej
+ * @p same będącej paramatrem procedury.
+ * @param[in,out] f     – wskaźnik na strukturę przechowującą stan pola,
+ * @param[in] same      – maska bitowa kierunków, w których leżą pola sąsiadujące
+ *                        z polem wskazywanym przez @p f, należące do jego
+ *                        właściciela.
+ */
+static inline void field_set_same_mask(field_t *f, uint8_t same) {
+    f->same = same;
+}
+
+/** @brief Aktualizuje maski sąsiada pola, którego właściciel się zmienił.
+ * Aktualizuje maski pola wskazywanego przez @p f po tym, jak pole leżące
+ * w kierunku @p dir od niego zostało zajęte przez gracza @p owner.
+ * @param[in,out] f     – wskaźnik na strukturę przechowującą stan pola,
+ * @param[in] dir       – numer kierunku, w którym leży zajęte pole,
+ * @param[in] owner     – wskaźnik na strukturę przechowującą stan gracza,
+ *                        który zajął sąsiednie pole.
+ * @return Wartość @p true, jeżeli pole wskazywane przez @p f należy do gracza
+ * wskazywanego przez @p owner, a @p false w przeciwnym przypadku.
+ */
+static inline bool field_neighbour_taken(field_t *f, unsigned dir, player_t *owner) {
+    uint8_t bit = FIELD_DIR_BIT(dir);
+    bool same = f->owner == owner;
+
+    f->free &= (uint8_t) ~bit;
+    f->busy |= bit;
+    f->same = (uint8_t) ((f->same & ~bit) | (same ? bit : 0));
+
+    return same;
+}
+
+/** @brief Zlicza kierunki w masce.
+ * Zlicza bity ustawione w masce kierunków @p mask.
+ * @param[in] mask      – maska bitowa kierunków zgodna z @ref FIELD_DIR_BIT.
+ * @return Liczba kierunków zapisanych w masce @p mask.
  */
-static inline void field_set_status(field_t *f, status_t status) {
-    f->status = status;
+static inline unsigned field_mask_count(uint8_t mask) {
+    return (mask & 1u) + (mask >> 1 & 1u) + (mask >> 2 & 1u) + (mask >> 3 & 1u);
 }
 
 /** @brief Daje napis reprezentujący pole.
@@ -5,17 +5,151 @@
  * @date 11.04.2020
  */
 
+#include <stdatomic.h>
 #include <stdlib.h>
 #include <string.h>
 #include <inttypes.h>
 
 #include "gamma.h"
+#include "parallel.h"
+#include "rng.h"
 
 /**
  * Maksymalna liczba pól, z jakimi pole może sąsiadować.
  */
 #define MAX_NEIGHBOURS 4
 
+/**
+ * Przesunięcia numeru kolumny prowadzące od pola do kolejnych jego sąsiadów.
+ */
+static const int64_t NEIGHBOUR_DX[MAX_NEIGHBOURS] = {-1, 1, 0, 0};
+/**
+ * Przesunięcia numeru wiersza prowadzące od pola do kolejnych jego sąsiadów.
+ */
+static const int64_t NEIGHBOUR_DY[MAX_NEIGHBOURS] = {0, 0, -1, 1};
+
+/**
+ * Długość boku kwadratowego kafelka planszy kopiowanego do migawki.
+ */
+#define SNAPSHOT_TILE 64
+
+/**
+ * Możliwość wykonania złotego ruchu przez gracza w migawce, która nie została
+ * jeszcze wyznaczona.
+ */
+#define SNAPSHOT_GOLDEN_UNKNOWN 0
+
+/**
+ * Gracz nie mógł wykonać złotego ruchu w chwili publikacji migawki.
+ */
+#define SNAPSHOT_GOLDEN_NO 1
+
+/**
+ * Gracz mógł wykonać złoty ruch w chwili publikacji migawki.
+ */
+#define SNAPSHOT_GOLDEN_YES 2
+
+/**
+ * Liczba pól, na których gracz może wykonać ruch w migawce, która nie została
+ * jeszcze wyznaczona.
+ */
+#define SNAPSHOT_FREE_UNKNOWN UINT64_MAX
+
+/**
+ * Liczba struktur przechowujących statystyki obszarów w pierwszym bloku pamięci
+ * puli. Każdy kolejny blok jest dwa razy większy od poprzedniego, aż do
+ * osiągnięcia rozmiaru @ref AREA_POOL_MAX_CHUNK.
+ */
+#define AREA_POOL_CHUNK 64
+
+/**
+ * Największa liczba struktur przechowujących statystyki obszarów w jednym bloku
+ * pamięci puli.
+ */
+#define AREA_POOL_MAX_CHUNK 65536
+
+/**
+ * Maksymalna liczba graczy, do których obwodów może jednocześnie należeć wolne
+ * pole, równa liczbie jego sąsiadów.
+ */
+#define PERIMETER_SLOTS 4
+
+/**
+ * Typ struktury przechowującej pozycję pola w zbiorze pól obwodu gracza.
+ */
+typedef struct perimeter_slot perimeter_slot_t;
+
+/**
+ * Struktura przechowująca pozycję pola w zbiorze pól obwodu gracza.
+ */
+struct perimeter_slot {
+    uint32_t player; /**< Numer gracza, do którego obwodu należy pole, lub 0,
+                      *   jeżeli pozycja jest nieużywana. */
+    uint32_t pos;    /**< Indeks pola w tablicy pól obwodu gracza. */
+};
+
+/**
+ * Odwrotność największej części liczby pól planszy, jaką może osiągnąć liczba
+ * zmian właścicieli pól zapisanych w dzienniku od ostatniego uaktualnienia
+ * zbiorów pól. Przy większej liczbie zmian taniej jest przejrzeć całą planszę.
+ */
+#define BOOKS_LOG_FRACTION 16
+
+/**
+ * Typ struktury przechowującej zmianę właściciela pola zapisaną w dzienniku.
+ */
+typedef struct books_change books_change_t;
+
+/**
+ * Struktura przechowująca zmianę właściciela pola zapisaną w dzienniku.
+ */
+struct books_change {
+    field_t *f;      /**< Wskaźnik na strukturę przechowującą stan pola. */
+    player_t *owner; /**< Wskaźnik na strukturę przechowującą stan właściciela
+                      *   pola sprzed zmiany lub NULL, jeżeli pole było wolne. */
+};
+
+/**
+ * Typ struktury przechowującej ramkę stosu iteracyjnego przeszukiwania w głąb.
+ */
+typedef struct dfs_frame dfs_frame_t;
+
+/**
+ * Struktura przechowująca ramkę stosu iteracyjnego przeszukiwania w głąb.
+ */
+struct dfs_frame {
+    field_t *f;     /**< Wskaźnik na strukturę przechowującą stan odwiedzanego
+                     *   pola. */
+    unsigned dir;   /**< Numer kolejnego sąsiada pola @p f do rozpatrzenia. */
+    uint32_t low;   /**< Najmniejszy numer w kolejności odwiedzania pola
+                     *   osiągalnego z poddrzewa przeszukiwania zaczepionego
+                     *   w polu @p f przy użyciu co najwyżej jednej krawędzi
+                     *   powrotnej, wykorzystywany przy wyznaczaniu punktów
+                     *   artykulacji. */
+    unsigned split; /**< Liczba obszarów, na które rozpadnie się obszar po
+                     *   usunięciu pola @p f, wyznaczona dla synów pola
+                     *   w drzewie przeszukiwania przetworzonych do tej pory. */
+};
+
+/**
+ * Typ struktury przechowującej pamięć roboczą wątku.
+ */
+typedef struct golden_scratch golden_scratch_t;
+
+/**
+ * Struktura przechowująca pamięć roboczą wątku sprawdzającego złoty ruch.
+ */
+struct golden_scratch {
+    uint64_t *visited;  /**< Mapa bitowa odwiedzonych pól, o jednym bicie na
+                         *   pole planszy, alokowana przy pierwszym użyciu,
+                         *   w której między przeszukiwaniami wszystkie bity
+                         *   są wyzerowane. */
+    uint64_t *queue;    /**< Kolejka przeszukiwania wszerz, zawierająca numery
+                         *   wszystkich pól odwiedzonych w bieżącym
+                         *   przeszukiwaniu. */
+    uint64_t capacity;  /**< Liczba pól, które mieszczą się w kolejce. */
+};
+
 /**
  * Struktura przechowująca stan gry.
  */
@@ -43,63 +177,354 @@ struct gamma {
                                  *   stan planszy, otrzymywanym w wyniku wywołania
                                  *   funkcji @ref gamma_board, liczba całkowita
                                  *   dodatnia nie większa niż @p PLAYER_MAX_DIGITS. */
+    uint32_t epoch;             /**< Numer bieżącej epoki przeszukiwania w głąb
+                                 *   (DFS), zwiększany przed rozpoczęciem każdego
+                                 *   nowego przeszukiwania. Pole jest odwiedzone
+                                 *   w bieżącym przeszukiwaniu, jeżeli jego znacznik
+                                 *   @ref field::visit jest równy tej wartości. */
+    dfs_frame_t *dfs_stack;     /**< Stos iteracyjnego przeszukiwania w głąb,
+                                 *   wykorzystywany przy wyznaczaniu punktów
+                                 *   artykulacji obszarów, alokowany leniwie. */
+    uint64_t dfs_stack_size;    /**< Liczba ramek, które mieszczą się na stosie
+                                 *   @ref gamma::dfs_stack. */
+    area_t **area_chunks;       /**< Tablica bloków pamięci puli struktur
+                                 *   przechowujących statystyki obszarów. */
+    uint32_t area_chunks_num;   /**< Liczba elementów tablicy
+                                 *   @ref gamma::area_chunks. */
+    area_t *area_free;          /**< Lista wolnych struktur puli, połączona
+                                 *   składową @ref area::link, lub NULL. */
+    uint64_t area_free_num;     /**< Liczba struktur na liście
+                                 *   @ref gamma::area_free. */
+    bool listed;                /**< Wartość @p true, jeżeli gra utrzymuje listy
+                                 *   obszarów graczy, tworzone przy pierwszym
+                                 *   zapytaniu o opisy obszarów. */
+    bool liberties_tracked;     /**< Wartość @p true, jeżeli gra utrzymuje liczby
+                                 *   wolnych sąsiadów obszarów, począwszy od
+                                 *   pierwszego zapytania o opis obszaru
+                                 *   w zachłannym sposobie utrzymywania
+                                 *   statystyk, a @p false, jeżeli nowe obszary
+                                 *   mają tę liczbę nieaktualną. */
+    bool indexed;               /**< Wartość @p true, jeżeli gra utrzymuje zbiory
+                                 *   wolnych pól planszy i pól obwodów graczy,
+                                 *   tworzone przy pierwszym wyliczeniu legalnych
+                                 *   ruchów, a @p false, jeżeli utrzymuje jedynie
+                                 *   obwody graczy jako liczby. */
+    field_t **free_fields_arr;  /**< Tablica wszystkich wolnych pól planszy,
+                                 *   w dowolnej kolejności, o długości równej
+                                 *   liczbie wolnych pól, lub NULL, jeżeli gra
+                                 *   nie utrzymuje zbiorów pól. */
+    uint32_t *free_pos;         /**< Tablica indeksów wolnych pól w tablicy
+                                 *   @ref gamma::free_fields_arr, indeksowana
+                                 *   numerem pola (@p x, @p y) równym
+                                 *   @p y * @p width + @p x, lub NULL. */
+    perimeter_slot_t *perimeter_slots; /**< Tablica pozycji wolnych pól
+                                 *   w zbiorach pól obwodów graczy, zawierająca
+                                 *   @ref PERIMETER_SLOTS kolejnych pozycji dla
+                                 *   każdego pola, indeksowana tak jak
+                                 *   @ref gamma::free_pos, lub NULL. */
+    uint32_t active_players;    /**< Liczba graczy na liście aktywnych graczy. */
+    bool active_stale;          /**< Wartość @p true, jeżeli od ostatniej
+                                 *   aktualizacji listy aktywnych graczy wykonano
+                                 *   ruch lub złoty ruch. */
+    uint32_t *dirty_players;    /**< Tablica numerów graczy, których aktywność
+                                 *   mogła się zmienić od ostatniej aktualizacji
+                                 *   listy aktywnych graczy, o długości równej
+                                 *   liczbie graczy. */
+    uint32_t dirty_count;       /**< Liczba elementów tablicy
+                                 *   @ref gamma::dirty_players. */
+    uint32_t *dependent_players; /**< Tablica numerów graczy, których aktywność
+                                  *   zależy tylko od możliwości wykonania złotego
+                                  *   ruchu i których nie udało się zapisać jako
+                                  *   obserwatorów sąsiadów, o długości równej
+                                  *   liczbie graczy. */
+    uint32_t dependent_count;   /**< Liczba elementów tablicy
+                                 *   @ref gamma::dependent_players. */
+    uint64_t watch_stamp;       /**< Znacznik ostatniego przeglądu sąsiadów
+                                 *   gracza, zwiększany przed każdym kolejnym. */
+    gamma_policy_t policy;      /**< Sposób utrzymywania statystyk graczy, równy
+                                 *   wartości @p policy z funkcji
+                                 *   @ref gamma_new_with_policy. */
+    uint64_t version;           /**< Liczba wykonanych ruchów i złotych ruchów. */
+    uint64_t books_version;     /**< Wartość @ref gamma::version, przy której
+                                 *   zbiory pól zostały ostatnio odbudowane
+                                 *   w leniwym sposobie utrzymywania statystyk. */
+    books_change_t *books_log;  /**< Dziennik zmian właścicieli pól od ostatniego
+                                 *   uaktualnienia zbiorów pól w leniwym sposobie
+                                 *   utrzymywania statystyk, w kolejności ich
+                                 *   wykonania. */
+    uint64_t books_log_num;     /**< Liczba elementów tablicy
+                                 *   @ref gamma::books_log. */
+    uint64_t books_log_capacity; /**< Liczba elementów, które mieszczą się
+                                  *   w tablicy @ref gamma::books_log. */
+    bool books_log_full;        /**< Wartość @p true, jeżeli dziennik zmian
+                                 *   przekroczył dopuszczalny rozmiar lub nie
+                                 *   udało się go powiększyć, więc zbiory pól
+                                 *   trzeba odbudować, przeglądając planszę. */
+    parallel_pool_t *golden_pool; /**< Pula wątków szukających pola, na
+                                 *   którym gracz może wykonać złoty ruch, tworzona
+                                 *   przy pierwszym równoległym przeglądaniu planszy,
+                                 *   lub NULL. */
+    golden_scratch_t *golden_scratch; /**< Tablica pamięci roboczych kolejnych
+                                 *   wątków puli @ref gamma::golden_pool,
+                                 *   zachowywanych między przeglądaniami planszy. */
+    _Atomic(gamma_snapshot_t *) snapshot; /**< Ostatnio opublikowana migawka
+                                 *   lub NULL. */
+    _Atomic uint64_t snapshot_readers; /**< Liczba czytelników będących w trakcie
+                                 *   pobierania migawki. */
+    gamma_snapshot_t *retired;  /**< Lista migawek zastąpionych nowszą migawką,
+                                 *   które mogą być jeszcze używane przez
+                                 *   czytelników. */
+    bool *dirty_tiles;          /**< Tablica wartości logicznych, w której
+                                 *   kafelki planszy zmienione od publikacji
+                                 *   ostatniej migawki mają wartość @p true,
+                                 *   alokowana przy pierwszej publikacji. */
+    uint32_t tiles_x;           /**< Liczba kafelków w wierszu planszy. */
+    uint32_t tiles_y;           /**< Liczba kafelków w kolumnie planszy. */
 };
 
 /** @name Obszar
- * Wykorzystanie struktury Find-Union z kompresją ścieżki oraz łączeniem według
- * rangi do efektywnego utrzymania informacji o obszarach zajętych przez gracza.
+ * Wykorzystanie struktury Find-Union z połowieniem ścieżki oraz łączeniem według
+ * rozmiaru do efektywnego utrzymania informacji o obszarach zajętych przez gracza.
+ * Korzeń każdego obszaru przechowuje jego statystyki oraz, od pierwszego zapytania
+ * o opisy obszarów, należy do listy obszarów zajętych przez jego właściciela.
  */
 ///@{
 
+/** @brief Podaje rozmiar bloku pamięci puli statystyk obszarów.
+ * @param[in] chunk – numer bloku.
+ * @return Liczba struktur przechowujących statystyki obszarów w bloku o numerze
+ * @p chunk.
+ */
+static inline uint64_t area_chunk_size(uint32_t chunk) {
+    uint64_t size = AREA_POOL_CHUNK;
+
+    for (uint32_t i = 0; i < chunk && size < AREA_POOL_MAX_CHUNK; i++) {
+        size *= 2;
+    }
+
+    return size;
+}
+
+/** @brief Zapewnia dostępność wolnych struktur w puli statystyk obszarów.
+ * Alokuje kolejne wyzerowane bloki pamięci puli, dopóki na liście wolnych
+ * struktur jest mniej niż @p count struktur. Zaalokowane bloki są zwalniane
+ * dopiero przy usuwaniu gry. Wolne struktury nie przechowują tablic punktów
+ * artykulacji.
+ * @param[in,out] g  – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in] count  – wymagana liczba wolnych struktur.
+ * @return Wartość @p true, jeżeli na liście wolnych struktur jest co najmniej
+ * @p count struktur, a @p false, jeżeli nie udało się zaalokować pamięci.
+ */
+static bool area_pool_reserve(gamma_t *g, uint64_t count) {
+    while (g->area_free_num < count) {
+        uint64_t size = area_chunk_size(g->area_chunks_num);
+
+        area_t **chunks = realloc(g->area_chunks,
+                                  ((uint64_t) g->area_chunks_num + 1)
+                                  * sizeof(area_t *));
+
+        if (chunks == NULL) {
+            return false;
+        }
+
+        g->area_chunks = chunks;
+
+        area_t *chunk = calloc(size, sizeof(area_t));
+
+        if (chunk == NULL) {
+            return false;
+        }
+
+        g->area_chunks[g->area_chunks_num++] = chunk;
+
+        for (uint64_t i = size; i-- > 0;) {
+            area_set_link(&chunk[i], g->area_free);
+            g->area_free = &chunk[i];
+        }
+
+        g->area_free_num += size;
+    }
+
+    return true;
+}
+
+/** @brief Przydziela strukturę z puli statystyk obszarów.
+ * Zakłada, że lista wolnych struktur puli nie jest pusta.
+ * @param[in,out] g  – wskaźnik na strukturę przechowującą stan gry.
+ * @return Wskaźnik na niezainicjowaną strukturę przechowującą statystyki obszaru.
+ */
+static inline area_t *area_alloc(gamma_t *g) {
+    area_t *a = g->area_free;
+
+    g->area_free = area_link(a);
+    g->area_free_num--;
+
+    return a;
+}
+
+/** @brief Zwraca strukturę do puli statystyk obszarów.
+ * Zwalnia tablicę punktów artykulacji obszaru i dopisuje strukturę wskazywaną
+ * przez @p a na początek listy wolnych struktur puli.
+ * @param[in,out] g  – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in,out] a  – wskaźnik na strukturę przechowującą statystyki obszaru.
+ */
+static inline void area_release(gamma_t *g, area_t *a) {
+    area_invalidate_cuts(a);
+    area_set_link(a, g->area_free);
+    g->area_free = a;
+    g->area_free_num++;
+}
+
+/** @brief Dodaje obszar do listy obszarów gracza.
+ * Wstawia pole wskazywane przez @p root na początek listy obszarów zajętych przez
+ * gracza wskazywanego przez @p owner. Nic nie robi, jeżeli gra nie utrzymuje
+ * jeszcze list obszarów.
+ * @param[in] g         – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in,out] owner – wskaźnik na strukturę przechowującą stan gracza,
+ * @param[in,out] root  – wskaźnik na strukturę przechowującą stan pola będącego
+ *                        korzeniem obszaru.
+ */
+static inline void area_list_add(gamma_t *g, player_t *owner, field_t *root) {
+    if (g->listed) {
+        field_t *first = player_first_area(owner);
+
+        area_set_prev(field_area(root), NULL);
+        area_set_next(field_area(root), first);
+
+        if (first != NULL) {
+            area_set_prev(field_area(first), root);
+        }
+
+        player_set_first_area(owner, root);
+    }
+}
+
+/** @brief Usuwa obszar z listy obszarów gracza.
+ * Usuwa pole wskazywane przez @p root z listy obszarów zajętych przez gracza
+ * wskazywanego przez @p owner. Nic nie robi, jeżeli gra nie utrzymuje jeszcze
+ * list obszarów.
+ * @param[in] g         – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in,out] owner – wskaźnik na strukturę przechowującą stan gracza,
+ * @param[in,out] root  – wskaźnik na strukturę przechowującą stan pola będącego
+ *                        korzeniem obszaru.
+ */
+static inline void area_list_remove(gamma_t *g, player_t *owner, field_t *root) {
+    if (g->listed) {
+        field_t *prev = area_prev(field_area(root));
+        field_t *next = area_next(field_area(root));
+
+        if (prev == NULL) {
+            player_set_first_area(owner, next);
+        }
+        else {
+            area_set_next(field_area(prev), next);
+        }
+
+        if (next != NULL) {
+            area_set_prev(field_area(next), prev);
+        }
+    }
+}
+
+/** @brief Tworzy listy obszarów graczy.
+ * Przy pierwszym wywołaniu przegląda planszę i dodaje korzeń każdego obszaru do
+ * listy obszarów jego właściciela, a od tej chwili gra utrzymuje te listy przy
+ * kolejnych ruchach. Nie alokuje pamięci.
+ * @param[in,out] g – wskaźnik na strukturę przechowującą stan gry.
+ */
+static void gamma_build_lists(gamma_t *g) {
+    if (!g->listed) {
+        g->listed = true;
+
+        for (uint32_t player = 0; player++ < g->players;) {
+            player_set_first_area(&g->players_arr[player], NULL);
+        }
+
+        for (uint32_t y = g->height; y-- > 0;) {
+            for (uint32_t x = g->width; x-- > 0;) {
+                field_t *f = &g->board[y][x];
+
+                if (field_owner(f) != NULL && field_parent(f) == NULL) {
+                    area_list_add(g, field_owner(f), f);
+                }
+            }
+        }
+    }
+}
+
 /** @brief Tworzy nowy obszar.
- * Czyni pole wskazywane przez @p f korzeniem nowego obszaru: ustawia składową
- * @ref field::rank pola wskazywanego przez @p f na 0 oraz ustawia składową
- * @ref field::parent pola wskazywanego przez @p f na NULL. Zwiększa o 1 wartość
- * składowej @ref player::areas gracza wskazywanego przez @p owner będącego
- * właścicielem wyżej wspomnianego pola.
+ * Czyni pole wskazywane przez @p f korzeniem nowego obszaru: przydziela mu
+ * z puli statystyki obszaru składającego się tylko z tego pola oraz ustawia
+ * składową @ref field::parent pola wskazywanego przez @p f na NULL. Zwiększa
+ * o 1 wartość składowej @ref player::areas gracza wskazywanego przez @p owner
+ * będącego właścicielem wyżej wspomnianego pola i dodaje obszar do listy jego
+ * obszarów. Liczba wolnych sąsiadów obszaru jest aktualna tylko wtedy, gdy gra
+ * ją utrzymuje. Zakłada, że lista wolnych struktur puli nie jest pusta.
+ * @param[in,out] g – wskaźnik na strukturę przechowującą stan gry,
  * @param[in,out] f – wskaźnik na strukturę przechowującą stan pola.
  */
-static inline void area_new(field_t *f) {
-    field_set_rank(f, 0);
+static inline void area_new(gamma_t *g, field_t *f) {
     field_set_parent(f, NULL);
+    field_set_area(f, area_alloc(g));
+    area_init(field_area(f), field_x(f), field_y(f),
+              field_mask_count(field_free_mask(f)));
+
+    if (!g->liberties_tracked) {
+        area_invalidate_liberties(field_area(f));
+    }
 
     player_t *owner = field_owner(f);
     player_set_areas(owner, player_areas(owner) + 1);
+    area_list_add(g, owner, f);
 }
 
 /** @brief Znajduje korzeń obszaru.
- * Rekurencyjnie znajduje korzeń @p root obszaru do którego należy pole
+ * Iteracyjnie znajduje korzeń @p root obszaru do którego należy pole
  * wskazywane przez @p f.
- * Dokonuje kompresji ścieżki od @p f do @p root, ustawiając składową
- * @ref field::parent w każdym polu na tej ścieżce na @p root, z wyjątkiem
- * samego korzenia @p root.
+ * Dokonuje połowienia ścieżki od @p f do @p root, ustawiając składową
+ * @ref field::parent co drugiego pola na tej ścieżce na jego dziadka, dzięki
+ * czemu nie wymaga stosu wywołań proporcjonalnego do długości ścieżki.
  * @param[in,out] f – wskaźnik na strukturę przechowującą stan pola.
  * @return Wskaźnik na strukturę przechowującą stan pola będącego korzeniem
  * obszaru do którego należy pole wskazywane przez @p f.
  */
 static field_t *area_find_root(field_t *f) {
-    if (field_parent(f) == NULL) {
-        return f;
+    while (field_parent(f) != NULL) {
+        field_t *parent = field_parent(f);
+
+        if (field_parent(parent) != NULL) {
+            field_set_parent(f, field_parent(parent));
+        }
+
+        f = field_parent(f);
     }
-    else {
-        field_t *root = area_find_root(field_parent(f));
-        field_set_parent(f, root);
 
-        return root;
+    return f;
+}
+
+/** @brief Znajduje korzeń obszaru bez skracania ścieżek.
+ * Nie modyfikuje pól, więc może być wywoływana równolegle w wielu wątkach.
+ * @param[in] f – wskaźnik na strukturę przechowującą stan pola.
+ * @return Wskaźnik na strukturę przechowującą stan pola będącego korzeniem
+ * obszaru do którego należy pole wskazywane przez @p f.
+ */
+static field_t *area_peek_root(field_t *f) {
+    while (field_parent(f) != NULL) {
+        f = field_parent(f);
     }
+
+    return f;
 }
 
-/** @brief Łączy dwa obszary w jeden według rangi.
- * Ustawia wskaźnik @ref field::parent pola wskazywanego przez @p f1_root,
- * będącego korzeniem pierwszego obszaru, do którego należy pole wskazywane
- * przez @p f1, na pole wskazywane przez @p f2_root, będące korzeniem drugiego
- * obszaru, do którego należy pole wskazywane przez @p f2, jeśli ranga
- * @p f1_root_rank korzenia pierwszego obszaru jest mniejsza od rangi
- * @p f2_root_rank korzenia drugiego obszaru.
- * W przeciwnym razie, ustawia wskaźnik @ref field::parent pola wskazywanego
- * przez @p f2_root na @p f1_root. Jeśli wartość @p f1_root_rank jest równa
- * wartości @p f2_root_rank, zwiększa rangę korzenia pierwszego obszaru, dodając
- * 1 do wartości składowej @ref field::rank pola wskazywanego przez @p f1_root.
+/** @brief Łączy dwa obszary w jeden według rozmiaru.
+ * Ustawia wskaźnik @ref field::parent korzenia mniejszego z obszarów, do których
+ * należą pola wskazywane przez @p f1 oraz @p f2, na korzeń większego z nich.
+ * Przy równych rozmiarach korzeniem połączonego obszaru zostaje korzeń obszaru
+ * zawierającego pole wskazywane przez @p f1. Dołącza statystyki mniejszego
+ * obszaru do statystyk większego, usuwa mniejszy obszar z listy obszarów
+ * właściciela i zwraca jego statystyki do puli oraz unieważnia punkty
+ * artykulacji połączonego obszaru.
+ * @param[in,out] g  – wskaźnik na strukturę przechowującą stan gry,
  * @param[in,out] f1 – wskaźnik na strukturę przechowującą stan pola
  *                     należącego do pierwszego obszaru,
  * @param[in,out] f2 – wskaźnik na strukturę przechowującą stan pola
@@ -107,27 +532,25 @@ static field_t *area_find_root(field_t *f) {
  * @return Wartość @p false, gdy pola wskazywane przez @p f1 oraz @p f2 należą do
  * tego samego obszaru i nie wykonano połączenia, a @p true w przeciwnym przypadku.
  */
-static bool area_merge(field_t *f1, field_t *f2) {
+static bool area_merge(gamma_t *g, field_t *f1, field_t *f2) {
     field_t *f1_root = area_find_root(f1);
     field_t *f2_root = area_find_root(f2);
 
-    uint32_t f1_root_rank = field_rank(f1_root);
-    uint32_t f2_root_rank = field_rank(f2_root);
-
     if (f1_root == f2_root) {
         return false;
     }
     else {
-        if (f1_root_rank < f2_root_rank) {
-            field_set_parent(f1_root, f2_root);
+        if (area_size(field_area(f1_root)) < area_size(field_area(f2_root))) {
+            field_t *tmp = f1_root;
+            f1_root = f2_root;
+            f2_root = tmp;
         }
-        else {
-            field_set_parent(f2_root, f1_root);
 
-            if (f1_root_rank == f2_root_rank) {
-                field_set_rank(f1_root, f1_root_rank + 1);
-            }
-        }
+        area_join(field_area(f1_root), field_area(f2_root));
+        area_list_remove(g, field_owner(f2_root), f2_root);
+        area_invalidate_cuts(field_area(f1_root));
+        area_release(g, field_area(f2_root));
+        field_set_parent(f2_root, f1_root);
 
         return true;
     }
@@ -230,809 +653,2535 @@ static inline bool player_valid_field(gamma_t *g, player_t *p,
     return valid_x(g, x) && valid_y(g, y) && field_owner(&g->board[y][x]) == p;
 }
 
-/** @brief Zlicza sąsiednie pola zajęte przez danego gracza.
- * Zlicza pola sąsiadujące z polem (@p x, @p y), które zostały zajęte przez gracza
- * wskazywanego przez @p p.
+/** @brief Podaje sąsiada pola.
+ * Podaje wskaźnik na strukturę przechowującą stan pola sąsiadującego z polem
+ * wskazywanym przez @p f w kierunku o numerze @p dir.
+ * @param[in] g   – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in] f   – wskaźnik na strukturę przechowującą stan pola,
+ * @param[in] dir – numer kierunku, liczba nieujemna mniejsza od
+ *                  @p MAX_NEIGHBOURS.
+ * @return Wskaźnik na strukturę przechowującą stan sąsiada lub NULL, jeżeli
+ * sąsiad w danym kierunku leży poza planszą.
+ */
+static inline field_t *field_neighbour(gamma_t *g, field_t *f, unsigned dir) {
+    int64_t x = (int64_t) field_x(f) + NEIGHBOUR_DX[dir];
+    int64_t y = (int64_t) field_y(f) + NEIGHBOUR_DY[dir];
+
+    return valid_x(g, x) && valid_y(g, y) ? &g->board[y][x] : NULL;
+}
+
+/** @brief Podaje maskę kierunków, w których pole ma sąsiadów na planszy.
  * @param[in] g – wskaźnik na strukturę przechowującą stan gry,
- * @param[in] p – wskaźnik na strukturę przechowującą stan gracza,
  * @param[in] x – numer kolumny, liczba nieujemna mniejsza od wartości
  *                @p width z funkcji @ref gamma_new,
  * @param[in] y – numer wiersza, liczba nieujemna mniejsza od wartości
- *                @p height z funkcji @ref gamma_new,
- * @return Liczba pól sąsiadujących z polem (@p x, @p y), które zostały zajęte
- * przez gracza wskazywanego przez @p p.
+ *                @p height z funkcji @ref gamma_new.
+ * @return Maska bitowa kierunków, zgodna z @ref FIELD_DIR_BIT, w których
+ * sąsiedzi pola (@p x, @p y) znajdują się na planszy.
  */
-static unsigned player_adjacent_fields(gamma_t *g, player_t *p,
-                                       uint32_t x, uint32_t y) {
-    unsigned fields = 0;
+static inline uint8_t board_neighbours_mask(gamma_t *g, uint32_t x, uint32_t y) {
+    uint8_t mask = 0;
 
-    fields += player_valid_field(g, p, x - 1, y);
-    fields += player_valid_field(g, p, x + 1, y);
-    fields += player_valid_field(g, p, x, y - 1);
-    fields += player_valid_field(g, p, x, y + 1);
+    for (unsigned dir = 0; dir < MAX_NEIGHBOURS; dir++) {
+        if (valid_x(g, (int64_t) x + NEIGHBOUR_DX[dir])
+            && valid_y(g, (int64_t) y + NEIGHBOUR_DY[dir])) {
 
-    return fields;
-}
+            mask |= FIELD_DIR_BIT(dir);
+        }
+    }
 
-/** @brief Sprawdza, czy pole (@p x, @p y) jest poprawne, wolne i nie sąsiaduje
- * z żadnym polem zajętym przez gracza wskazywanego przez @p owner.
- * Sprawdza, czy numer kolumny @p x jest liczbą całkowitą nieujemną
- * mniejszą od wartości @p width z funkcji @ref gamma_new.
- * Sprawdza, czy numer wiersza @p y jest liczbą całkowitą nieujemną
- * mniejszą od wartości @p height z funkcji @ref gamma_new.
- * Sprawdza, czy pole nie zostało jeszcze stworzone, tzn. czy wartość wskaźnika
- * @p g->board[y][x] jest równa NULL, lub, w przeciwnym razie, czy pole nie ma
- * przypisanego właściciela, tzn. czy wskaźnik @ref field::owner będący składową
- * pola na które wskazuje @p g->board[y][x] jest równy NULL.
- * Sprawdza, czy liczba pól sąsiadujących z polem (@p x, @p y), zajętych przez
- * gracza wskazywanego przez @p owner jest równa 0.
- * @param[in] g     – wskaźnik na strukturę przechowującą stan gry,
- * @param[in] owner – wskaźnik na strukturę przechowującą stan gracza,
- * @param[in] x     – numer kolumny, liczba nieujemna mniejsza od wartości
- *                    @p width z funkcji @ref gamma_new,
- * @param[in] y     – numer wiersza, liczba nieujemna mniejsza od wartości
- *                    @p height z funkcji @ref gamma_new.
- * @return Wartość @p true, jezeli pole (@p x, @p y) jest poprawne, wolne
- * i nie sąsiaduje z żadnym polem zajętym przez gracza wskazywanego przez @p owner,
- * a @p false w przeciwnym przypadku.
- */
-static inline bool player_valid_free_single_field(gamma_t *g, player_t *owner,
-                                                  int64_t x, int64_t y) {
-    return valid_free_field(g, x, y) && player_adjacent_fields(g, owner, x, y) == 0;
+    return mask;
 }
 
-/** @brief Zlicza sąsiednie, wolne pola, nie sąsiadujące z żadnym polem zajętym
- * przez danego gracza.
- * Zlicza pola sąsiadujące z polem (@p x, @p y), które nie zostały zajęte przez
- * żadnego gracza i które nie sąsiadują z żadnym polem zajętym przez gracza
- * wskazywanego przez @p owner.
- * @param[in] g     – wskaźnik na strukturę przechowującą stan gry,
- * @param[in] owner – wskaźnik na strukturę przechowującą stan gracza,
- * @param[in] x     – numer kolumny, liczba nieujemna mniejsza od wartości
- *                    @p width z funkcji @ref gamma_new,
- * @param[in] y     – numer wiersza, liczba nieujemna mniejsza od wartości
- *                    @p height z funkcji @ref gamma_new.
- * @return Liczba pól sąsiadujących z polem (@p x, @p y), które nie zostały zajęte
- * przez żadnego gracza i które nie sąsiadują z żadnym polem zajętym przez gracza
- * wskazywanego przez @p owner.
+/** @brief Sprawdza, czy pole sąsiaduje z polem zajętym przez danego gracza.
+ * Sprawdza, czy któreś z zajętych pól sąsiadujących z polem wskazywanym przez
+ * @p f, leżących w kierunkach spoza maski @p skip, należy do gracza wskazywanego
+ * przez @p p. Rozpatruje tylko kierunki zapisane w masce @ref field::busy.
+ * @param[in] g    – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in] f    – wskaźnik na strukturę przechowującą stan pola,
+ * @param[in] p    – wskaźnik na strukturę przechowującą stan gracza,
+ * @param[in] skip – maska bitowa kierunków, które należy pominąć.
+ * @return Wartość @p true, jeżeli pole wskazywane przez @p f sąsiaduje z polem
+ * gracza wskazywanego przez @p p, a @p false w przeciwnym przypadku.
  */
-static unsigned player_adjacent_free_single_fields(gamma_t *g, player_t *owner,
-                                                   uint32_t x, uint32_t y) {
-    unsigned fields = 0;
+static bool field_adjacent_to(gamma_t *g, field_t *f, player_t *p, uint8_t skip) {
+    uint8_t busy = field_busy_mask(f) & (uint8_t) ~skip;
 
-    fields += player_valid_free_single_field(g, owner, x - 1, y);
-    fields += player_valid_free_single_field(g, owner, x + 1, y);
-    fields += player_valid_free_single_field(g, owner, x, y - 1);
-    fields += player_valid_free_single_field(g, owner, x, y + 1);
+    for (unsigned dir = 0; busy != 0; dir++, busy >>= 1) {
+        if ((busy & 1u) && field_owner(field_neighbour(g, f, dir)) == p) {
+            return true;
+        }
+    }
 
-    return fields;
+    return false;
 }
 
-///@}
-
-/** @name Gracz
- * Sprawdzanie czy gracz lub związany z nim element spełnia określony predykat.
- * Zmiana stanu gracza lub związanych z nim elementów przy wykonywaniu ruchów
- * przez tego gracza podczas zwykłego ruchu lub innego gracza podczas złotego ruchu.
+/** @brief Wyznacza różnych właścicieli pól sąsiadujących z polem.
+ * Zapisuje w tablicy @p owners wskaźniki na graczy posiadających pionek na co
+ * najmniej jednym z pól sąsiadujących z polem wskazywanym przez @p f, wskazanych
+ * przez maskę @ref field::busy, uwzględniając każdego z nich tylko raz. Dla
+ * wolnego pola są to dokładnie gracze, do których obwodów ono należy.
+ * @param[in] g       – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in] f       – wskaźnik na strukturę przechowującą stan pola,
+ * @param[out] owners – tablica, w której mają zostać zapisani gracze.
+ * @return Liczba graczy zapisanych w tablicy @p owners.
  */
-///@{
+static unsigned field_neighbour_owners(gamma_t *g, field_t *f,
+                                       player_t *owners[MAX_NEIGHBOURS]) {
+    uint8_t busy = field_busy_mask(f);
+    unsigned added = 0;
 
-/** @brief Sprawdza poprawność numeru gracza.
- * Sprawdza, czy numer gracza @p player jest liczbą całkowitą dodatnią
- * nie większą od wartości @p players z funkcji @ref gamma_new.
- * @param[in] g      – wskaźnik na strukturę przechowującą stan gry,
- * @param[in] player – numer gracza, liczba dodatnia niewiększa od wartości
- *                     @p players z funkcji @ref gamma_new.
- * @return Wartość @p true, jeśli numer gracza jest poprawny,
- * a @p false w przeciwnym przypadku.
- */
-static inline bool valid_player(gamma_t *g, int64_t player) {
-    return 1 <= player && player <= g->players;
+    for (unsigned dir = 0; busy != 0; dir++, busy >>= 1) {
+        if (busy & 1u) {
+            player_t *owner = field_owner(field_neighbour(g, f, dir));
+            unsigned i = 0;
+
+            while (i < added && owner != owners[i]) {
+                i++;
+            }
+
+            if (i == added) {
+                owners[added++] = owner;
+            }
+        }
+    }
+
+    return added;
 }
 
-/** @brief Aktualizuje obwód gracza po wykonaniu przez niego ruchu.
- * Aktualizuje obwód gracza będącego właścicielem pola wskazywanego przez @p f,
- * po wykonaniu przez niego ruchu na pole wskazywane przez @p f.
- * @param[in] g           – wskaźnik na strukturę przechowującą stan gry,
- * @param[in] f           – wskaźnik na strukturę przechowującą stan pola właśnie
- *                          zajętego przez gracza,
- * @param[in] golden_move – wartość @p true, jeżeli funkcja została wywołana
- *                          w wyniku wykonania złotego ruchu przez gracza,
- *                          a @p false, jeżeli funkcja została wywołana w wyniku
- *                          wykonania zwykłego ruchu przez gracza.
+/** @brief Zmienia właściciela pola.
+ * Przypisuje polu wskazywanemu przez @p f właściciela wskazywanego przez
+ * @p owner i aktualizuje maski sąsiedztwa tego pola oraz jego sąsiadów.
+ * Oznacza kafelek planszy zawierający pole jako zmieniony od publikacji ostatniej
+ * migawki.
+ * @param[in] g      – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in,out] f  – wskaźnik na strukturę przechowującą stan pola,
+ * @param[in] owner  – wskaźnik na strukturę przechowującą stan nowego
+ *                     właściciela pola.
  */
-static void player_update_perimeter(gamma_t *g, field_t *f, bool golden_move) {
-    uint32_t x = field_x(f);
-    uint32_t y = field_y(f);
-    player_t *owner = field_owner(f);
-    uint64_t perimeter = player_perimeter(owner);
+static void field_update_owner(gamma_t *g, field_t *f, player_t *owner) {
+    uint8_t same = 0;
 
-    field_set_owner(f, NULL);
+    field_set_owner(f, owner);
 
-    if (!golden_move && player_adjacent_fields(g, owner, x, y) > 0) {
-        perimeter--;
+    if (g->dirty_tiles != NULL) {
+        g->dirty_tiles[(uint64_t) (field_y(f) / SNAPSHOT_TILE) * g->tiles_x
+                       + field_x(f) / SNAPSHOT_TILE] = true;
     }
 
-    perimeter += player_valid_free_single_field(g, owner, x - 1, y);
-    perimeter += player_valid_free_single_field(g, owner, x + 1, y);
-    perimeter += player_valid_free_single_field(g, owner, x, y - 1);
-    perimeter += player_valid_free_single_field(g, owner, x, y + 1);
+    for (unsigned dir = 0; dir < MAX_NEIGHBOURS; dir++) {
+        field_t *n = field_neighbour(g, f, dir);
 
-    field_set_owner(f, owner);
-    player_set_perimeter(owner, perimeter);
+        if (n != NULL && field_neighbour_taken(n, dir ^ 1, owner)) {
+            same |= FIELD_DIR_BIT(dir);
+        }
+    }
+
+    field_set_same_mask(f, same);
 }
 
-/** @brief Łączy obszary gracza po wykonaniu przez niego ruchu na pole
- * wskazywane przez @p f.
- * Łączy obszar gracza, będącego właścicielem pola wskazywanego przez @p f,
- * do którego należy pole wskazywane przez @p f, z obszarem tego gracza,
- * do którego należy pole (@p x, @p y).
- * Zmniejsza o 1 liczbę obszarów gracza, jeżeli pole (@p x, @p y) jest poprawne 
- * i należy do tego gracza oraz połączono obszary.
- * Nic nie robi, jeżeli pole (@p x, @p y) jest niepoprawne lub nie należy do gracza,
- * lub oba pola należą do tego samego obszaru.
- * @param[in] g           – wskaźnik na strukturę przechowującą stan gry,
- * @param[in] f           – wskaźnik na strukturę przechowującą stan pola właśnie
- *                          zajętego przez gracza,
- * @param[in] x           – numer kolumny, liczba nieujemna mniejsza od wartości
- *                          @p width z funkcji @ref gamma_new,
- * @param[in] y           – numer wiersza, liczba nieujemna mniejsza od wartości
- *                          @p height z funkcji @ref gamma_new.
+/** @brief Zeruje znaczniki odwiedzin wszystkich pól planszy.
+ * Wywoływana, gdy numer epoki przeszukiwania osiąga największą wartość, jaką
+ * można zapisać w znaczniku odwiedzin pola.
+ * @param[in,out] g – wskaźnik na strukturę przechowującą stan gry.
  */
-static void player_merge_adjacent_areas(gamma_t *g, field_t *f,
-                                        int64_t x, int64_t y) {
-    player_t *owner = field_owner(f);
-
-    if (player_valid_field(g, owner, x, y) && area_merge(f, &g->board[y][x])) {
-        player_set_areas(owner, player_areas(owner) - 1);
+static void board_reset_visits(gamma_t *g) {
+    for (uint32_t y = 0; y < g->height; y++) {
+        for (uint32_t x = 0; x < g->width; x++) {
+            field_set_visited(&g->board[y][x], 0);
+        }
     }
+
+    g->epoch = 0;
 }
 
-/** @brief Modyfikuje obszary gracza po wykonaniu przez niego ruchu na pole
- * wskazywane przez @p f.
- * Tworzy nowy obszar składający się tylko z pola wskazywanego przez @p f,
- * po czym próbuje łączyć ten obszar z sąsiednimi obszarami należącymi do
- * właściciela tego pola, jeżeli takie istnieją.
- * @param[in] g           – wskaźnik na strukturę przechowującą stan gry,
- * @param[in] f           – wskaźnik na strukturę przechowującą stan pola właśnie
- *                          zajętego przez gracza.
+/** @brief Rozpoczyna ciąg nowych epok przeszukiwania.
+ * Zwiększa numer bieżącej epoki przeszukiwania @ref gamma::epoch o @p count,
+ * dzięki czemu wszystkie pola planszy stają się nieodwiedzone bez konieczności
+ * przeglądania ich i przywracania ich stanu. Gdy numer epoki miałby się
+ * przekręcić, najpierw zeruje znaczniki odwiedzin wszystkich pól, co zdarza się
+ * raz na około @p UINT32_MAX przeszukiwań.
+ * @param[in,out] g – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in] count – liczba epok, liczba dodatnia.
+ * @return Numer pierwszej z nowych epok przeszukiwania. Każda z nich jest
+ * większa od numeru każdej wcześniejszej epoki.
  */
-static void player_modify_areas(gamma_t *g, field_t *f) {
-    area_new(f);
+static inline uint32_t gamma_new_epochs(gamma_t *g, uint32_t count) {
+    if (g->epoch > UINT32_MAX - count) {
+        board_reset_visits(g);
+    }
 
-    uint32_t x = field_x(f);
-    uint32_t y = field_y(f);
+    g->epoch += count;
+
+    return g->epoch - count + 1;
+}
 
-    player_merge_adjacent_areas(g, f, x - 1, y);
-    player_merge_adjacent_areas(g, f, x + 1, y);
-    player_merge_adjacent_areas(g, f, x, y - 1);
-    player_merge_adjacent_areas(g, f, x, y + 1);
+/** @brief Rozpoczyna nową epokę przeszukiwania.
+ * @param[in,out] g – wskaźnik na strukturę przechowującą stan gry.
+ * @return Numer nowej epoki przeszukiwania.
+ */
+static inline uint32_t gamma_new_epoch(gamma_t *g) {
+    return gamma_new_epochs(g, 1);
 }
 
 ///@}
 
-/** @name Sąsiedzi
- * Tworzenie zbioru graczy @p neighbours posiadających co najmniej jedno pole
- * sąsiadujące z polem, na który stawiany jest pionek.
- * Aktualizacja obwodów graczy należących do utworzonego zbioru reprezentowanego
- * przez tablicę @p neighbours z funkcji @ref add_unique_neighbours i przekazywaną
- * do pozostałych funkcji z tej grupy.
+/** @name Zbiory pól
+ * Utrzymanie obwodów graczy oraz, po pierwszym wyliczeniu legalnych ruchów,
+ * zbioru wolnych pól planszy i zbiorów pól obwodów graczy, każdego jako tablicy
+ * pól wraz z indeksem każdego pola w tej tablicy, zapamiętanym w tablicy
+ * indeksowanej numerem pola. Pozwala to dodawać i usuwać pola w czasie stałym
+ * oraz wyliczać pola, na których gracz może postawić pionek, bez przeglądania
+ * planszy, a grom, które nie wyliczają legalnych ruchów, nie zwiększa rozmiaru
+ * pamięci przypadającej na pole.
  */
 ///@{
 
-/** @brief Sprawdza, czy gracz nie został jeszcze dodany do zbioru @p neighbours.
- * Sprawdza, czy adres struktury gracza wskazywanej przez @p p nie został jeszcze
- * dodany do tablicy @p neighbours, przechowującej niepowtarzające się adresy
- * struktur graczy zajmujących co najmniej jedno pole w sąsiedztwie pewnego pola,
- * na które został postawiony pionek.
- * @param[in] p          – wskaźnik na strukturę przechowującą stan gracza,
- * @param[in] neighbours – tablica wskaźników na dodanych już graczy,
- * @param[in] added      – liczba dodanych już graczy.
- * @return Wartość @p true, jeśli wskaźnik @p p nie został jeszcze dodany
- * do tablicy @p neighbours, a @p false w przeciwnym przypadku.
+/** @brief Podaje numer pola.
+ * @param[in] g – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in] f – wskaźnik na strukturę przechowującą stan pola.
+ * @return Numer pola (@p x, @p y) wskazywanego przez @p f, równy
+ * @p y * @p width + @p x.
  */
-static bool unique_neighbour(player_t *p, player_t *neighbours[MAX_NEIGHBOURS],
-                             unsigned added) {
-    unsigned i = 0;
-
-    while (i < added && p != neighbours[i]) {
-        i++;
-    }
-
-    return i == added;
+static inline uint64_t board_index(gamma_t *g, field_t *f) {
+    return (uint64_t) field_y(f) * g->width + field_x(f);
 }
 
-/** @brief Sprawdza, czy pole (@p x, @p y) jest zajęte i należy do gracza, który
- * nie został jeszcze dodany do zbioru @p neighbours.
- * Sprawdza, czy numer kolumny @p x jest liczbą całkowitą nieujemną
- * mniejszą od wartości @p width z funkcji @ref gamma_new.
- * Sprawdza, czy numer wiersza @p y jest liczbą całkowitą nieujemną
- * mniejszą od wartości @p height z funkcji @ref gamma_new.
- * Sprawdza, czy pole zostało już stworzone, tzn. czy wartość wskaźnika
- * @p g->board[y][x] jest różna od NULL.
- * Sprawdza, czy wskaźnik na gracza będącego właścicielem pola (@p x, @p y)
- * nie został jeszcze dodany do tablicy @p neighbours.
- * @param[in] g          – wskaźnik na strukturę przechowującą stan gry,
- * @param[in] x          – numer kolumny, liczba nieujemna mniejsza od wartości
- *                         @p width z funkcji @ref gamma_new,
- * @param[in] y          – numer wiersza, liczba nieujemna mniejsza od wartości
- *                         @p height z funkcji @ref gamma_new,
- * @param[in] neighbours – tablica wskaźników na dodanych już graczy,
- * @param[in] added      – liczba dodanych już graczy.
- * @return Wartość @p true, jeśli pole (@p x, @p y) jest poprawne oraz jest zajęte
- * przez gracza, którego adres nie został jeszcze dodany do tablicy @p neighbours,
- * a @p false w przeciwnym przypadku.
+/** @brief Zapewnia miejsce w tablicy pól obwodu gracza.
+ * Powiększa tablicę pól obwodu gracza wskazywanego przez @p p tak, aby mieściła
+ * co najmniej @p size pól.
+ * @param[in,out] p – wskaźnik na strukturę przechowującą stan gracza,
+ * @param[in] size  – wymagana liczba pól.
+ * @return Wartość @p true, jeżeli tablica mieści wymaganą liczbę pól, a @p false,
+ * jeżeli nie udało się zaalokować pamięci.
  */
-static bool neighbour_valid_unique_field(gamma_t *g, int64_t x, int64_t y,
-                                         player_t *neighbours[MAX_NEIGHBOURS],
-                                         unsigned added) {
-    if (!valid_x(g, x) || !valid_y(g, y)) {
-        return false;
+static bool perimeter_reserve(player_t *p, uint64_t size) {
+    uint64_t capacity = player_perimeter_capacity(p);
+
+    if (size <= capacity) {
+        return true;
     }
     else {
-        field_t *f = &g->board[y][x];
+        uint64_t new_capacity = capacity == 0 ? 16 : 2 * capacity;
 
-        return f != NULL && unique_neighbour(field_owner(f), neighbours, added);
-    }
-}
+        while (new_capacity < size) {
+            new_capacity *= 2;
+        }
 
-/** @brief Dodaje adres gracz posiadającego pionek na polu (@p x, @p y), jeżeli
- * nie został on jeszcze dodany do zbioru @p neighbours.
- * Sprawdza, czy pole (@p x, @p y) jest poprawne i zajęte oraz należy do gracza,
- * który nie został jeszcze dodany do zbioru @p neighbours. Jeżeli tak,
- * to dodaje adres gracza posiadającego pionek na polu (@p x, @p y) do tablicy
- * @p neighbours i zwiększa liczbę @p added dodanych adresów do tej tablicy o 1.
- * Zwraca wartość zmiennej @p added.
- * @param[in] g              – wskaźnik na strukturę przechowującą stan gry,
- * @param[in] x              – numer kolumny, liczba nieujemna mniejsza od wartości
- *                             @p width z funkcji @ref gamma_new,
- * @param[in] y              – numer wiersza, liczba nieujemna mniejsza od wartości
- *                             @p height z funkcji @ref gamma_new,
- * @param[in,out] neighbours – tablica wskaźników na dodanych już graczy,
- * @param[in,out] added      – liczba dodanych już graczy.
- * @return Wartość zmiennej @p added, przechowującej liczbę dodanych adresów graczy
- * do tablicy @p neighbours.
- */
-static unsigned add_neighbour_if_unique(gamma_t *g, int64_t x, int64_t y,
-                                        player_t *neighbours[MAX_NEIGHBOURS],
-                                        unsigned added) {
-    if (neighbour_valid_unique_field(g, x, y, neighbours, added)) {
-        neighbours[added] = field_owner(&g->board[y][x]);
-        added++;
+        field_t **fields = realloc(player_perimeter_fields(p),
+                                   new_capacity * sizeof(field_t *));
+
+        if (fields == NULL) {
+            return false;
+        }
+        else {
+            player_set_perimeter_fields(p, fields, new_capacity);
+
+            return true;
+        }
     }
+}
 
-    return added;
+/** @brief Znajduje pozycję pola w zbiorze pól obwodu gracza.
+ * Zakłada, że gra utrzymuje zbiory pól oraz że szukana pozycja istnieje.
+ * @param[in] g      – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in] f      – wskaźnik na strukturę przechowującą stan wolnego pola,
+ * @param[in] player – numer gracza lub 0.
+ * @return Wskaźnik na pozycję pola wskazywanego przez @p f w obwodzie gracza
+ * @p player, a dla @p player równego 0 wskaźnik na nieużywaną pozycję.
+ */
+static inline perimeter_slot_t *perimeter_slot(gamma_t *g, field_t *f,
+                                               uint32_t player) {
+    perimeter_slot_t *slots = &g->perimeter_slots[board_index(g, f)
+                                                  * PERIMETER_SLOTS];
+    unsigned i = 0;
+
+    while (slots[i].player != player) {
+        i++;
+    }
+
+    return &slots[i];
 }
 
-/** @brief Tworzy zbiór graczy posiadających pionek na co najmniej jednym z pól
- * sąsiadujących z polem (@p x, @p y).
- * Inicjucje przekazaną tablicę @p neighbours tak, aby reprezentowała zbiór pusty.
- * Dodaje niepowtarzające się adresy struktur przechowujących stany graczy
- * posiadających pionek na co najmniej jednym z pól sąsiadujących z polem
- * (@p x, @p y) do przekazanej tablicy @p neighbours.
- * @param[in] g              – wskaźnik na strukturę przechowującą stan gry,
- * @param[in] x              – numer kolumny, liczba nieujemna mniejsza od wartości
- *                             @p width z funkcji @ref gamma_new,
- * @param[in] y              – numer wiersza, liczba nieujemna mniejsza od wartości
- *                             @p height z funkcji @ref gamma_new,
- * @param[in,out] neighbours – tablica, która po wywołaniu funkcji będzie
- *                             reprezentować zbiór graczy posiadających pionek
- *                             na co najmniej jednym z pól sąsiadujących z polem
- *                             (@p x, @p y).
+/** @brief Dodaje pole do obwodu gracza.
+ * Zwiększa o 1 obwód gracza wskazywanego przez @p p, a jeżeli gra utrzymuje
+ * zbiory pól, dopisuje pole do tablicy pól jego obwodu. Zakłada, że pole
+ * wskazywane przez @p f nie należy do obwodu tego gracza oraz że tablica pól
+ * obwodu gracza ma wolne miejsce.
+ * @param[in,out] g – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in,out] p – wskaźnik na strukturę przechowującą stan gracza,
+ * @param[in] f     – wskaźnik na strukturę przechowującą stan wolnego pola.
  */
-static void add_unique_neighbours(gamma_t *g, uint32_t x, uint32_t y,
-                                  player_t *neighbours[MAX_NEIGHBOURS]) {
-    for (unsigned i = 0; i < MAX_NEIGHBOURS; i++) {
-        neighbours[i] = NULL;
+static inline void perimeter_add(gamma_t *g, player_t *p, field_t *f) {
+    uint64_t perimeter = player_perimeter(p);
+
+    if (g->indexed) {
+        player_perimeter_fields(p)[perimeter] = f;
+        *perimeter_slot(g, f, 0) = (perimeter_slot_t) {
+            player_number(p), (uint32_t) perimeter
+        };
     }
 
-    unsigned added = 0;
+    player_set_perimeter(p, perimeter + 1);
+}
 
-    added = add_neighbour_if_unique(g, x - 1, y, neighbours, added);
-    added = add_neighbour_if_unique(g, x + 1, y, neighbours, added);
-    added = add_neighbour_if_unique(g, x, y - 1, neighbours, added);
-    add_neighbour_if_unique(g, x, y + 1, neighbours, added);
-}
-
-/** @brief Zmniejsza o 1 obwód każdego gracza posiadającego pionek na co namniej
- * jednym polu sąsiadującym z polem wskazywanym przez @p f.
- * Wywołuje funkcję @ref add_unique_neighbours tworzącą zbiór graczy posiadających
- * pionek na co najmniej jednym polu sąsiadującym z polem wskazywanym przez @p f,
- * które było dotąd wolne i na którym postawiono właśnie pionek, reprezentowanym
- * przez tablicę wskaźników @p neighbours.
- * Zmniejsza o 1 wartość składowej @ref player::perimeter każdego z graczy,
- * którego adres został dodany do tablicy @p neighbours.
- * Zwalnia tablicę @p neighbours.
- * @param[in] g              – wskaźnik na strukturę przechowującą stan gry,
- * @param[in] f              – wskaźnik na strukturę przechowującą stan pola.
+/** @brief Usuwa pole z obwodu gracza.
+ * Zmniejsza o 1 obwód gracza wskazywanego przez @p p, a jeżeli gra utrzymuje
+ * zbiory pól, przenosi ostatnie pole tablicy pól jego obwodu na miejsce pola
+ * wskazywanego przez @p f. Zakłada, że pole wskazywane przez @p f należy do
+ * obwodu tego gracza.
+ * @param[in,out] g – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in,out] p – wskaźnik na strukturę przechowującą stan gracza,
+ * @param[in] f     – wskaźnik na strukturę przechowującą stan pola.
  */
-static void neighbours_update_perimeter(gamma_t *g, field_t *f) {
-    player_t *owner = field_owner(f);
-    player_t *neighbours[MAX_NEIGHBOURS];
+static void perimeter_remove(gamma_t *g, player_t *p, field_t *f) {
+    uint64_t perimeter = player_perimeter(p) - 1;
+
+    if (g->indexed) {
+        field_t **fields = player_perimeter_fields(p);
+        perimeter_slot_t *slot = perimeter_slot(g, f, player_number(p));
+        field_t *last = fields[perimeter];
 
-    add_unique_neighbours(g, field_x(f), field_y(f), neighbours);
+        fields[slot->pos] = last;
+        perimeter_slot(g, last, player_number(p))->pos = slot->pos;
+        *slot = (perimeter_slot_t) {0, 0};
+    }
+
+    player_set_perimeter(p, perimeter);
+}
+
+/** @brief Usuwa z obwodu gracza wolnych sąsiadów pola, którzy nie sąsiadują
+ * z innym polem tego gracza.
+ * Usuwa z obwodu gracza wskazywanego przez @p owner wolne pola sąsiadujące
+ * z polem wskazywanym przez @p f, które nie sąsiadują z żadnym polem zajętym
+ * przez tego gracza, innym niż pole wskazywane przez @p f.
+ * @param[in,out] g     – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in] f         – wskaźnik na strukturę przechowującą stan pola,
+ * @param[in,out] owner – wskaźnik na strukturę przechowującą stan gracza.
+ */
+static void player_remove_single_neighbours(gamma_t *g, field_t *f,
+                                            player_t *owner) {
+    uint8_t free = field_free_mask(f);
+
+    for (unsigned dir = 0; free != 0; dir++, free >>= 1) {
+        if (free & 1u) {
+            field_t *n = field_neighbour(g, f, dir);
 
-    for (unsigned i = 0; i < MAX_NEIGHBOURS; i++) {
-        if (neighbours[i] != NULL && neighbours[i] != owner) {
-            player_set_perimeter(neighbours[i], player_perimeter(neighbours[i]) - 1);
+            if (!field_adjacent_to(g, n, owner, FIELD_DIR_BIT(dir ^ 1))) {
+                perimeter_remove(g, owner, n);
+            }
         }
     }
 }
 
-///@}
+/** @brief Usuwa pole ze zbioru wolnych pól planszy.
+ * Jeżeli gra utrzymuje zbiory pól, przenosi ostatnie pole tablicy
+ * @ref gamma::free_fields_arr na miejsce pola wskazywanego przez @p f. Zakłada,
+ * że pole to należy do zbioru.
+ * @param[in,out] g    – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in] f        – wskaźnik na strukturę przechowującą stan pola,
+ * @param[in] free_num – liczba pól w zbiorze przed usunięciem pola.
+ */
+static inline void free_fields_remove(gamma_t *g, field_t *f, uint64_t free_num) {
+    if (g->indexed) {
+        uint64_t last_pos = free_num - 1;
+        field_t *last = g->free_fields_arr[last_pos];
+        uint32_t pos = g->free_pos[board_index(g, f)];
+
+        g->free_fields_arr[pos] = last;
+        g->free_pos[board_index(g, last)] = pos;
+    }
+}
 
-/** @name Ruch
- * Sprawdzanie czy dany ruch może zostać przez gracza wykonany oraz realizacja
- * ruchu gracza.
+/** @brief Zwalnia zbiory pól.
+ * Zwalnia tablice zbiorów pól i oznacza, że gra ich nie utrzymuje. Tablice pól
+ * obwodów graczy pozostają zaalokowane do ponownego użycia.
+ * @param[in,out] g – wskaźnik na strukturę przechowującą stan gry.
  */
-///@{
+static void gamma_drop_index(gamma_t *g) {
+    free(g->free_fields_arr);
+    free(g->free_pos);
+    free(g->perimeter_slots);
+    g->free_fields_arr = NULL;
+    g->free_pos = NULL;
+    g->perimeter_slots = NULL;
+    g->indexed = false;
+}
 
-/** @brief Sprawdza, czy gracz może wykonać ruch.
- * Sprawdza, czy gracz wskazywany przez @p p może postawić pionek
- * na polu (@p x, @p y).
- * Sprawdza, czy pole (@p x, @p y) jest poprawne oraz wolne.
- * Sprawdza, czy wykonanie ruchu nie przekroczy maksymalnej dopuszczalnej liczby
- * obszarów zajętych przez jednego gracza.
- * @param[in] g – wskaźnik na strukturę przechowującą stan gry,
- * @param[in] p – wskaźnik na strukturę przechowującą stan gracza,
- * @param[in] x – numer kolumny, liczba nieujemna mniejsza od wartości @p width
- *                z funkcji @ref gamma_new,
- * @param[in] y – numer wiersza, liczba nieujemna mniejsza od wartości @p height
- *                z funkcji @ref gamma_new.
- * @return Wartość @p true, jeżeli gracz wskazywany przez @p p może postawić
- * pionek na polu (@p x, @p y), a @p false w przeciwnym przypadku.
+/** @brief Odbudowuje zbiory pól.
+ * Wyznacza od nowa obwody wszystkich graczy, przeglądając planszę, a jeżeli gra
+ * utrzymuje zbiory pól, także zbiór wolnych pól planszy i zbiory pól obwodów
+ * graczy. Jeżeli gra nie utrzymuje zbiorów pól, nie alokuje pamięci.
+ * @param[in,out] g – wskaźnik na strukturę przechowującą stan gry.
+ * @return Wartość @p true, jeżeli udało się odbudować zbiory pól, a @p false,
+ * jeżeli nie udało się zaalokować pamięci.
  */
-static bool player_move_legal(gamma_t *g, player_t *p, uint32_t x, uint32_t y) {
-    if (!valid_free_field(g, x, y)) {
-        return false;
+static bool gamma_rebuild_books(gamma_t *g) {
+    uint64_t free_fields = 0;
+
+    for (uint32_t player = 0; player++ < g->players;) {
+        player_set_perimeter(&g->players_arr[player], 0);
     }
-    else if (p == NULL || player_areas(p) < g->areas) {
-        return true;
+
+    if (g->indexed) {
+        memset(g->perimeter_slots, 0, (uint64_t) g->width * g->height
+                                      * PERIMETER_SLOTS * sizeof(perimeter_slot_t));
     }
-    else {
-        return player_adjacent_fields(g, p, x, y) > 0;
+
+    for (uint32_t y = 0; y < g->height; y++) {
+        for (uint32_t x = 0; x < g->width; x++) {
+            field_t *f = &g->board[y][x];
+
+            if (field_is_free(f)) {
+                player_t *owners[MAX_NEIGHBOURS];
+                unsigned owners_num = field_neighbour_owners(g, f, owners);
+
+                if (g->indexed) {
+                    g->free_pos[board_index(g, f)] = (uint32_t) free_fields;
+                    g->free_fields_arr[free_fields++] = f;
+                }
+
+                for (unsigned i = 0; i < owners_num; i++) {
+                    if (g->indexed
+                        && !perimeter_reserve(owners[i],
+                                              player_perimeter(owners[i]) + 1)) {
+                        return false;
+                    }
+
+                    perimeter_add(g, owners[i], f);
+                }
+            }
+        }
     }
+
+    g->books_version = g->version;
+    g->books_log_num = 0;
+    g->books_log_full = false;
+
+    return true;
 }
 
-/** @brief Wykonuje ruch.
- * Ustawia pionek gracza @p player na polu (@p x, @p y).
- * @param[in,out] g   – wskaźnik na strukturę przechowującą stan gry,
- * @param[in] player  – numer gracza, liczba dodatnia niewiększa od wartości
- *                      @p players z funkcji @ref gamma_new,
- * @param[in] x       – numer kolumny, liczba nieujemna mniejsza od wartości
- *                      @p width z funkcji @ref gamma_new,
- * @param[in] y       – numer wiersza, liczba nieujemna mniejsza od wartości
- *                      @p height z funkcji @ref gamma_new.
+/** @brief Zapisuje w dzienniku zmianę właściciela pola.
+ * Wywoływana w leniwym sposobie utrzymywania statystyk przed zmianą właściciela
+ * pola wskazywanego przez @p f. Jeżeli dziennik przekroczyłby dopuszczalny
+ * rozmiar lub nie udało się go powiększyć, oznacza go jako przepełniony,
+ * a kolejne zmiany aż do odbudowy zbiorów pól pomija.
+ * @param[in,out] g – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in] f     – wskaźnik na strukturę przechowującą stan pola.
  */
-static void gamma_move_update(gamma_t *g, uint32_t player, uint32_t x, uint32_t y) {
-    player_t *p = &g->players_arr[player];
-    field_t *f = &g->board[y][x];
+static void books_log_change(gamma_t *g, field_t *f) {
+    if (!g->books_log_full) {
+        if (g->books_log_num == g->books_log_capacity) {
+            uint64_t limit = (uint64_t) g->width * g->height / BOOKS_LOG_FRACTION;
+            uint64_t capacity = g->books_log_capacity == 0
+                                ? 64 : 2 * g->books_log_capacity;
+            books_change_t *log = capacity > limit ? NULL
+                                  : realloc(g->books_log,
+                                            capacity * sizeof(books_change_t));
+
+            if (log == NULL) {
+                g->books_log_full = true;
+
+                return;
+            }
 
-    field_set_owner(f, p);
-    g->busy_fields++;
-    player_set_busy_fields(p, player_busy_fields(p) + 1);
+            g->books_log = log;
+            g->books_log_capacity = capacity;
+        }
 
-    player_modify_areas(g, f);
-    neighbours_update_perimeter(g, f);
-    player_update_perimeter(g, f, false);
+        g->books_log[g->books_log_num++] = (books_change_t) {f, field_owner(f)};
+    }
 }
 
-///@}
-
-/** @name Złoty ruch
- * Sprawdzanie czy złoty ruch jest legalny zarówno ze strony gracza,
- * który stawia swój pionek na polu zajętym przez przeciwnika, nazywanym
- * ofiarą (@p victim), jak i ze strony tracącego pole.
- * Implementacja algorytmu przeszukiwania w głąb (DFS), wykorzystywanego
- * do sprawdzenia, czy usunięcie pola nie zwiększy liczby obszarów zajętych
- * przez ofiarę ponad dopuszczalny limit.
+/** @brief Wyznacza różnych właścicieli pól sąsiadujących z polem.
+ * Działa jak funkcja @ref field_neighbour_owners, lecz odczytuje właścicieli
+ * sąsiadów zamiast maski @ref field::busy, więc nie wymaga aktualnych masek
+ * sąsiedztwa.
+ * @param[in] g       – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in] f       – wskaźnik na strukturę przechowującą stan pola,
+ * @param[out] owners – tablica, w której mają zostać zapisani gracze.
+ * @return Liczba graczy zapisanych w tablicy @p owners.
  */
-///@{
+static unsigned field_owners_around(gamma_t *g, field_t *f,
+                                    player_t *owners[MAX_NEIGHBOURS]) {
+    unsigned added = 0;
 
-/** @brief Przeszukuje obszar zajęty przez gracza.
- * Wykonuje przeszukiwanie w głąb (DFS) obszaru zajętego przez gracza wskazywanego
- * przez @p owner, zaczynając od pola (@p x, @p y) i ustawiając status
- * @ref field::status każdego odwiedzonego pola w tym obszarze na wartość
- * @p desired, równą jednej z wartości zdefiniowanych w wyliczeniu @ref status.
- * @param[in,out] g      – wskaźnik na strukturę przechowującą stan gry,
- * @param[in] owner      – wskaźnik na strukturę przechowującą stan gracza,
- *                         będącego właścicielem pola (@p x, @p y),
- * @param[in] x          – numer kolumny, liczba nieujemna mniejsza od wartości
- *                         @p width z funkcji @ref gamma_new,
- * @param[in] y          – numer wiersza, liczba nieujemna mniejsza od wartości
- *                         @p height z funkcji @ref gamma_new,
- * @param[in] desired    – status na jaki ma się zmienić status każdego
- *                         odwiedzonego pola, jedna z wartości zdefiniowanych
- *                         w wyliczeniu @ref status.
- * @return Wartość @p true, jeżeli pole (@p x, @p y) jest poprawne i należy do
- * gracza wskazywanego przez @p owner oraz w momencie wywołania funkcji nie miało
- * jeszcze żądanego statusu, a @p false w przeciwnym przypadku.
- */
-static bool area_search(gamma_t *g, player_t *owner,
-                        int64_t x, int64_t y, status_t desired) {
-    if (!player_valid_field(g, owner, x, y)) {
-        return false;
-    }
-    else if (field_status(&g->board[y][x]) == desired) {
-        return false;
-    }
-    else {
-        field_set_status(&g->board[y][x], desired);
+    for (unsigned dir = 0; dir < MAX_NEIGHBOURS; dir++) {
+        field_t *n = field_neighbour(g, f, dir);
 
-        area_search(g, owner, x - 1, y, desired);
-        area_search(g, owner, x + 1, y, desired);
-        area_search(g, owner, x, y - 1, desired);
-        area_search(g, owner, x, y + 1, desired);
+        if (n != NULL && !field_is_free(n)) {
+            unsigned i = 0;
 
-        return true;
+            while (i < added && field_owner(n) != owners[i]) {
+                i++;
+            }
+
+            if (i == added) {
+                owners[added++] = field_owner(n);
+            }
+        }
     }
+
+    return added;
 }
 
-/** @brief Daje liczbę obszarów zajętych przez gracza po utracie pola (@p x, @p y).
- * Oblicza, ile obszarów będzie zajmować gracz wskazywany przez @p victim
- * po utracie pola (@p x, @p y).
- * @param[in,out] g      – wskaźnik na strukturę przechowującą stan gry,
- * @param[in] victim     – wskaźnik na strukturę przechowującą stan gracza,
- *                         będącego właścicielem pola (@p x, @p y),
- * @param[in] x          – numer kolumny, liczba nieujemna mniejsza od wartości
- *                         @p width z funkcji @ref gamma_new,
- * @param[in] y          – numer wiersza, liczba nieujemna mniejsza od wartości
- *                         @p height z funkcji @ref gamma_new.
- * @return Liczba obszarów, jakie będzie zajmować gracz wskazywany przez @p victim
- * po utracie pola (@p x, @p y).
+/** @brief Usuwa ze zbiorów pól lub dopisuje do nich pole i jego sąsiadów.
+ * Dla pola wskazywanego przez @p f i każdego jego sąsiada, nieodwiedzonego
+ * jeszcze w epoce @p epoch, oznacza je jako odwiedzone, a jeżeli jest wolne,
+ * usuwa je z obwodów graczy, których pola z nim sąsiadują, oraz ze zbioru
+ * wolnych pól planszy lub je do nich dopisuje. Właściciele pól są odczytywani
+ * bez korzystania z masek sąsiedztwa.
+ * @param[in,out] g        – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in] f            – wskaźnik na strukturę przechowującą stan pola,
+ * @param[in] epoch        – numer epoki przeszukiwania,
+ * @param[in] add          – wartość @p true, jeżeli pola mają zostać dopisane,
+ *                           a @p false, jeżeli mają zostać usunięte,
+ * @param[in,out] free_num – liczba pól w zbiorze wolnych pól planszy.
+ * @return Wartość @p true, jeżeli się to udało, a @p false, jeżeli nie udało się
+ * zaalokować pamięci na pola obwodu gracza.
  */
-static uint32_t victim_new_areas(gamma_t *g, player_t *victim,
-                                 uint32_t x, uint32_t y) {
-    field_set_status(&g->board[y][x], COUNTED);
+static bool books_update_around(gamma_t *g, field_t *f, uint32_t epoch, bool add,
+                                uint64_t *free_num) {
+    for (unsigned dir = 0; dir <= MAX_NEIGHBOURS; dir++) {
+        field_t *c = dir == MAX_NEIGHBOURS ? f : field_neighbour(g, f, dir);
 
-    uint32_t areas = player_areas(victim) - 1;
+        if (c != NULL && !field_visited(c, epoch)) {
+            field_set_visited(c, epoch);
 
-    areas += area_search(g, victim, x - 1, y, COUNTED);
-    areas += area_search(g, victim, x + 1, y, COUNTED);
-    areas += area_search(g, victim, x, y - 1, COUNTED);
-    areas += area_search(g, victim, x, y + 1, COUNTED);
+            if (field_is_free(c)) {
+                player_t *owners[MAX_NEIGHBOURS];
+                unsigned owners_num = field_owners_around(g, c, owners);
 
-    return areas;
+                for (unsigned i = 0; i < owners_num; i++) {
+                    if (!add) {
+                        perimeter_remove(g, owners[i], c);
+                    }
+                    else if (g->indexed
+                             && !perimeter_reserve(owners[i],
+                                                   player_perimeter(owners[i]) + 1)) {
+                        return false;
+                    }
+                    else {
+                        perimeter_add(g, owners[i], c);
+                    }
+                }
+
+                if (g->indexed && !add) {
+                    free_fields_remove(g, c, (*free_num)--);
+                }
+                else if (g->indexed) {
+                    g->free_pos[board_index(g, c)] = (uint32_t) *free_num;
+                    g->free_fields_arr[(*free_num)++] = c;
+                }
+            }
+        }
+    }
+
+    return true;
 }
 
-/** @brief Sprawdza, czy złoty ruch jest legalny ze strony gracza, który traci pole.
- * Funkcja zakłada, że współrzędne @p x oraz @p y są poprawne, ponieważ sprawdzenie
- * tego warunku powinno nastąpić w funkcji wołającej.
- * Sprawdza, czy pole (@p x, @p y) jest zajęte.
- * Sprawdza, czy złoty ruch jest legalny ze strony gracza, który traci pionek
- * z pola (@p x, @p y).
- * Sprawdza, czy po utracie pola (@p x, @p y) przez jego właściciela liczba zajętych
- * przez niego obszarów nie przekroczy maksymalnej dozwolonej liczby obszarów
- * zajętych przez jednego gracza.
- * @param[in] g – wskaźnik na strukturę przechowującą stan gry,
- * @param[in] x – numer kolumny, liczba nieujemna mniejsza od wartości @p width
- *                z funkcji @ref gamma_new,
- * @param[in] y – numer wiersza, liczba nieujemna mniejsza od wartości @p height
- *                z funkcji @ref gamma_new.
- * @return Wartość @p true, jeżeli po utracie pola (@p x, @p y) przez jego
- * właściciela liczba zajętych przez niego obszarów nie będzie przekraczać
- * maksymalnej dozwolonej liczby obszarów zajętych przez jednego gracza,
- * a @p false w przeciwnym przypadku.
+/** @brief Uaktualnia zbiory pól na podstawie dziennika zmian.
+ * Przywraca na czas uaktualnienia właścicieli pól zapisanych w dzienniku sprzed
+ * zmian, usuwa ze zbiorów pól każde pole zmienione od ostatniego uaktualnienia
+ * oraz jego sąsiadów, a po przywróceniu bieżących właścicieli dopisuje je
+ * ponownie. Czas działania jest proporcjonalny do liczby zmian, a nie do
+ * rozmiaru planszy. Maski sąsiedztwa pól nie są przy tym zmieniane. Jeżeli nie
+ * udało się zaalokować pamięci, zwalnia zbiory pól i wyznacza od nowa same
+ * obwody graczy, tak jak funkcja @ref gamma_build_index.
+ * @param[in,out] g – wskaźnik na strukturę przechowującą stan gry.
+ * @return Wartość @p true, jeżeli udało się uaktualnić zbiory pól, a @p false,
+ * jeżeli nie udało się zaalokować pamięci.
  */
-static bool victim_golden_move_legal(gamma_t *g, uint32_t x, uint32_t y) {
-    if (field_is_free(&g->board[y][x])) {
-        return false;
+static bool gamma_replay_books(gamma_t *g) {
+    books_change_t *log = g->books_log;
+    uint64_t free_num = (uint64_t) g->width * g->height - g->busy_fields;
+    uint32_t epoch = gamma_new_epochs(g, 2);
+
+    for (uint64_t i = g->books_log_num; i-- > 0;) {
+        player_t *owner = field_owner(log[i].f);
+
+        free_num += log[i].owner == NULL;
+        field_set_owner(log[i].f, log[i].owner);
+        log[i].owner = owner;
     }
-    else {
-        player_t *victim = field_owner(&g->board[y][x]);
-        unsigned mx_new_areas = player_adjacent_fields(g, victim, x, y) - 1;
 
-        if (player_areas(victim) + mx_new_areas <= g->areas) {
-            return true;
-        }
-        else if (victim_new_areas(g, victim, x, y) <= g->areas) {
-            return true;
-        }
-        else {
-            area_search(g, victim, x, y, UNCHECKED);
+    for (uint64_t i = 0; i < g->books_log_num; i++) {
+        books_update_around(g, log[i].f, epoch, false, &free_num);
+    }
+
+    for (uint64_t i = 0; i < g->books_log_num; i++) {
+        player_t *owner = field_owner(log[i].f);
+
+        field_set_owner(log[i].f, log[i].owner);
+        log[i].owner = owner;
+    }
+
+    for (uint64_t i = 0; i < g->books_log_num; i++) {
+        if (!books_update_around(g, log[i].f, epoch + 1, true, &free_num)) {
+            gamma_drop_index(g);
+            gamma_rebuild_books(g);
 
             return false;
         }
     }
+
+    g->books_version = g->version;
+    g->books_log_num = 0;
+
+    return true;
 }
 
-/** @brief Sprawdza, czy złoty ruch jest legalny ze strony gracza, który
- * stawia pionek na polu zajętym przez przeciwnika.
- * Zakłada, że gracz wskazywany przez @p p jeszcze nie wykonał w rozgrywce złotego
- * ruchu oraz że współrzędne pola (@p x, @p y) są poprawne, ponieważ sprawdzenie
- * tych warunków powinno nastąpić w funkcji wołającej.
- * Sprawdza, czy złoty ruch jest legalny ze strony gracza wskazywanego
- * przez @p p, który stawia pionek na polu (@p x, @p y) zajętym przez przeciwnika.
- * Sprawdza, czy pole (@p x, @p y) nie jest zajęte przez gracza wskazywanego przez
- * @p p oraz czy po postawieniu pionka na tym polu nie zostanie przekroczona
- * maksymalna liczba obszarów, jakie może gracz zajmować.
- * @param[in] g – wskaźnik na strukturę przechowującą stan gry,
- * @param[in] p – wskaźnik na strukturę przechowującą stan gracza,
- * @param[in] x – numer kolumny, liczba nieujemna mniejsza od wartości @p width
- *                z funkcji @ref gamma_new,
- * @param[in] y – numer wiersza, liczba nieujemna mniejsza od wartości @p height
- *                z funkcji @ref gamma_new.
- * @return Wartość @p true, jeżeli pole (@p x, @p y) nie jest zajęte przez gracza
- * wskazywanego przez @p p oraz po postawieniu pionka na tym polu nie zostanie
- * przekroczona maksymalna liczba obszarów, jakie może gracz zajmować.
+/** @brief Tworzy zbiory pól.
+ * Alokuje tablice zbiorów pól i wypełnia je funkcją @ref gamma_rebuild_books.
+ * Jeżeli się to nie uda, zwalnia je i wyznacza od nowa same obwody graczy, co
+ * nie wymaga alokowania pamięci, więc stan gry pozostaje spójny. Numery pól
+ * i indeksy w tablicach są zapisywane na 32 bitach, więc zbiorów pól nie da się
+ * utworzyć dla planszy mającej więcej niż @p UINT32_MAX pól.
+ * @param[in,out] g – wskaźnik na strukturę przechowującą stan gry.
+ * @return Wartość @p true, jeżeli udało się utworzyć zbiory pól, a @p false,
+ * jeżeli plansza jest zbyt duża lub nie udało się zaalokować pamięci.
  */
-static bool player_golden_move_legal(gamma_t *g, player_t *p,
-                                     uint32_t x, uint32_t y) {
-    if (field_is_free(&g->board[y][x]) || field_owner(&g->board[y][x]) == p) {
+static bool gamma_build_index(gamma_t *g) {
+    uint64_t cells = (uint64_t) g->width * g->height;
+
+    if (cells > UINT32_MAX) {
         return false;
     }
-    else if (player_areas(p) < g->areas) {
+
+    g->free_fields_arr = malloc(cells * sizeof(field_t *));
+    g->free_pos = malloc(cells * sizeof(uint32_t));
+    g->perimeter_slots = malloc(cells * PERIMETER_SLOTS * sizeof(perimeter_slot_t));
+    g->indexed = true;
+
+    if (g->free_fields_arr != NULL && g->free_pos != NULL
+        && g->perimeter_slots != NULL && gamma_rebuild_books(g)) {
         return true;
     }
     else {
-        return player_adjacent_fields(g, p, x, y) > 0;
+        gamma_drop_index(g);
+        gamma_rebuild_books(g);
+
+        return false;
     }
 }
 
-/** @brief Zmienia rangę oraz rodzica w każdym polu obszaru.
- * Wykonuje przeszukiwanie w głąb (DFS) obszaru zajętego przez gracza wskazywanego
- * przez @p owner, zaczynając od pola (@p x, @p y) i ustawiając składową
- * @ref field::rank każdego odwiedzonego pola na 0 oraz składową @ref field::parent
- * na wartość równą zmiennej @p parent będącej parametrem procedury.
- * Ustawia status @ref field::status każdego odwiedzonego pola na @p MODIFIED.
- * @param[in,out] g      – wskaźnik na strukturę przechowującą stan gry,
- * @param[in] owner      – wskaźnik na strukturę przechowującą stan gracza,
- *                         będącego właścicielem pola (@p x, @p y),
- * @param[in] x          – numer kolumny, liczba nieujemna mniejsza od wartości
- *                         @p width z funkcji @ref gamma_new,
- * @param[in] y          – numer wiersza, liczba nieujemna mniejsza od wartości
- *                         @p height z funkcji @ref gamma_new,
- * @param[in] parent     – wskaźnik na pole będące nowym rodzicem każdego
- *                         odwiedzonego pola.
+/** @brief Uaktualnia zbiory pól.
+ * Jeżeli wymagane są zbiory pól, a gra ich jeszcze nie utrzymuje, tworzy je
+ * funkcją @ref gamma_build_index. W przeciwnym przypadku, jeżeli gra utrzymuje
+ * statystyki leniwie i od ostatniego uaktualnienia wykonano ruch, uaktualnia
+ * obwody graczy oraz utrzymywane zbiory pól funkcją @ref gamma_replay_books,
+ * a gdy dziennik zmian jest przepełniony, odbudowuje je funkcją
+ * @ref gamma_rebuild_books.
+ * @param[in,out] g – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in] sets  – wartość @p true, jeżeli potrzebne są zbiory pól, a @p false,
+ *                    jeżeli wystarczą obwody graczy.
+ * @return Wartość @p true, jeżeli obwody graczy oraz, w razie potrzeby, zbiory
+ * pól są aktualne, a @p false, jeżeli nie udało się zaalokować pamięci lub
+ * plansza jest zbyt duża, by utworzyć zbiory pól.
  */
-static void area_update_parent_and_rank(gamma_t *g, player_t *owner,
-                                        int64_t x, int64_t y, field_t *parent) {
-    if (player_valid_field(g, owner, x, y)
-        && field_status(&g->board[y][x]) != MODIFIED) {
-
-        field_t *f = &g->board[y][x];
-        field_set_rank(f, 0);
-        field_set_parent(f, parent);
-        field_set_status(f, MODIFIED);
-
-        area_update_parent_and_rank(g, owner, x - 1, y, parent);
-        area_update_parent_and_rank(g, owner, x + 1, y, parent);
-        area_update_parent_and_rank(g, owner, x, y - 1, parent);
-        area_update_parent_and_rank(g, owner, x, y + 1, parent);
+static bool gamma_sync_books(gamma_t *g, bool sets) {
+    if (sets && !g->indexed) {
+        return gamma_build_index(g);
+    }
+    else if (g->policy == GAMMA_POLICY_EAGER || g->books_version == g->version) {
+        return true;
+    }
+    else if (g->books_log_full) {
+        return gamma_rebuild_books(g);
+    }
+    else {
+        return gamma_replay_books(g);
     }
 }
 
-/** @brief Wyodrębnia nowy obszar ze starego po usunięciu z niego pola w wyniku
- * złotego ruchu.
- * Jeżeli pole (@p x, @p y) należy do gracza wskazywanego przez @p old_owner,
- * będącego graczem który w wyniku złotego ruchu wykonanego przez przeciwnika
- * stracił sąsiadujące pole, czyni pole (@p x, @p y) korzeniem nowego obszaru,
- * ustawiając jego rangę @ref field::rank na 0 oraz rodzica @p parent na NULL,
- * po czym wywołuje funkcję @ref area_update_parent_and_rank dla każdego sąsiedniego
- * pola, przekazując jako parametr @p parent tej funkcji wskaźnik do struktury
- * przechowującej stan pola (@p x, @p y).
- * Oblicza liczbę obszarów zajętych przez gracza wskazywanego przez @p old_owner
- * po wyodrębnieniu wszystkich nowych obszarów.
- * @param[in,out] g      – wskaźnik na strukturę przechowującą stan gry,
- * @param[in] old_owner  – wskaźnik na strukturę przechowującą stan gracza,
- *                         będącego właścicielem pola (@p x, @p y),
- * @param[in] x          – numer kolumny, liczba nieujemna mniejsza od wartości
- *                         @p width z funkcji @ref gamma_new,
- * @param[in] y          – numer wiersza, liczba nieujemna mniejsza od wartości
- *                         @p height z funkcji @ref gamma_new,
- * @param[in,out] areas  – liczba obszarów zajętych przez gracza wskazywanego
- *                         przez @p old_owner.
- * @return Liczba obszarów zajętych przez gracza wskazywanego przez @p old_owner
- * po ewentualnym wyobrębnieniu nowego obszaru z korzeniem w polu (@p x, @p y).
- */
-static uint32_t area_set_component(gamma_t *g, player_t *old_owner,
-                                   uint32_t x, uint32_t y, uint32_t areas) {
-    if (player_valid_field(g, old_owner, x, y)) {
-        if (field_status(&g->board[y][x]) != MODIFIED) {
-            areas++;
+///@}
 
-            field_t *root = &g->board[y][x];
-            field_set_status(root, MODIFIED);
-            field_set_rank(root, 0);
-            field_set_parent(root, NULL);
+/** @name Gracz
+ * Sprawdzanie czy gracz lub związany z nim element spełnia określony predykat.
+ * Zmiana stanu gracza lub związanych z nim elementów przy wykonywaniu ruchów
+ * przez tego gracza podczas zwykłego ruchu lub innego gracza podczas złotego ruchu.
+ */
+///@{
+
+/** @brief Sprawdza poprawność numeru gracza.
+ * Sprawdza, czy numer gracza @p player jest liczbą całkowitą dodatnią
+ * nie większą od wartości @p players z funkcji @ref gamma_new.
+ * @param[in] g      – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in] player – numer gracza, liczba dodatnia niewiększa od wartości
+ *                     @p players z funkcji @ref gamma_new.
+ * @return Wartość @p true, jeśli numer gracza jest poprawny,
+ * a @p false w przeciwnym przypadku.
+ */
+static inline bool valid_player(gamma_t *g, int64_t player) {
+    return 1 <= player && player <= g->players;
+}
+
+/** @brief Aktualizuje obwód gracza po wykonaniu przez niego ruchu.
+ * Dodaje do obwodu gracza będącego właścicielem pola wskazywanego przez @p f,
+ * po wykonaniu przez niego ruchu na to pole, każde wolne pole z nim sąsiadujące,
+ * które nie należało jeszcze do obwodu tego gracza, czyli nie sąsiaduje z innym
+ * polem tego gracza. Zakłada, że tablica pól obwodu gracza mieści co najmniej
+ * @p MAX_NEIGHBOURS dodatkowych pól, jeżeli gra utrzymuje zbiory pól.
+ * @param[in,out] g       – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in] f           – wskaźnik na strukturę przechowującą stan pola właśnie
+ *                          zajętego przez gracza.
+ */
+static void player_update_perimeter(gamma_t *g, field_t *f) {
+    player_t *owner = field_owner(f);
+    uint8_t free = field_free_mask(f);
+
+    for (unsigned dir = 0; free != 0; dir++, free >>= 1) {
+        if (free & 1u) {
+            field_t *n = field_neighbour(g, f, dir);
 
-            area_update_parent_and_rank(g, old_owner, x - 1, y, root);
-            area_update_parent_and_rank(g, old_owner, x + 1, y, root);
-            area_update_parent_and_rank(g, old_owner, x, y - 1, root);
-            area_update_parent_and_rank(g, old_owner, x, y + 1, root);
+            if (!field_adjacent_to(g, n, owner, FIELD_DIR_BIT(dir ^ 1))) {
+                perimeter_add(g, owner, n);
+            }
         }
     }
+}
 
-    return areas;
+/** @brief Zlicza wolnych sąsiadów pola, którzy nie sąsiadują z innym polem
+ * danego obszaru.
+ * Zlicza wolne pola sąsiadujące z polem wskazywanym przez @p f, które nie
+ * sąsiadują z żadnym innym niż @p f polem obszaru, którego korzeniem jest pole
+ * wskazywane przez @p root.
+ * @param[in] g    – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in] f    – wskaźnik na strukturę przechowującą stan pola należącego
+ *                   do obszaru,
+ * @param[in] root – wskaźnik na strukturę przechowującą stan pola będącego
+ *                   korzeniem obszaru.
+ * @return Liczba wolnych pól sąsiadujących z polem wskazywanym przez @p f,
+ * które poza nim nie sąsiadują z żadnym polem obszaru o korzeniu @p root.
+ */
+static unsigned area_free_single_neighbours(gamma_t *g, field_t *f, field_t *root) {
+    uint8_t free = field_free_mask(f);
+    unsigned fields = 0;
+
+    for (unsigned dir = 0; free != 0; dir++, free >>= 1) {
+        if (free & 1u) {
+            field_t *n = field_neighbour(g, f, dir);
+            uint8_t busy = field_busy_mask(n) & (uint8_t) ~FIELD_DIR_BIT(dir ^ 1);
+            bool single = true;
+
+            for (unsigned n_dir = 0; busy != 0 && single; n_dir++, busy >>= 1) {
+                if (busy & 1u) {
+                    field_t *m = field_neighbour(g, n, n_dir);
+                    single = field_owner(m) != field_owner(f)
+                             || area_find_root(m) != root;
+                }
+            }
+
+            fields += single;
+        }
+    }
+
+    return fields;
 }
 
-/** @brief Modyfikuje obszary gracza po utracie przez niego pola (@p x, @p y).
- * Dla każdego pola sąsiadującego z (@p x, @p y), należącego do gracza wskazywanego
- * przez @p old_owner i nie należącego do żadnego nowo stworzonego obszaru, tworzy
- * nowy obszar z korzeniem w tym polu.
- * Odpowiednio aktualizuje liczbę obszarów zajętych przez gracza wskazywanego przez
- * @p old_owner.
- * @param[in,out] g      – wskaźnik na strukturę przechowującą stan gry,
- * @param[in] old_owner  – wskaźnik na strukturę przechowującą stan gracza,
- *                         który utracił pole (@p x, @p y),
- * @param[in] x          – numer kolumny, liczba nieujemna mniejsza od wartości
- *                         @p width z funkcji @ref gamma_new,
- * @param[in] y          – numer wiersza, liczba nieujemna mniejsza od wartości
- *                         @p height z funkcji @ref gamma_new.
+/** @brief Modyfikuje obszary gracza po wykonaniu przez niego ruchu na pole
+ * wskazywane przez @p f.
+ * Wyznacza różne obszary właściciela pola wskazywanego przez @p f, do których
+ * należą jego sąsiedzi wskazani przez maskę @ref field::same. Jeżeli takiego
+ * obszaru nie ma, tworzy nowy obszar składający się tylko z tego pola. Jeżeli
+ * jest dokładnie jeden, dołącza do niego pole bez przydzielania statystyk
+ * obszaru i aktualizuje liczbę jego wolnych sąsiadów bez przeszukiwania obszaru.
+ * W przeciwnym przypadku tworzy nowy obszar i łączy go z każdym z sąsiednich
+ * obszarów, zmniejszając o 1 liczbę obszarów gracza przy każdym połączeniu, a
+ * liczba wolnych sąsiadów połączonego obszaru pozostaje nieaktualna.
+ * @param[in] g           – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in] f           – wskaźnik na strukturę przechowującą stan pola właśnie
+ *                          zajętego przez gracza,
+ * @param[in] golden_move – wartość @p true, jeżeli funkcja została wywołana
+ *                          w wyniku wykonania złotego ruchu przez gracza,
+ *                          a @p false, jeżeli funkcja została wywołana w wyniku
+ *                          wykonania zwykłego ruchu przez gracza.
  */
-static void old_owner_modify_areas(gamma_t *g, player_t *old_owner,
-                                   uint32_t x, uint32_t y) {
-    uint32_t areas = player_areas(old_owner) - 1;
+static void player_modify_areas(gamma_t *g, field_t *f, bool golden_move) {
+    player_t *owner = field_owner(f);
+    uint8_t same = field_same_mask(f);
+    field_t *roots[MAX_NEIGHBOURS];
+    unsigned roots_num = 0;
 
-    areas = area_set_component(g, old_owner, x - 1, y, areas);
-    areas = area_set_component(g, old_owner, x + 1, y, areas);
-    areas = area_set_component(g, old_owner, x, y - 1, areas);
-    areas = area_set_component(g, old_owner, x, y + 1, areas);
+    for (unsigned dir = 0; same != 0; dir++, same >>= 1) {
+        if (same & 1u) {
+            field_t *root = area_find_root(field_neighbour(g, f, dir));
+            unsigned i = 0;
 
-    player_set_areas(old_owner, areas);
+            while (i < roots_num && root != roots[i]) {
+                i++;
+            }
+
+            if (i == roots_num) {
+                roots[roots_num++] = root;
+            }
+        }
+    }
+
+    if (roots_num == 1) {
+        area_t *a = field_area(roots[0]);
+
+        field_set_parent(f, roots[0]);
+        area_include(a, field_x(f), field_y(f));
+        area_invalidate_cuts(a);
+
+        if (area_liberties_valid(a) && g->policy == GAMMA_POLICY_EAGER) {
+            uint64_t liberties = area_liberties(a);
+
+            if (!golden_move) {
+                liberties--;
+            }
+
+            liberties += area_free_single_neighbours(g, f, roots[0]);
+            area_set_liberties(a, liberties);
+        }
+    }
+    else {
+        area_new(g, f);
+
+        for (unsigned i = 0; i < roots_num; i++) {
+            area_merge(g, f, roots[i]);
+        }
 
-    area_search(g, old_owner, x - 1, y, UNCHECKED);
-    area_search(g, old_owner, x + 1, y, UNCHECKED);
-    area_search(g, old_owner, x, y - 1, UNCHECKED);
-    area_search(g, old_owner, x, y + 1, UNCHECKED);
+        player_set_areas(owner, player_areas(owner) - roots_num);
+    }
 }
 
-/** @brief Wykonuje złoty ruch.
- * Ustawia pionek gracza @p player na polu (@p x, @p y) zajętym przez innego
- * gracza, usuwając pionek innego gracza.
- * @param[in,out] g   – wskaźnik na strukturę przechowującą stan gry,
- * @param[in] player  – numer gracza, liczba dodatnia niewiększa od wartości
- *                      @p players z funkcji @ref gamma_new,
- * @param[in] x       – numer kolumny, liczba nieujemna mniejsza od wartości
- *                      @p width z funkcji @ref gamma_new,
- * @param[in] y       – numer wiersza, liczba nieujemna mniejsza od wartości
- *                      @p height z funkcji @ref gamma_new.
+///@}
+
+/** @name Sąsiedzi
+ * Aktualizacja obwodów graczy oraz liczby wolnych sąsiadów obszarów posiadających
+ * co najmniej jedno pole sąsiadujące z polem, na które stawiany jest pionek.
  */
-static void gamma_golden_move_update(gamma_t *g, uint32_t player,
-                                     uint32_t x, uint32_t y) {
-    player_t *new_owner = &g->players_arr[player];
-    field_t *f = &g->board[y][x];
-    player_t *old_owner = field_owner(f);
+///@{
 
-    field_set_owner(f, new_owner);
-    field_set_status(f, UNCHECKED);
+/** @brief Zmniejsza o 1 liczbę wolnych sąsiadów każdego obszaru sąsiadującego
+ * z polem wskazywanym przez @p f.
+ * Rozpatruje tylko zajętych sąsiadów pola, niebędących polami jego właściciela,
+ * wskazanych przez maski @ref field::busy oraz @ref field::same pola, które było
+ * dotąd wolne i na którym postawiono właśnie pionek. Zmniejsza o 1 liczbę wolnych
+ * sąsiadów każdego z obszarów, do których należą te pola, uwzględniając każdy
+ * z nich tylko raz.
+ * @param[in] g              – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in] f              – wskaźnik na strukturę przechowującą stan pola.
+ */
+static void neighbours_update_liberties(gamma_t *g, field_t *f) {
+    uint8_t others = g->liberties_tracked
+                     ? field_busy_mask(f) & (uint8_t) ~field_same_mask(f) : 0;
+    field_t *roots[MAX_NEIGHBOURS];
+    unsigned added = 0;
 
-    player_modify_areas(g, f);
-    player_update_perimeter(g, f, true);
-    player_set_golden_possible(new_owner, false);
-    player_set_busy_fields(new_owner, player_busy_fields(new_owner) + 1);
+    for (unsigned dir = 0; others != 0; dir++, others >>= 1) {
+        if (others & 1u) {
+            field_t *root = area_find_root(field_neighbour(g, f, dir));
+            unsigned i = 0;
 
-    old_owner_modify_areas(g, old_owner, x, y);
-    player_set_busy_fields(old_owner, player_busy_fields(old_owner) - 1);
-    player_set_perimeter(old_owner,
-                         player_perimeter(old_owner) -
-                         player_adjacent_free_single_fields(g, old_owner, x, y));
+            while (i < added && root != roots[i]) {
+                i++;
+            }
+
+            if (i == added) {
+                roots[added++] = root;
+
+                area_t *a = field_area(root);
+
+                if (area_liberties_valid(a)) {
+                    area_set_liberties(a, area_liberties(a) - 1);
+                }
+            }
+        }
+    }
 }
 
 ///@}
 
-/** @name Plansza
- * Tworzenie, usuwanie oraz wypisywanie planszy.
+/** @name Aktywni gracze
+ * Utrzymanie cyklicznej listy graczy, którzy mogą wykonać ruch lub złoty ruch,
+ * uporządkowanej według numerów graczy. Ruch oznacza do sprawdzenia tylko graczy,
+ * których statystyki zmienił, a lista jest aktualizowana leniwie, przy pierwszym
+ * zapytaniu po ruchu. Możliwość wykonania złotego ruchu przez gracza, który
+ * zajmuje maksymalną liczbę obszarów, zależy od obszarów graczy sąsiadujących
+ * z jego polami, więc gracz ten dopisuje się do ich list obserwatorów, a ruch
+ * oznacza do sprawdzenia obserwatorów gracza, który go wykonał. Gracze, których
+ * nie udało się dopisać, są sprawdzani po każdym ruchu.
+ * Gracz usunięty z listy pamięta swoich sąsiadów z chwili usunięcia, dzięki czemu
+ * następnik dowolnego gracza można znaleźć bez przeglądania wszystkich graczy.
  */
 ///@{
 
-/** @brief Usuwa wiersze planszy.
- * Usuwa @p num_of_rows początkowych wierszy tablicy @ref  gamma::board
- * struktur przechowujących stany pól, reprezentującej planszę, na której
- * toczy się rozgrywka.
- * Zwalnia pamięć po każdym z @p num_of_rows początkowych wierszy.
- * @param[in,out] board       – tablica pól, o liczbie wierszy
- *                              równej wartości @p height z funkcji
- *                              @ref gamma_new oraz liczbie kolumn równej
- *                              wartości @p width z funkcji @ref gamma_new,
- *                              reprezentująca planszę na której odbywa się
- *                              rozgrywka,
- * @param[in] num_of_rows     – liczba wierszy tablicy @ref gamma::board,
- *                              które należy usunąć.
+/** @brief Podaje odległość między graczami na liście cyklicznej.
+ * @param[in] g – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in] a – numer gracza, od którego liczona jest odległość,
+ * @param[in] b – numer gracza, do którego liczona jest odległość.
+ * @return Liczba kroków, o jaką gracz @p b następuje po graczu @p a w cyklicznej
+ * kolejności numerów graczy.
  */
-static inline void board_remove_rows(field_t **board, uint32_t num_of_rows) {
-    for (uint32_t i = 0; i < num_of_rows; i++) {
-        free(board[i]);
+static inline uint32_t player_distance(gamma_t *g, uint32_t a, uint32_t b) {
+    return (uint32_t) (((uint64_t) b + g->players - a) % g->players);
+}
+
+/** @brief Znajduje najbliższego aktywnego gracza następującego po danym graczu.
+ * Przechodzi po zapamiętanych następnikach, aż trafi na aktywnego gracza, po czym
+ * cofa się po liście aktywnych graczy, dopóki poprzednik leży bliżej gracza
+ * @p player. Zakłada, że lista aktywnych graczy nie jest pusta.
+ * @param[in] g      – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in] player – numer gracza, liczba dodatnia niewiększa od wartości
+ *                     @p players z funkcji @ref gamma_new.
+ * @return Numer pierwszego aktywnego gracza następującego cyklicznie po graczu
+ * @p player, równy @p player, jeżeli jest on jedynym aktywnym graczem.
+ */
+static uint32_t active_successor(gamma_t *g, uint32_t player) {
+    uint32_t next = player;
+
+    do {
+        next = player_next_active(&g->players_arr[next]);
+    } while (!player_active(&g->players_arr[next]));
+
+    uint32_t prev = player_prev_active(&g->players_arr[next]);
+
+    while (player_distance(g, player, prev) > 0
+           && player_distance(g, player, prev) < player_distance(g, player, next)) {
+        next = prev;
+        prev = player_prev_active(&g->players_arr[next]);
     }
+
+    return next;
 }
 
-/** @brief Tworzy planszę.
- * Alokuje pamięć na tablicę wskaźników do struktur przechowujących stan pól,
- * o @p height wierszach i @p width kolumnach.
- * Przypisuje każdej komórce tej tablicy wartość NULL.
- * @param[in] width           – szerokość tworzonej planszy, długość każdego
- *                              z wierszy tworzonej tablicy, równa wartości
- *                              @p width z funkcji @ref gamma_new,
- * @param[in] height          – wysokość tworzonej planszy, liczba wierszy
- *                              tworzonej tablicy, wartość równa @p height
- *                              z funkcji @ref gamma_new.
- * @return Wskaźnik na utworzoną tablicę lub NULL, jeśli nie udało się zaalokować
- * pamięci.
+/** @brief Dodaje gracza do listy aktywnych graczy.
+ * Jeżeli lista jest pusta, zapamiętani sąsiedzi usuniętych graczy mogą tworzyć
+ * cykle, więc wszyscy gracze zapamiętują dodawanego gracza jako swojego sąsiada.
+ * @param[in,out] g  – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in] player – numer nieaktywnego gracza.
  */
-static field_t **board_new(uint32_t width, uint32_t height) {
-    field_t **board = calloc(height, sizeof(field_t *));
+static void active_insert(gamma_t *g, uint32_t player) {
+    player_t *p = &g->players_arr[player];
 
-    if (board == NULL) {
-        return NULL;
+    if (g->active_players == 0) {
+        for (uint32_t other = 0; other++ < g->players;) {
+            player_set_next_active(&g->players_arr[other], player);
+            player_set_prev_active(&g->players_arr[other], player);
+        }
     }
     else {
-        bool mem_error = false;
-        uint32_t added_rows = 0;
+        uint32_t next = active_successor(g, player);
+        uint32_t prev = player_prev_active(&g->players_arr[next]);
 
-        for (uint32_t i = 0; i < height && !mem_error; i++, added_rows++) {
-            board[i] = calloc(width, sizeof(field_t));
-            if (board[i] == NULL) {
-                mem_error = true;
-                board_remove_rows(board, added_rows);
+        player_set_next_active(p, next);
+        player_set_prev_active(p, prev);
+        player_set_next_active(&g->players_arr[prev], player);
+        player_set_prev_active(&g->players_arr[next], player);
+    }
+
+    player_set_active(p, true);
+    g->active_players++;
+}
+
+/** @brief Usuwa gracza z listy aktywnych graczy.
+ * Gracz zachowuje numery swojego poprzednika i następnika z chwili usunięcia.
+ * @param[in,out] g  – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in] player – numer aktywnego gracza.
+ */
+static void active_remove(gamma_t *g, uint32_t player) {
+    player_t *p = &g->players_arr[player];
+
+    player_set_next_active(&g->players_arr[player_prev_active(p)],
+                           player_next_active(p));
+    player_set_prev_active(&g->players_arr[player_next_active(p)],
+                           player_prev_active(p));
+    player_set_active(p, false);
+    g->active_players--;
+}
+
+/** @brief Oznacza aktywność gracza do ponownego wyznaczenia.
+ * @param[in,out] g – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in,out] p – wskaźnik na strukturę przechowującą stan gracza.
+ */
+static inline void player_mark_dirty(gamma_t *g, player_t *p) {
+    if (!player_dirty(p)) {
+        player_set_dirty(p, true);
+        g->dirty_players[g->dirty_count++] = player_number(p);
+    }
+}
+
+/** @brief Dopisuje gracza do listy obserwatorów innego gracza.
+ * Nic nie robi, jeżeli w bieżącym przeglądzie sąsiadów obserwatora już go
+ * dopisano. Zanim powiększy tablicę wpisów, usuwa z niej wpisy nieaktualne,
+ * dzięki czemu lista zawiera co najwyżej jeden aktualny wpis każdego gracza.
+ * @param[in,out] g       – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in,out] owner   – wskaźnik na strukturę przechowującą stan gracza
+ *                          obserwowanego,
+ * @param[in] watcher     – wskaźnik na strukturę przechowującą stan gracza
+ *                          obserwującego.
+ * @return Wartość @p true, jeżeli gracz jest na liście obserwatorów, a @p false,
+ * jeżeli nie udało się zaalokować pamięci.
+ */
+static bool player_watch_add(gamma_t *g, player_t *owner, player_t *watcher) {
+    uint64_t stamp = player_watch_stamp(watcher);
+    player_watch_t *watchers = player_watchers(owner);
+    uint32_t num = player_watchers_num(owner);
+
+    if (player_watched_stamp(owner) == stamp) {
+        return true;
+    }
+
+    if (num == player_watchers_capacity(owner)) {
+        uint32_t kept = 0;
+
+        for (uint32_t i = 0; i < num; i++) {
+            if (watchers[i].stamp
+                == player_watch_stamp(&g->players_arr[watchers[i].player])) {
+                watchers[kept++] = watchers[i];
             }
         }
 
-        if (!mem_error) {
-            return board;
-        }
-        else {
-            free(board);
+        num = kept;
 
-            return NULL;
+        if (num >= player_watchers_capacity(owner) / 2) {
+            uint64_t capacity = num == 0 ? 4 : 2 * (uint64_t) num;
+
+            if (capacity > g->players) {
+                capacity = (uint64_t) g->players + 1;
+            }
+
+            watchers = realloc(watchers, capacity * sizeof(player_watch_t));
+
+            if (watchers == NULL) {
+                player_set_watchers_num(owner, num);
+
+                return false;
+            }
+
+            player_set_watchers(owner, watchers, (uint32_t) capacity);
         }
     }
+
+    watchers[num++] = (player_watch_t) {player_number(watcher), stamp};
+    player_set_watchers_num(owner, num);
+    player_set_watched_stamp(owner, stamp);
+
+    return true;
 }
 
-/** @brief Wypełnia bufor opisujący stan planszy.
- * Wypełnia bufor wskazywany przez @p board opisujący stan planszy.
- * @param[in] g               – wskaźnik na strukturę przechowującą stan gry,
- * @param[in,out] board       – wskaźnik na bufor mający przechowywać tekstowy
- *                              opis stanu planszy.
+/** @brief Oznacza aktywność każdego gracza do ponownego wyznaczenia.
+ * @param[in,out] g – wskaźnik na strukturę przechowującą stan gry.
  */
-static void gamma_board_fill(gamma_t *g, char *board) {
-    uint64_t filled = 0;
+static void players_mark_all_dirty(gamma_t *g) {
+    for (uint32_t player = 0; player++ < g->players;) {
+        player_mark_dirty(g, &g->players_arr[player]);
+    }
+}
 
-    for (int64_t y = g->height - 1; y >= 0; y--, filled++) {
-        for (uint32_t x = 0; x < g->width; x++) {
-            char repr[FIELD_MAX_WIDTH + 1];
+/** @brief Oznacza do ponownego wyznaczenia aktywność obserwatorów gracza.
+ * Oznacza każdego gracza, który ma aktualny wpis na liście obserwatorów gracza
+ * wskazywanego przez @p owner, i opróżnia tę listę. Oznaczeni gracze dopiszą się
+ * do niej ponownie przy wyznaczaniu swojej aktywności.
+ * @param[in,out] g     – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in,out] owner – wskaźnik na strukturę przechowującą stan gracza, którego
+ *                        obszary się zmieniły.
+ */
+static void players_mark_watchers(gamma_t *g, player_t *owner) {
+    player_watch_t *watchers = player_watchers(owner);
 
-            field_repr(&g->board[y][x], repr, g->board_field_width);
-            strncpy(board + filled, repr, g->board_field_width);
+    for (uint32_t i = 0; i < player_watchers_num(owner); i++) {
+        player_t *watcher = &g->players_arr[watchers[i].player];
 
-            filled += g->board_field_width;
+        if (watchers[i].stamp == player_watch_stamp(watcher)) {
+            player_mark_dirty(g, watcher);
         }
-
-        board[filled] = '\n';
     }
 
-    board[filled] = '\0';
+    player_set_watchers_num(owner, 0);
+    player_set_watched_stamp(owner, 0);
 }
 
-/** @brief Daje napis opisujący stan planszy.
- * Alokuje w pamięci bufor, w którym umieszcza napis zawierający tekstowy
- * opis aktualnego stanu planszy.
- * @param[in] g               – wskaźnik na strukturę przechowującą stan gry,
- * @param[in] board_len       – długość, jaką ma mieć bufor zawierający
- *                              napis opisujący planszę.
- * @return Wskaźnik na zaalokowany bufor zawierający napis opisujący stan
- * planszy lub NULL, jeśli nie udało się zaalokować pamięci.
+/** @brief Wyznacza ponownie aktywność gracza.
+ * Sprawdza, czy gracz @p player może wykonać ruch lub złoty ruch, i odpowiednio
+ * dodaje go do listy aktywnych graczy lub z niej usuwa. Gracz, który może wykonać
+ * tylko złoty ruch, dopisuje się przy tym do list obserwatorów swoich sąsiadów
+ * w funkcji @ref gamma_golden_possible.
+ * @param[in,out] g  – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in] player – numer gracza, liczba dodatnia niewiększa od wartości
+ *                     @p players z funkcji @ref gamma_new.
+ * @return Wartość @p true, jeżeli gracz nie może wykonać zwykłego ruchu, nie
+ * wykonał jeszcze złotego ruchu, zajmuje maksymalną liczbę obszarów i nie udało
+ * się dopisać go do list obserwatorów sąsiadów, a @p false w przeciwnym
+ * przypadku.
  */
-static char *gamma_board_new(gamma_t *g, uint64_t board_len) {
-    char *board = calloc(board_len, sizeof(char));
+static bool player_update_active(gamma_t *g, uint32_t player) {
+    player_t *p = &g->players_arr[player];
+    bool free = gamma_free_fields(g, player) > 0;
+    bool active = free || gamma_golden_possible(g, player);
 
-    if (board != NULL) {
-        gamma_board_fill(g, board);
+    if (active && !player_active(p)) {
+        active_insert(g, player);
+    }
+    else if (!active && player_active(p)) {
+        active_remove(g, player);
     }
 
-    return board;
+    return !free && player_golden_possible(p) && player_areas(p) >= g->areas
+           && player_watch_stamp(p) == 0;
 }
 
-///@}
-
-/** @name Inicjacja
- * Inicjacja struktury przechowującej stan gry.
+/** @brief Aktualizuje listę aktywnych graczy.
+ * Wyznacza ponownie aktywność graczy oznaczonych od ostatniej aktualizacji oraz
+ * graczy, których aktywność zależy tylko od możliwości wykonania złotego ruchu,
+ * a nie udało się dopisać ich do list obserwatorów sąsiadów.
+ * Nic nie robi, jeżeli od ostatniej aktualizacji nie wykonano żadnego ruchu.
+ * @param[in,out] g – wskaźnik na strukturę przechowującą stan gry.
  */
-///@{
+static void gamma_sync_active(gamma_t *g) {
+    if (g->active_stale) {
+        for (uint32_t i = 0; i < g->dirty_count; i++) {
+            player_t *p = &g->players_arr[g->dirty_players[i]];
+            player_set_dirty(p, false);
 
-/** @brief Inicjuje strukturę przechowującą stan gry.
- * Inicjuje strukturę przechowującą stan gry, wskazywaną przez @p g,
- * tak, aby reprezentowała początkowy stan gry.
- * @param[in,out] g   – wskaźnik na inicjalizowaną strukturę,
+            if (player_update_active(g, g->dirty_players[i])
+                && !player_dependent(p)) {
+
+                player_set_dependent(p, true);
+                g->dependent_players[g->dependent_count++] = player_number(p);
+            }
+        }
+
+        uint32_t kept = 0;
+
+        for (uint32_t i = 0; i < g->dependent_count; i++) {
+            uint32_t player = g->dependent_players[i];
+
+            if (player_update_active(g, player)) {
+                g->dependent_players[kept++] = player;
+            }
+            else {
+                player_set_dependent(&g->players_arr[player], false);
+            }
+        }
+
+        g->dirty_count = 0;
+        g->dependent_count = kept;
+        g->active_stale = false;
+    }
+}
+
+///@}
+
+/** @name Ruch
+ * Sprawdzanie czy dany ruch może zostać przez gracza wykonany oraz realizacja
+ * ruchu gracza.
+ */
+///@{
+
+/** @brief Sprawdza, czy gracz może wykonać ruch.
+ * Sprawdza, czy gracz wskazywany przez @p p może postawić pionek
+ * na polu (@p x, @p y).
+ * Sprawdza, czy pole (@p x, @p y) jest poprawne oraz wolne.
+ * Sprawdza, czy wykonanie ruchu nie przekroczy maksymalnej dopuszczalnej liczby
+ * obszarów zajętych przez jednego gracza.
+ * @param[in] g – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in] p – wskaźnik na strukturę przechowującą stan gracza,
+ * @param[in] x – numer kolumny, liczba nieujemna mniejsza od wartości @p width
+ *                z funkcji @ref gamma_new,
+ * @param[in] y – numer wiersza, liczba nieujemna mniejsza od wartości @p height
+ *                z funkcji @ref gamma_new.
+ * @return Wartość @p true, jeżeli gracz wskazywany przez @p p może postawić
+ * pionek na polu (@p x, @p y), a @p false w przeciwnym przypadku.
+ */
+static bool player_move_legal(gamma_t *g, player_t *p, uint32_t x, uint32_t y) {
+    if (!valid_free_field(g, x, y)) {
+        return false;
+    }
+    else if (p == NULL || player_areas(p) < g->areas) {
+        return true;
+    }
+    else {
+        return field_adjacent_to(g, &g->board[y][x], p, 0);
+    }
+}
+
+/** @brief Wykonuje ruch.
+ * Ustawia pionek gracza @p player na polu (@p x, @p y).
+ * @param[in,out] g   – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in] player  – numer gracza, liczba dodatnia niewiększa od wartości
+ *                      @p players z funkcji @ref gamma_new,
+ * @param[in] x       – numer kolumny, liczba nieujemna mniejsza od wartości
+ *                      @p width z funkcji @ref gamma_new,
+ * @param[in] y       – numer wiersza, liczba nieujemna mniejsza od wartości
+ *                      @p height z funkcji @ref gamma_new.
+ */
+static void gamma_move_update(gamma_t *g, uint32_t player, uint32_t x, uint32_t y) {
+    player_t *p = &g->players_arr[player];
+    field_t *f = &g->board[y][x];
+    bool eager = g->policy == GAMMA_POLICY_EAGER;
+    player_t *owners[MAX_NEIGHBOURS];
+    unsigned owners_num = field_neighbour_owners(g, f, owners);
+
+    player_mark_dirty(g, p);
+    players_mark_watchers(g, p);
+
+    for (unsigned i = 0; i < owners_num; i++) {
+        player_mark_dirty(g, owners[i]);
+
+        if (eager) {
+            perimeter_remove(g, owners[i], f);
+        }
+    }
+
+    if (eager) {
+        free_fields_remove(g, f, (uint64_t) g->width * g->height - g->busy_fields);
+    }
+    else {
+        books_log_change(g, f);
+    }
+
+    field_update_owner(g, f, p);
+    g->busy_fields++;
+    player_set_busy_fields(p, player_busy_fields(p) + 1);
+
+    player_modify_areas(g, f, false);
+
+    if (eager) {
+        neighbours_update_liberties(g, f);
+        player_update_perimeter(g, f);
+    }
+
+    if (g->busy_fields == (uint64_t) g->width * g->height) {
+        players_mark_all_dirty(g);
+    }
+
+    g->version++;
+    g->active_stale = true;
+}
+
+///@}
+
+/** @name Złoty ruch
+ * Sprawdzanie czy złoty ruch jest legalny zarówno ze strony gracza,
+ * który stawia swój pionek na polu zajętym przez przeciwnika, nazywanym
+ * ofiarą (@p victim), jak i ze strony tracącego pole.
+ * Wyznaczanie punktów artykulacji obszarów algorytmem Tarjana, wykorzystywane
+ * do sprawdzenia, czy usunięcie pola nie zwiększy liczby obszarów zajętych
+ * przez ofiarę ponad dopuszczalny limit. Wynik jest zapamiętywany dla każdego
+ * obszaru i wyznaczany ponownie dopiero po zmianie tego obszaru.
+ */
+///@{
+
+/** @brief Przeszukuje obszar zajęty przez gracza.
+ * Wykonuje przeszukiwanie w głąb (DFS) obszaru zajętego przez gracza wskazywanego
+ * przez @p owner, zaczynając od pola (@p x, @p y) i oznaczając każde odwiedzone
+ * pole w tym obszarze jako odwiedzone w epoce @p epoch.
+ * @param[in,out] g      – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in] owner      – wskaźnik na strukturę przechowującą stan gracza,
+ *                         będącego właścicielem pola (@p x, @p y),
+ * @param[in] x          – numer kolumny, liczba nieujemna mniejsza od wartości
+ *                         @p width z funkcji @ref gamma_new,
+ * @param[in] y          – numer wiersza, liczba nieujemna mniejsza od wartości
+ *                         @p height z funkcji @ref gamma_new,
+ * @param[in] epoch      – numer epoki bieżącego przeszukiwania.
+ * @return Wartość @p true, jeżeli pole (@p x, @p y) jest poprawne i należy do
+ * gracza wskazywanego przez @p owner oraz w momencie wywołania funkcji nie było
+ * jeszcze odwiedzone w epoce @p epoch, a @p false w przeciwnym przypadku.
+ */
+static bool area_search(gamma_t *g, player_t *owner,
+                        int64_t x, int64_t y, uint32_t epoch) {
+    if (!player_valid_field(g, owner, x, y)) {
+        return false;
+    }
+    else if (field_visited(&g->board[y][x], epoch)) {
+        return false;
+    }
+    else {
+        field_set_visited(&g->board[y][x], epoch);
+
+        area_search(g, owner, x - 1, y, epoch);
+        area_search(g, owner, x + 1, y, epoch);
+        area_search(g, owner, x, y - 1, epoch);
+        area_search(g, owner, x, y + 1, epoch);
+
+        return true;
+    }
+}
+
+/** @brief Wylicza liczbę obszarów zajętych przez gracza po utracie pola
+ * (@p x, @p y), przeszukując jego obszar.
+ * Oblicza, ile obszarów będzie zajmować gracz wskazywany przez @p victim
+ * po utracie pola (@p x, @p y), przeszukując w głąb (DFS) obszar zawierający
+ * to pole. Wykorzystywana, gdy nie udało się zaalokować pamięci na stos
+ * potrzebny do wyznaczenia punktów artykulacji obszaru.
+ * @param[in,out] g      – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in] victim     – wskaźnik na strukturę przechowującą stan gracza,
+ *                         będącego właścicielem pola (@p x, @p y),
+ * @param[in] x          – numer kolumny, liczba nieujemna mniejsza od wartości
+ *                         @p width z funkcji @ref gamma_new,
+ * @param[in] y          – numer wiersza, liczba nieujemna mniejsza od wartości
+ *                         @p height z funkcji @ref gamma_new.
+ * @return Liczba obszarów, jakie będzie zajmować gracz wskazywany przez @p victim
+ * po utracie pola (@p x, @p y).
+ */
+static uint32_t victim_search_new_areas(gamma_t *g, player_t *victim,
+                                        uint32_t x, uint32_t y) {
+    uint32_t epoch = gamma_new_epoch(g);
+    field_set_visited(&g->board[y][x], epoch);
+
+    uint32_t areas = player_areas(victim) - 1;
+
+    areas += area_search(g, victim, x - 1, y, epoch);
+    areas += area_search(g, victim, x + 1, y, epoch);
+    areas += area_search(g, victim, x, y - 1, epoch);
+    areas += area_search(g, victim, x, y + 1, epoch);
+
+    return areas;
+}
+
+/** @brief Zapewnia miejsce na stosie przeszukiwania w głąb.
+ * Powiększa stos @ref gamma::dfs_stack tak, aby mieścił co najmniej @p size
+ * ramek.
+ * @param[in,out] g – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in] size  – wymagana liczba ramek.
+ * @return Wartość @p true, jeżeli stos mieści wymaganą liczbę ramek, a @p false,
+ * jeżeli nie udało się zaalokować pamięci.
+ */
+static bool dfs_stack_reserve(gamma_t *g, uint64_t size) {
+    if (size <= g->dfs_stack_size) {
+        return true;
+    }
+    else {
+        uint64_t new_size = g->dfs_stack_size == 0 ? 64 : g->dfs_stack_size;
+
+        while (new_size < size) {
+            new_size *= 2;
+        }
+
+        dfs_frame_t *stack = realloc(g->dfs_stack, new_size * sizeof(dfs_frame_t));
+
+        if (stack == NULL) {
+            return false;
+        }
+        else {
+            g->dfs_stack = stack;
+            g->dfs_stack_size = new_size;
+
+            return true;
+        }
+    }
+}
+
+/** @brief Dopisuje punkt artykulacji do tablicy.
+ * @param[in,out] cuts     – wskaźnik na tablicę punktów artykulacji,
+ * @param[in,out] cuts_num – liczba elementów tablicy,
+ * @param[in] f            – wskaźnik na strukturę przechowującą stan pola,
+ * @param[in] split        – liczba obszarów, na które rozpadnie się obszar po
+ *                           usunięciu pola.
+ * @return Wartość @p true, jeżeli dopisano punkt artykulacji, a @p false,
+ * jeżeli nie udało się zaalokować pamięci.
+ */
+static bool area_cuts_push(area_cut_t **cuts, uint32_t *cuts_num, field_t *f,
+                           unsigned split) {
+    if ((*cuts_num & (*cuts_num - 1)) == 0) {
+        uint64_t capacity = *cuts_num == 0 ? 4 : 2 * (uint64_t) *cuts_num;
+        area_cut_t *resized = realloc(*cuts, capacity * sizeof(area_cut_t));
+
+        if (resized == NULL) {
+            return false;
+        }
+
+        *cuts = resized;
+    }
+
+    (*cuts)[(*cuts_num)++] = (area_cut_t) {field_x(f), field_y(f), split};
+
+    return true;
+}
+
+/** @brief Wyznacza punkty artykulacji obszaru.
+ * Wykonuje iteracyjny algorytm Tarjana na obszarze, którego korzeniem jest pole
+ * wskazywane przez @p root. Numer pola w kolejności odwiedzania jest zapisany
+ * w jego znaczniku odwiedzin jako przesunięcie względem pierwszej z epok
+ * zarezerwowanych dla przeszukiwania, a pozostałe dane algorytmu są
+ * przechowywane w ramkach stosu przeszukiwania, więc pola nie przechowują
+ * żadnych danych pomocniczych. Dla każdego pola obszaru zapisuje, czy jest ono
+ * punktem artykulacji, a w tablicy punktów artykulacji obszaru zapisuje, na ile
+ * obszarów rozpadnie się ten obszar po usunięciu danego punktu. Wartość ta jest
+ * równa stopniowi pola w drzewie bloków i punktów artykulacji obszaru: liczbie
+ * synów pola w drzewie przeszukiwania, z których poddrzew nie prowadzi krawędź
+ * powrotna powyżej pola, powiększonej o 1 dla pól innych niż pole startowe.
+ * @param[in,out] g  – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in] root   – wskaźnik na strukturę przechowującą stan pola będącego
+ *                     korzeniem obszaru.
+ * @return Wartość @p true, jeżeli udało się wyznaczyć punkty artykulacji obszaru,
+ * a @p false, jeżeli nie udało się zaalokować pamięci.
+ */
+static bool area_compute_splits(gamma_t *g, field_t *root) {
+    area_t *a = field_area(root);
+    area_cut_t *cuts = NULL;
+    uint32_t cuts_num = 0;
+    uint64_t depth = 0;
+    uint32_t order = 0;
+
+    if (area_size(a) > UINT32_MAX || !dfs_stack_reserve(g, area_size(a))) {
+        return false;
+    }
+
+    uint32_t base = gamma_new_epochs(g, (uint32_t) area_size(a));
+
+    field_set_visited(root, base + order++);
+    g->dfs_stack[depth++] = (dfs_frame_t) {.f = root, .low = 0, .split = 0};
+
+    while (depth > 0) {
+        dfs_frame_t *top = &g->dfs_stack[depth - 1];
+
+        if (top->dir < MAX_NEIGHBOURS) {
+            unsigned dir = top->dir++;
+
+            if (field_same_mask(top->f) & FIELD_DIR_BIT(dir)) {
+                field_t *n = field_neighbour(g, top->f, dir);
+
+                if (field_visit(n) >= base) {
+                    if (field_visit(n) - base < top->low) {
+                        top->low = field_visit(n) - base;
+                    }
+                }
+                else {
+                    field_set_visited(n, base + order);
+                    g->dfs_stack[depth++] = (dfs_frame_t) {
+                        .f = n, .low = order++, .split = 1
+                    };
+                }
+            }
+        }
+        else {
+            depth--;
+            field_set_cut(top->f, top->split >= 2);
+
+            if (top->split >= 2
+                && !area_cuts_push(&cuts, &cuts_num, top->f, top->split)) {
+                free(cuts);
+
+                return false;
+            }
+
+            if (depth > 0) {
+                dfs_frame_t *parent = &g->dfs_stack[depth - 1];
+
+                if (top->low < parent->low) {
+                    parent->low = top->low;
+                }
+                if (top->low >= field_visit(parent->f) - base) {
+                    parent->split++;
+                }
+            }
+        }
+    }
+
+    area_set_cuts(a, cuts, cuts_num);
+
+    return true;
+}
+
+/** @brief Podaje liczbę obszarów powstałych po usunięciu pola z obszaru.
+ * Zakłada, że punkty artykulacji obszaru są aktualne oraz że pole sąsiaduje
+ * z co najmniej jednym polem tego samego obszaru.
+ * @param[in] root – wskaźnik na strukturę przechowującą stan pola będącego
+ *                   korzeniem obszaru,
+ * @param[in] f    – wskaźnik na strukturę przechowującą stan pola obszaru.
+ * @return Liczba obszarów, na które rozpadnie się obszar po usunięciu pola
+ * wskazywanego przez @p f.
+ */
+static inline unsigned area_field_split(field_t *root, field_t *f) {
+    if (!field_cut(f)) {
+        return 1;
+    }
+    else {
+        return area_cut_split(field_area(root), field_x(f), field_y(f));
+    }
+}
+
+/** @brief Daje liczbę obszarów zajętych przez gracza po utracie pola (@p x, @p y).
+ * Oblicza, ile obszarów będzie zajmować gracz wskazywany przez @p victim
+ * po utracie pola (@p x, @p y), odczytując z punktów artykulacji obszaru, na ile
+ * części podzieli go usunięcie tego pola.
+ * Pole sąsiadujące z co najwyżej jednym polem tego samego gracza nie dzieli
+ * obszaru, więc wynik podaje bez odczytywania punktów artykulacji.
+ * Wyznacza punkty artykulacji obszaru zawierającego to pole tylko wtedy, gdy
+ * obszar zmienił się od ostatniego ich wyznaczenia. Jeżeli nie udało się
+ * zaalokować pamięci, przeszukuje obszar funkcją @ref victim_search_new_areas.
+ * @param[in,out] g      – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in] victim     – wskaźnik na strukturę przechowującą stan gracza,
+ *                         będącego właścicielem pola (@p x, @p y),
+ * @param[in] x          – numer kolumny, liczba nieujemna mniejsza od wartości
+ *                         @p width z funkcji @ref gamma_new,
+ * @param[in] y          – numer wiersza, liczba nieujemna mniejsza od wartości
+ *                         @p height z funkcji @ref gamma_new.
+ * @return Liczba obszarów, jakie będzie zajmować gracz wskazywany przez @p victim
+ * po utracie pola (@p x, @p y).
+ */
+static uint32_t victim_new_areas(gamma_t *g, player_t *victim,
+                                 uint32_t x, uint32_t y) {
+    field_t *f = &g->board[y][x];
+    unsigned neighbours = field_mask_count(field_same_mask(f));
+
+    if (neighbours <= 1) {
+        return player_areas(victim) - 1 + neighbours;
+    }
+
+    field_t *root = area_find_root(f);
+
+    if (area_cuts_valid(field_area(root)) || area_compute_splits(g, root)) {
+        return player_areas(victim) - 1 + area_field_split(root, f);
+    }
+    else {
+        return victim_search_new_areas(g, victim, x, y);
+    }
+}
+
+/** @brief Sprawdza, czy złoty ruch jest legalny ze strony gracza, który traci pole.
+ * Funkcja zakłada, że współrzędne @p x oraz @p y są poprawne, ponieważ sprawdzenie
+ * tego warunku powinno nastąpić w funkcji wołającej.
+ * Sprawdza, czy pole (@p x, @p y) jest zajęte.
+ * Sprawdza, czy złoty ruch jest legalny ze strony gracza, który traci pionek
+ * z pola (@p x, @p y).
+ * Sprawdza, czy po utracie pola (@p x, @p y) przez jego właściciela liczba zajętych
+ * przez niego obszarów nie przekroczy maksymalnej dozwolonej liczby obszarów
+ * zajętych przez jednego gracza.
+ * @param[in] g – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in] x – numer kolumny, liczba nieujemna mniejsza od wartości @p width
+ *                z funkcji @ref gamma_new,
+ * @param[in] y – numer wiersza, liczba nieujemna mniejsza od wartości @p height
+ *                z funkcji @ref gamma_new.
+ * @return Wartość @p true, jeżeli po utracie pola (@p x, @p y) przez jego
+ * właściciela liczba zajętych przez niego obszarów nie będzie przekraczać
+ * maksymalnej dozwolonej liczby obszarów zajętych przez jednego gracza,
+ * a @p false w przeciwnym przypadku.
+ */
+static bool victim_golden_move_legal(gamma_t *g, uint32_t x, uint32_t y) {
+    if (field_is_free(&g->board[y][x])) {
+        return false;
+    }
+    else {
+        player_t *victim = field_owner(&g->board[y][x]);
+        unsigned neighbours = field_mask_count(field_same_mask(&g->board[y][x]));
+        unsigned mx_new_areas = neighbours == 0 ? 0 : neighbours - 1;
+
+        if (player_areas(victim) + mx_new_areas <= g->areas) {
+            return true;
+        }
+        else {
+            return victim_new_areas(g, victim, x, y) <= g->areas;
+        }
+    }
+}
+
+/** @brief Sprawdza, czy złoty ruch jest legalny ze strony gracza, który
+ * stawia pionek na polu zajętym przez przeciwnika.
+ * Zakłada, że gracz wskazywany przez @p p jeszcze nie wykonał w rozgrywce złotego
+ * ruchu oraz że współrzędne pola (@p x, @p y) są poprawne, ponieważ sprawdzenie
+ * tych warunków powinno nastąpić w funkcji wołającej.
+ * Sprawdza, czy złoty ruch jest legalny ze strony gracza wskazywanego
+ * przez @p p, który stawia pionek na polu (@p x, @p y) zajętym przez przeciwnika.
+ * Sprawdza, czy pole (@p x, @p y) nie jest zajęte przez gracza wskazywanego przez
+ * @p p oraz czy po postawieniu pionka na tym polu nie zostanie przekroczona
+ * maksymalna liczba obszarów, jakie może gracz zajmować.
+ * @param[in] g – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in] p – wskaźnik na strukturę przechowującą stan gracza,
+ * @param[in] x – numer kolumny, liczba nieujemna mniejsza od wartości @p width
+ *                z funkcji @ref gamma_new,
+ * @param[in] y – numer wiersza, liczba nieujemna mniejsza od wartości @p height
+ *                z funkcji @ref gamma_new.
+ * @return Wartość @p true, jeżeli pole (@p x, @p y) nie jest zajęte przez gracza
+ * wskazywanego przez @p p oraz po postawieniu pionka na tym polu nie zostanie
+ * przekroczona maksymalna liczba obszarów, jakie może gracz zajmować.
+ */
+static bool player_golden_move_legal(gamma_t *g, player_t *p,
+                                     uint32_t x, uint32_t y) {
+    if (field_is_free(&g->board[y][x]) || field_owner(&g->board[y][x]) == p) {
+        return false;
+    }
+    else if (player_areas(p) < g->areas) {
+        return true;
+    }
+    else {
+        return field_adjacent_to(g, &g->board[y][x], p, 0);
+    }
+}
+
+/** @brief Opisuje złoty ruch, jeżeli jest legalny.
+ * Sprawdza, czy gracz wskazywany przez @p p może wykonać złoty ruch na pole
+ * (@p x, @p y), i jeżeli tak, zapisuje jego opis w strukturze wskazywanej przez
+ * @p move. Punkty artykulacji obszaru ofiary wyznacza co najwyżej raz, wspólnie
+ * dla wszystkich pól tego obszaru.
+ * @param[in,out] g  – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in] p      – wskaźnik na strukturę przechowującą stan gracza, który
+ *                     nie wykonał jeszcze złotego ruchu,
+ * @param[in] x      – numer kolumny, liczba nieujemna mniejsza od wartości
+ *                     @p width z funkcji @ref gamma_new,
+ * @param[in] y      – numer wiersza, liczba nieujemna mniejsza od wartości
+ *                     @p height z funkcji @ref gamma_new,
+ * @param[out] move  – wskaźnik na strukturę, w której ma zostać zapisany opis
+ *                     złotego ruchu.
+ * @return Wartość @p true, jeżeli gracz może wykonać złoty ruch na pole
+ * (@p x, @p y), a @p false w przeciwnym przypadku.
+ */
+static bool golden_move_describe(gamma_t *g, player_t *p, uint32_t x, uint32_t y,
+                                 gamma_golden_move_t *move) {
+    if (!player_golden_move_legal(g, p, x, y)) {
+        return false;
+    }
+    else {
+        player_t *victim = field_owner(&g->board[y][x]);
+        uint32_t victim_areas = victim_new_areas(g, victim, x, y);
+
+        *move = (gamma_golden_move_t) {
+            .x = x,
+            .y = y,
+            .victim = player_number(victim),
+            .victim_areas = victim_areas
+        };
+
+        return victim_areas <= g->areas;
+    }
+}
+
+/** @brief Zmienia rodzica w każdym polu obszaru.
+ * Wykonuje przeszukiwanie w głąb (DFS) obszaru zajętego przez gracza wskazywanego
+ * przez @p owner, zaczynając od pola (@p x, @p y) i ustawiając składową
+ * @ref field::parent każdego odwiedzonego pola na wartość równą zmiennej
+ * @p parent będącej parametrem procedury oraz dołączając to pole do statystyk
+ * obszaru przechowywanych w polu wskazywanym przez @p parent.
+ * Oznacza każde odwiedzone pole jako odwiedzone w epoce @p epoch.
+ * @param[in,out] g      – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in] owner      – wskaźnik na strukturę przechowującą stan gracza,
+ *                         będącego właścicielem pola (@p x, @p y),
+ * @param[in] x          – numer kolumny, liczba nieujemna mniejsza od wartości
+ *                         @p width z funkcji @ref gamma_new,
+ * @param[in] y          – numer wiersza, liczba nieujemna mniejsza od wartości
+ *                         @p height z funkcji @ref gamma_new,
+ * @param[in,out] parent – wskaźnik na pole będące nowym rodzicem każdego
+ *                         odwiedzonego pola,
+ * @param[in] epoch      – numer epoki bieżącego przeszukiwania.
+ */
+static void area_update_parent(gamma_t *g, player_t *owner,
+                               int64_t x, int64_t y, field_t *parent,
+                               uint32_t epoch) {
+    if (player_valid_field(g, owner, x, y)
+        && !field_visited(&g->board[y][x], epoch)) {
+
+        field_t *f = &g->board[y][x];
+        field_set_parent(f, parent);
+        field_set_visited(f, epoch);
+        area_include(field_area(parent), x, y);
+
+        area_update_parent(g, owner, x - 1, y, parent, epoch);
+        area_update_parent(g, owner, x + 1, y, parent, epoch);
+        area_update_parent(g, owner, x, y - 1, parent, epoch);
+        area_update_parent(g, owner, x, y + 1, parent, epoch);
+    }
+}
+
+/** @brief Wyodrębnia nowy obszar ze starego po usunięciu z niego pola w wyniku
+ * złotego ruchu.
+ * Jeżeli pole (@p x, @p y) należy do gracza wskazywanego przez @p old_owner,
+ * będącego graczem który w wyniku złotego ruchu wykonanego przez przeciwnika
+ * stracił sąsiadujące pole, czyni pole (@p x, @p y) korzeniem nowego obszaru,
+ * przydzielając mu z puli statystyki obszaru, ustawiając rodzica @p parent na NULL i dodając go
+ * do listy obszarów gracza, po czym wywołuje funkcję @ref area_update_parent
+ * dla każdego sąsiedniego pola, przekazując jako parametr @p parent tej funkcji
+ * wskaźnik do struktury przechowującej stan pola (@p x, @p y). Liczba wolnych
+ * sąsiadów nowego obszaru pozostaje nieaktualna.
+ * Oblicza liczbę obszarów zajętych przez gracza wskazywanego przez @p old_owner
+ * po wyodrębnieniu wszystkich nowych obszarów.
+ * @param[in,out] g      – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in] old_owner  – wskaźnik na strukturę przechowującą stan gracza,
+ *                         będącego właścicielem pola (@p x, @p y),
+ * @param[in] x          – numer kolumny, liczba nieujemna mniejsza od wartości
+ *                         @p width z funkcji @ref gamma_new,
+ * @param[in] y          – numer wiersza, liczba nieujemna mniejsza od wartości
+ *                         @p height z funkcji @ref gamma_new,
+ * @param[in,out] areas  – liczba obszarów zajętych przez gracza wskazywanego
+ *                         przez @p old_owner,
+ * @param[in] epoch      – numer epoki bieżącego przeszukiwania.
+ * @return Liczba obszarów zajętych przez gracza wskazywanego przez @p old_owner
+ * po ewentualnym wyobrębnieniu nowego obszaru z korzeniem w polu (@p x, @p y).
+ */
+static uint32_t area_set_component(gamma_t *g, player_t *old_owner,
+                                   uint32_t x, uint32_t y, uint32_t areas,
+                                   uint32_t epoch) {
+    if (player_valid_field(g, old_owner, x, y)) {
+        if (!field_visited(&g->board[y][x], epoch)) {
+            areas++;
+
+            field_t *root = &g->board[y][x];
+            field_set_visited(root, epoch);
+            field_set_parent(root, NULL);
+            field_set_area(root, area_alloc(g));
+            area_init(field_area(root), x, y, 0);
+            area_invalidate_liberties(field_area(root));
+            area_list_add(g, old_owner, root);
+
+            area_update_parent(g, old_owner, x - 1, y, root, epoch);
+            area_update_parent(g, old_owner, x + 1, y, root, epoch);
+            area_update_parent(g, old_owner, x, y - 1, root, epoch);
+            area_update_parent(g, old_owner, x, y + 1, root, epoch);
+        }
+    }
+
+    return areas;
+}
+
+/** @brief Modyfikuje obszary gracza po utracie przez niego pola (@p x, @p y).
+ * Dla każdego pola sąsiadującego z (@p x, @p y), należącego do gracza wskazywanego
+ * przez @p old_owner i nie należącego do żadnego nowo stworzonego obszaru, tworzy
+ * nowy obszar z korzeniem w tym polu.
+ * Odpowiednio aktualizuje liczbę obszarów zajętych przez gracza wskazywanego przez
+ * @p old_owner. Zakłada, że obszar, do którego należało pole (@p x, @p y), został
+ * już usunięty z listy obszarów tego gracza.
+ * @param[in,out] g      – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in] old_owner  – wskaźnik na strukturę przechowującą stan gracza,
+ *                         który utracił pole (@p x, @p y),
+ * @param[in] x          – numer kolumny, liczba nieujemna mniejsza od wartości
+ *                         @p width z funkcji @ref gamma_new,
+ * @param[in] y          – numer wiersza, liczba nieujemna mniejsza od wartości
+ *                         @p height z funkcji @ref gamma_new.
+ */
+static void old_owner_modify_areas(gamma_t *g, player_t *old_owner,
+                                   uint32_t x, uint32_t y) {
+    uint32_t epoch = gamma_new_epoch(g);
+    uint32_t areas = player_areas(old_owner) - 1;
+
+    areas = area_set_component(g, old_owner, x - 1, y, areas, epoch);
+    areas = area_set_component(g, old_owner, x + 1, y, areas, epoch);
+    areas = area_set_component(g, old_owner, x, y - 1, areas, epoch);
+    areas = area_set_component(g, old_owner, x, y + 1, areas, epoch);
+
+    player_set_areas(old_owner, areas);
+}
+
+/** @brief Sprawdza, czy gracz może wykonać złoty ruch.
+ * Sprawdza, czy gracz @p player może postawić pionek na polu (@p x, @p y) zajętym
+ * przez innego gracza, zarówno ze strony gracza wykonującego złoty ruch, jak
+ * i ze strony gracza tracącego pole.
+ * @param[in,out] g   – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in] player  – numer gracza, liczba dodatnia niewiększa od wartości
+ *                      @p players z funkcji @ref gamma_new,
+ * @param[in] x       – numer kolumny, liczba nieujemna mniejsza od wartości
+ *                      @p width z funkcji @ref gamma_new,
+ * @param[in] y       – numer wiersza, liczba nieujemna mniejsza od wartości
+ *                      @p height z funkcji @ref gamma_new.
+ * @return Wartość @p true, jeżeli złoty ruch jest legalny, a @p false
+ * w przeciwnym przypadku.
+ */
+static bool golden_move_legal(gamma_t *g, uint32_t player, uint32_t x, uint32_t y) {
+    if (!player_golden_possible(&g->players_arr[player])) {
+        return false;
+    }
+    else if (!valid_busy_field(g, x, y)) {
+        return false;
+    }
+    else if (!player_golden_move_legal(g, &g->players_arr[player], x, y)) {
+        return false;
+    }
+    else {
+        return victim_golden_move_legal(g, x, y);
+    }
+}
+
+/** @brief Wykonuje złoty ruch.
+ * Ustawia pionek gracza @p player na polu (@p x, @p y) zajętym przez innego
+ * gracza, usuwając pionek innego gracza.
+ * @param[in,out] g   – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in] player  – numer gracza, liczba dodatnia niewiększa od wartości
+ *                      @p players z funkcji @ref gamma_new,
+ * @param[in] x       – numer kolumny, liczba nieujemna mniejsza od wartości
+ *                      @p width z funkcji @ref gamma_new,
+ * @param[in] y       – numer wiersza, liczba nieujemna mniejsza od wartości
+ *                      @p height z funkcji @ref gamma_new.
+ */
+static void gamma_golden_move_update(gamma_t *g, uint32_t player,
+                                     uint32_t x, uint32_t y) {
+    player_t *new_owner = &g->players_arr[player];
+    field_t *f = &g->board[y][x];
+    player_t *old_owner = field_owner(f);
+    field_t *old_root = area_find_root(f);
+
+    area_list_remove(g, old_owner, old_root);
+    area_release(g, field_area(old_root));
+    field_set_area(old_root, NULL);
+
+    if (g->policy == GAMMA_POLICY_LAZY) {
+        books_log_change(g, f);
+    }
+
+    field_update_owner(g, f, new_owner);
+
+    old_owner_modify_areas(g, old_owner, x, y);
+    player_set_busy_fields(old_owner, player_busy_fields(old_owner) - 1);
+
+    player_modify_areas(g, f, true);
+    player_set_golden_possible(new_owner, false);
+    player_set_busy_fields(new_owner, player_busy_fields(new_owner) + 1);
+
+    if (g->policy == GAMMA_POLICY_EAGER) {
+        player_remove_single_neighbours(g, f, old_owner);
+        player_update_perimeter(g, f);
+    }
+
+    player_mark_dirty(g, new_owner);
+    player_mark_dirty(g, old_owner);
+    players_mark_watchers(g, new_owner);
+    players_mark_watchers(g, old_owner);
+
+    g->version++;
+    g->active_stale = true;
+}
+
+///@}
+
+/** @name Równoległe sprawdzanie złotego ruchu
+ * Sprawdzanie możliwości wykonania złotego ruchu przeglądaniem planszy w pasach
+ * wierszy przez wiele wątków, bez modyfikowania stanu gry. Podział obszaru ofiary
+ * jest odczytywany z zapamiętanych punktów artykulacji, o ile są aktualne,
+ * a w przeciwnym przypadku wyznaczany przeszukiwaniem wszerz, którego stan jest
+ * przechowywany w pamięci roboczej wątku. Przeszukiwanie kończy się, gdy tylko
+ * odwiedzi wszystkich sąsiadów usuwanego pola należących do ofiary. Wątki oraz
+ * ich pamięci robocze są tworzone przy pierwszym przeglądaniu i używane przez
+ * kolejne, aż do usunięcia gry.
+ */
+///@{
+
+/**
+ * Typ struktury przechowującej dane wspólne dla wątków sprawdzających złoty ruch.
+ */
+typedef struct golden_scan golden_scan_t;
+
+/**
+ * Struktura przechowująca dane wspólne dla wątków sprawdzających złoty ruch.
+ */
+struct golden_scan {
+    gamma_t *g;         /**< Wskaźnik na strukturę przechowującą stan gry. */
+    golden_scratch_t *scratch; /**< Tablica pamięci roboczych kolejnych
+                         *   wątków. */
+    player_t *p;        /**< Wskaźnik na strukturę przechowującą stan gracza
+                         *   wykonującego złoty ruch. */
+    atomic_bool found;  /**< Wartość @p true, jeżeli któryś wątek znalazł pole,
+                         *   na którym gracz może wykonać złoty ruch. */
+    atomic_bool failed; /**< Wartość @p true, jeżeli któryś wątek nie przejrzał
+                         *   swojego pasa, bo nie udało się zaalokować pamięci. */
+};
+
+/**
+ * Typ funkcji podającej maskę sąsiadów pola o numerze @p i zajętych przez
+ * właściciela tego pola, zapisaną tak jak @ref field::same.
+ */
+typedef uint8_t (*board_same_fn_t)(void *board, uint64_t i);
+
+/**
+ * Typ struktury przechowującej widok planszy przeszukiwanej wszerz.
+ */
+typedef struct board_view board_view_t;
+
+/**
+ * Struktura przechowująca widok planszy przeszukiwanej wszerz, pozwalający
+ * przeszukiwać w ten sam sposób planszę gry i planszę migawki. Pola są
+ * identyfikowane numerami równymi @p y * @p width + @p x.
+ */
+struct board_view {
+    void *board;          /**< Wskaźnik na strukturę przechowującą stan gry
+                           *   lub na migawkę. */
+    uint32_t width;       /**< Szerokość planszy. */
+    uint64_t cells;       /**< Liczba pól planszy. */
+    board_same_fn_t same; /**< Funkcja podająca maski sąsiadów pól zajętych
+                           *   przez ich właścicieli. */
+};
+
+/** @brief Podaje numer sąsiada pola w widoku planszy.
+ * Zakłada, że sąsiad leży na planszy.
+ * @param[in] v   – wskaźnik na widok planszy,
+ * @param[in] i   – numer pola,
+ * @param[in] dir – numer kierunku, liczba nieujemna mniejsza od
+ *                  @p MAX_NEIGHBOURS.
+ * @return Numer sąsiada pola o numerze @p i w kierunku @p dir.
+ */
+static inline uint64_t board_view_neighbour(const board_view_t *v, uint64_t i,
+                                            unsigned dir) {
+    return i + (uint64_t) (NEIGHBOUR_DX[dir] + NEIGHBOUR_DY[dir] * (int64_t) v->width);
+}
+
+/** @brief Podaje maskę sąsiadów pola planszy gry zajętych przez jego właściciela.
+ * @param[in] board – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in] i     – numer zajętego pola.
+ * @return Wartość @ref field::same pola o numerze @p i.
+ */
+static uint8_t board_same_mask(void *board, uint64_t i) {
+    gamma_t *g = board;
+
+    return field_same_mask(&g->board[i / g->width][i % g->width]);
+}
+
+/** @brief Oznacza pole jako odwiedzone w bieżącym przeszukiwaniu.
+ * @param[in,out] s    – wskaźnik na pamięć roboczą wątku,
+ * @param[in] i        – numer pola,
+ * @param[in,out] size – liczba pól w kolejce przeszukiwania.
+ * @return Wartość @p true, jeżeli pole nie było jeszcze odwiedzone i zostało
+ * dopisane do kolejki, a @p false, jeżeli było już odwiedzone lub nie udało się
+ * zaalokować pamięci, przy czym w drugim przypadku zwalnia kolejkę i mapę
+ * odwiedzonych pól, której nie da się już wyczyścić.
+ */
+static bool golden_scratch_visit(golden_scratch_t *s, uint64_t i, uint64_t *size) {
+    uint64_t bit = UINT64_C(1) << (i % 64);
+
+    if (s->visited[i / 64] & bit) {
+        return false;
+    }
+    else {
+        if (*size == s->capacity) {
+            uint64_t capacity = s->capacity == 0 ? 64 : 2 * s->capacity;
+            uint64_t *queue = realloc(s->queue, capacity * sizeof(uint64_t));
+
+            if (queue == NULL) {
+                free(s->visited);
+                free(s->queue);
+                s->visited = NULL;
+                s->queue = NULL;
+                s->capacity = 0;
+
+                return false;
+            }
+
+            s->queue = queue;
+            s->capacity = capacity;
+        }
+
+        s->visited[i / 64] |= bit;
+        s->queue[(*size)++] = i;
+
+        return true;
+    }
+}
+
+/** @brief Zlicza części, na które rozpadnie się obszar po usunięciu pola.
+ * Przeszukuje wszerz obszar zawierający pole o numerze @p i z pominięciem tego
+ * pola, zaczynając kolejno od jego sąsiadów należących do tego samego gracza,
+ * którzy nie zostali jeszcze odwiedzeni. Kończy, gdy odwiedzi wszystkich takich
+ * sąsiadów. Po zakończeniu czyści mapę odwiedzonych pól. Korzysta tylko
+ * z widoku planszy, więc przeszukuje tak samo planszę gry i planszę migawki.
+ * @param[in] v            – wskaźnik na widok planszy,
+ * @param[in,out] s        – wskaźnik na pamięć roboczą wątku,
+ * @param[in] i            – numer zajętego pola,
+ * @param[out] components  – liczba części obszaru po usunięciu pola.
+ * @return Wartość @p true, jeżeli udało się zliczyć części, a @p false, jeżeli
+ * nie udało się zaalokować pamięci.
+ */
+static bool golden_scratch_components(const board_view_t *v, golden_scratch_t *s,
+                                      uint64_t i, unsigned *components) {
+    uint8_t same = v->same(v->board, i);
+    unsigned remaining = field_mask_count(same);
+    uint64_t size = 0, head = 1;
+
+    if (s->visited == NULL) {
+        s->visited = calloc((v->cells + 63) / 64, sizeof(uint64_t));
+
+        if (s->visited == NULL) {
+            return false;
+        }
+    }
+    if (!golden_scratch_visit(s, i, &size)) {
+        return false;
+    }
+
+    *components = 0;
+
+    for (unsigned dir = 0; dir < MAX_NEIGHBOURS && remaining > 0; dir++) {
+        if (same & FIELD_DIR_BIT(dir)) {
+            if (!golden_scratch_visit(s, board_view_neighbour(v, i, dir), &size)) {
+                if (s->queue == NULL) {
+                    return false;
+                }
+
+                continue;
+            }
+
+            (*components)++;
+            remaining--;
+
+            while (head < size && remaining > 0) {
+                uint64_t cur = s->queue[head++];
+                uint8_t cur_same = v->same(v->board, cur);
+
+                for (unsigned d = 0; d < MAX_NEIGHBOURS; d++) {
+                    if (cur_same & FIELD_DIR_BIT(d)) {
+                        uint64_t n = board_view_neighbour(v, cur, d);
+
+                        if (golden_scratch_visit(s, n, &size)) {
+                            uint64_t dx = n % v->width > i % v->width
+                                          ? n % v->width - i % v->width
+                                          : i % v->width - n % v->width;
+                            uint64_t dy = n / v->width > i / v->width
+                                          ? n / v->width - i / v->width
+                                          : i / v->width - n / v->width;
+
+                            remaining -= dx + dy == 1;
+                        }
+                        else if (s->queue == NULL) {
+                            return false;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    for (uint64_t j = 0; j < size; j++) {
+        s->visited[s->queue[j] / 64] &= ~(UINT64_C(1) << (s->queue[j] % 64));
+    }
+
+    return true;
+}
+
+/** @brief Wyznacza bez modyfikowania stanu gry liczbę obszarów ofiary po utracie
+ * pola.
+ * Działa jak funkcja @ref victim_new_areas, lecz gdy punkty artykulacji obszaru
+ * zawierającego pole nie są aktualne, zlicza części obszaru po usunięciu pola
+ * funkcją @ref golden_scratch_components zamiast wyznaczać je ponownie.
+ * @param[in] g      – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in,out] s  – wskaźnik na pamięć roboczą wątku,
+ * @param[in] f      – wskaźnik na strukturę przechowującą stan zajętego pola,
+ * @param[out] areas – liczba obszarów, jakie będzie zajmować właściciel pola
+ *                     wskazywanego przez @p f po jego utracie.
+ * @return Wartość @p true, jeżeli udało się wyznaczyć liczbę obszarów,
+ * a @p false, jeżeli nie udało się zaalokować pamięci.
+ */
+static bool victim_new_areas_scratch(gamma_t *g, golden_scratch_t *s, field_t *f,
+                                     uint32_t *areas) {
+    player_t *victim = field_owner(f);
+    unsigned neighbours = field_mask_count(field_same_mask(f));
+    unsigned components = 0;
+    board_view_t view = {
+        g, g->width, (uint64_t) g->width * g->height, board_same_mask
+    };
+
+    if (neighbours <= 1) {
+        *areas = player_areas(victim) - 1 + neighbours;
+    }
+    else if (area_cuts_valid(field_area(area_peek_root(f)))) {
+        *areas = player_areas(victim) - 1 + area_field_split(area_peek_root(f), f);
+    }
+    else if (!golden_scratch_components(&view, s, board_index(g, f), &components)) {
+        return false;
+    }
+    else {
+        *areas = player_areas(victim) - 1 + components;
+    }
+
+    return true;
+}
+
+/** @brief Sprawdza bez modyfikowania stanu gry, czy złoty ruch jest legalny ze
+ * strony gracza, który traci pole.
+ * Działa jak funkcja @ref victim_golden_move_legal, lecz liczbę obszarów ofiary
+ * wyznacza funkcją @ref victim_new_areas_scratch.
+ * @param[in] g     – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in,out] s – wskaźnik na pamięć roboczą wątku,
+ * @param[in] x     – numer kolumny, liczba nieujemna mniejsza od wartości
+ *                    @p width z funkcji @ref gamma_new,
+ * @param[in] y     – numer wiersza, liczba nieujemna mniejsza od wartości
+ *                    @p height z funkcji @ref gamma_new,
+ * @param[out] ok   – wartość @p false, jeżeli nie udało się zaalokować pamięci.
+ * @return Wartość @p true, jeżeli złoty ruch jest legalny ze strony gracza, który
+ * traci pole (@p x, @p y), a @p false w przeciwnym przypadku.
+ */
+static bool victim_golden_move_legal_scratch(gamma_t *g, golden_scratch_t *s,
+                                             uint32_t x, uint32_t y, bool *ok) {
+    field_t *f = &g->board[y][x];
+
+    if (field_is_free(f)) {
+        return false;
+    }
+    else {
+        player_t *victim = field_owner(f);
+        unsigned neighbours = field_mask_count(field_same_mask(f));
+        uint32_t areas = 0;
+
+        if (neighbours <= 1 || player_areas(victim) + neighbours - 1 <= g->areas) {
+            return true;
+        }
+        else if (!victim_new_areas_scratch(g, s, f, &areas)) {
+            *ok = false;
+
+            return false;
+        }
+        else {
+            return areas <= g->areas;
+        }
+    }
+}
+
+/** @brief Szuka pola, na którym gracz może wykonać złoty ruch, w pasie wierszy.
+ * Przed sprawdzeniem każdego pola sprawdza, czy pole nie zostało już znalezione
+ * przez któryś wątek, i jeżeli tak, przerywa przeglądanie.
+ * @param[in,out] arg – wskaźnik na dane wspólne dla wątków,
+ * @param[in] begin   – numer pierwszego wiersza pasa,
+ * @param[in] end     – numer wiersza następującego po ostatnim wierszu pasa,
+ * @param[in] worker  – numer wątku.
+ */
+static void golden_scan_rows(void *arg, uint32_t begin, uint32_t end,
+                             unsigned worker) {
+    golden_scan_t *scan = arg;
+    gamma_t *g = scan->g;
+    golden_scratch_t *s = &scan->scratch[worker];
+    bool ok = true;
+
+    for (uint32_t y = begin; y < end && ok; y++) {
+        for (uint32_t x = 0; x < g->width && ok; x++) {
+            if (atomic_load_explicit(&scan->found, memory_order_relaxed)) {
+                return;
+            }
+            else if (player_golden_move_legal(g, scan->p, x, y)
+                     && victim_golden_move_legal_scratch(g, s, x, y, &ok)) {
+
+                atomic_store_explicit(&scan->found, true, memory_order_relaxed);
+
+                return;
+            }
+        }
+    }
+
+    if (!ok) {
+        atomic_store_explicit(&scan->failed, true, memory_order_relaxed);
+    }
+}
+
+/** @brief Zapewnia istnienie puli wątków szukających złotego ruchu.
+ * Przy pierwszym wywołaniu tworzy pulę @p threads wątków oraz tablicę ich pamięci
+ * roboczych.
+ * @param[in,out] g   – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in] threads – liczba wątków, liczba dodatnia.
+ * @return Wartość @p true, jeżeli pula istnieje, a @p false, jeżeli nie udało
+ * się zaalokować pamięci.
+ */
+static bool golden_pool_ensure(gamma_t *g, unsigned threads) {
+    if (g->golden_pool == NULL) {
+        parallel_pool_t *pool = parallel_pool_new(threads);
+        golden_scratch_t *scratch = pool == NULL
+                                    ? NULL
+                                    : calloc(parallel_pool_threads(pool),
+                                             sizeof(golden_scratch_t));
+
+        if (scratch == NULL) {
+            parallel_pool_delete(pool);
+
+            return false;
+        }
+
+        g->golden_pool = pool;
+        g->golden_scratch = scratch;
+    }
+
+    return true;
+}
+
+/** @brief Usuwa pulę wątków szukających złotego ruchu.
+ * Kończy wątki puli i zwalnia ich pamięci robocze.
+ * @param[in,out] g – wskaźnik na strukturę przechowującą stan gry.
+ */
+static void golden_pool_delete(gamma_t *g) {
+    if (g->golden_pool != NULL) {
+        for (unsigned i = 0; i < parallel_pool_threads(g->golden_pool); i++) {
+            free(g->golden_scratch[i].visited);
+            free(g->golden_scratch[i].queue);
+        }
+
+        parallel_pool_delete(g->golden_pool);
+        free(g->golden_scratch);
+        g->golden_pool = NULL;
+        g->golden_scratch = NULL;
+    }
+}
+
+/** @brief Szuka równolegle pola, na którym gracz może wykonać złoty ruch.
+ * Dzieli planszę na pasy wierszy przeglądane równolegle przez wątki puli
+ * @ref gamma::golden_pool. Nie modyfikuje stanu gry.
+ * @param[in,out] g   – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in] p       – wskaźnik na strukturę przechowującą stan gracza, który
+ *                      nie wykonał jeszcze złotego ruchu,
+ * @param[in] threads – liczba wątków tworzonej puli, liczba dodatnia,
+ * @param[out] found  – wartość @p true, jeżeli znaleziono pole, na którym gracz
+ *                      może wykonać złoty ruch.
+ * @return Wartość @p true, jeżeli przejrzano całą planszę lub znaleziono pole,
+ * a @p false, jeżeli nie udało się zaalokować pamięci.
+ */
+static bool golden_scan(gamma_t *g, player_t *p, unsigned threads, bool *found) {
+    if (!golden_pool_ensure(g, threads)) {
+        return false;
+    }
+
+    golden_scan_t scan = {.g = g, .scratch = g->golden_scratch, .p = p};
+
+    atomic_init(&scan.found, false);
+    atomic_init(&scan.failed, false);
+    parallel_pool_for(g->golden_pool, g->height, golden_scan_rows, &scan);
+
+    *found = atomic_load(&scan.found);
+
+    return *found || !atomic_load(&scan.failed);
+}
+
+///@}
+
+/** @name Statystyki obszarów
+ * Wyznaczanie nieaktualnych liczb wolnych sąsiadów obszarów oraz odczytywanie
+ * statystyk obszarów zajętych przez gracza.
+ */
+///@{
+
+/** @brief Wyznacza liczbę wolnych sąsiadów obszaru.
+ * Wykonuje iteracyjne przeszukiwanie w głąb obszaru, którego korzeniem jest pole
+ * wskazywane przez @p root, oznaczając w bieżącej epoce odwiedzone pola obszaru
+ * oraz policzone już wolne pola, dzięki czemu każde wolne pole sąsiadujące
+ * z obszarem jest liczone tylko raz. Zapisuje wynik w statystykach obszaru.
+ * @param[in,out] g  – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in] root   – wskaźnik na strukturę przechowującą stan pola będącego
+ *                     korzeniem obszaru.
+ * @return Wartość @p true, jeżeli udało się wyznaczyć liczbę wolnych sąsiadów
+ * obszaru, a @p false, jeżeli nie udało się zaalokować pamięci.
+ */
+static bool area_compute_liberties(gamma_t *g, field_t *root) {
+    uint32_t epoch = gamma_new_epoch(g);
+    uint64_t liberties = 0, depth = 0;
+
+    if (!dfs_stack_reserve(g, area_size(field_area(root)))) {
+        return false;
+    }
+
+    field_set_visited(root, epoch);
+    g->dfs_stack[depth++] = (dfs_frame_t) {.f = root};
+
+    while (depth > 0) {
+        field_t *f = g->dfs_stack[--depth].f;
+        uint8_t free = field_free_mask(f);
+        uint8_t same = field_same_mask(f);
+
+        for (unsigned dir = 0; dir < MAX_NEIGHBOURS; dir++) {
+            if ((free | same) & FIELD_DIR_BIT(dir)) {
+                field_t *n = field_neighbour(g, f, dir);
+
+                if (!field_visited(n, epoch)) {
+                    field_set_visited(n, epoch);
+
+                    if (free & FIELD_DIR_BIT(dir)) {
+                        liberties++;
+                    }
+                    else {
+                        g->dfs_stack[depth++] = (dfs_frame_t) {.f = n};
+                    }
+                }
+            }
+        }
+    }
+
+    area_set_liberties(field_area(root), liberties);
+
+    return true;
+}
+
+/** @brief Wypełnia opis obszaru.
+ * Zapisuje w strukturze wskazywanej przez @p info statystyki obszaru, którego
+ * korzeniem jest pole wskazywane przez @p root. Wyznacza liczbę wolnych sąsiadów
+ * obszaru, jeżeli jest ona nieaktualna lub gra utrzymuje statystyki leniwie.
+ * W zachłannym sposobie utrzymywania statystyk od tej chwili gra utrzymuje liczby
+ * wolnych sąsiadów obszarów przy kolejnych ruchach.
+ * @param[in,out] g  – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in] root   – wskaźnik na strukturę przechowującą stan pola będącego
+ *                     korzeniem obszaru,
+ * @param[out] info  – wskaźnik na strukturę, w której ma zostać zapisany opis
+ *                     obszaru.
+ * @return Wartość @p true, jeżeli udało się wypełnić opis obszaru, a @p false,
+ * jeżeli nie udało się zaalokować pamięci.
+ */
+static bool area_fill_info(gamma_t *g, field_t *root, gamma_area_info_t *info) {
+    area_t *a = field_area(root);
+
+    g->liberties_tracked = g->policy == GAMMA_POLICY_EAGER;
+
+    if ((g->policy == GAMMA_POLICY_LAZY || !area_liberties_valid(a))
+        && !area_compute_liberties(g, root)) {
+        return false;
+    }
+    else {
+        *info = (gamma_area_info_t) {
+            .x = field_x(root),
+            .y = field_y(root),
+            .size = a->size,
+            .min_x = a->min_x,
+            .min_y = a->min_y,
+            .max_x = a->max_x,
+            .max_y = a->max_y,
+            .liberties = area_liberties(a)
+        };
+
+        return true;
+    }
+}
+
+///@}
+
+/** @name Ruch próbny
+ * Wyznaczanie zmian statystyk graczy, jakie spowodowałby ruch lub złoty ruch,
+ * bez zmiany stanu gry. Zmiany są odczytywane z masek sąsiedztwa pola i jego
+ * sąsiadów, korzeni obszarów odczytywanych bez skracania ścieżek oraz
+ * zapamiętanych punktów artykulacji obszarów lub przeszukiwania obszaru ofiary
+ * w pamięci roboczej wywołania.
+ */
+///@{
+
+/** @brief Zlicza różne obszary gracza sąsiadujące z polem.
+ * @param[in] g – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in] f – wskaźnik na strukturę przechowującą stan pola,
+ * @param[in] p – wskaźnik na strukturę przechowującą stan gracza.
+ * @return Liczba różnych obszarów gracza wskazywanego przez @p p, do których
+ * należą pola sąsiadujące z polem wskazywanym przez @p f.
+ */
+static unsigned player_adjacent_areas(gamma_t *g, field_t *f, player_t *p) {
+    uint8_t busy = field_busy_mask(f);
+    field_t *roots[MAX_NEIGHBOURS];
+    unsigned added = 0;
+
+    for (unsigned dir = 0; busy != 0; dir++, busy >>= 1) {
+        if (busy & 1u) {
+            field_t *n = field_neighbour(g, f, dir);
+
+            if (field_owner(n) == p) {
+                field_t *root = area_peek_root(n);
+                unsigned i = 0;
+
+                while (i < added && root != roots[i]) {
+                    i++;
+                }
+
+                if (i == added) {
+                    roots[added++] = root;
+                }
+            }
+        }
+    }
+
+    return added;
+}
+
+/** @brief Zlicza wolnych sąsiadów pola, którzy nie sąsiadują z innym polem
+ * danego gracza.
+ * Są to pola, które dołączą do obwodu gracza, gdy zajmie on pole wskazywane
+ * przez @p f, oraz te, które opuszczą jego obwód, gdy straci to pole.
+ * @param[in] g – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in] f – wskaźnik na strukturę przechowującą stan pola,
+ * @param[in] p – wskaźnik na strukturę przechowującą stan gracza.
+ * @return Liczba wolnych pól sąsiadujących z polem wskazywanym przez @p f,
+ * które poza nim nie sąsiadują z żadnym polem gracza wskazywanego przez @p p.
+ */
+static unsigned player_single_free_neighbours(gamma_t *g, field_t *f, player_t *p) {
+    uint8_t free = field_free_mask(f);
+    unsigned fields = 0;
+
+    for (unsigned dir = 0; free != 0; dir++, free >>= 1) {
+        if (free & 1u) {
+            field_t *n = field_neighbour(g, f, dir);
+            fields += !field_adjacent_to(g, n, p, FIELD_DIR_BIT(dir ^ 1));
+        }
+    }
+
+    return fields;
+}
+
+/** @brief Dopisuje zmianę statystyk gracza do opisu skutków ruchu.
+ * @param[in,out] delta   – wskaźnik na strukturę opisującą skutki ruchu,
+ * @param[in] p           – wskaźnik na strukturę przechowującą stan gracza,
+ * @param[in] busy_fields – zmiana liczby pól zajętych przez gracza,
+ * @param[in] areas       – zmiana liczby obszarów zajętych przez gracza,
+ * @param[in] perimeter   – zmiana obwodu gracza.
+ */
+static inline void move_delta_add(gamma_move_delta_t *delta, player_t *p,
+                                  int64_t busy_fields, int64_t areas,
+                                  int64_t perimeter) {
+    delta->changes[delta->players++] = (gamma_player_delta_t) {
+        .player = player_number(p),
+        .busy_fields = busy_fields,
+        .areas = areas,
+        .perimeter = perimeter
+    };
+}
+
+/** @brief Wyznacza skutki ruchu.
+ * Zapisuje w strukturze wskazywanej przez @p delta zmiany statystyk gracza
+ * wskazywanego przez @p p, wykonującego ruch na wolne pole wskazywane przez
+ * @p f, oraz każdego gracza, do którego obwodu należy to pole.
+ * @param[in] g          – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in] f          – wskaźnik na strukturę przechowującą stan pola,
+ * @param[in] p          – wskaźnik na strukturę przechowującą stan gracza,
+ * @param[out] delta     – wskaźnik na strukturę opisującą skutki ruchu.
+ */
+static void move_delta(gamma_t *g, field_t *f, player_t *p,
+                       gamma_move_delta_t *delta) {
+    player_t *owners[MAX_NEIGHBOURS];
+    unsigned owners_num = field_neighbour_owners(g, f, owners);
+
+    delta->players = 0;
+    move_delta_add(delta, p, 1, 1 - (int64_t) player_adjacent_areas(g, f, p),
+                   (int64_t) player_single_free_neighbours(g, f, p)
+                   - field_adjacent_to(g, f, p, 0));
+
+    for (unsigned i = 0; i < owners_num; i++) {
+        if (owners[i] != p) {
+            move_delta_add(delta, owners[i], 0, 0, -1);
+        }
+    }
+}
+
+/** @brief Wyznacza skutki złotego ruchu.
+ * Zapisuje w strukturze wskazywanej przez @p delta zmiany statystyk gracza
+ * wskazywanego przez @p p, wykonującego złoty ruch na pole wskazywane przez
+ * @p f, oraz gracza, który traci to pole.
+ * @param[in] g            – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in] f            – wskaźnik na strukturę przechowującą stan pola,
+ * @param[in] p            – wskaźnik na strukturę przechowującą stan gracza,
+ * @param[in] victim_areas – liczba obszarów, jakie będzie zajmować gracz tracący
+ *                           pole, wyznaczona funkcją
+ *                           @ref victim_new_areas_scratch,
+ * @param[out] delta       – wskaźnik na strukturę opisującą skutki ruchu.
+ */
+static void golden_move_delta(gamma_t *g, field_t *f, player_t *p,
+                              uint32_t victim_areas, gamma_move_delta_t *delta) {
+    player_t *victim = field_owner(f);
+
+    delta->players = 0;
+    move_delta_add(delta, p, 1, 1 - (int64_t) player_adjacent_areas(g, f, p),
+                   player_single_free_neighbours(g, f, p));
+    move_delta_add(delta, victim, -1,
+                   (int64_t) victim_areas - player_areas(victim),
+                   -(int64_t) player_single_free_neighbours(g, f, victim));
+}
+
+///@}
+
+/** @name Plansza
+ * Tworzenie, usuwanie oraz wypisywanie planszy.
+ */
+///@{
+
+/** @brief Usuwa wiersze planszy.
+ * Usuwa @p num_of_rows początkowych wierszy tablicy @ref  gamma::board
+ * struktur przechowujących stany pól, reprezentującej planszę, na której
+ * toczy się rozgrywka.
+ * Zwalnia pamięć po każdym z @p num_of_rows początkowych wierszy.
+ * @param[in,out] board       – tablica pól, o liczbie wierszy
+ *                              równej wartości @p height z funkcji
+ *                              @ref gamma_new oraz liczbie kolumn równej
+ *                              wartości @p width z funkcji @ref gamma_new,
+ *                              reprezentująca planszę na której odbywa się
+ *                              rozgrywka,
+ * @param[in] num_of_rows     – liczba wierszy tablicy @ref gamma::board,
+ *                              które należy usunąć.
+ */
+static inline void board_remove_rows(field_t **board, uint32_t num_of_rows) {
+    for (uint32_t i = 0; i < num_of_rows; i++) {
+        free(board[i]);
+    }
+}
+
+/** @brief Tworzy planszę.
+ * Alokuje pamięć na tablicę wskaźników do struktur przechowujących stan pól,
+ * o @p height wierszach i @p width kolumnach.
+ * Przypisuje każdej komórce tej tablicy wartość NULL.
+ * @param[in] width           – szerokość tworzonej planszy, długość każdego
+ *                              z wierszy tworzonej tablicy, równa wartości
+ *                              @p width z funkcji @ref gamma_new,
+ * @param[in] height          – wysokość tworzonej planszy, liczba wierszy
+ *                              tworzonej tablicy, wartość równa @p height
+ *                              z funkcji @ref gamma_new.
+ * @return Wskaźnik na utworzoną tablicę lub NULL, jeśli nie udało się zaalokować
+ * pamięci.
+ */
+static field_t **board_new(uint32_t width, uint32_t height) {
+    field_t **board = calloc(height, sizeof(field_t *));
+
+    if (board == NULL) {
+        return NULL;
+    }
+    else {
+        bool mem_error = false;
+        uint32_t added_rows = 0;
+
+        for (uint32_t i = 0; i < height && !mem_error; i++, added_rows++) {
+            board[i] = calloc(width, sizeof(field_t));
+            if (board[i] == NULL) {
+                mem_error = true;
+                board_remove_rows(board, added_rows);
+            }
+        }
+
+        if (!mem_error) {
+            return board;
+        }
+        else {
+            free(board);
+
+            return NULL;
+        }
+    }
+}
+
+/** @brief Wypełnia bufor opisujący stan planszy.
+ * Wypełnia bufor wskazywany przez @p board opisujący stan planszy.
+ * @param[in] g               – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in,out] board       – wskaźnik na bufor mający przechowywać tekstowy
+ *                              opis stanu planszy.
+ */
+static void gamma_board_fill(gamma_t *g, char *board) {
+    uint64_t filled = 0;
+
+    for (int64_t y = g->height - 1; y >= 0; y--, filled++) {
+        for (uint32_t x = 0; x < g->width; x++) {
+            char repr[FIELD_MAX_WIDTH + 1];
+
+            field_repr(&g->board[y][x], repr, g->board_field_width);
+            strncpy(board + filled, repr, g->board_field_width);
+
+            filled += g->board_field_width;
+        }
+
+        board[filled] = '\n';
+    }
+
+    board[filled] = '\0';
+}
+
+/** @brief Daje napis opisujący stan planszy.
+ * Alokuje w pamięci bufor, w którym umieszcza napis zawierający tekstowy
+ * opis aktualnego stanu planszy.
+ * @param[in] g               – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in] board_len       – długość, jaką ma mieć bufor zawierający
+ *                              napis opisujący planszę.
+ * @return Wskaźnik na zaalokowany bufor zawierający napis opisujący stan
+ * planszy lub NULL, jeśli nie udało się zaalokować pamięci.
+ */
+static char *gamma_board_new(gamma_t *g, uint64_t board_len) {
+    char *board = calloc(board_len, sizeof(char));
+
+    if (board != NULL) {
+        gamma_board_fill(g, board);
+    }
+
+    return board;
+}
+
+///@}
+
+/** @name Inicjacja
+ * Inicjacja struktury przechowującej stan gry.
+ */
+///@{
+
+/** @brief Inicjuje strukturę przechowującą stan gry.
+ * Inicjuje strukturę przechowującą stan gry, wskazywaną przez @p g,
+ * tak, aby reprezentowała początkowy stan gry.
+ * @param[in,out] g   – wskaźnik na inicjalizowaną strukturę,
  * @param[in] width   – szerokość planszy, liczba dodatnia,
  *                      równa wartości @p width z funkcji
  *                      @ref gamma_new,
@@ -1045,251 +3194,1972 @@ static char *gamma_board_new(gamma_t *g, uint64_t board_len) {
  * @param[in] areas   – maksymalna liczba obszarów,
  *                      jakie może zająć jeden gracz,
  *                      liczba dodatnia równa wartości
- *                      @p areas z funkcji @ref gamma_new.
+ *                      @p areas z funkcji @ref gamma_new,
+ * @param[in] policy  – sposób utrzymywania statystyk graczy, równy
+ *                      wartości @p policy z funkcji
+ *                      @ref gamma_new_with_policy.
  * @return Wartość @p true, jeśli inicjalizacja struktury przebiegła pomyślnie,
  * a @p false w przeciwnym przypadku, na przykład w przypadku braku pamięci.
  */
-static bool gamma_init(gamma_t *g, uint32_t width, uint32_t height,
-                       uint32_t players, uint32_t areas) {
-    g->width = width;
-    g->height = height;
-    g->players = players;
-    g->areas = areas;
-    g->busy_fields = 0;
-    g->board = board_new(width, height);
+static bool gamma_init(gamma_t *g, uint32_t width, uint32_t height,
+                       uint32_t players, uint32_t areas, gamma_policy_t policy) {
+    g->width = width;
+    g->height = height;
+    g->players = players;
+    g->areas = areas;
+    g->busy_fields = 0;
+    g->epoch = 0;
+    g->dfs_stack = NULL;
+    g->dfs_stack_size = 0;
+    g->area_chunks = NULL;
+    g->area_chunks_num = 0;
+    g->area_free = NULL;
+    g->area_free_num = 0;
+    g->listed = false;
+    g->liberties_tracked = false;
+    g->indexed = false;
+    g->free_fields_arr = NULL;
+    g->free_pos = NULL;
+    g->perimeter_slots = NULL;
+    g->active_players = 0;
+    g->active_stale = false;
+    g->dirty_players = NULL;
+    g->dirty_count = 0;
+    g->dependent_players = NULL;
+    g->dependent_count = 0;
+    g->watch_stamp = 0;
+    g->policy = policy;
+    g->version = 0;
+    g->books_version = 0;
+    g->books_log = NULL;
+    g->books_log_num = 0;
+    g->books_log_capacity = 0;
+    g->books_log_full = false;
+    g->golden_pool = NULL;
+    g->golden_scratch = NULL;
+    atomic_init(&g->snapshot, NULL);
+    atomic_init(&g->snapshot_readers, 0);
+    g->retired = NULL;
+    g->dirty_tiles = NULL;
+    g->tiles_x = (uint32_t) (((uint64_t) width + SNAPSHOT_TILE - 1) / SNAPSHOT_TILE);
+    g->tiles_y = (uint32_t) (((uint64_t) height + SNAPSHOT_TILE - 1) / SNAPSHOT_TILE);
+    g->board = board_new(width, height);
+
+    if (g->board == NULL) {
+        return false;
+    }
+    else {
+        g->players_arr = calloc(((uint64_t) players + 1), sizeof(player_t));
+        g->dirty_players = malloc((uint64_t) players * sizeof(uint32_t));
+        g->dependent_players = malloc((uint64_t) players * sizeof(uint32_t));
+
+        if (g->players_arr == NULL || g->dirty_players == NULL || g->dependent_players == NULL) {
+            return false;
+        }
+        else {
+            g->board_field_width = 0;
+            uint32_t mx_player = g->players;
+
+            while (mx_player > 0) {
+                g->board_field_width++;
+                mx_player /= 10;
+            }
+
+            if (g->players >= 10) {
+                g->board_field_width++;
+            }
+
+            for (uint32_t y = 0; y < height; y++) {
+                for (uint32_t x = 0; x < width; x++) {
+                    field_init(&g->board[y][x], x, y);
+                    field_set_free_mask(&g->board[y][x],
+                                        board_neighbours_mask(g, x, y));
+                }
+            }
+
+            for (uint32_t player = 0; player++ < g->players;) {
+                player_init(&g->players_arr[player], player);
+            }
+
+            for (uint32_t player = 0; player++ < g->players;) {
+                player_t *p = &g->players_arr[player];
+                player_set_active(p, true);
+                player_set_next_active(p, player % g->players + 1);
+                player_set_prev_active(p, player == 1 ? g->players : player - 1);
+            }
+
+            g->active_players = g->players;
+
+            return true;
+        }
+    }
+}
+
+///@}
+
+/** @name Wczytywanie planszy
+ * Budowa stanu gry z macierzy właścicieli pól w czasie liniowym. Obszary są
+ * wyznaczane jednym przejściem etykietowania spójnych składowych, wykonywanym
+ * równolegle w pasach wierszy planszy, po którym sekwencyjnie łączone są obszary
+ * przecinające granice pasów.
+ */
+///@{
+
+/**
+ * Typ struktury przechowującej dane wspólne dla wątków wczytujących planszę.
+ */
+typedef struct board_load board_load_t;
+
+/**
+ * Struktura przechowująca dane wspólne dla wątków wczytujących planszę.
+ */
+struct board_load {
+    gamma_t *g;             /**< Wskaźnik na strukturę przechowującą stan gry. */
+    const uint32_t *owners; /**< Macierz numerów właścicieli pól, zapisana
+                             *   wierszami. */
+};
+
+/** @brief Podaje właściciela pola z macierzy właścicieli.
+ * @param[in] load – wskaźnik na dane wczytywanej planszy,
+ * @param[in] x    – numer kolumny pola,
+ * @param[in] y    – numer wiersza pola.
+ * @return Wskaźnik na strukturę przechowującą stan właściciela pola lub NULL,
+ * jeżeli pole jest wolne.
+ */
+static inline player_t *board_load_owner(board_load_t *load, int64_t x, int64_t y) {
+    uint32_t player = load->owners[(uint64_t) y * load->g->width + x];
+
+    return player == 0 ? NULL : &load->g->players_arr[player];
+}
+
+/** @brief Łączy obszary dwóch pól bez wyznaczania statystyk.
+ * Łączy obszary, do których należą pola wskazywane przez @p f1 oraz @p f2,
+ * ustawiając rodzica korzenia leżącego dalej w kolejności wierszy i kolumn na
+ * drugi korzeń. Korzeniem każdego obszaru zostaje więc jego pierwsze pole w tej
+ * kolejności, a statystyki obszarów są wyznaczane dopiero po połączeniu
+ * wszystkich pól. Może być wywoływana równolegle dla rozłącznych fragmentów
+ * planszy.
+ * @param[in,out] f1 – wskaźnik na strukturę przechowującą stan pierwszego pola,
+ * @param[in,out] f2 – wskaźnik na strukturę przechowującą stan drugiego pola.
+ */
+static void board_load_link(field_t *f1, field_t *f2) {
+    field_t *r1 = area_find_root(f1);
+    field_t *r2 = area_find_root(f2);
+
+    if (r1 != r2) {
+        if (field_y(r1) > field_y(r2)
+            || (field_y(r1) == field_y(r2) && field_x(r1) > field_x(r2))) {
+            field_t *tmp = r1;
+            r1 = r2;
+            r2 = tmp;
+        }
+
+        field_set_parent(r2, r1);
+    }
+}
+
+/** @brief Wczytuje pas wierszy planszy.
+ * Ustawia właścicieli i maski sąsiedztwa pól w wierszach [@p begin, @p end)
+ * oraz łączy obszary sąsiednich pól tego samego gracza leżących w tym pasie.
+ * @param[in,out] arg – wskaźnik na dane wczytywanej planszy,
+ * @param[in] begin   – numer pierwszego wiersza pasa,
+ * @param[in] end     – numer wiersza następującego po ostatnim wierszu pasa,
+ * @param[in] worker  – numer wątku.
+ */
+static void board_load_rows(void *arg, uint32_t begin, uint32_t end,
+                            unsigned worker) {
+    board_load_t *load = arg;
+    gamma_t *g = load->g;
+    (void) worker;
+
+    for (uint32_t y = begin; y < end; y++) {
+        for (uint32_t x = 0; x < g->width; x++) {
+            field_t *f = &g->board[y][x];
+            player_t *owner = board_load_owner(load, x, y);
+            uint8_t free = 0, same = 0;
+
+            field_set_owner(f, owner);
+            field_set_parent(f, NULL);
+
+            for (unsigned dir = 0; dir < MAX_NEIGHBOURS; dir++) {
+                int64_t nx = (int64_t) x + NEIGHBOUR_DX[dir];
+                int64_t ny = (int64_t) y + NEIGHBOUR_DY[dir];
+
+                if (valid_x(g, nx) && valid_y(g, ny)) {
+                    player_t *n_owner = board_load_owner(load, nx, ny);
+
+                    if (n_owner == NULL) {
+                        free |= FIELD_DIR_BIT(dir);
+                    }
+                    else if (n_owner == owner) {
+                        same |= FIELD_DIR_BIT(dir);
+                    }
+                }
+            }
+
+            field_set_free_mask(f, free);
+            field_set_same_mask(f, same);
+            field_set_busy_mask(f, board_neighbours_mask(g, x, y) & (uint8_t) ~free);
+
+            if (owner != NULL) {
+                if (x > 0 && (same & FIELD_DIR_BIT(0))) {
+                    board_load_link(f, &g->board[y][x - 1]);
+                }
+                if (y > begin && (same & FIELD_DIR_BIT(2))) {
+                    board_load_link(f, &g->board[y - 1][x]);
+                }
+            }
+        }
+    }
+}
+
+/** @brief Wczytuje planszę z macierzy właścicieli pól.
+ * Wczytuje równolegle pasy wierszy planszy, łączy obszary przecinające granice
+ * pasów, po czym zlicza pola i obszary graczy, przydziela statystyki obszarom,
+ * buduje listy obszarów graczy oraz zbiory pól i oznacza aktywność wszystkich
+ * graczy do ponownego wyznaczenia. Korzeń każdego obszaru jest jego pierwszym
+ * polem w kolejności wierszy i kolumn, więc jego statystyki są przydzielane
+ * przed dołączeniem do nich pozostałych pól obszaru.
+ * @param[in,out] g   – wskaźnik na strukturę przechowującą stan początkowy gry,
+ * @param[in] owners  – macierz numerów właścicieli pól, zapisana wierszami,
+ *                      zawierająca tylko poprawne numery graczy lub zera.
+ * @return Wartość @p true, jeżeli żaden gracz nie zajmuje więcej obszarów niż
+ * wartość @p areas z funkcji @ref gamma_new i udało się zaalokować pamięć,
+ * a @p false w przeciwnym przypadku.
+ */
+static bool gamma_load_board(gamma_t *g, const uint32_t *owners) {
+    board_load_t load = {g, owners};
+    unsigned threads = parallel_threads((uint64_t) g->width * g->height);
+
+    if (threads > g->height) {
+        threads = g->height;
+    }
+
+    parallel_for(g->height, threads, board_load_rows, &load);
+
+    for (unsigned i = 1; i < threads; i++) {
+        uint32_t y = (uint32_t) ((uint64_t) g->height * i / threads);
+
+        for (uint32_t x = 0; x < g->width; x++) {
+            if (field_same_mask(&g->board[y][x]) & FIELD_DIR_BIT(2)) {
+                board_load_link(&g->board[y][x], &g->board[y - 1][x]);
+            }
+        }
+    }
+
+    for (uint32_t y = 0; y < g->height; y++) {
+        for (uint32_t x = 0; x < g->width; x++) {
+            field_t *f = &g->board[y][x];
+            player_t *owner = field_owner(f);
+
+            if (owner != NULL) {
+                g->busy_fields++;
+                player_set_busy_fields(owner, player_busy_fields(owner) + 1);
+
+                if (field_parent(f) == NULL) {
+                    if (!area_pool_reserve(g, 1)) {
+                        return false;
+                    }
+
+                    field_set_area(f, area_alloc(g));
+                    area_init(field_area(f), x, y, 0);
+                    area_invalidate_liberties(field_area(f));
+                    player_set_areas(owner, player_areas(owner) + 1);
+                    area_list_add(g, owner, f);
+                }
+                else {
+                    area_include(field_area(area_find_root(f)), x, y);
+                }
+            }
+        }
+    }
+
+    for (uint32_t player = 0; player++ < g->players;) {
+        if (player_areas(&g->players_arr[player]) > g->areas) {
+            return false;
+        }
+    }
+
+    players_mark_all_dirty(g);
+    g->active_stale = true;
+
+    return gamma_rebuild_books(g);
+}
+
+///@}
+
+/** @name Audyt
+ * Sprawdzanie zgodności statystyk graczy i struktury obszarów z planszą.
+ * Statystyki są wyznaczane od nowa, niezależnie od utrzymywanych struktur,
+ * równolegle w pasach wierszy planszy. Obszary w obrębie pasa są etykietowane
+ * z użyciem osobnej tablicy, a obszary przecinające granice pasów są łączone
+ * sekwencyjnie. Listy obszarów graczy są sprawdzane tylko wtedy, gdy gra już je
+ * utrzymuje. Audyt nie uaktualnia obwodów graczy ani zbiorów pól, lecz porównuje
+ * je z planszą w takim stanie, w jakim je zastał, o ile są aktualne.
+ */
+///@{
+
+/**
+ * Typ struktury przechowującej statystyki wyznaczone dla jednego pasa wierszy.
+ */
+typedef struct verify_band verify_band_t;
+
+/**
+ * Struktura przechowująca statystyki wyznaczone dla jednego pasa wierszy.
+ */
+struct verify_band {
+    uint64_t *busy_fields; /**< Liczby pól pasa zajętych przez graczy. */
+    uint64_t *areas;       /**< Liczby obszarów graczy w obrębie pasa. */
+    uint64_t *perimeter;   /**< Liczby wolnych pól pasa sąsiadujących z polami
+                            *   graczy. */
+    uint64_t *roots;       /**< Liczby korzeni obszarów graczy w pasie. */
+    uint64_t *root_sizes;  /**< Sumy rozmiarów obszarów o korzeniach w pasie. */
+    uint64_t mismatches;   /**< Liczba wykrytych niezgodności. */
+};
+
+/**
+ * Typ struktury przechowującej dane wspólne dla wątków audytu.
+ */
+typedef struct verify verify_t;
+
+/**
+ * Struktura przechowująca dane wspólne dla wątków audytu.
+ */
+struct verify {
+    gamma_t *g;           /**< Wskaźnik na strukturę przechowującą stan gry. */
+    uint64_t *label;      /**< Tablica, w której indeksie @p y * @p width + @p x
+                           *   przechowywany jest indeks rodzica pola (@p x, @p y)
+                           *   w etykietowaniu obszarów. */
+    verify_band_t *bands; /**< Tablica statystyk kolejnych pasów. */
+    uint32_t bands_count; /**< Liczba pasów. */
+    bool books;           /**< Wartość @p true, jeżeli obwody graczy i zbiory
+                           *   pól są aktualne i mają zostać sprawdzone. */
+};
+
+/** @brief Znajduje etykietę obszaru w etykietowaniu audytu.
+ * @param[in,out] label – tablica indeksów rodziców pól,
+ * @param[in] i         – indeks pola.
+ * @return Indeks pola będącego korzeniem etykietowanego obszaru.
+ */
+static uint64_t verify_find(uint64_t *label, uint64_t i) {
+    while (label[i] != i) {
+        label[i] = label[label[i]];
+        i = label[i];
+    }
+
+    return i;
+}
+
+/** @brief Łączy dwa obszary w etykietowaniu audytu.
+ * @param[in,out] label – tablica indeksów rodziców pól,
+ * @param[in] i         – indeks pola pierwszego obszaru,
+ * @param[in] j         – indeks pola drugiego obszaru.
+ * @return Wartość @p true, jeżeli połączono dwa różne obszary, a @p false,
+ * jeżeli pola należały do tego samego obszaru.
+ */
+static bool verify_union(uint64_t *label, uint64_t i, uint64_t j) {
+    i = verify_find(label, i);
+    j = verify_find(label, j);
+
+    if (i == j) {
+        return false;
+    }
+    else {
+        if (i < j) {
+            label[j] = i;
+        }
+        else {
+            label[i] = j;
+        }
+
+        return true;
+    }
+}
+
+/** @brief Sprawdza połączenie dwóch sąsiednich pól tego samego gracza.
+ * Łączy obszary pól w etykietowaniu audytu i sprawdza, czy w strukturze
+ * obszarów gry pola mają ten sam korzeń.
+ * @param[in] g         – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in,out] label – tablica indeksów rodziców pól,
+ * @param[in] f1        – wskaźnik na strukturę przechowującą stan pierwszego pola,
+ * @param[in] f2        – wskaźnik na strukturę przechowującą stan drugiego pola,
+ * @param[in,out] band  – statystyki pasa, którego łączone obszary dotyczą.
+ * @return Wartość @p true, jeżeli połączono dwa różne obszary etykietowania,
+ * a @p false w przeciwnym przypadku.
+ */
+static bool verify_link(gamma_t *g, uint64_t *label, field_t *f1, field_t *f2,
+                        verify_band_t *band) {
+    if (area_peek_root(f1) != area_peek_root(f2)) {
+        band->mismatches++;
+    }
+
+    return verify_union(label,
+                        (uint64_t) field_y(f1) * g->width + field_x(f1),
+                        (uint64_t) field_y(f2) * g->width + field_x(f2));
+}
+
+/** @brief Sprawdza pozycje wolnego pola w zbiorach pól.
+ * Sprawdza, czy pole wskazywane przez @p f zajmuje zapisaną dla niego pozycję
+ * w tablicy wolnych pól oraz w tablicach pól obwodów dokładnie tych graczy,
+ * których pola z nim sąsiadują.
+ * @param[in] g     – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in] f     – wskaźnik na strukturę przechowującą stan wolnego pola,
+ * @param[in] seen  – tablica wskaźników na struktury graczy, których pola
+ *                    sąsiadują z polem, bez powtórzeń,
+ * @param[in] count – liczba elementów tablicy @p seen.
+ * @return Liczba wykrytych niezgodności.
+ */
+static uint64_t verify_index(gamma_t *g, field_t *f, player_t **seen,
+                             unsigned count) {
+    uint64_t i = board_index(g, f);
+    uint64_t free_fields = (uint64_t) g->width * g->height - g->busy_fields;
+    perimeter_slot_t *slots = &g->perimeter_slots[i * PERIMETER_SLOTS];
+    uint64_t mismatches = g->free_pos[i] >= free_fields
+                          || g->free_fields_arr[g->free_pos[i]] != f;
+    unsigned used = 0;
+
+    for (unsigned k = 0; k < PERIMETER_SLOTS; k++) {
+        used += slots[k].player != 0;
+    }
+
+    mismatches += used != count;
+
+    for (unsigned k = 0; k < count; k++) {
+        unsigned j = 0;
+
+        while (j < PERIMETER_SLOTS && slots[j].player != player_number(seen[k])) {
+            j++;
+        }
+
+        mismatches += j == PERIMETER_SLOTS
+                      || slots[j].pos >= player_perimeter(seen[k])
+                      || player_perimeter_fields(seen[k])[slots[j].pos] != f;
+    }
+
+    return mismatches;
+}
+
+/** @brief Wyznacza statystyki pasa wierszy planszy.
+ * Zlicza pola zajęte przez graczy, obszary graczy w obrębie pasa, wolne pola
+ * pasa sąsiadujące z polami graczy oraz korzenie obszarów i ich rozmiary.
+ * Sprawdza poprawność masek sąsiedztwa pól, to, czy statystyki obszarów są
+ * przydzielone dokładnie korzeniom obszarów, oraz to, czy sąsiednie pola tego
+ * samego gracza mają ten sam korzeń obszaru. Jeżeli zbiory pól są aktualne,
+ * sprawdza także pozycje wolnych pól pasa w tych zbiorach.
+ * @param[in,out] arg – wskaźnik na dane wspólne dla wątków audytu,
+ * @param[in] begin   – numer pierwszego wiersza pasa,
+ * @param[in] end     – numer wiersza następującego po ostatnim wierszu pasa,
+ * @param[in] worker  – numer pasa.
+ */
+static void verify_rows(void *arg, uint32_t begin, uint32_t end,
+                        unsigned worker) {
+    verify_t *v = arg;
+    gamma_t *g = v->g;
+    verify_band_t *band = &v->bands[worker];
+
+    for (uint32_t y = begin; y < end; y++) {
+        for (uint32_t x = 0; x < g->width; x++) {
+            field_t *f = &g->board[y][x];
+            player_t *owner = field_owner(f);
+            uint64_t i = (uint64_t) y * g->width + x;
+            player_t *seen[MAX_NEIGHBOURS];
+            unsigned seen_count = 0;
+            uint8_t free = 0, busy = 0, same = 0;
+
+            v->label[i] = i;
+
+            for (unsigned dir = 0; dir < MAX_NEIGHBOURS; dir++) {
+                int64_t nx = (int64_t) x + NEIGHBOUR_DX[dir];
+                int64_t ny = (int64_t) y + NEIGHBOUR_DY[dir];
+
+                if (valid_x(g, nx) && valid_y(g, ny)) {
+                    player_t *n_owner = field_owner(&g->board[ny][nx]);
+
+                    if (n_owner == NULL) {
+                        free |= FIELD_DIR_BIT(dir);
+                    }
+                    else {
+                        busy |= FIELD_DIR_BIT(dir);
+
+                        if (n_owner == owner) {
+                            same |= FIELD_DIR_BIT(dir);
+                        }
+                    }
+
+                    if (owner == NULL && n_owner != NULL) {
+                        unsigned k = 0;
+
+                        while (k < seen_count && seen[k] != n_owner) {
+                            k++;
+                        }
+                        if (k == seen_count) {
+                            seen[seen_count++] = n_owner;
+                            band->perimeter[player_number(n_owner)]++;
+                        }
+                    }
+                }
+            }
+
+            if (field_free_mask(f) != free || field_busy_mask(f) != busy
+                || (owner != NULL && field_same_mask(f) != same)
+                || (field_area(f) != NULL)
+                   != (owner != NULL && field_parent(f) == NULL)) {
+                band->mismatches++;
+            }
+
+            if (owner == NULL && v->books && g->indexed) {
+                band->mismatches += verify_index(g, f, seen, seen_count);
+            }
+
+            if (owner != NULL) {
+                uint32_t player = player_number(owner);
+
+                band->busy_fields[player]++;
+                band->areas[player]++;
+
+                if (field_parent(f) == NULL && field_area(f) != NULL) {
+                    band->roots[player]++;
+                    band->root_sizes[player] += area_size(field_area(f));
+                }
+
+                if (x > 0 && (same & FIELD_DIR_BIT(0))
+                    && verify_link(g, v->label, f, &g->board[y][x - 1], band)) {
+                    band->areas[player]--;
+                }
+                if (y > begin && (same & FIELD_DIR_BIT(2))
+                    && verify_link(g, v->label, f, &g->board[y - 1][x], band)) {
+                    band->areas[player]--;
+                }
+            }
+        }
+    }
+}
+
+/** @brief Porównuje statystyki graczy ze statystykami wyznaczonymi od nowa.
+ * Łączy obszary przecinające granice pasów, sumuje statystyki pasów i porównuje
+ * je z utrzymywanymi statystykami graczy. Obwody graczy porównuje tylko wtedy,
+ * gdy są aktualne.
+ * @param[in,out] v – wskaźnik na dane wspólne dla wątków audytu.
+ * @return Liczba wykrytych niezgodności.
+ */
+static uint64_t verify_compare(verify_t *v) {
+    gamma_t *g = v->g;
+    verify_band_t *total = &v->bands[0];
+    uint64_t busy_fields = 0;
+
+    for (uint32_t b = 1; b < v->bands_count; b++) {
+        uint32_t y = (uint32_t) ((uint64_t) g->height * b / v->bands_count);
+
+        for (uint32_t x = 0; x < g->width; x++) {
+            field_t *f = &g->board[y][x];
+
+            if (field_owner(f) != NULL && (field_same_mask(f) & FIELD_DIR_BIT(2))
+                && verify_link(g, v->label, f, &g->board[y - 1][x], total)) {
+                total->areas[player_number(field_owner(f))]--;
+            }
+        }
+
+        for (uint32_t player = 0; player++ < g->players;) {
+            total->busy_fields[player] += v->bands[b].busy_fields[player];
+            total->areas[player] += v->bands[b].areas[player];
+            total->perimeter[player] += v->bands[b].perimeter[player];
+            total->roots[player] += v->bands[b].roots[player];
+            total->root_sizes[player] += v->bands[b].root_sizes[player];
+        }
+
+        total->mismatches += v->bands[b].mismatches;
+    }
+
+    for (uint32_t player = 0; player++ < g->players;) {
+        player_t *p = &g->players_arr[player];
+        uint64_t listed = g->listed ? 0 : total->roots[player];
+
+        for (field_t *root = player_first_area(p); g->listed && root != NULL
+             && listed <= total->roots[player];
+             root = area_next(field_area(root))) {
+            listed++;
+        }
+
+        busy_fields += total->busy_fields[player];
+        total->mismatches += (player_busy_fields(p) != total->busy_fields[player])
+                             + (player_areas(p) != total->areas[player])
+                             + (v->books
+                                && player_perimeter(p) != total->perimeter[player])
+                             + (total->roots[player] != total->areas[player])
+                             + (total->root_sizes[player]
+                                != total->busy_fields[player])
+                             + (listed != total->roots[player]);
+    }
+
+    return total->mismatches + (g->busy_fields != busy_fields);
+}
+
+/** @brief Sprawdza zgodność statystyk graczy z planszą.
+ * Nie uaktualnia obwodów graczy ani zbiorów pól, więc w trybie
+ * @ref GAMMA_POLICY_LAZY sprawdza je tylko wtedy, gdy od ich ostatniego
+ * uaktualnienia nie wykonano ruchu.
+ * @param[in] g       – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in] threads – liczba wątków lub 0, jeżeli ma zostać dobrana
+ *                      automatycznie.
+ * @return Liczba wykrytych niezgodności lub @p UINT64_MAX, jeżeli nie udało się
+ * zaalokować pamięci.
+ */
+static uint64_t gamma_audit(gamma_t *g, unsigned threads) {
+    if (threads == 0) {
+        threads = parallel_threads((uint64_t) g->width * g->height);
+    }
+    if (threads > g->height) {
+        threads = g->height;
+    }
+
+    uint64_t stats = (uint64_t) threads * (g->players + 1);
+    verify_t v = {
+        .g = g,
+        .label = malloc((uint64_t) g->width * g->height * sizeof(uint64_t)),
+        .bands = malloc(threads * sizeof(verify_band_t)),
+        .bands_count = threads,
+        .books = g->policy == GAMMA_POLICY_EAGER
+                 || g->books_version == g->version
+    };
+    uint64_t *counters = calloc(5 * stats, sizeof(uint64_t));
+    uint64_t mismatches = UINT64_MAX;
+
+    if (v.label != NULL && v.bands != NULL && counters != NULL) {
+        for (unsigned b = 0; b < threads; b++) {
+            uint64_t *c = counters + (uint64_t) b * (g->players + 1);
+
+            v.bands[b] = (verify_band_t) {
+                .busy_fields = c,
+                .areas = c + stats,
+                .perimeter = c + 2 * stats,
+                .roots = c + 3 * stats,
+                .root_sizes = c + 4 * stats,
+                .mismatches = 0
+            };
+        }
+
+        parallel_for(g->height, threads, verify_rows, &v);
+        mismatches = verify_compare(&v);
+    }
+
+    free(v.label);
+    free(v.bands);
+    free(counters);
+
+    return mismatches;
+}
+
+///@}
+
+/** @name Zapamiętywanie wyników
+ * Zapamiętywanie wyników zapytań o możliwość wykonania złotego ruchu oraz
+ * o liczbę pól, na których gracz może wykonać ruch. Zapamiętany wynik jest
+ * ważny do następnego ruchu lub złotego ruchu, czyli do zmiany wartości
+ * @ref gamma::version.
+ */
+///@{
+
+/** @brief Podaje znacznik bieżącego stanu gry.
+ * @param[in] g – wskaźnik na strukturę przechowującą stan gry.
+ * @return Wartość @ref gamma::version powiększona o 1, dzięki czemu wartość 0
+ * oznacza brak zapamiętanego wyniku.
+ */
+static inline uint64_t memo_stamp(gamma_t *g) {
+    return g->version + 1;
+}
+
+/** @brief Sprawdza, czy możliwość wykonania złotego ruchu wynika ze statystyk.
+ * Rozstrzyga, czy gracz może wykonać złoty ruch, bez przeglądania planszy, jeżeli
+ * wynika to z tego, czy gracz wykonał już złoty ruch, z liczby pól zajętych przez
+ * innych graczy lub z liczby obszarów gracza.
+ * @param[in] g          – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in] p          – wskaźnik na strukturę przechowującą stan gracza,
+ * @param[out] possible  – wartość @p true, jeżeli gracz może wykonać złoty ruch,
+ *                         a @p false w przeciwnym przypadku.
+ * @return Wartość @p true, jeżeli wartość @p possible została wyznaczona,
+ * a @p false, jeżeli wymaga to przejrzenia planszy.
+ */
+static bool golden_possible_known(gamma_t *g, player_t *p, bool *possible) {
+    if (!player_golden_possible(p) || player_busy_fields(p) == g->busy_fields) {
+        *possible = false;
+
+        return true;
+    }
+    else if (player_areas(p) < g->areas) {
+        *possible = true;
+
+        return true;
+    }
+    else {
+        return false;
+    }
+}
+
+/** @brief Dopisuje gracza do list obserwatorów jego sąsiadów.
+ * Przeszukuje w głąb każdy obszar z listy obszarów gracza wskazywanego przez
+ * @p p, w czasie proporcjonalnym do liczby jego pól, i dopisuje go do listy
+ * obserwatorów każdego gracza, do którego należy pole sąsiadujące z polem
+ * gracza. Wcześniejsze wpisy gracza przestają być aktualne.
+ * @param[in,out] g – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in,out] p – wskaźnik na strukturę przechowującą stan gracza.
+ * @return Wartość @p true, jeżeli dopisano gracza do wszystkich list,
+ * a @p false, jeżeli nie udało się zaalokować pamięci. W drugim przypadku
+ * żaden wpis gracza nie jest aktualny.
+ */
+static bool player_watch_neighbours(gamma_t *g, player_t *p) {
+    uint32_t epoch = gamma_new_epoch(g);
+
+    gamma_build_lists(g);
+    player_set_watch_stamp(p, ++g->watch_stamp);
+
+    for (field_t *root = player_first_area(p); root != NULL;
+         root = area_next(field_area(root))) {
+        uint64_t depth = 0;
+
+        if (!dfs_stack_reserve(g, area_size(field_area(root)))) {
+            player_set_watch_stamp(p, 0);
+
+            return false;
+        }
+
+        field_set_visited(root, epoch);
+        g->dfs_stack[depth++] = (dfs_frame_t) {.f = root};
+
+        while (depth > 0) {
+            field_t *f = g->dfs_stack[--depth].f;
+            uint8_t busy = field_busy_mask(f);
+            uint8_t same = field_same_mask(f);
+
+            for (unsigned dir = 0; dir < MAX_NEIGHBOURS; dir++) {
+                if (busy & FIELD_DIR_BIT(dir)) {
+                    field_t *n = field_neighbour(g, f, dir);
+
+                    if (!(same & FIELD_DIR_BIT(dir))) {
+                        if (!player_watch_add(g, field_owner(n), p)) {
+                            player_set_watch_stamp(p, 0);
+
+                            return false;
+                        }
+                    }
+                    else if (!field_visited(n, epoch)) {
+                        field_set_visited(n, epoch);
+                        g->dfs_stack[depth++] = (dfs_frame_t) {.f = n};
+                    }
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
+/** @brief Sprawdza, czy gracz może wykonać złoty ruch.
+ * Wyznacza wynik funkcji @ref gamma_golden_possible bez korzystania
+ * z zapamiętanych wyników. Jeżeli wynik zależy od obszarów sąsiadów gracza,
+ * dopisuje go do ich list obserwatorów funkcją @ref player_watch_neighbours,
+ * a w przeciwnym przypadku unieważnia jego wpisy.
+ * @param[in,out] g – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in] p     – wskaźnik na strukturę przechowującą stan gracza.
+ * @return Wartość @p true, jeżeli gracz może wykonać złoty ruch, a @p false
+ * w przeciwnym przypadku.
+ */
+static bool golden_possible_compute(gamma_t *g, player_t *p) {
+    bool possible = false;
+
+    if (golden_possible_known(g, p, &possible)) {
+        player_set_watch_stamp(p, 0);
+
+        return possible;
+    }
+    else {
+        player_watch_neighbours(g, p);
+
+        unsigned threads = parallel_threads((uint64_t) g->width * g->height);
+        bool found = false;
+
+        if (threads > g->height) {
+            threads = g->height;
+        }
+        if (threads > 1 && golden_scan(g, p, threads, &found)) {
+            return found;
+        }
+
+        for (uint32_t y = 0; y < g->height; y++) {
+            for (uint32_t x = 0; x < g->width; x++) {
+                if (player_golden_move_legal(g, p, x, y)
+                    && victim_golden_move_legal(g, x, y)) {
+
+                    return true;
+                }
+            }
+        }
+
+        return false;
+    }
+}
+
+///@}
+
+/** @name Migawki
+ * Publikowanie niezmiennych migawek stanu gry, z których mogą korzystać wątki
+ * czytelników, podczas gdy wątek piszący wykonuje kolejne ruchy. Migawka zawiera
+ * statystyki graczy oraz właścicieli pól, podzielonych na kwadratowe kafelki.
+ * Kafelki niezmienione od poprzedniej publikacji są współdzielone z poprzednią
+ * migawką, a zmienione są kopiowane. Migawka zastąpiona nowszą jest zwalniana
+ * przez wątek piszący dopiero wtedy, gdy nie korzysta z niej żaden czytelnik
+ * i żaden czytelnik nie jest w trakcie pobierania migawki, więc czytelnicy nigdy
+ * nie blokują wątku piszącego, a on nie blokuje ich. Możliwość wykonania złotego
+ * ruchu, której nie da się odczytać ze statystyk gry, wyznacza na podstawie
+ * migawki pierwszy czytelnik, który o nią zapyta.
+ */
+///@{
+
+/**
+ * Typ struktury przechowującej kafelek planszy w migawce.
+ */
+typedef struct snapshot_tile snapshot_tile_t;
+
+/**
+ * Struktura przechowująca kafelek planszy w migawce.
+ */
+struct snapshot_tile {
+    uint64_t refs; /**< Liczba migawek zawierających kafelek, modyfikowana tylko
+                    *   przez wątek piszący. */
+    uint32_t owners[SNAPSHOT_TILE * SNAPSHOT_TILE]; /**< Numery właścicieli pól
+                    *   kafelka zapisane wierszami lub 0 dla wolnych pól. */
+};
+
+/**
+ * Struktura przechowująca migawkę stanu gry.
+ */
+struct gamma_snapshot {
+    _Atomic uint64_t refs;      /**< Liczba czytelników korzystających
+                                 *   z migawki. */
+    uint64_t version;           /**< Wartość @ref gamma::version w chwili
+                                 *   publikacji. */
+    uint32_t width;             /**< Szerokość planszy. */
+    uint32_t height;            /**< Wysokość planszy. */
+    uint32_t players;           /**< Liczba graczy. */
+    uint32_t areas;             /**< Maksymalna liczba obszarów, jakie może zająć
+                                 *   jeden gracz. */
+    unsigned board_field_width; /**< Szerokość pola w napisie opisującym
+                                 *   planszę. */
+    uint32_t tiles_x;           /**< Liczba kafelków w wierszu planszy. */
+    uint64_t *busy_fields;      /**< Liczby pól zajętych przez graczy. */
+    _Atomic uint64_t *free_fields; /**< Liczby pól, na których gracze mogą
+                                 *   wykonać ruch, lub @ref SNAPSHOT_FREE_UNKNOWN,
+                                 *   jeżeli obwód gracza nie był aktualny
+                                 *   w chwili publikacji; wtedy wyznacza ją
+                                 *   pierwszy czytelnik, który o nią zapyta. */
+    uint32_t *areas_num;        /**< Liczby obszarów zajętych przez graczy. */
+    _Atomic uint8_t *golden_possible; /**< Możliwość wykonania złotego ruchu
+                                 *   przez graczy, jedna z wartości
+                                 *   @ref SNAPSHOT_GOLDEN_UNKNOWN,
+                                 *   @ref SNAPSHOT_GOLDEN_NO oraz
+                                 *   @ref SNAPSHOT_GOLDEN_YES, wyznaczana przez
+                                 *   pierwszego czytelnika, który o nią zapyta,
+                                 *   jeżeli nie wynikała ze statystyk gry. */
+    snapshot_tile_t **tiles;    /**< Tablica kafelków planszy zapisana
+                                 *   wierszami. */
+    uint64_t tiles_count;       /**< Liczba kafelków planszy. */
+    gamma_snapshot_t *next;     /**< Następna migawka na liście migawek
+                                 *   zastąpionych nowszą migawką. */
+};
+
+/** @brief Zwalnia migawkę.
+ * Zmniejsza liczniki migawek zawierających kafelki zwalnianej migawki, zwalniając
+ * kafelki, których nie zawiera już żadna migawka.
+ * @param[in,out] s – wskaźnik na migawkę.
+ */
+static void snapshot_free(gamma_snapshot_t *s) {
+    if (s->tiles != NULL) {
+        for (uint64_t i = 0; i < s->tiles_count; i++) {
+            if (s->tiles[i] != NULL && --s->tiles[i]->refs == 0) {
+                free(s->tiles[i]);
+            }
+        }
+    }
+
+    free(s->tiles);
+    free(s->busy_fields);
+    free((void *) s->free_fields);
+    free(s->areas_num);
+    free(s->golden_possible);
+    free(s);
+}
+
+/** @brief Zwalnia migawki, z których nie korzysta żaden czytelnik.
+ * Zwalnia migawki z listy migawek zastąpionych nowszą migawką, jeżeli żaden
+ * czytelnik nie jest w trakcie pobierania migawki i żaden z nich nie
+ * korzysta.
+ * @param[in,out] g – wskaźnik na strukturę przechowującą stan gry.
+ */
+static void snapshots_reclaim(gamma_t *g) {
+    if (atomic_load(&g->snapshot_readers) == 0) {
+        gamma_snapshot_t **prev = &g->retired;
+
+        while (*prev != NULL) {
+            gamma_snapshot_t *s = *prev;
+
+            if (atomic_load(&s->refs) == 0) {
+                *prev = s->next;
+                snapshot_free(s);
+            }
+            else {
+                prev = &s->next;
+            }
+        }
+    }
+}
+
+/** @brief Zwalnia wszystkie migawki.
+ * Zakłada, że żaden czytelnik nie korzysta już z migawek.
+ * @param[in,out] g – wskaźnik na strukturę przechowującą stan gry.
+ */
+static void snapshots_delete(gamma_t *g) {
+    gamma_snapshot_t *s = atomic_load(&g->snapshot);
+
+    if (s != NULL) {
+        snapshot_free(s);
+    }
+
+    while (g->retired != NULL) {
+        s = g->retired;
+        g->retired = s->next;
+        snapshot_free(s);
+    }
+
+    free(g->dirty_tiles);
+}
+
+/** @brief Kopiuje kafelek planszy.
+ * @param[in] g  – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in] tx – numer kolumny kafelka,
+ * @param[in] ty – numer wiersza kafelka.
+ * @return Wskaźnik na nowy kafelek zawierający właścicieli pól planszy lub NULL,
+ * jeżeli nie udało się zaalokować pamięci.
+ */
+static snapshot_tile_t *snapshot_tile_new(gamma_t *g, uint32_t tx, uint32_t ty) {
+    snapshot_tile_t *tile = calloc(1, sizeof(snapshot_tile_t));
+
+    if (tile != NULL) {
+        uint32_t x0 = tx * SNAPSHOT_TILE, y0 = ty * SNAPSHOT_TILE;
+
+        tile->refs = 1;
+
+        for (uint32_t dy = 0; dy < SNAPSHOT_TILE && y0 + dy < g->height; dy++) {
+            for (uint32_t dx = 0; dx < SNAPSHOT_TILE && x0 + dx < g->width; dx++) {
+                player_t *owner = field_owner(&g->board[y0 + dy][x0 + dx]);
+
+                tile->owners[dy * SNAPSHOT_TILE + dx] =
+                    owner == NULL ? 0 : player_number(owner);
+            }
+        }
+    }
+
+    return tile;
+}
+
+/** @brief Podaje możliwość wykonania złotego ruchu zapisywaną w migawce.
+ * Korzysta z zapamiętanego wyniku funkcji @ref gamma_golden_possible, jeżeli jest
+ * aktualny, lub ze statystyk gry, a w przeciwnym przypadku pozostawia wyznaczenie
+ * tej możliwości pierwszemu czytelnikowi, który o nią zapyta.
+ * @param[in] g – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in] p – wskaźnik na strukturę przechowującą stan gracza.
+ * @return Wartość @ref SNAPSHOT_GOLDEN_YES, @ref SNAPSHOT_GOLDEN_NO lub
+ * @ref SNAPSHOT_GOLDEN_UNKNOWN.
+ */
+static uint8_t snapshot_golden_state(gamma_t *g, player_t *p) {
+    bool possible = false;
+
+    if (player_golden_memo_valid(p, memo_stamp(g))) {
+        return player_golden_memo(p) ? SNAPSHOT_GOLDEN_YES : SNAPSHOT_GOLDEN_NO;
+    }
+    else if (golden_possible_known(g, p, &possible)) {
+        return possible ? SNAPSHOT_GOLDEN_YES : SNAPSHOT_GOLDEN_NO;
+    }
+    else {
+        return SNAPSHOT_GOLDEN_UNKNOWN;
+    }
+}
+
+/** @brief Podaje liczbę pól, na których gracz może wykonać ruch, zapisywaną
+ * w migawce.
+ * Korzysta z zapamiętanego wyniku funkcji @ref gamma_free_fields, jeżeli jest
+ * aktualny, z liczby wolnych pól planszy lub z obwodu gracza, o ile jest
+ * aktualny, a w przeciwnym przypadku pozostawia wyznaczenie tej liczby
+ * pierwszemu czytelnikowi, który o nią zapyta. Nie uaktualnia obwodów graczy.
+ * @param[in] g – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in] p – wskaźnik na strukturę przechowującą stan gracza.
+ * @return Liczba pól, na których gracz może wykonać ruch, lub
+ * @ref SNAPSHOT_FREE_UNKNOWN.
+ */
+static uint64_t snapshot_free_state(gamma_t *g, player_t *p) {
+    if (player_free_memo_valid(p, memo_stamp(g))) {
+        return player_free_memo(p);
+    }
+    else if (player_areas(p) < g->areas) {
+        return (uint64_t) g->width * g->height - g->busy_fields;
+    }
+    else if (g->policy == GAMMA_POLICY_EAGER || g->books_version == g->version) {
+        return player_perimeter(p);
+    }
+    else {
+        return SNAPSHOT_FREE_UNKNOWN;
+    }
+}
+
+/** @brief Tworzy migawkę bieżącego stanu gry.
+ * Współdzieli z migawką @p prev kafelki niezmienione od jej publikacji.
+ * @param[in,out] g – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in] prev  – wskaźnik na ostatnio opublikowaną migawkę lub NULL.
+ * @return Wskaźnik na nową migawkę lub NULL, jeżeli nie udało się zaalokować
+ * pamięci.
+ */
+static gamma_snapshot_t *snapshot_new(gamma_t *g, gamma_snapshot_t *prev) {
+    gamma_snapshot_t *s = calloc(1, sizeof(gamma_snapshot_t));
+
+    if (s == NULL) {
+        return NULL;
+    }
+
+    atomic_init(&s->refs, 0);
+    s->version = g->version;
+    s->width = g->width;
+    s->height = g->height;
+    s->players = g->players;
+    s->areas = g->areas;
+    s->board_field_width = g->board_field_width;
+    s->tiles_x = g->tiles_x;
+    s->tiles_count = (uint64_t) g->tiles_x * g->tiles_y;
+    s->busy_fields = malloc(((uint64_t) g->players + 1) * sizeof(uint64_t));
+    s->free_fields = malloc(((uint64_t) g->players + 1) * sizeof(_Atomic uint64_t));
+    s->areas_num = malloc(((uint64_t) g->players + 1) * sizeof(uint32_t));
+    s->golden_possible = malloc(((uint64_t) g->players + 1) * sizeof(_Atomic uint8_t));
+    s->tiles = calloc(s->tiles_count, sizeof(snapshot_tile_t *));
+
+    if (s->busy_fields == NULL || s->free_fields == NULL || s->areas_num == NULL
+        || s->golden_possible == NULL || s->tiles == NULL) {
+        snapshot_free(s);
+
+        return NULL;
+    }
+
+    for (uint64_t i = 0; i < s->tiles_count; i++) {
+        if (prev != NULL && !g->dirty_tiles[i]) {
+            s->tiles[i] = prev->tiles[i];
+            s->tiles[i]->refs++;
+        }
+        else if ((s->tiles[i] = snapshot_tile_new(g, (uint32_t) (i % g->tiles_x),
+                                                  (uint32_t) (i / g->tiles_x)))
+                 == NULL) {
+            snapshot_free(s);
+
+            return NULL;
+        }
+    }
+
+    for (uint32_t player = 0; player++ < g->players;) {
+        s->busy_fields[player] = gamma_busy_fields(g, player);
+        atomic_init(&s->free_fields[player],
+                    snapshot_free_state(g, &g->players_arr[player]));
+        s->areas_num[player] = player_areas(&g->players_arr[player]);
+        atomic_init(&s->golden_possible[player],
+                    snapshot_golden_state(g, &g->players_arr[player]));
+    }
+
+    return s;
+}
+
+/** @brief Publikuje migawkę bieżącego stanu gry.
+ * Tworzy migawkę, udostępnia ją czytelnikom w miejsce poprzedniej, dopisuje
+ * poprzednią migawkę do listy migawek zastąpionych nowszą migawką i zwalnia
+ * migawki, z których nie korzysta już żaden czytelnik.
+ * @param[in,out] g – wskaźnik na strukturę przechowującą stan gry.
+ * @return Wartość @p true, jeżeli opublikowano migawkę, a @p false, jeżeli nie
+ * udało się zaalokować pamięci.
+ */
+static bool snapshot_publish(gamma_t *g) {
+    if (g->dirty_tiles == NULL) {
+        g->dirty_tiles = calloc((uint64_t) g->tiles_x * g->tiles_y, sizeof(bool));
+
+        if (g->dirty_tiles == NULL) {
+            return false;
+        }
+    }
+
+    gamma_snapshot_t *prev = atomic_load(&g->snapshot);
+    gamma_snapshot_t *s = snapshot_new(g, prev);
+
+    if (s == NULL) {
+        return false;
+    }
+    else {
+        memset(g->dirty_tiles, 0,
+               (uint64_t) g->tiles_x * g->tiles_y * sizeof(bool));
+        atomic_store(&g->snapshot, s);
+
+        if (prev != NULL) {
+            prev->next = g->retired;
+            g->retired = prev;
+        }
+
+        snapshots_reclaim(g);
+
+        return true;
+    }
+}
+
+/** @brief Wypełnia bufor opisujący stan planszy w migawce.
+ * Zapisuje planszę w tym samym formacie co funkcja @ref gamma_board_fill.
+ * @param[in] s         – wskaźnik na migawkę,
+ * @param[in,out] board – wskaźnik na bufor mający przechowywać tekstowy opis
+ *                        stanu planszy.
+ */
+static void snapshot_board_fill(gamma_snapshot_t *s, char *board) {
+    uint64_t filled = 0;
+
+    for (int64_t y = s->height - 1; y >= 0; y--, filled++) {
+        for (uint32_t x = 0; x < s->width; x++) {
+            uint32_t owner = gamma_snapshot_field_owner(s, x, (uint32_t) y);
+            char repr[FIELD_MAX_WIDTH + 1];
+
+            if (owner == 0) {
+                sprintf(repr, "%*c", s->board_field_width, FREE_FIELD);
+            }
+            else {
+                sprintf(repr, "%*" PRIu32, s->board_field_width, owner);
+            }
+
+            memcpy(board + filled, repr, s->board_field_width);
+            filled += s->board_field_width;
+        }
+
+        board[filled] = '\n';
+    }
+
+    board[filled] = '\0';
+}
+
+/** @brief Podaje numer gracza zajmującego pole w migawce.
+ * @param[in] s – wskaźnik na migawkę,
+ * @param[in] x – numer kolumny, liczba nieujemna mniejsza od szerokości planszy,
+ * @param[in] y – numer wiersza, liczba nieujemna mniejsza od wysokości planszy.
+ * @return Numer gracza zajmującego pole (@p x, @p y) lub 0 dla wolnego pola.
+ */
+static inline uint32_t snapshot_owner(gamma_snapshot_t *s, uint32_t x, uint32_t y) {
+    snapshot_tile_t *tile = s->tiles[(uint64_t) (y / SNAPSHOT_TILE) * s->tiles_x
+                                     + x / SNAPSHOT_TILE];
+
+    return tile->owners[(y % SNAPSHOT_TILE) * SNAPSHOT_TILE + x % SNAPSHOT_TILE];
+}
+
+/** @brief Podaje numer sąsiada pola w migawce.
+ * @param[in] s    – wskaźnik na migawkę,
+ * @param[in] i    – numer pola, równy @p y * szerokość planszy + @p x,
+ * @param[in] dir  – numer kierunku, liczba nieujemna mniejsza od
+ *                   @p MAX_NEIGHBOURS,
+ * @param[out] n   – numer sąsiada pola w kierunku @p dir.
+ * @return Wartość @p true, jeżeli sąsiad leży na planszy, a @p false
+ * w przeciwnym przypadku.
+ */
+static inline bool snapshot_neighbour(gamma_snapshot_t *s, uint64_t i,
+                                      unsigned dir, uint64_t *n) {
+    int64_t x = (int64_t) (i % s->width) + NEIGHBOUR_DX[dir];
+    int64_t y = (int64_t) (i / s->width) + NEIGHBOUR_DY[dir];
+
+    if (x < 0 || x >= s->width || y < 0 || y >= s->height) {
+        return false;
+    }
+    else {
+        *n = (uint64_t) y * s->width + (uint64_t) x;
+
+        return true;
+    }
+}
+
+/** @brief Podaje numer gracza zajmującego pole o danym numerze w migawce.
+ * @param[in] s – wskaźnik na migawkę,
+ * @param[in] i – numer pola, równy @p y * szerokość planszy + @p x.
+ * @return Numer gracza zajmującego pole lub 0 dla wolnego pola.
+ */
+static inline uint32_t snapshot_index_owner(gamma_snapshot_t *s, uint64_t i) {
+    return snapshot_owner(s, (uint32_t) (i % s->width), (uint32_t) (i / s->width));
+}
+
+/** @brief Zlicza sąsiadów pola zajętych przez gracza w migawce.
+ * @param[in] s      – wskaźnik na migawkę,
+ * @param[in] i      – numer pola, równy @p y * szerokość planszy + @p x,
+ * @param[in] player – numer gracza.
+ * @return Liczba pól sąsiadujących z polem o numerze @p i zajętych przez gracza
+ * @p player.
+ */
+static unsigned snapshot_owned_neighbours(gamma_snapshot_t *s, uint64_t i,
+                                          uint32_t player) {
+    unsigned count = 0;
+    uint64_t n = 0;
+
+    for (unsigned dir = 0; dir < MAX_NEIGHBOURS; dir++) {
+        count += snapshot_neighbour(s, i, dir, &n)
+                 && snapshot_index_owner(s, n) == player;
+    }
+
+    return count;
+}
+
+/** @brief Podaje maskę sąsiadów pola migawki zajętych przez jego właściciela.
+ * Wyznacza dla pola migawki wartość odpowiadającą @ref field::same.
+ * @param[in] board – wskaźnik na migawkę,
+ * @param[in] i     – numer zajętego pola.
+ * @return Maska sąsiadów pola o numerze @p i zajętych przez jego właściciela.
+ */
+static uint8_t snapshot_same_mask(void *board, uint64_t i) {
+    gamma_snapshot_t *s = board;
+    uint32_t owner = snapshot_index_owner(s, i);
+    uint8_t same = 0;
+    uint64_t n = 0;
+
+    for (unsigned dir = 0; dir < MAX_NEIGHBOURS; dir++) {
+        if (snapshot_neighbour(s, i, dir, &n) && snapshot_index_owner(s, n) == owner) {
+            same |= FIELD_DIR_BIT(dir);
+        }
+    }
+
+    return same;
+}
+
+/** @brief Sprawdza, czy gracz mógł wykonać złoty ruch, na podstawie migawki.
+ * Przegląda pola migawki tak jak funkcja @ref golden_possible_compute przegląda
+ * planszę. Zakłada, że gracz nie wykonał złotego ruchu, zajmował maksymalną
+ * liczbę obszarów, a inni gracze zajmowali co najmniej jedno pole, czyli że
+ * wyniku nie dało się wyznaczyć ze statystyk gry. Nie modyfikuje migawki.
+ * @param[in] s          – wskaźnik na migawkę,
+ * @param[in] player     – numer gracza,
+ * @param[out] possible  – wartość @p true, jeżeli gracz mógł wykonać złoty ruch,
+ *                         a @p false w przeciwnym przypadku.
+ * @return Wartość @p true, jeżeli wyznaczono wartość @p possible, a @p false,
+ * jeżeli nie udało się zaalokować pamięci.
+ */
+static bool snapshot_golden_compute(gamma_snapshot_t *s, uint32_t player,
+                                    bool *possible) {
+    uint64_t cells = (uint64_t) s->width * s->height;
+    board_view_t view = {s, s->width, cells, snapshot_same_mask};
+    golden_scratch_t sc = {NULL, NULL, 0};
+    bool ok = true;
+
+    *possible = false;
+
+    for (uint64_t i = 0; i < cells && ok && !*possible; i++) {
+        uint32_t victim = snapshot_index_owner(s, i);
+
+        if (victim != 0 && victim != player
+            && snapshot_owned_neighbours(s, i, player) > 0) {
+
+            unsigned neighbours = snapshot_owned_neighbours(s, i, victim);
+            unsigned components = 0;
+
+            if (neighbours <= 1
+                || (uint64_t) s->areas_num[victim] + neighbours - 1 <= s->areas) {
+                *possible = true;
+            }
+            else if (!golden_scratch_components(&view, &sc, i, &components)) {
+                ok = false;
+            }
+            else {
+                *possible = (uint64_t) s->areas_num[victim] - 1 + components
+                            <= s->areas;
+            }
+        }
+    }
+
+    free(sc.visited);
+    free(sc.queue);
+
+    return ok;
+}
+
+/** @brief Zlicza pola, na których gracz mógł wykonać ruch, na podstawie migawki.
+ * Zlicza wolne pola migawki sąsiadujące z polem gracza. Zakłada, że gracz
+ * zajmował maksymalną liczbę obszarów. Nie modyfikuje migawki.
+ * @param[in] s      – wskaźnik na migawkę,
+ * @param[in] player – numer gracza.
+ * @return Liczba wolnych pól migawki sąsiadujących z polem gracza @p player.
+ */
+static uint64_t snapshot_free_compute(gamma_snapshot_t *s, uint32_t player) {
+    uint64_t cells = (uint64_t) s->width * s->height;
+    uint64_t free_fields = 0;
+
+    for (uint64_t i = 0; i < cells; i++) {
+        free_fields += snapshot_index_owner(s, i) == 0
+                       && snapshot_owned_neighbours(s, i, player) > 0;
+    }
+
+    return free_fields;
+}
+
+///@}
+
+/** @name Interfejs
+ * Implementacja funkcji zadeklarowanych w pliku nagłówkowym gamma.
+ */
+///@{
+
+gamma_t *gamma_new(uint32_t width, uint32_t height,
+                   uint32_t players, uint32_t areas) {
+    return gamma_new_with_policy(width, height, players, areas, GAMMA_POLICY_EAGER);
+}
+
+gamma_t *gamma_new_with_policy(uint32_t width, uint32_t height,
+                               uint32_t players, uint32_t areas,
+                               gamma_policy_t policy) {
+    if (width == 0 || height == 0 || players == 0 || areas == 0) {
+        return NULL;
+    }
+    else if (policy != GAMMA_POLICY_EAGER && policy != GAMMA_POLICY_LAZY) {
+        return NULL;
+    }
+    else {
+        gamma_t *g = malloc(sizeof(gamma_t));
+
+        if (g == NULL) {
+            return NULL;
+        }
+        else if (gamma_init(g, width, height, players, areas, policy)) {
+            return g;
+        }
+        else {
+            gamma_delete(g);
+
+            return NULL;
+        }
+    }
+}
+
+void gamma_delete(gamma_t *g) {
+    if (g != NULL) {
+        if (g->board != NULL) {
+            if (g->players_arr != NULL) {
+                for (uint32_t player = 0; player++ < g->players;) {
+                    free(player_perimeter_fields(&g->players_arr[player]));
+                    free(player_watchers(&g->players_arr[player]));
+                }
+            }
+
+            board_remove_rows(g->board, g->height);
+            free(g->board);
+            free(g->players_arr);
+        }
+
+        for (uint32_t i = 0; i < g->area_chunks_num; i++) {
+            for (uint64_t j = 0; j < area_chunk_size(i); j++) {
+                area_invalidate_cuts(&g->area_chunks[i][j]);
+            }
+
+            free(g->area_chunks[i]);
+        }
+
+        free(g->area_chunks);
+        free(g->dfs_stack);
+        free(g->books_log);
+        golden_pool_delete(g);
+        gamma_drop_index(g);
+        free(g->dirty_players);
+        free(g->dependent_players);
+        snapshots_delete(g);
+
+        free(g);
+    }
+}
+
+bool gamma_move(gamma_t *g, uint32_t player, uint32_t x, uint32_t y) {
+    if (g == NULL || !valid_player(g, player)) {
+        return false;
+    }
+    else if (!player_move_legal(g, &g->players_arr[player], x, y)) {
+        return false;
+    }
+    else if (!area_pool_reserve(g, 1)) {
+        return false;
+    }
+    else if (g->policy == GAMMA_POLICY_EAGER && g->indexed
+             && !perimeter_reserve(&g->players_arr[player],
+                                player_perimeter(&g->players_arr[player])
+                                + MAX_NEIGHBOURS)) {
+        return false;
+    }
+    else {
+        gamma_move_update(g, player, x, y);
+
+        return true;
+    }
+}
+
+bool gamma_golden_possible(gamma_t *g, uint32_t player) {
+    if (g == NULL || !valid_player(g, player)) {
+        return false;
+    }
+    else {
+        player_t *p = &g->players_arr[player];
+
+        if (!player_golden_memo_valid(p, memo_stamp(g))) {
+            player_set_golden_memo(p, memo_stamp(g), golden_possible_compute(g, p));
+        }
+
+        return player_golden_memo(p);
+    }
+}
+
+bool gamma_golden_move(gamma_t *g, uint32_t player, uint32_t x, uint32_t y) {
+    if (g == NULL || !valid_player(g, player)) {
+        return false;
+    }
+    else if (!golden_move_legal(g, player, x, y)) {
+        return false;
+    }
+    else if (!area_pool_reserve(g, MAX_NEIGHBOURS + 1)) {
+        return false;
+    }
+    else if (g->policy == GAMMA_POLICY_EAGER && g->indexed
+             && !perimeter_reserve(&g->players_arr[player],
+                                player_perimeter(&g->players_arr[player])
+                                + MAX_NEIGHBOURS)) {
+        return false;
+    }
+    else {
+        gamma_golden_move_update(g, player, x, y);
+
+        return true;
+    }
+}
+
+uint64_t gamma_busy_fields(gamma_t *g, uint32_t player) {
+    if (g == NULL || !valid_player(g, player)) {
+        return 0;
+    }
+    else {
+        return player_busy_fields(&g->players_arr[player]);
+    }
+}
+
+uint64_t gamma_free_fields(gamma_t *g, uint32_t player) {
+    if (g == NULL || !valid_player(g, player)) {
+        return 0;
+    }
+    else {
+        player_t *p = &g->players_arr[player];
+
+        if (player_free_memo_valid(p, memo_stamp(g))) {
+            return player_free_memo(p);
+        }
+        else if (player_areas(p) < g->areas) {
+            player_set_free_memo(p, memo_stamp(g), (uint64_t) g->width
+                                 * (uint64_t) g->height - g->busy_fields);
+        }
+        else if (!gamma_sync_books(g, false)) {
+            return 0;
+        }
+        else {
+            player_set_free_memo(p, memo_stamp(g), player_perimeter(p));
+        }
+
+        return player_free_memo(p);
+    }
+}
+
+char *gamma_board(gamma_t *g) {
+    if (g == NULL) {
+        return NULL;
+    }
+    else {
+        return gamma_board_new(g, (uint64_t) g->height * gamma_board_width(g) + 1);
+    }
+}
+
+uint64_t gamma_version(gamma_t *g) {
+    return g == NULL ? 0 : g->version;
+}
+
+uint32_t gamma_board_height(gamma_t *g) {
+    return g == NULL ? 0 : g->height;
+}
+
+uint64_t gamma_board_width(gamma_t *g) {
+    return g == NULL ? 0 : (uint64_t) g->width * (uint64_t) g->board_field_width + 1;
+}
+
+unsigned gamma_board_field_width(gamma_t *g) {
+    return g == NULL ? 0 : g->board_field_width;
+}
+
+uint32_t gamma_board_field_owner(gamma_t *g, uint32_t x, uint32_t y) {
+    if (g == NULL || !valid_x(g, x) || !valid_y(g, y)) {
+        return 0;
+    }
+    else {
+        player_t *owner = field_owner(&g->board[y][x]);
+
+        return owner == NULL ? 0 : player_number(owner);
+    }
+}
+
+void gamma_board_field_repr(gamma_t *g, uint32_t x, uint32_t y,
+                            char repr[FIELD_MAX_WIDTH + 1]) {
+    if (g != NULL && valid_x(g, x) && valid_y(g, y)) {
+        field_repr(&g->board[y][x], repr, g->board_field_width);
+    }
+}
 
-    if (g->board == NULL) {
+uint32_t gamma_players(gamma_t *g) {
+    return g == NULL ? 0 : g->players;
+}
+
+uint32_t gamma_width(gamma_t *g) {
+    return g == NULL ? 0 : g->width;
+}
+
+bool gamma_board_owners(gamma_t *g, uint32_t *owners) {
+    if (g == NULL || owners == NULL) {
         return false;
     }
     else {
-        g->players_arr = calloc(((uint64_t) players + 1), sizeof(player_t));
+        for (uint32_t y = 0; y < g->height; y++) {
+            for (uint32_t x = 0; x < g->width; x++) {
+                player_t *owner = field_owner(&g->board[y][x]);
 
-        if (g->players_arr == NULL) {
-            return false;
+                *owners++ = owner == NULL ? 0 : player_number(owner);
+            }
         }
-        else {
-            g->board_field_width = 0;
-            uint32_t mx_player = g->players;
 
-            while (mx_player > 0) {
-                g->board_field_width++;
-                mx_player /= 10;
-            }
+        return true;
+    }
+}
 
-            if (g->players >= 10) {
-                g->board_field_width++;
-            }
+bool gamma_same_area(gamma_t *g, uint32_t x1, uint32_t y1,
+                     uint32_t x2, uint32_t y2) {
+    if (g == NULL || !valid_busy_field(g, x1, y1) || !valid_busy_field(g, x2, y2)) {
+        return false;
+    }
+    else {
+        return area_find_root(&g->board[y1][x1]) == area_find_root(&g->board[y2][x2]);
+    }
+}
 
-            for (uint32_t y = 0; y < height; y++) {
-                for (uint32_t x = 0; x < width; x++) {
-                    field_init(&g->board[y][x], x, y);
-                }
-            }
+uint64_t gamma_max_busy_fields(gamma_t *g) {
+    if (g == NULL) {
+        return 0;
+    }
+    else {
+        uint64_t max_busy_fields = 0;
 
-            for (uint32_t player = 0; player++ < g->players;) {
-                player_init(&g->players_arr[player], player);
-            }
+        for (uint32_t player = 0; player++ < g->players;) {
+            uint64_t busy_fields = gamma_busy_fields(g, player);
 
-            return true;
+            if (busy_fields > max_busy_fields) {
+                max_busy_fields = busy_fields;
+            }
         }
+
+        return max_busy_fields;
     }
 }
 
 ///@}
 
-/** @name Interfejs
- * Implementacja funkcji zadeklarowanych w pliku nagłówkowym gamma.
- */
-///@{
+uint32_t gamma_player_areas(gamma_t *g, uint32_t player) {
+    if (g == NULL || !valid_player(g, player)) {
+        return 0;
+    }
+    else {
+        return player_areas(&g->players_arr[player]);
+    }
+}
 
-gamma_t *gamma_new(uint32_t width, uint32_t height,
-                   uint32_t players, uint32_t areas) {
-    if (width == 0 || height == 0 || players == 0 || areas == 0) {
-        return NULL;
+uint32_t gamma_player_areas_info(gamma_t *g, uint32_t player,
+                                 gamma_area_info_t *info, uint32_t len) {
+    if (g == NULL || !valid_player(g, player) || (info == NULL && len > 0)) {
+        return 0;
     }
     else {
-        gamma_t *g = malloc(sizeof(gamma_t));
+        player_t *p = &g->players_arr[player];
 
-        if (g == NULL) {
-            return NULL;
-        }
-        else if (gamma_init(g, width, height, players, areas)) {
-            return g;
-        }
-        else {
-            gamma_delete(g);
+        gamma_build_lists(g);
 
-            return NULL;
+        field_t *root = player_first_area(p);
+
+        for (uint32_t i = 0; i < len && root != NULL; i++) {
+            if (!area_fill_info(g, root, &info[i])) {
+                return 0;
+            }
+
+            root = area_next(field_area(root));
         }
+
+        return player_areas(p);
     }
 }
 
-void gamma_delete(gamma_t *g) {
-    if (g != NULL) {
-        if (g->board != NULL) {
-            board_remove_rows(g->board, g->height);
-            free(g->board);
-            free(g->players_arr);
+uint64_t gamma_legal_moves(gamma_t *g, uint32_t player,
+                           gamma_position_t *out, uint64_t cap) {
+    if (g == NULL || !valid_player(g, player) || (out == NULL && cap > 0)) {
+        return UINT64_MAX;
+    }
+    else if (!gamma_sync_books(g, true)) {
+        return UINT64_MAX;
+    }
+    else {
+        player_t *p = &g->players_arr[player];
+        field_t **fields = g->free_fields_arr;
+        uint64_t moves = (uint64_t) g->width * g->height - g->busy_fields;
+
+        if (player_areas(p) >= g->areas) {
+            fields = player_perimeter_fields(p);
+            moves = player_perimeter(p);
         }
 
-        free(g);
+        for (uint64_t i = 0; i < moves && i < cap; i++) {
+            out[i] = (gamma_position_t) {field_x(fields[i]), field_y(fields[i])};
+        }
+
+        return moves;
     }
 }
 
-bool gamma_move(gamma_t *g, uint32_t player, uint32_t x, uint32_t y) {
-    if (g == NULL || !valid_player(g, player)) {
-        return false;
+uint64_t gamma_legal_mask(gamma_t *g, uint32_t player, uint64_t *bitmap) {
+    if (g == NULL || bitmap == NULL) {
+        return UINT64_MAX;
     }
-    else if (!player_move_legal(g, &g->players_arr[player], x, y)) {
-        return false;
+    else if (!valid_player(g, player)) {
+        memset(bitmap, 0, ((uint64_t) g->width * g->height + 63) / 64
+                          * sizeof(uint64_t));
+
+        return UINT64_MAX;
     }
     else {
-        gamma_move_update(g, player, x, y);
+        player_t *p = &g->players_arr[player];
+        bool limited = player_areas(p) >= g->areas;
+        uint64_t moves = 0, word = 0, bit = 0;
 
-        return true;
+        for (uint32_t y = 0; y < g->height; y++) {
+            for (uint32_t x = 0; x < g->width; x++) {
+                field_t *f = &g->board[y][x];
+
+                if (field_owner(f) == NULL
+                    && (!limited || field_adjacent_to(g, f, p, 0))) {
+
+                    word |= UINT64_C(1) << (bit % 64);
+                    moves++;
+                }
+
+                if (++bit % 64 == 0) {
+                    bitmap[bit / 64 - 1] = word;
+                    word = 0;
+                }
+            }
+        }
+
+        if (bit % 64 != 0) {
+            bitmap[bit / 64] = word;
+        }
+
+        return moves;
     }
 }
 
-bool gamma_golden_possible(gamma_t *g, uint32_t player) {
-    if (g == NULL || !valid_player(g, player)) {
-        return false;
+uint64_t gamma_random_legal_move(gamma_t *g, uint32_t player, uint64_t *rng,
+                                 gamma_position_t *move) {
+    if (g == NULL || !valid_player(g, player) || rng == NULL || move == NULL) {
+        return UINT64_MAX;
+    }
+    else if (!gamma_sync_books(g, true)) {
+        return UINT64_MAX;
     }
     else {
         player_t *p = &g->players_arr[player];
+        field_t **fields = g->free_fields_arr;
+        uint64_t moves = (uint64_t) g->width * g->height - g->busy_fields;
 
-        if (!player_golden_possible(p) || player_busy_fields(p) == g->busy_fields) {
-            return false;
+        if (player_areas(p) >= g->areas) {
+            fields = player_perimeter_fields(p);
+            moves = player_perimeter(p);
         }
-        else if (player_areas(p) < g->areas) {
-            return true;
+
+        if (moves > 0) {
+            field_t *f = fields[rng_below(rng, moves)];
+            *move = (gamma_position_t) {field_x(f), field_y(f)};
         }
-        else {
-            for (uint32_t y = 0; y < g->height; y++) {
-                for (uint32_t x = 0; x < g->width; x++) {
-                    if (player_golden_move_legal(g, p, x, y)
-                        && victim_golden_move_legal(g, x, y)) {
 
-                        player_t *victim = field_owner(&g->board[y][x]);
-                        area_search(g, victim, x, y, UNCHECKED);
+        return moves;
+    }
+}
 
-                        return true;
+uint64_t gamma_golden_moves(gamma_t *g, uint32_t player,
+                            gamma_golden_move_t *out, uint64_t cap) {
+    if (g == NULL || !valid_player(g, player) || (out == NULL && cap > 0)) {
+        return 0;
+    }
+    else if (!player_golden_possible(&g->players_arr[player])) {
+        return 0;
+    }
+    else {
+        player_t *p = &g->players_arr[player];
+        uint64_t moves = 0;
+        gamma_golden_move_t move;
+
+        for (uint32_t y = 0; y < g->height; y++) {
+            for (uint32_t x = 0; x < g->width; x++) {
+                if (golden_move_describe(g, p, x, y, &move)) {
+                    if (moves < cap) {
+                        out[moves] = move;
                     }
+
+                    moves++;
                 }
             }
-
-            return false;
         }
+
+        return moves;
     }
 }
 
-bool gamma_golden_move(gamma_t *g, uint32_t player, uint32_t x, uint32_t y) {
-    if (g == NULL || !valid_player(g, player)) {
+bool gamma_random_golden_move(gamma_t *g, uint32_t player, uint64_t *rng,
+                              gamma_golden_move_t *move) {
+    if (g == NULL || !valid_player(g, player) || rng == NULL || move == NULL) {
         return false;
     }
     else if (!player_golden_possible(&g->players_arr[player])) {
         return false;
     }
-    else if (!valid_busy_field(g, x, y)) {
-        return false;
+    else {
+        player_t *p = &g->players_arr[player];
+        uint64_t moves = 0;
+        gamma_golden_move_t candidate;
+
+        for (uint32_t y = 0; y < g->height; y++) {
+            for (uint32_t x = 0; x < g->width; x++) {
+                if (golden_move_describe(g, p, x, y, &candidate)
+                    && rng_below(rng, ++moves) == 0) {
+
+                    *move = candidate;
+                }
+            }
+        }
+
+        return moves > 0;
     }
-    else if (!player_golden_move_legal(g, &g->players_arr[player], x, y)) {
+}
+
+bool gamma_move_check(gamma_t *g, uint32_t player, uint32_t x, uint32_t y,
+                      gamma_move_delta_t *delta) {
+    if (g == NULL || !valid_player(g, player)) {
         return false;
     }
-    else if (!victim_golden_move_legal(g, x, y)) {
+    else if (!player_move_legal(g, &g->players_arr[player], x, y)) {
         return false;
     }
     else {
-        gamma_golden_move_update(g, player, x, y);
+        if (delta != NULL) {
+            move_delta(g, &g->board[y][x], &g->players_arr[player], delta);
+        }
 
         return true;
     }
 }
 
-uint64_t gamma_busy_fields(gamma_t *g, uint32_t player) {
+bool gamma_golden_move_check(gamma_t *g, uint32_t player, uint32_t x, uint32_t y,
+                             gamma_move_delta_t *delta) {
     if (g == NULL || !valid_player(g, player)) {
-        return 0;
+        return false;
+    }
+    else if (!player_golden_possible(&g->players_arr[player])
+             || !valid_busy_field(g, x, y)
+             || !player_golden_move_legal(g, &g->players_arr[player], x, y)) {
+        return false;
     }
     else {
-        return player_busy_fields(&g->players_arr[player]);
+        field_t *f = &g->board[y][x];
+        golden_scratch_t s = {NULL, NULL, 0};
+        uint32_t victim_areas = 0;
+        bool ok = true, legal;
+
+        if (delta == NULL) {
+            legal = victim_golden_move_legal_scratch(g, &s, x, y, &ok);
+        }
+        else {
+            ok = victim_new_areas_scratch(g, &s, f, &victim_areas);
+            legal = ok && victim_areas <= g->areas;
+        }
+
+        free(s.visited);
+        free(s.queue);
+
+        if (legal && delta != NULL) {
+            golden_move_delta(g, f, &g->players_arr[player], victim_areas, delta);
+        }
+
+        return legal;
     }
 }
 
-uint64_t gamma_free_fields(gamma_t *g, uint32_t player) {
-    if (g == NULL || !valid_player(g, player)) {
+uint32_t gamma_next_active_player(gamma_t *g, uint32_t after) {
+    if (g == NULL || after > g->players) {
         return 0;
     }
     else {
-        player_t *p = &g->players_arr[player];
+        gamma_sync_active(g);
 
-        if (p == NULL || player_areas(p) < g->areas) {
-            return (uint64_t) g->width * (uint64_t) g->height - g->busy_fields;
+        if (g->active_players == 0) {
+            return 0;
         }
         else {
-            return player_perimeter(p);
+            return active_successor(g, after == 0 ? g->players : after);
         }
     }
 }
 
-char *gamma_board(gamma_t *g) {
+bool gamma_game_over(gamma_t *g) {
     if (g == NULL) {
-        return NULL;
+        return false;
     }
     else {
-        return gamma_board_new(g, (uint64_t) g->height * gamma_board_width(g) + 1);
+        gamma_sync_active(g);
+
+        return g->active_players == 0;
     }
 }
 
-uint32_t gamma_board_height(gamma_t *g) {
-    return g == NULL ? 0 : g->height;
+gamma_t *gamma_new_from_board(uint32_t width, uint32_t height,
+                              uint32_t players, uint32_t areas,
+                              const uint32_t *owners) {
+    if (owners == NULL) {
+        return NULL;
+    }
+    else {
+        for (uint64_t i = 0; i < (uint64_t) width * height; i++) {
+            if (owners[i] > players) {
+                return NULL;
+            }
+        }
+
+        gamma_t *g = gamma_new(width, height, players, areas);
+
+        if (g != NULL && !gamma_load_board(g, owners)) {
+            gamma_delete(g);
+
+            return NULL;
+        }
+        else {
+            return g;
+        }
+    }
 }
 
-uint64_t gamma_board_width(gamma_t *g) {
-    return g == NULL ? 0 : (uint64_t) g->width * (uint64_t) g->board_field_width + 1;
+uint64_t gamma_verify(gamma_t *g, unsigned threads) {
+    if (g == NULL) {
+        return UINT64_MAX;
+    }
+    else {
+        return gamma_audit(g, threads);
+    }
 }
 
-unsigned gamma_board_field_width(gamma_t *g) {
-    return g == NULL ? 0 : g->board_field_width;
+bool gamma_snapshot_publish(gamma_t *g) {
+    return g != NULL && snapshot_publish(g);
 }
 
-uint32_t gamma_board_field_owner(gamma_t *g, uint32_t x, uint32_t y) {
-    if (g == NULL || !valid_x(g, x) || !valid_y(g, y)) {
-        return 0;
+gamma_snapshot_t *gamma_snapshot_acquire(gamma_t *g) {
+    if (g == NULL) {
+        return NULL;
     }
     else {
-        player_t *owner = field_owner(&g->board[y][x]);
+        atomic_fetch_add(&g->snapshot_readers, 1);
 
-        return owner == NULL ? 0 : player_number(owner);
+        gamma_snapshot_t *s = atomic_load(&g->snapshot);
+
+        if (s != NULL) {
+            atomic_fetch_add(&s->refs, 1);
+        }
+
+        atomic_fetch_sub(&g->snapshot_readers, 1);
+
+        return s;
     }
 }
 
-void gamma_board_field_repr(gamma_t *g, uint32_t x, uint32_t y,
-                            char repr[FIELD_MAX_WIDTH + 1]) {
-    if (g != NULL && valid_x(g, x) && valid_y(g, y)) {
-        field_repr(&g->board[y][x], repr, g->board_field_width);
+void gamma_snapshot_release(gamma_snapshot_t *s) {
+    if (s != NULL) {
+        atomic_fetch_sub(&s->refs, 1);
     }
 }
 
-uint32_t gamma_players(gamma_t *g) {
-    return g == NULL ? 0 : g->players;
+uint64_t gamma_snapshot_version(gamma_snapshot_t *s) {
+    return s == NULL ? 0 : s->version;
 }
 
-uint64_t gamma_max_busy_fields(gamma_t *g) {
-    if (g == NULL) {
+uint64_t gamma_snapshot_busy_fields(gamma_snapshot_t *s, uint32_t player) {
+    return s == NULL || player == 0 || player > s->players
+           ? 0 : s->busy_fields[player];
+}
+
+uint64_t gamma_snapshot_free_fields(gamma_snapshot_t *s, uint32_t player) {
+    if (s == NULL || player == 0 || player > s->players) {
         return 0;
     }
     else {
-        uint64_t max_busy_fields = 0;
+        uint64_t free_fields = atomic_load(&s->free_fields[player]);
 
-        for (uint32_t player = 0; player++ < g->players;) {
-            uint64_t busy_fields = gamma_busy_fields(g, player);
+        if (free_fields == SNAPSHOT_FREE_UNKNOWN) {
+            free_fields = snapshot_free_compute(s, player);
+            atomic_store(&s->free_fields[player], free_fields);
+        }
 
-            if (busy_fields > max_busy_fields) {
-                max_busy_fields = busy_fields;
-            }
+        return free_fields;
+    }
+}
+
+bool gamma_snapshot_golden_possible(gamma_snapshot_t *s, uint32_t player) {
+    if (s == NULL || player == 0 || player > s->players) {
+        return false;
+    }
+    else {
+        uint8_t state = atomic_load(&s->golden_possible[player]);
+        bool possible = false;
+
+        if (state != SNAPSHOT_GOLDEN_UNKNOWN) {
+            return state == SNAPSHOT_GOLDEN_YES;
         }
+        else if (!snapshot_golden_compute(s, player, &possible)) {
+            return false;
+        }
+        else {
+            atomic_store(&s->golden_possible[player],
+                         possible ? SNAPSHOT_GOLDEN_YES : SNAPSHOT_GOLDEN_NO);
 
-        return max_busy_fields;
+            return possible;
+        }
     }
 }
 
-///@}
+uint32_t gamma_snapshot_field_owner(gamma_snapshot_t *s, uint32_t x, uint32_t y) {
+    if (s == NULL || x >= s->width || y >= s->height) {
+        return 0;
+    }
+    else {
+        return snapshot_owner(s, x, y);
+    }
+}
+
+char *gamma_snapshot_board(gamma_snapshot_t *s) {
+    if (s == NULL) {
+        return NULL;
+    }
+    else {
+        uint64_t width = (uint64_t) s->width * s->board_field_width + 1;
+        char *board = calloc((uint64_t) s->height * width + 1, sizeof(char));
+
+        if (board != NULL) {
+            snapshot_board_fill(s, board);
+        }
+
+        return board;
+    }
+}
@@ -20,9 +20,123 @@
  */
 typedef struct gamma gamma_t;
 
+/**
+ * Typ struktury przechowującej niezmienną migawkę stanu gry.
+ */
+typedef struct gamma_snapshot gamma_snapshot_t;
+
+/**
+ * Typ wyliczeniowy określający sposób utrzymywania statystyk graczy.
+ */
+typedef enum gamma_policy gamma_policy_t;
+
+/**
+ * Wyliczenie określające sposób utrzymywania statystyk graczy.
+ */
+enum gamma_policy {
+    GAMMA_POLICY_EAGER, /**< Obwody graczy, zbiory pól oraz liczby wolnych sąsiadów
+                         *   obszarów są aktualizowane przy każdym ruchu. */
+    GAMMA_POLICY_LAZY   /**< Ruch aktualizuje tylko właścicieli pól oraz obszary,
+                         *   a pozostałe statystyki są wyznaczane przeglądaniem
+                         *   planszy przy pierwszym zapytaniu po ruchu. */
+};
+
+/**
+ * Typ struktury przechowującej opis obszaru zajętego przez gracza.
+ */
+typedef struct gamma_area_info gamma_area_info_t;
+
+/**
+ * Struktura przechowująca opis obszaru zajętego przez gracza.
+ */
+struct gamma_area_info {
+    uint32_t x;         /**< Numer kolumny pola reprezentującego obszar. */
+    uint32_t y;         /**< Numer wiersza pola reprezentującego obszar. */
+    uint64_t size;      /**< Liczba pól obszaru. */
+    uint32_t min_x;     /**< Najmniejszy numer kolumny pola obszaru. */
+    uint32_t min_y;     /**< Najmniejszy numer wiersza pola obszaru. */
+    uint32_t max_x;     /**< Największy numer kolumny pola obszaru. */
+    uint32_t max_y;     /**< Największy numer wiersza pola obszaru. */
+    uint64_t liberties; /**< Liczba wolnych pól sąsiadujących z obszarem. */
+};
+
+/**
+ * Typ struktury przechowującej współrzędne pola.
+ */
+typedef struct gamma_position gamma_position_t;
+
+/**
+ * Struktura przechowująca współrzędne pola.
+ */
+struct gamma_position {
+    uint32_t x; /**< Numer kolumny pola. */
+    uint32_t y; /**< Numer wiersza pola. */
+};
+
+/**
+ * Typ struktury przechowującej opis złotego ruchu.
+ */
+typedef struct gamma_golden_move gamma_golden_move_t;
+
+/**
+ * Struktura przechowująca opis złotego ruchu.
+ */
+struct gamma_golden_move {
+    uint32_t x;            /**< Numer kolumny pola, na które można wykonać
+                            *   złoty ruch. */
+    uint32_t y;            /**< Numer wiersza pola, na które można wykonać
+                            *   złoty ruch. */
+    uint32_t victim;       /**< Numer gracza zajmującego to pole. */
+    uint32_t victim_areas; /**< Liczba obszarów, jakie będzie zajmować gracz
+                            *   @p victim po wykonaniu złotego ruchu. */
+};
+
+/**
+ * Maksymalna liczba graczy, których statystyki może zmienić jeden ruch: gracz
+ * wykonujący ruch oraz właściciele czterech pól sąsiadujących z polem ruchu.
+ */
+#define GAMMA_DELTA_MAX_PLAYERS 5
+
+/**
+ * Typ struktury przechowującej zmianę statystyk gracza w wyniku ruchu.
+ */
+typedef struct gamma_player_delta gamma_player_delta_t;
+
+/**
+ * Struktura przechowująca zmianę statystyk gracza w wyniku ruchu.
+ */
+struct gamma_player_delta {
+    uint32_t player;     /**< Numer gracza. */
+    int64_t busy_fields; /**< Zmiana liczby pól zajętych przez gracza. */
+    int64_t areas;       /**< Zmiana liczby obszarów zajętych przez gracza. */
+    int64_t perimeter;   /**< Zmiana liczby wolnych pól sąsiadujących z polami
+                          *   gracza. */
+};
+
+/**
+ * Typ struktury przechowującej skutki ruchu.
+ */
+typedef struct gamma_move_delta gamma_move_delta_t;
+
+/**
+ * Struktura przechowująca skutki ruchu.
+ */
+struct gamma_move_delta {
+    uint32_t players;    /**< Liczba graczy, których statystyki zmieniłby ruch,
+                          *   liczba nie większa od @p GAMMA_DELTA_MAX_PLAYERS. */
+    gamma_player_delta_t changes[GAMMA_DELTA_MAX_PLAYERS];
+                         /**< Zmiany statystyk graczy, zaczynając od gracza
+                          *   wykonującego ruch. */
+};
+
 /** @brief Tworzy strukturę przechowującą stan gry.
  * Alokuje pamięć na nową strukturę przechowującą stan gry.
  * Inicjuje tę strukturę tak, aby reprezentowała początkowy stan gry.
+ * Na platformie 64-bitowej stan gry zajmuje 32 bajty na pole planszy oraz
+ * 64 bajty na statystyki każdego obszaru, przydzielane tylko jego korzeniowi.
+ * Po pierwszym wyliczeniu legalnych ruchów zbiory pól zajmują dodatkowo 44 bajty
+ * na pole. Dla planszy o 100 milionach pól stan gry zajmuje więc około 3,2 GB,
+ * nie licząc statystyk obszarów.
  * @param[in] width   – szerokość planszy, liczba dodatnia,
  * @param[in] height  – wysokość planszy, liczba dodatnia,
  * @param[in] players – liczba graczy, liczba dodatnia,
@@ -34,6 +148,46 @@ typedef struct gamma gamma_t;
 gamma_t *gamma_new(uint32_t width, uint32_t height,
                    uint32_t players, uint32_t areas);
 
+/** @brief Tworzy strukturę przechowującą stan gry o wybranym sposobie
+ * utrzymywania statystyk graczy.
+ * Działa jak funkcja @ref gamma_new, pozwalając wybrać, czy obwody graczy, zbiory
+ * pól, na których gracze mogą wykonać ruch, oraz liczby wolnych sąsiadów obszarów
+ * mają być aktualizowane przy każdym ruchu, czy wyznaczane dopiero przy pierwszym
+ * zapytaniu po ruchu.
+ * @param[in] width   – szerokość planszy, liczba dodatnia,
+ * @param[in] height  – wysokość planszy, liczba dodatnia,
+ * @param[in] players – liczba graczy, liczba dodatnia,
+ * @param[in] areas   – maksymalna liczba obszarów,
+ *                      jakie może zająć jeden gracz, liczba dodatnia,
+ * @param[in] policy  – sposób utrzymywania statystyk graczy.
+ * @return Wskaźnik na utworzoną strukturę lub NULL, gdy nie udało się
+ * zaalokować pamięci lub któryś z parametrów jest niepoprawny.
+ */
+gamma_t *gamma_new_with_policy(uint32_t width, uint32_t height,
+                               uint32_t players, uint32_t areas,
+                               gamma_policy_t policy);
+
+/** @brief Tworzy strukturę przechowującą stan gry z macierzy właścicieli pól.
+ * Tworzy strukturę przechowującą stan gry, w którym pole (@p x, @p y) jest zajęte
+ * przez gracza o numerze @p owners[@p y * @p width + @p x] lub wolne, jeżeli ten
+ * numer jest równy 0. Buduje obszary, liczby zajętych pól i obszarów oraz obwody
+ * graczy w czasie liniowym względem rozmiaru planszy, dzieląc wyznaczanie
+ * obszarów dużych plansz między wątki. Każdy gracz może wykonać złoty ruch.
+ * @param[in] width   – szerokość planszy, liczba dodatnia,
+ * @param[in] height  – wysokość planszy, liczba dodatnia,
+ * @param[in] players – liczba graczy, liczba dodatnia,
+ * @param[in] areas   – maksymalna liczba obszarów,
+ *                      jakie może zająć jeden gracz, liczba dodatnia,
+ * @param[in] owners  – macierz numerów właścicieli pól o @p height wierszach
+ *                      i @p width kolumnach, zapisana wierszami.
+ * @return Wskaźnik na utworzoną strukturę lub NULL, gdy nie udało się
+ * zaalokować pamięci, któryś z parametrów jest niepoprawny lub któryś z graczy
+ * zajmuje więcej niż @p areas obszarów.
+ */
+gamma_t *gamma_new_from_board(uint32_t width, uint32_t height,
+                              uint32_t players, uint32_t areas,
+                              const uint32_t *owners);
+
 /** @brief Usuwa strukturę przechowującą stan gry.
  * Usuwa z pamięci strukturę wskazywaną przez @p g.
  * Nic nie robi, jeśli wskaźnik ten ma wartość NULL.
@@ -119,6 +273,16 @@ bool gamma_golden_possible(gamma_t *g, uint32_t player);
  */
 char *gamma_board(gamma_t *g);
 
+/** @brief Podaje wersję stanu gry.
+ * Wersja jest równa liczbie poprawnie wykonanych ruchów i złotych ruchów, więc
+ * rośnie przy każdej zmianie stanu gry i tylko wtedy. Wyniki funkcji
+ * @ref gamma_golden_possible oraz @ref gamma_free_fields są zapamiętywane
+ * i ponownie wyznaczane dopiero po zmianie wersji.
+ * @param[in] g       – wskaźnik na strukturę przechowującą stan gry.
+ * @return Wersja stanu gry lub 0, gdy wskaźnik @p g jest równy NULL.
+ */
+uint64_t gamma_version(gamma_t *g);
+
 /** @brief Podaje wysokość planszy w jej tekstowym opisie.
  * Podaje wysokość planszy w napisie otrzymywanym w wyniku wywołania funkcji
  * @ref gamma_board.
@@ -184,6 +348,43 @@ void gamma_board_field_repr(gamma_t *g, uint32_t x, uint32_t y,
  */
 uint32_t gamma_players(gamma_t *g);
 
+/** @brief Podaje szerokość planszy.
+ * @param[in] g       – wskaźnik na strukturę przechowującą stan gry.
+ * @return Liczba kolumn planszy, równa wartości @p width z funkcji
+ * @ref gamma_new, lub 0, gdy wskaźnik @p g jest równy NULL.
+ */
+uint32_t gamma_width(gamma_t *g);
+
+/** @brief Zapisuje macierz właścicieli pól.
+ * Zapisuje w tablicy @p owners, w indeksie @p y * @p width + @p x, numer gracza
+ * zajmującego pole (@p x, @p y) lub 0, jeżeli pole jest wolne. Zapisana macierz
+ * może zostać przekazana do funkcji @ref gamma_new_from_board.
+ * @param[in] g       – wskaźnik na strukturę przechowującą stan gry,
+ * @param[out] owners – tablica o długości co najmniej @p width * @p height.
+ * @return Wartość @p true, jeżeli zapisano macierz, a @p false, gdy któryś
+ * z parametrów jest równy NULL.
+ */
+bool gamma_board_owners(gamma_t *g, uint32_t *owners);
+
+/** @brief Sprawdza, czy dwa pola należą do tego samego obszaru.
+ * Sprawdza, czy pola (@p x1, @p y1) oraz (@p x2, @p y2) są zajęte przez tego
+ * samego gracza i należą do tego samego obszaru, odczytując korzenie ich obszarów
+ * ze struktury Find-Union, bez przeszukiwania planszy.
+ * @param[in,out] g   – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in] x1      – numer kolumny pierwszego pola, liczba nieujemna mniejsza
+ *                      od wartości @p width z funkcji @ref gamma_new,
+ * @param[in] y1      – numer wiersza pierwszego pola, liczba nieujemna mniejsza
+ *                      od wartości @p height z funkcji @ref gamma_new,
+ * @param[in] x2      – numer kolumny drugiego pola, liczba nieujemna mniejsza
+ *                      od wartości @p width z funkcji @ref gamma_new,
+ * @param[in] y2      – numer wiersza drugiego pola, liczba nieujemna mniejsza
+ *                      od wartości @p height z funkcji @ref gamma_new.
+ * @return Wartość @p true, jeżeli oba pola są zajęte i należą do tego samego
+ * obszaru, a @p false, gdy tak nie jest lub któryś z parametrów jest niepoprawny.
+ */
+bool gamma_same_area(gamma_t *g, uint32_t x1, uint32_t y1,
+                     uint32_t x2, uint32_t y2);
+
 /** @brief Podaje maksymalną liczbę pól zajętych przez jednego gracza.
  * Podaje maksymalną liczbę pól, jaka została zajęta przez jednego gracza.
  * @param[in] g       – wskaźnik na strukturę przechowującą stan gry.
@@ -192,4 +393,295 @@ uint32_t gamma_players(gamma_t *g);
  */
 uint64_t gamma_max_busy_fields(gamma_t *g);
 
+/** @brief Podaje liczbę obszarów zajętych przez gracza.
+ * @param[in] g       – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in] player  – numer gracza, liczba dodatnia niewiększa od wartości
+ *                      @p players z funkcji @ref gamma_new.
+ * @return Liczba obszarów zajętych przez gracza @p player lub 0,
+ * gdy któryś z parametrów jest niepoprawny.
+ */
+uint32_t gamma_player_areas(gamma_t *g, uint32_t player);
+
+/** @brief Podaje opisy obszarów zajętych przez gracza.
+ * Zapisuje w tablicy @p info opisy co najwyżej @p len obszarów zajętych przez
+ * gracza @p player, w nieokreślonej kolejności. Opisy są odczytywane ze statystyk
+ * przechowywanych w strukturze Find-Union, bez przeszukiwania planszy; jedynie
+ * liczba wolnych sąsiadów obszaru, który został połączony z innym lub podzielony
+ * od czasu jej ostatniego wyznaczenia, jest wyznaczana przeszukaniem tego obszaru.
+ * @param[in,out] g   – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in] player  – numer gracza, liczba dodatnia niewiększa od wartości
+ *                      @p players z funkcji @ref gamma_new,
+ * @param[out] info   – tablica o długości co najmniej @p len, w której mają
+ *                      zostać zapisane opisy obszarów,
+ * @param[in] len     – długość tablicy @p info.
+ * @return Liczba wszystkich obszarów zajętych przez gracza @p player, która może
+ * być większa od @p len, lub 0, gdy któryś z parametrów jest niepoprawny albo nie
+ * udało się zaalokować pamięci.
+ */
+uint32_t gamma_player_areas_info(gamma_t *g, uint32_t player,
+                                 gamma_area_info_t *info, uint32_t len);
+
+/** @brief Podaje pola, na których gracz może wykonać ruch.
+ * Zapisuje w tablicy @p out współrzędne co najwyżej @p cap pól, na których gracz
+ * @p player może postawić pionek zwykłym ruchem, w nieokreślonej kolejności.
+ * Pola są odczytywane ze zbioru wolnych pól planszy lub zbioru pól obwodu gracza,
+ * utrzymywanych przy każdym ruchu, bez przeglądania planszy.
+ * @param[in] g       – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in] player  – numer gracza, liczba dodatnia niewiększa od wartości
+ *                      @p players z funkcji @ref gamma_new,
+ * @param[out] out    – tablica o długości co najmniej @p cap, w której mają
+ *                      zostać zapisane współrzędne pól,
+ * @param[in] cap     – długość tablicy @p out.
+ * @return Liczba wszystkich pól, na których gracz @p player może wykonać ruch,
+ * równa wartości @ref gamma_free_fields i mogąca być większa od @p cap, lub
+ * @p UINT64_MAX, gdy któryś z parametrów jest niepoprawny albo nie udało się
+ * zaalokować pamięci na zbiory pól.
+ */
+uint64_t gamma_legal_moves(gamma_t *g, uint32_t player,
+                           gamma_position_t *out, uint64_t cap);
+
+/** @brief Zapisuje mapę bitową pól, na których gracz może wykonać ruch.
+ * Ustawia w tablicy @p bitmap bit o numerze @p y * @p width + @p x, licząc od
+ * najmłodszego bitu pierwszego słowa, dokładnie wtedy, gdy gracz @p player może
+ * postawić pionek zwykłym ruchem na polu (@p x, @p y). Pozostałe bity zeruje.
+ * Wyznacza kolejne słowa mapy wierszami planszy na podstawie właścicieli pól
+ * i masek ich zajętych sąsiadów, nie korzystając ze zbiorów pól i nie alokując
+ * pamięci, więc czas działania jest proporcjonalny do rozmiaru planszy.
+ * @param[in] g       – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in] player  – numer gracza, liczba dodatnia niewiększa od wartości
+ *                      @p players z funkcji @ref gamma_new,
+ * @param[out] bitmap – tablica co najmniej (@p width * @p height + 63) / 64 słów.
+ * @return Liczba ustawionych bitów, równa wartości @ref gamma_free_fields, lub
+ * @p UINT64_MAX, gdy któryś z parametrów jest niepoprawny. Jeżeli niepoprawny
+ * jest tylko numer gracza, zeruje całą tablicę @p bitmap.
+ */
+uint64_t gamma_legal_mask(gamma_t *g, uint32_t player, uint64_t *bitmap);
+
+/** @brief Losuje pole, na którym gracz może wykonać ruch.
+ * Losuje z rozkładem jednostajnym, w oczekiwanym czasie stałym, jedno z pól,
+ * na których gracz @p player może postawić pionek zwykłym ruchem.
+ * @param[in] g         – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in] player    – numer gracza, liczba dodatnia niewiększa od wartości
+ *                        @p players z funkcji @ref gamma_new,
+ * @param[in,out] rng   – wskaźnik na stan generatora liczb pseudolosowych
+ *                        xorshift64, aktualizowany przy każdym losowaniu,
+ * @param[out] move     – wskaźnik na strukturę, w której mają zostać zapisane
+ *                        współrzędne wylosowanego pola, jeżeli takie istnieje.
+ * @return Liczba pól, spośród których wylosowano pole, równa 0, gdy gracz nie
+ * może wykonać żadnego ruchu, lub @p UINT64_MAX, gdy któryś z parametrów jest
+ * niepoprawny albo nie udało się zaalokować pamięci na zbiory pól.
+ */
+uint64_t gamma_random_legal_move(gamma_t *g, uint32_t player, uint64_t *rng,
+                                 gamma_position_t *move);
+
+/** @brief Podaje wszystkie złote ruchy, które może wykonać gracz.
+ * Zapisuje w tablicy @p out opisy co najwyżej @p cap złotych ruchów, które może
+ * wykonać gracz @p player, w kolejności wierszy i kolumn planszy. Przegląda
+ * jeden raz wszystkie pola planszy, więc czas działania jest proporcjonalny do
+ * jej rozmiaru, nawet gdy złotych ruchów jest niewiele. Punkty artykulacji
+ * każdego obszaru ofiary wyznacza co najwyżej raz, wspólnie dla wszystkich pól
+ * tego obszaru.
+ * @param[in,out] g   – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in] player  – numer gracza, liczba dodatnia niewiększa od wartości
+ *                      @p players z funkcji @ref gamma_new,
+ * @param[out] out    – tablica o długości co najmniej @p cap, w której mają
+ *                      zostać zapisane opisy złotych ruchów,
+ * @param[in] cap     – długość tablicy @p out.
+ * @return Liczba wszystkich złotych ruchów, które może wykonać gracz @p player,
+ * mogąca być większa od @p cap, lub 0, gdy gracz wykonał już złoty ruch albo
+ * któryś z parametrów jest niepoprawny.
+ */
+uint64_t gamma_golden_moves(gamma_t *g, uint32_t player,
+                            gamma_golden_move_t *out, uint64_t cap);
+
+/** @brief Losuje złoty ruch, który może wykonać gracz.
+ * Losuje z rozkładem jednostajnym jeden ze złotych ruchów podawanych przez
+ * funkcję @ref gamma_golden_moves, przeglądając planszę jeden raz i nie alokując
+ * pamięci na ich listę: k-ty napotkany ruch zastępuje dotychczas wybrany
+ * z prawdopodobieństwem 1/k.
+ * @param[in,out] g     – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in] player    – numer gracza, liczba dodatnia niewiększa od wartości
+ *                        @p players z funkcji @ref gamma_new,
+ * @param[in,out] rng   – wskaźnik na stan generatora liczb pseudolosowych
+ *                        xorshift64, aktualizowany przy każdym losowaniu,
+ * @param[out] move     – wskaźnik na strukturę, w której ma zostać zapisany opis
+ *                        wylosowanego złotego ruchu.
+ * @return Wartość @p true, jeżeli wylosowano złoty ruch, a @p false, gdy gracz
+ * nie może wykonać złotego ruchu lub któryś z parametrów jest niepoprawny.
+ */
+bool gamma_random_golden_move(gamma_t *g, uint32_t player, uint64_t *rng,
+                              gamma_golden_move_t *move);
+
+/** @brief Sprawdza ruch bez jego wykonania.
+ * Sprawdza, czy gracz @p player może postawić pionek na polu (@p x, @p y),
+ * i jeżeli tak, zapisuje w strukturze wskazywanej przez @p delta zmiany statystyk
+ * gracza oraz każdego gracza, którego obwód by się zmniejszył. Nie zmienia stanu
+ * gry ani jego struktur pomocniczych, więc sprawdzenia mogą być wykonywane
+ * jednocześnie przez wiele wątków.
+ * @param[in] g       – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in] player  – numer gracza, liczba dodatnia niewiększa od wartości
+ *                      @p players z funkcji @ref gamma_new,
+ * @param[in] x       – numer kolumny, liczba nieujemna mniejsza od wartości
+ *                      @p width z funkcji @ref gamma_new,
+ * @param[in] y       – numer wiersza, liczba nieujemna mniejsza od wartości
+ *                      @p height z funkcji @ref gamma_new,
+ * @param[out] delta  – wskaźnik na strukturę, w której mają zostać zapisane
+ *                      skutki ruchu, lub NULL.
+ * @return Wartość @p true, jeżeli ruch jest legalny, a @p false, gdy ruch jest
+ * nielegalny lub któryś z parametrów jest niepoprawny.
+ */
+bool gamma_move_check(gamma_t *g, uint32_t player, uint32_t x, uint32_t y,
+                      gamma_move_delta_t *delta);
+
+/** @brief Sprawdza złoty ruch bez jego wykonania.
+ * Sprawdza, czy gracz @p player może wykonać złoty ruch na pole (@p x, @p y),
+ * i jeżeli tak, zapisuje w strukturze wskazywanej przez @p delta zmiany statystyk
+ * gracza oraz gracza tracącego pole. Nie zmienia stanu gry ani jego struktur
+ * pomocniczych, więc sprawdzenia mogą być wykonywane jednocześnie przez wiele
+ * wątków. Gdy punkty artykulacji obszaru ofiary nie są aktualne, przeszukuje
+ * ten obszar w pamięci alokowanej na czas wywołania.
+ * @param[in] g       – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in] player  – numer gracza, liczba dodatnia niewiększa od wartości
+ *                      @p players z funkcji @ref gamma_new,
+ * @param[in] x       – numer kolumny, liczba nieujemna mniejsza od wartości
+ *                      @p width z funkcji @ref gamma_new,
+ * @param[in] y       – numer wiersza, liczba nieujemna mniejsza od wartości
+ *                      @p height z funkcji @ref gamma_new,
+ * @param[out] delta  – wskaźnik na strukturę, w której mają zostać zapisane
+ *                      skutki złotego ruchu, lub NULL.
+ * @return Wartość @p true, jeżeli złoty ruch jest legalny, a @p false, gdy ruch
+ * jest nielegalny, któryś z parametrów jest niepoprawny lub nie udało się
+ * zaalokować pamięci.
+ */
+bool gamma_golden_move_check(gamma_t *g, uint32_t player, uint32_t x, uint32_t y,
+                             gamma_move_delta_t *delta);
+
+/** @brief Podaje następnego gracza, który może wykonać ruch.
+ * Podaje numer pierwszego gracza następującego cyklicznie po graczu @p after,
+ * który może wykonać ruch lub złoty ruch. Korzysta z listy aktywnych graczy
+ * aktualizowanej przy ruchach, więc nie sprawdza pozostałych graczy.
+ * @param[in,out] g   – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in] after   – numer gracza, po którym należy szukać, lub 0, aby szukać
+ *                      od gracza numer 1.
+ * @return Numer następnego gracza, który może wykonać ruch, równy @p after,
+ * jeżeli jest on jedynym takim graczem, lub 0, gdy żaden gracz nie może wykonać
+ * ruchu albo któryś z parametrów jest niepoprawny.
+ */
+uint32_t gamma_next_active_player(gamma_t *g, uint32_t after);
+
+/** @brief Sprawdza, czy gra się zakończyła.
+ * @param[in,out] g   – wskaźnik na strukturę przechowującą stan gry.
+ * @return Wartość @p true, jeżeli żaden gracz nie może wykonać ruchu ani złotego
+ * ruchu, a @p false w przeciwnym przypadku lub gdy wskaźnik @p g jest równy NULL.
+ */
+bool gamma_game_over(gamma_t *g);
+
+/** @brief Sprawdza zgodność stanu gry z planszą.
+ * Wyznacza od nowa, na podstawie samej planszy, liczby pól zajętych przez
+ * graczy, liczby ich obszarów i liczby wolnych pól sąsiadujących z ich polami,
+ * po czym porównuje je ze statystykami utrzymywanymi przez grę. Sprawdza także,
+ * czy każdy obszar ma dokładnie jeden korzeń, a rozmiary obszarów zapisane
+ * w korzeniach sumują się do liczb zajętych pól. Nie uaktualnia wcześniej
+ * obwodów graczy ani zbiorów pól, dlatego obwody i pozycje pól w zbiorach
+ * porównuje z planszą tylko wtedy, gdy są aktualne, czyli zawsze w trybie
+ * @ref GAMMA_POLICY_EAGER, a w trybie @ref GAMMA_POLICY_LAZY, jeżeli od
+ * zapytania, które je uaktualniło, nie wykonano ruchu. Dzieli planszę na pasy
+ * wierszy sprawdzane równolegle. Alokuje na czas działania tablicę etykiet
+ * o rozmiarze 8 bajtów na pole planszy.
+ * @param[in] g       – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in] threads – liczba wątków lub 0, jeżeli ma zostać dobrana
+ *                      automatycznie do rozmiaru planszy.
+ * @return Liczba wykrytych niezgodności, równa 0 dla poprawnego stanu gry, lub
+ * @p UINT64_MAX, gdy wskaźnik @p g jest równy NULL lub nie udało się
+ * zaalokować pamięci.
+ */
+uint64_t gamma_verify(gamma_t *g, unsigned threads);
+
+/** @brief Publikuje migawkę stanu gry.
+ * Tworzy niezmienną migawkę bieżącego stanu gry i udostępnia ją czytelnikom
+ * w miejsce poprzednio opublikowanej migawki. Kopiuje tylko kafelki planszy
+ * zmienione od poprzedniej publikacji i zwalnia zastąpione migawki, z których nie
+ * korzysta już żaden czytelnik. Nie uaktualnia obwodów graczy ani zbiorów pól,
+ * więc w trybie @ref GAMMA_POLICY_LAZY nie przegląda całej planszy. Może być
+ * wywoływana tylko przez wątek wykonujący ruchy, równolegle z funkcjami
+ * @ref gamma_snapshot_acquire, @ref gamma_snapshot_release oraz funkcjami
+ * odczytującymi migawki.
+ * @param[in,out] g   – wskaźnik na strukturę przechowującą stan gry.
+ * @return Wartość @p true, jeżeli opublikowano migawkę, a @p false, gdy wskaźnik
+ * @p g jest równy NULL lub nie udało się zaalokować pamięci.
+ */
+bool gamma_snapshot_publish(gamma_t *g);
+
+/** @brief Pobiera ostatnio opublikowaną migawkę stanu gry.
+ * Może być wywoływana równolegle przez wiele wątków, także w trakcie wykonywania
+ * ruchów, i nigdy nie czeka na inne wątki. Pobrana migawka pozostaje poprawna
+ * do czasu jej zwolnienia funkcją @ref gamma_snapshot_release.
+ * @param[in] g       – wskaźnik na strukturę przechowującą stan gry.
+ * @return Wskaźnik na migawkę lub NULL, gdy wskaźnik @p g jest równy NULL lub
+ * nie opublikowano jeszcze żadnej migawki.
+ */
+gamma_snapshot_t *gamma_snapshot_acquire(gamma_t *g);
+
+/** @brief Zwalnia pobraną migawkę stanu gry.
+ * @param[in] s       – wskaźnik na migawkę pobraną funkcją
+ *                      @ref gamma_snapshot_acquire lub NULL.
+ */
+void gamma_snapshot_release(gamma_snapshot_t *s);
+
+/** @brief Podaje numer stanu gry zapisanego w migawce.
+ * @param[in] s       – wskaźnik na migawkę.
+ * @return Liczba ruchów i złotych ruchów wykonanych przed publikacją migawki
+ * lub 0, gdy wskaźnik @p s jest równy NULL.
+ */
+uint64_t gamma_snapshot_version(gamma_snapshot_t *s);
+
+/** @brief Podaje liczbę pól zajętych przez gracza w migawce.
+ * @param[in] s       – wskaźnik na migawkę,
+ * @param[in] player  – numer gracza.
+ * @return Wartość funkcji @ref gamma_busy_fields w chwili publikacji migawki
+ * lub 0, gdy któryś z parametrów jest niepoprawny.
+ */
+uint64_t gamma_snapshot_busy_fields(gamma_snapshot_t *s, uint32_t player);
+
+/** @brief Podaje liczbę pól, na których gracz mógł wykonać ruch, w migawce.
+ * Jeżeli w chwili publikacji migawki obwód gracza nie był aktualny, pierwsze
+ * zapytanie o niego wyznacza tę liczbę, przeglądając planszę migawki.
+ * @param[in] s       – wskaźnik na migawkę,
+ * @param[in] player  – numer gracza.
+ * @return Wartość funkcji @ref gamma_free_fields w chwili publikacji migawki
+ * lub 0, gdy któryś z parametrów jest niepoprawny.
+ */
+uint64_t gamma_snapshot_free_fields(gamma_snapshot_t *s, uint32_t player);
+
+/** @brief Sprawdza, czy gracz mógł wykonać złoty ruch, w migawce.
+ * Publikacja migawki nie przegląda planszy. Jeżeli wynik nie był wtedy
+ * zapamiętany ani nie wynikał ze statystyk gry, wyznacza go pierwsze wywołanie
+ * tej funkcji, przeglądając planszę migawki, a kolejne korzystają z wyniku.
+ * @param[in] s       – wskaźnik na migawkę,
+ * @param[in] player  – numer gracza.
+ * @return Wartość funkcji @ref gamma_golden_possible w chwili publikacji migawki
+ * lub @p false, gdy któryś z parametrów jest niepoprawny albo nie udało się
+ * zaalokować pamięci.
+ */
+bool gamma_snapshot_golden_possible(gamma_snapshot_t *s, uint32_t player);
+
+/** @brief Podaje numer gracza zajmującego pole (@p x, @p y) w migawce.
+ * @param[in] s       – wskaźnik na migawkę,
+ * @param[in] x       – numer kolumny,
+ * @param[in] y       – numer wiersza.
+ * @return Numer gracza zajmującego pole (@p x, @p y) w chwili publikacji migawki
+ * lub zero, gdy pole było wolne albo któryś z parametrów jest niepoprawny.
+ */
+uint32_t gamma_snapshot_field_owner(gamma_snapshot_t *s, uint32_t x, uint32_t y);
+
+/** @brief Daje napis opisujący stan planszy w migawce.
+ * Alokuje w pamięci bufor, w którym umieszcza napis w formacie funkcji
+ * @ref gamma_board. Funkcja wywołująca musi zwolnić ten bufor.
+ * @param[in] s       – wskaźnik na migawkę.
+ * @return Wskaźnik na zaalokowany bufor zawierający napis opisujący stan planszy
+ * w chwili publikacji migawki lub NULL, jeżeli nie udało się zaalokować pamięci
+ * albo wskaźnik @p s jest równy NULL.
+ */
+char *gamma_snapshot_board(gamma_snapshot_t *s);
+
 #endif // GAMMA_H
@@ -0,0 +1,106 @@
+/** @file
+ * Program mierzący przepustowość zwykłych ruchów i zużycie pamięci gry gamma
+ *
+ * @author Szymon Czyżmański 417797
+ * @date 22.05.2020
+ */
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <time.h>
+#include <sys/resource.h>
+
+#include "gamma.h"
+#include "rng.h"
+
+/**
+ * Liczba argumentów wywołania programu, nie licząc jego nazwy.
+ */
+#define BENCH_ARGUMENTS_NUM 6
+
+/** @brief Podaje bieżący czas.
+ * @return Liczba nanosekund, które upłynęły od ustalonej chwili w przeszłości.
+ */
+static uint64_t bench_now(void) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint64_t) ts.tv_sec * 1000000000u + (uint64_t) ts.tv_nsec;
+}
+
+/** @brief Mierzy przepustowość zwykłych ruchów.
+ * Program wywołuje się z argumentami @p WIDTH @p HEIGHT @p PLAYERS @p AREAS
+ * @p MOVES @p SEED. Tworzy grę o podanych parametrach i wykonuje @p MOVES
+ * wywołań @ref gamma_move na losowych polach planszy, kolejno dla każdego
+ * gracza. Na standardowe wyjście wypisuje liczbę wywołań, liczbę udanych
+ * ruchów, czas tworzenia gry i czas ruchów w sekundach, liczbę wywołań na
+ * sekundę oraz maksymalny rozmiar zbioru roboczego procesu w kilobajtach.
+ * @param[in] argc – liczba argumentów wywołania programu,
+ * @param[in] argv – argumenty wywołania programu.
+ * @return Wartość @p EXIT_SUCCESS, jeśli pomiar się powiódł, a @p EXIT_FAILURE,
+ * jeżeli argumenty są niepoprawne lub nie udało się utworzyć gry.
+ */
+int main(int argc, char *argv[]) {
+    uint64_t arguments[BENCH_ARGUMENTS_NUM];
+    char *end = NULL;
+
+    for (int i = 0; i < BENCH_ARGUMENTS_NUM && i + 1 < argc; i++) {
+        arguments[i] = strtoull(argv[i + 1], &end, 10);
+
+        if (*end != '\0' || (i < 4 && (arguments[i] == 0
+                                       || arguments[i] > UINT32_MAX))) {
+            end = NULL;
+            break;
+        }
+    }
+
+    if (argc != BENCH_ARGUMENTS_NUM + 1 || end == NULL) {
+        fprintf(stderr, "Usage: %s WIDTH HEIGHT PLAYERS AREAS MOVES SEED\n",
+                argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    uint32_t width = (uint32_t) arguments[0];
+    uint32_t height = (uint32_t) arguments[1];
+    uint32_t players = (uint32_t) arguments[2];
+    uint64_t moves = arguments[4];
+    uint64_t rng = arguments[5];
+    uint64_t accepted = 0;
+
+    uint64_t start = bench_now();
+    gamma_t *g = gamma_new(width, height, players, (uint32_t) arguments[3]);
+
+    if (g == NULL) {
+        fprintf(stderr, "gamma_new failed\n");
+        return EXIT_FAILURE;
+    }
+
+    uint64_t created = bench_now();
+
+    for (uint64_t i = 0; i < moves; i++) {
+        uint64_t r = rng_next(&rng);
+        uint32_t x = (uint32_t) ((r & UINT32_MAX) % width);
+        uint32_t y = (uint32_t) ((r >> 32) % height);
+
+        accepted += gamma_move(g, (uint32_t) (i % players) + 1, x, y);
+    }
+
+    uint64_t finished = bench_now();
+    struct rusage usage;
+
+    getrusage(RUSAGE_SELF, &usage);
+    printf("moves %" PRIu64 " accepted %" PRIu64 " new %.3f s moves %.3f s"
+           " rate %.0f/s maxrss %ld KiB\n", moves, accepted,
+           (double) (created - start) / 1e9, (double) (finished - created) / 1e9,
+           (double) moves * 1e9 / (double) (finished - created + 1),
+           usage.ru_maxrss);
+
+    gamma_delete(g);
+
+    return EXIT_SUCCESS;
+}
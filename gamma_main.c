@@ -6,48 +6,49 @@
  */
 
 #include <stdlib.h>
+#include <string.h>
 
 #include "parser.h"
 #include "inter_mode.h"
+#include "bin_mode.h"
 
 /**
- * Początkowa długość bufora, do którego wpisywana jest linia pobierana
- * ze standardowego wejścia.
+ * Opcja wywołania programu włączająca potokowy tryb wsadowy.
  */
-#define INITIAL_BUFFER_SIZE 16
+#define PIPELINE_OPTION "--pipeline"
 
 /** @brief Rozpoczyna i kończy działanie programu
- * Alokuje pamięć na bufor przechowujący wczytywane linie, wczytuje dane ze
- * standardowego strumienia wejścia i uruchamia tryb wsadowy lub interaktywny.
- * Zwalnia pamięć po buforze i strukturze przechowującej stan gry.
+ * Wczytuje dane ze standardowego strumienia wejścia i uruchamia tryb wsadowy,
+ * interaktywny lub binarny. Zwalnia pamięć po strukturze przechowującej stan gry.
+ * Jeżeli program wywołano z opcją @ref PIPELINE_OPTION, tryb wsadowy działa
+ * potokowo.
+ * @param[in] argc – liczba argumentów wywołania programu,
+ * @param[in] argv – argumenty wywołania programu.
  * @return Wartość @p EXIT_SUCCESS, jeśli w trakcie działania programu nie wystąpił
  * żaden krytyczny błąd, a @p EXIT_FAILURE w przeciwnym przypadku.
  */
-int main() {
+int main(int argc, char *argv[]) {
     int exit_code = EXIT_SUCCESS;
-    char *line_buffer = malloc(INITIAL_BUFFER_SIZE * sizeof(char));
+    gamma_t *g = NULL;
+    input_mode_t mode = PENDING_MODE;
+    bool pipelined = argc > 1 && strcmp(argv[1], PIPELINE_OPTION) == 0;
 
-    if (line_buffer == NULL) {
+    if (!read_lines(&g, &mode, pipelined)) {
         exit_code = EXIT_FAILURE;
     }
-    else {
-        gamma_t *g = NULL;
-        input_mode_t mode = PENDING_MODE;
 
-        if (!read_lines(&g, &line_buffer, INITIAL_BUFFER_SIZE, &mode)) {
+    if (mode == INTERACTIVE_MODE) {
+        if (!inter_mode_launch(g)) {
             exit_code = EXIT_FAILURE;
         }
-
-        free(line_buffer);
-
-        if (mode == INTERACTIVE_MODE) {
-            if (!inter_mode_launch(g)) {
-                exit_code = EXIT_FAILURE;
-            }
+    }
+    else if (mode == BINARY_MODE) {
+        if (!bin_mode_launch(g)) {
+            exit_code = EXIT_FAILURE;
         }
-
-        gamma_delete(g);
     }
 
+    gamma_delete(g);
+
     return exit_code;
-}
\ No newline at end of file
+}
@@ -0,0 +1,47 @@
+/** @file
+ * Plik zawierający funkcję @ref main serwera gier, rozpoczynającą i kończącą
+ * jego działanie
+ *
+ * @author Szymon Czyżmański 417797
+ * @date 22.05.2020
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+#include "parallel.h"
+#include "server.h"
+
+/**
+ * Największa liczba wątków roboczych serwera.
+ */
+#define SERVER_MAX_WORKERS 256
+
+/** @brief Rozpoczyna i kończy działanie serwera gier.
+ * Program wywołuje się z argumentem będącym ścieżką gniazda domeny uniksowej
+ * i opcjonalnym argumentem będącym liczbą wątków roboczych. Domyślnie liczba
+ * wątków roboczych jest równa liczbie dostępnych procesorów.
+ * @param[in] argc – liczba argumentów wywołania programu,
+ * @param[in] argv – argumenty wywołania programu.
+ * @return Wartość @p EXIT_SUCCESS, jeśli serwer zakończył działanie po
+ * otrzymaniu sygnału, a @p EXIT_FAILURE, jeżeli argumenty są niepoprawne lub
+ * wystąpił krytyczny błąd.
+ */
+int main(int argc, char *argv[]) {
+    unsigned long workers_num = parallel_threads(UINT64_MAX);
+    char *end = NULL;
+
+    if (argc == 3) {
+        workers_num = strtoul(argv[2], &end, 10);
+    }
+
+    if (argc < 2 || argc > 3 || (end != NULL && *end != '\0')
+        || workers_num == 0 || workers_num > SERVER_MAX_WORKERS) {
+        fprintf(stderr, "Usage: %s SOCKET_PATH [WORKERS]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    return server_run(argv[1], (unsigned) workers_num) ? EXIT_SUCCESS
+                                                       : EXIT_FAILURE;
+}
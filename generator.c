@@ -0,0 +1,127 @@
+/** @file
+ * Implementacja modułu generującego ruchy wewnątrz programu na potrzeby testów
+ * obciążeniowych
+ *
+ * @author Szymon Czyżmański 417797
+ * @date 22.05.2020
+ */
+
+/**
+ * Dostęp do funkcji clock_gettime.
+ */
+#define _GNU_SOURCE
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "generator.h"
+#include "rng.h"
+
+/**
+ * Odwrotność prawdopodobieństwa, z jakim gracz mogący wykonać złoty ruch
+ * wykonuje go zamiast zwykłego ruchu.
+ */
+#define GENERATOR_GOLDEN_ODDS 64
+
+/** @brief Podaje bieżący czas.
+ * @return Czas zegara monotonicznego w nanosekundach.
+ */
+static uint64_t generator_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint64_t) ts.tv_sec * UINT64_C(1000000000) + (uint64_t) ts.tv_nsec;
+}
+
+/** @brief Wykonuje losowy złoty ruch.
+ * Losuje jeden ze złotych ruchów, które może wykonać gracz, funkcją
+ * @ref gamma_random_golden_move i wykonuje go.
+ * @param[in,out] g   – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in] player  – numer gracza,
+ * @param[in,out] rng – wskaźnik na stan generatora liczb pseudolosowych.
+ * @return Wartość @p true, jeżeli wykonano złoty ruch, a @p false, gdy gracz
+ * nie może wykonać złotego ruchu.
+ */
+static bool generator_golden_move(gamma_t *g, uint32_t player, uint64_t *rng) {
+    gamma_golden_move_t move;
+
+    return gamma_random_golden_move(g, player, rng, &move)
+           && gamma_golden_move(g, player, move.x, move.y);
+}
+
+bool generator_random_moves(gamma_t *g, uint64_t n, uint64_t seed,
+                            generator_stats_t *stats) {
+    uint64_t start = generator_now();
+    uint64_t rng = seed;
+    uint32_t player = 0;
+    bool stuck = false, failed = false;
+
+    *stats = (generator_stats_t) {0};
+
+    while (stats->moves + stats->golden_moves < n && !stuck && !failed
+           && (player = gamma_next_active_player(g, player)) != 0) {
+
+        gamma_position_t move;
+        uint64_t legal;
+
+        if (rng_next(&rng) % GENERATOR_GOLDEN_ODDS == 0
+            && gamma_golden_possible(g, player)
+            && generator_golden_move(g, player, &rng)) {
+
+            stats->golden_moves++;
+        }
+        else if ((legal = gamma_random_legal_move(g, player, &rng, &move))
+                 == UINT64_MAX) {
+
+            failed = true;
+        }
+        else if (legal > 0 && gamma_move(g, player, move.x, move.y)) {
+            stats->moves++;
+        }
+        else if (generator_golden_move(g, player, &rng)) {
+            stats->golden_moves++;
+        }
+        else {
+            stuck = true;
+        }
+    }
+
+    stats->elapsed_ns = generator_now() - start;
+
+    return !failed;
+}
+
+bool generator_fill(gamma_t *g, uint32_t x1, uint32_t y1, uint32_t x2,
+                    uint32_t y2, uint32_t block, generator_stats_t *stats) {
+    if (g == NULL || x1 > x2 || y1 > y2 || block == 0) {
+        return false;
+    }
+    else {
+        uint32_t width = gamma_width(g), height = gamma_board_height(g);
+        uint32_t players = gamma_players(g);
+        uint64_t start = generator_now();
+        *stats = (generator_stats_t) {0};
+
+        if (x2 >= width) {
+            x2 = width - 1;
+        }
+        if (y2 >= height) {
+            y2 = height - 1;
+        }
+
+        for (uint32_t y = y1; y <= y2; y++) {
+            for (uint32_t x = x1; x <= x2; x++) {
+                uint32_t player = 1 + (x / block + y / block) % players;
+
+                if (gamma_move(g, player, x, y)) {
+                    stats->moves++;
+                }
+            }
+        }
+
+        stats->elapsed_ns = generator_now() - start;
+
+        return true;
+    }
+}
@@ -0,0 +1,73 @@
+/** @file
+ * Interfejs modułu generującego ruchy wewnątrz programu na potrzeby testów
+ * obciążeniowych
+ *
+ * @author Szymon Czyżmański 417797
+ * @date 22.05.2020
+ */
+
+#ifndef GENERATOR_H
+#define GENERATOR_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "gamma.h"
+
+/**
+ * Typ struktury przechowującej statystyki wygenerowanych ruchów.
+ */
+typedef struct generator_stats generator_stats_t;
+
+/**
+ * Struktura przechowująca statystyki wygenerowanych ruchów.
+ */
+struct generator_stats {
+    uint64_t moves;        /**< Liczba wykonanych ruchów. */
+    uint64_t golden_moves; /**< Liczba wykonanych złotych ruchów. */
+    uint64_t elapsed_ns;   /**< Czas generowania w nanosekundach. */
+};
+
+/** @brief Rozgrywa losowe ruchy.
+ * Wykonuje co najwyżej @p n ruchów lub złotych ruchów, przydzielając je
+ * kolejnym graczom, którzy mogą wykonać ruch. Gracz wykonuje zwykle ruch na
+ * pole wylosowane spośród pól, na których może postawić pionek, a czasami,
+ * lub gdy nie może wykonać zwykłego ruchu, złoty ruch wylosowany spośród
+ * wszystkich jego legalnych złotych ruchów. Kończy działanie wcześniej, jeżeli
+ * żaden gracz nie może wykonać ruchu lub nie udało się zaalokować pamięci na
+ * zbiory pól, na których gracze mogą wykonać ruch.
+ * @param[in,out] g   – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in] n       – największa liczba ruchów,
+ * @param[in] seed    – ziarno generatora liczb pseudolosowych,
+ * @param[out] stats  – wskaźnik na strukturę, w której mają zostać zapisane
+ *                      statystyki ruchów wygenerowanych do chwili zakończenia.
+ * @return Wartość @p true, jeżeli generowanie zakończyło się po wykonaniu
+ * @p n ruchów lub dlatego, że żaden gracz nie może wykonać ruchu, a @p false,
+ * gdy nie udało się zaalokować pamięci.
+ */
+bool generator_random_moves(gamma_t *g, uint64_t n, uint64_t seed,
+                            generator_stats_t *stats);
+
+/** @brief Wypełnia prostokąt planszy wzorem.
+ * Próbuje wykonać, wierszami, ruch na każde pole prostokąta o przeciwległych
+ * rogach (@p x1, @p y1) i (@p x2, @p y2), przyciętego do planszy. Plansza
+ * jest podzielona na kwadratowe bloki o boku @p block, przydzielane kolejnym
+ * graczom na przemian, jak pola szachownicy o wielu kolorach, a ruch na pole
+ * wykonuje gracz, któremu przydzielono jego blok. Legalność ruchów sprawdza
+ * funkcja @ref gamma_move.
+ * @param[in,out] g   – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in] x1      – najmniejszy numer kolumny pola prostokąta,
+ * @param[in] y1      – najmniejszy numer wiersza pola prostokąta,
+ * @param[in] x2      – największy numer kolumny pola prostokąta,
+ * @param[in] y2      – największy numer wiersza pola prostokąta,
+ * @param[in] block   – długość boku bloku, liczba dodatnia,
+ * @param[out] stats  – wskaźnik na strukturę, w której mają zostać zapisane
+ *                      statystyki wygenerowanych ruchów.
+ * @return Wartość @p true, jeżeli parametry są poprawne, a @p false, gdy
+ * @p g jest równe NULL, @p x1 > @p x2, @p y1 > @p y2 lub @p block jest
+ * równe 0.
+ */
+bool generator_fill(gamma_t *g, uint32_t x1, uint32_t y1, uint32_t x2,
+                    uint32_t y2, uint32_t block, generator_stats_t *stats);
+
+#endif // GENERATOR_H
@@ -629,50 +629,39 @@ static bool inter_mode_handle_input(inter_mode_t *imode,
 }
 
 /** @brief Prowadzi rozgrywkę.
- * Odpowiada za prowadzenie rozgrywki i poprawne wyświetlanie planszy. Sprawdza,
- * czy gra powinna być kontynuowana, zachęca graczy do wykonywania ruchów oraz
- * obsługuje ich akcje.
+ * Odpowiada za prowadzenie rozgrywki i poprawne wyświetlanie planszy. Zachęca
+ * do wykonania ruchu kolejnych graczy z listy aktywnych graczy, podawanych przez
+ * funkcję @ref gamma_next_active_player, oraz obsługuje ich akcje. Kończy
+ * rozgrywkę, gdy żaden gracz nie może wykonać ruchu.
  * @param[in,out] imode – wskaźnik na strukturę przechowującą stan trybu
  *                        interaktywnego.
  * @return Wartośc @p true, jeżeli wczytywane dane były poprawne, to znaczy jeżeli
  * nie wystąpił kod @p EOF, a @p false w przeciwnym przypadku.
  */
 static bool inter_mode_play_gamma(inter_mode_t *imode) {
-    uint32_t num_of_players = gamma_players(imode->g);
     bool valid_input = true;
-    bool any_player_possible_move = true;
     bool end_of_game_key_pressed = false;
+    uint32_t player = gamma_next_active_player(imode->g, 0);
 
-    while (valid_input && any_player_possible_move && !end_of_game_key_pressed) {
-        any_player_possible_move = false;
-        uint32_t player = 0;
-
-        while (player++ < num_of_players && !end_of_game_key_pressed) {
-            imode->player = player;
-            uint64_t player_free_fields = gamma_free_fields(imode->g, player);
-            bool player_gamma_possible = gamma_golden_possible(imode->g, player);
-
-            if (player_free_fields > 0 || player_gamma_possible) {
-                any_player_possible_move = true;
+    while (valid_input && player != 0 && !end_of_game_key_pressed) {
+        imode->player = player;
 
-                uint32_t cursor_row = imode->cursor_row;
-                uint64_t cursor_col = imode->cursor_col;
+        uint32_t cursor_row = imode->cursor_row;
+        uint64_t cursor_col = imode->cursor_col;
 
-                printf(CLEAR_SCREEN);
-                printf(MOVE_CURSOR_TO_TOP_LEFT_CORNER);
+        printf(CLEAR_SCREEN);
+        printf(MOVE_CURSOR_TO_TOP_LEFT_CORNER);
 
-                inter_mode_print_board(imode);
-                inter_mode_print_prompt(imode);
+        inter_mode_print_board(imode);
+        inter_mode_print_prompt(imode);
 
-                imode->cursor_row = cursor_row, imode->cursor_col = cursor_col;
-                inter_mode_update_cursor_on_display(imode);
+        imode->cursor_row = cursor_row, imode->cursor_col = cursor_col;
+        inter_mode_update_cursor_on_display(imode);
 
-                inter_mode_turn_reverse_on_and_reprint_row(imode);
+        inter_mode_turn_reverse_on_and_reprint_row(imode);
 
-                valid_input = inter_mode_handle_input(imode,
-                                                      &end_of_game_key_pressed);
-            }
-        }
+        valid_input = inter_mode_handle_input(imode, &end_of_game_key_pressed);
+        player = gamma_next_active_player(imode->g, player);
     }
 
     return valid_input;
@@ -0,0 +1,281 @@
+/** @file
+ * Implementacja modułu odpowiedzialnego za równoległe wykonywanie pracy
+ * podzielonej na przedziały
+ *
+ * @author Szymon Czyżmański 417797
+ * @date 20.05.2020
+ */
+
+/**
+ * Dostęp do funkcji sysconf.
+ */
+#define _GNU_SOURCE
+
+#include <stdlib.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#include "parallel.h"
+
+/**
+ * Typ struktury przechowującej zadanie jednego wątku.
+ */
+typedef struct parallel_task parallel_task_t;
+
+/**
+ * Struktura przechowująca zadanie jednego wątku.
+ */
+struct parallel_task {
+    parallel_fn_t fn;   /**< Funkcja wykonująca pracę. */
+    void *arg;          /**< Wskaźnik przekazywany do funkcji @p fn. */
+    uint32_t begin;     /**< Początek przedziału. */
+    uint32_t end;       /**< Koniec przedziału. */
+    unsigned worker;    /**< Numer wątku. */
+    pthread_t thread;   /**< Identyfikator wątku. */
+    bool started;       /**< Wartość @p true, jeżeli udało się utworzyć wątek. */
+};
+
+/**
+ * Struktura przechowująca pulę wątków wielokrotnego użytku.
+ */
+struct parallel_pool {
+    pthread_mutex_t lock;  /**< Zamek chroniący pozostałe pola. */
+    pthread_cond_t start;  /**< Zmienna warunkowa sygnalizowana po zleceniu
+                            *   pracy lub zamknięciu puli. */
+    pthread_cond_t done;   /**< Zmienna warunkowa sygnalizowana, gdy ostatni
+                            *   wątek puli skończy swój przedział. */
+    pthread_t *threads;    /**< Tablica identyfikatorów wątków puli. */
+    unsigned started;      /**< Liczba utworzonych wątków puli. */
+    uint64_t generation;   /**< Numer ostatnio zleconej pracy. */
+    unsigned pending;      /**< Liczba wątków puli, które nie skończyły jeszcze
+                            *   przedziału bieżącej pracy. */
+    bool closed;           /**< Wartość @p true, jeżeli pula jest zamykana. */
+    parallel_fn_t fn;      /**< Funkcja wykonująca bieżącą pracę. */
+    void *arg;             /**< Wskaźnik przekazywany do funkcji @p fn. */
+    uint32_t n;            /**< Długość przedziału bieżącej pracy. */
+};
+
+/**
+ * Typ struktury przechowującej argument wątku puli.
+ */
+typedef struct parallel_member parallel_member_t;
+
+/**
+ * Struktura przechowująca argument wątku puli.
+ */
+struct parallel_member {
+    parallel_pool_t *pool; /**< Wskaźnik na pulę wątków. */
+    unsigned worker;       /**< Numer przedziału wykonywanego przez wątek. */
+};
+
+/** @brief Wykonuje zadanie wątku.
+ * @param[in,out] data – wskaźnik na strukturę przechowującą zadanie wątku.
+ * @return Wartość NULL.
+ */
+static void *parallel_task_run(void *data) {
+    parallel_task_t *task = data;
+    task->fn(task->arg, task->begin, task->end, task->worker);
+
+    return NULL;
+}
+
+unsigned parallel_threads(uint64_t work) {
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    uint64_t threads = work / PARALLEL_MIN_WORK;
+
+    if (cpus < 1 || threads < 1) {
+        return 1;
+    }
+    else {
+        return threads < (uint64_t) cpus ? (unsigned) threads : (unsigned) cpus;
+    }
+}
+
+void parallel_for(uint32_t n, unsigned threads, parallel_fn_t fn, void *arg) {
+    parallel_task_t *tasks = threads > 1 ? malloc(threads * sizeof(parallel_task_t))
+                                         : NULL;
+
+    if (tasks == NULL) {
+        fn(arg, 0, n, 0);
+    }
+    else {
+        for (unsigned i = 0; i < threads; i++) {
+            tasks[i] = (parallel_task_t) {
+                .fn = fn,
+                .arg = arg,
+                .begin = (uint32_t) ((uint64_t) n * i / threads),
+                .end = (uint32_t) ((uint64_t) n * (i + 1) / threads),
+                .worker = i,
+                .started = false
+            };
+        }
+
+        for (unsigned i = 0; i + 1 < threads; i++) {
+            tasks[i].started = pthread_create(&tasks[i].thread, NULL,
+                                              parallel_task_run, &tasks[i]) == 0;
+        }
+
+        parallel_task_run(&tasks[threads - 1]);
+
+        for (unsigned i = 0; i + 1 < threads; i++) {
+            if (tasks[i].started) {
+                pthread_join(tasks[i].thread, NULL);
+            }
+            else {
+                parallel_task_run(&tasks[i]);
+            }
+        }
+
+        free(tasks);
+    }
+}
+
+/** @brief Wyznacza przedział pracy puli.
+ * @param[in] pool    – wskaźnik na pulę wątków,
+ * @param[in] worker  – numer przedziału,
+ * @param[out] begin  – początek przedziału,
+ * @param[out] end    – koniec przedziału.
+ */
+static void parallel_pool_range(const parallel_pool_t *pool, unsigned worker,
+                                uint32_t *begin, uint32_t *end) {
+    unsigned threads = pool->started + 1;
+
+    *begin = (uint32_t) ((uint64_t) pool->n * worker / threads);
+    *end = (uint32_t) ((uint64_t) pool->n * (worker + 1) / threads);
+}
+
+/** @brief Wykonuje przedziały kolejnych prac zlecanych puli.
+ * @param[in,out] data – wskaźnik na strukturę przechowującą argument wątku,
+ *                       zwalnianą przy zakończeniu wątku.
+ * @return Wartość NULL.
+ */
+static void *parallel_member_run(void *data) {
+    parallel_member_t *member = data;
+    parallel_pool_t *pool = member->pool;
+    uint64_t generation = 0;
+
+    pthread_mutex_lock(&pool->lock);
+
+    while (true) {
+        while (!pool->closed && pool->generation == generation) {
+            pthread_cond_wait(&pool->start, &pool->lock);
+        }
+
+        if (pool->closed) {
+            break;
+        }
+
+        uint32_t begin, end;
+
+        generation = pool->generation;
+        parallel_pool_range(pool, member->worker, &begin, &end);
+        pthread_mutex_unlock(&pool->lock);
+
+        pool->fn(pool->arg, begin, end, member->worker);
+
+        pthread_mutex_lock(&pool->lock);
+
+        if (--pool->pending == 0) {
+            pthread_cond_signal(&pool->done);
+        }
+    }
+
+    pthread_mutex_unlock(&pool->lock);
+    free(member);
+
+    return NULL;
+}
+
+parallel_pool_t *parallel_pool_new(unsigned threads) {
+    parallel_pool_t *pool = malloc(sizeof(parallel_pool_t));
+
+    if (pool == NULL) {
+        return NULL;
+    }
+
+    *pool = (parallel_pool_t) {
+        .threads = threads > 1 ? malloc((threads - 1) * sizeof(pthread_t)) : NULL,
+        .started = 0,
+        .generation = 0,
+        .pending = 0,
+        .closed = false
+    };
+
+    if (threads > 1 && pool->threads == NULL) {
+        free(pool);
+
+        return NULL;
+    }
+
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->start, NULL);
+    pthread_cond_init(&pool->done, NULL);
+
+    for (unsigned i = 0; i + 1 < threads; i++) {
+        parallel_member_t *member = malloc(sizeof(parallel_member_t));
+
+        if (member == NULL) {
+            break;
+        }
+
+        *member = (parallel_member_t) {.pool = pool, .worker = pool->started};
+
+        if (pthread_create(&pool->threads[pool->started], NULL,
+                           parallel_member_run, member) != 0) {
+            free(member);
+            break;
+        }
+
+        pool->started++;
+    }
+
+    return pool;
+}
+
+unsigned parallel_pool_threads(const parallel_pool_t *pool) {
+    return pool->started + 1;
+}
+
+void parallel_pool_for(parallel_pool_t *pool, uint32_t n, parallel_fn_t fn,
+                       void *arg) {
+    uint32_t begin, end;
+
+    pthread_mutex_lock(&pool->lock);
+    pool->fn = fn;
+    pool->arg = arg;
+    pool->n = n;
+    pool->pending = pool->started;
+    pool->generation++;
+    pthread_cond_broadcast(&pool->start);
+    parallel_pool_range(pool, pool->started, &begin, &end);
+    pthread_mutex_unlock(&pool->lock);
+
+    fn(arg, begin, end, pool->started);
+
+    pthread_mutex_lock(&pool->lock);
+
+    while (pool->pending > 0) {
+        pthread_cond_wait(&pool->done, &pool->lock);
+    }
+
+    pthread_mutex_unlock(&pool->lock);
+}
+
+void parallel_pool_delete(parallel_pool_t *pool) {
+    if (pool != NULL) {
+        pthread_mutex_lock(&pool->lock);
+        pool->closed = true;
+        pthread_cond_broadcast(&pool->start);
+        pthread_mutex_unlock(&pool->lock);
+
+        for (unsigned i = 0; i < pool->started; i++) {
+            pthread_join(pool->threads[i], NULL);
+        }
+
+        pthread_cond_destroy(&pool->start);
+        pthread_cond_destroy(&pool->done);
+        pthread_mutex_destroy(&pool->lock);
+        free(pool->threads);
+        free(pool);
+    }
+}
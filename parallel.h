@@ -0,0 +1,92 @@
+/** @file
+ * Interfejs modułu odpowiedzialnego za równoległe wykonywanie pracy
+ * podzielonej na przedziały
+ *
+ * @author Szymon Czyżmański 417797
+ * @date 20.05.2020
+ */
+
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * Najmniejsza liczba jednostek pracy, na przykład pól planszy, przypadająca
+ * na jeden wątek. Mniejsza praca jest wykonywana w wątku wołającym.
+ */
+#define PARALLEL_MIN_WORK (UINT64_C(1) << 16)
+
+/**
+ * Typ funkcji wykonującej pracę dla przedziału [@p begin, @p end) w wątku
+ * o numerze @p worker.
+ */
+typedef void (*parallel_fn_t)(void *arg, uint32_t begin, uint32_t end,
+                              unsigned worker);
+
+/** @brief Podaje liczbę wątków, na które warto podzielić pracę.
+ * @param[in] work – łączna liczba jednostek pracy.
+ * @return Liczba dodatnia nie większa od liczby dostępnych procesorów, taka,
+ * że na każdy wątek przypada co najmniej @p PARALLEL_MIN_WORK jednostek pracy,
+ * lub 1, jeżeli praca jest za mała, aby ją dzielić.
+ */
+unsigned parallel_threads(uint64_t work);
+
+/** @brief Wykonuje pracę równolegle.
+ * Dzieli przedział [0, @p n) na @p threads spójnych, możliwie równych
+ * przedziałów i wywołuje funkcję @p fn dla każdego z nich w osobnym wątku,
+ * przy czym ostatni przedział jest przetwarzany w wątku wołającym. Kończy
+ * działanie dopiero po zakończeniu wszystkich wątków. Jeżeli nie udało się
+ * utworzyć wątku, jego przedział jest przetwarzany w wątku wołającym.
+ * @param[in] n       – długość dzielonego przedziału,
+ * @param[in] threads – liczba przedziałów, liczba dodatnia,
+ * @param[in] fn      – funkcja wykonująca pracę dla jednego przedziału,
+ * @param[in,out] arg – wskaźnik przekazywany do każdego wywołania funkcji @p fn.
+ */
+void parallel_for(uint32_t n, unsigned threads, parallel_fn_t fn, void *arg);
+
+/**
+ * Typ struktury przechowującej pulę wątków wielokrotnego użytku.
+ */
+typedef struct parallel_pool parallel_pool_t;
+
+/** @brief Tworzy pulę wątków wielokrotnego użytku.
+ * Uruchamia @p threads - 1 wątków, które czekają na pracę zlecaną funkcją
+ * @ref parallel_pool_for. Jeżeli nie udało się utworzyć któregoś z wątków,
+ * pula ma ich mniej.
+ * @param[in] threads – liczba przedziałów, na które ma być dzielona praca,
+ *                      liczba dodatnia.
+ * @return Wskaźnik na utworzoną pulę lub NULL, gdy nie udało się zaalokować
+ * pamięci.
+ */
+parallel_pool_t *parallel_pool_new(unsigned threads);
+
+/** @brief Podaje liczbę przedziałów, na które pula dzieli pracę.
+ * @param[in] pool – wskaźnik na pulę wątków.
+ * @return Liczba dodatnia, równa liczbie wątków puli powiększonej o 1.
+ */
+unsigned parallel_pool_threads(const parallel_pool_t *pool);
+
+/** @brief Wykonuje pracę równolegle w wątkach puli.
+ * Działa jak funkcja @ref parallel_for z liczbą przedziałów równą wartości
+ * @ref parallel_pool_threads, lecz zamiast tworzyć wątki, zleca przedziały
+ * wątkom puli. Numer wątku przekazywany do funkcji @p fn jest numerem
+ * przedziału, więc może indeksować pamięć roboczą przechowywaną między
+ * wywołaniami. Pula może wykonywać naraz tylko jedną pracę.
+ * @param[in,out] pool – wskaźnik na pulę wątków,
+ * @param[in] n        – długość dzielonego przedziału,
+ * @param[in] fn       – funkcja wykonująca pracę dla jednego przedziału,
+ * @param[in,out] arg  – wskaźnik przekazywany do każdego wywołania funkcji @p fn.
+ */
+void parallel_pool_for(parallel_pool_t *pool, uint32_t n, parallel_fn_t fn,
+                       void *arg);
+
+/** @brief Usuwa pulę wątków.
+ * Kończy wątki puli i zwalnia pamięć. Nic nie robi, jeżeli wskaźnik @p pool
+ * jest równy NULL.
+ * @param[in] pool – wskaźnik na pulę wątków.
+ */
+void parallel_pool_delete(parallel_pool_t *pool);
+
+#endif // PARALLEL_H
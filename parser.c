@@ -6,17 +6,15 @@
  * @date 14.05.2020
  */
 
-/**
- * Dostęp do funkcji getline.
- */
-#define _GNU_SOURCE
-
 #include <stdlib.h>
-#include <inttypes.h>
-#include <ctype.h>
-#include <errno.h>
 
 #include "parser.h"
+#include "command.h"
+#include "parallel.h"
+#include "reader.h"
+#include "ring.h"
+#include "session.h"
+#include "writer.h"
 
 /**
  * Znak oznaczający początek komentarza, jeśli występuje on jako pierwszy
@@ -34,154 +32,115 @@
  * @ref gamma_new i przejście do trybu interaktywnego.
  */
 #define INTERACTIVE 'I'
-
-/**
- * Znak oznaczający komendę powodującą wywołanie funkcji @ref gamma_new.
- */
-#define GAMMA_MOVE 'm'
-/**
- * Znak oznaczający komendę powodującą wywołanie funkcji @ref gamma_golden_move.
- */
-#define GAMMA_GOLDEN_MOVE 'g'
 /**
- * Znak oznaczający komendę powodującą wywołanie funkcji @ref gamma_busy_fields.
+ * Znak oznaczający komendę powodującą utworzenie nowej gry za pomocą funkcji
+ * @ref gamma_new i przejście do trybu binarnego.
  */
-#define GAMMA_BUSY_FIELDS 'b'
+#define BINARY 'C'
 /**
- * Znak oznaczający komendę powodującą wywołanie funkcji @ref gamma_free_fields.
+ * Znak oznaczający komendę powodującą przejście do trybu wielu gier.
  */
-#define GAMMA_FREE_FIELDS 'f'
+#define SESSIONS 'S'
+
 /**
- * Znak oznaczający komendę powodującą wywołanie funkcji @ref gamma_golden_possible.
+ * Liczba tokenów w komendach @ref BATCH, @ref INTERACTIVE oraz @ref BINARY.
  */
-#define GAMMA_GOLDEN_POSSIBLE 'q'
+#define MODE_COMMAND_TOKENS_NUM 5
 /**
- * Znak oznaczający komendę powodującą wywołanie funkcji @ref gamma_board.
+ * Liczba tokenów w komendzie @ref SESSIONS.
  */
-#define GAMMA_BOARD 'p'
-
+#define SESSIONS_COMMAND_TOKENS_NUM 2
 /**
- * Liczba tokenów w komendach @ref BATCH oraz @ref INTERACTIVE.
+ * Liczba tokenów w komendzie @ref session_opcode::SESSION_DELETE, nie licząc
+ * identyfikatora gry.
  */
-#define MODE_COMMAND_TOKENS_NUM 5
+#define DELETE_COMMAND_TOKENS_NUM 1
 /**
  * Liczba tokenów w komendach @ref GAMMA_MOVE oraz @ref GAMMA_GOLDEN_MOVE.
  */
 #define MOVE_COMMAND_TOKENS_NUM 4
 /**
- * Liczba tokenów w komendach @ref GAMMA_BUSY_FIELDS, @ref GAMMA_FREE_FIELDS
- * oraz @ref GAMMA_GOLDEN_POSSIBLE.
+ * Liczba tokenów w komendach @ref GAMMA_BUSY_FIELDS, @ref GAMMA_FREE_FIELDS,
+ * @ref GAMMA_GOLDEN_POSSIBLE oraz @ref TERRITORY_PLAYER.
  */
 #define QUERY_COMMAND_TOKENS_NUM 2
 /**
  * Liczba tokenów w komendzie @ref GAMMA_BOARD.
  */
 #define BOARD_COMMAND_TOKENS_NUM 1
+/**
+ * Liczba tokenów w komendzie @ref GAMMA_SAME_AREA.
+ */
+#define SAME_AREA_COMMAND_TOKENS_NUM 5
+/**
+ * Liczba tokenów w komendzie @ref GENERATE_RANDOM.
+ */
+#define RANDOM_COMMAND_TOKENS_NUM 3
+/**
+ * Liczba tokenów w komendzie @ref GENERATE_FILL.
+ */
+#define FILL_COMMAND_TOKENS_NUM 6
+/**
+ * Początek komunikatu o poprawnym wykonaniu polecenia @ref BATCH, @ref BINARY
+ * lub @ref SESSIONS.
+ */
+#define OK_PREFIX "OK "
 
-/** @brief Wypisuje na standardowe wyjście diagnostyczne informację o błędzie.
- * Wypisuje na standardowej wyjście diagnostyczne komunikat informujący o błędzie,
- * występującym wskutek tego, że polecenie w linii o numerze @p line_num było
- * niepoprawne lub wynikiem funkcji wywołanej wskutek wykonania polecenia
- * była wartość NULL.
- * @param[in] line_num – numer linii, w której wystąpił błąd.
+/** @brief Sprawdza, czy znak oddziela tokeny.
+ * @param[in] c – sprawdzany znak.
+ * @return Wartość @p true, jeżeli @p c jest białym znakiem innym niż znak
+ * nowej linii, a @p false w przeciwnym przypadku.
  */
-static inline void print_error(unsigned line_num) {
-    fprintf(stderr, "ERROR %u\n", line_num);
+static inline bool char_delimiter(char c) {
+    return c == ' ' || c == '\t' || c == '\v' || c == '\f' || c == '\r';
 }
 
-/** @brief Dzieli linię na tokeny.
- * Dzieli przekazaną linię na tokeny według białych znaków. Zapisuje uzyskane
- * tokeny w tablicy @p tokens.
- * @param[in,out] line   – wskaźnik na bufor zawierający linię do podzielenia,
- * @param[in,out] tokens – tablica do której mają zostać zapisane uzyskane tokeny,
- * @param[in] tokens_len – długość tablicy @p tokens, oczekiwana liczba tokenów.
- * @return Wartość @p true, jeżeli pierwszy token ma długość równą 1 oraz liczba
- * tokenów jest równa @p tokens_len, a @p false w przeciwnym przypadku.
+/** @brief Sprawdza, czy znak jest cyfrą.
+ * @param[in] c – sprawdzany znak.
+ * @return Wartość @p true, jeżeli @p c jest cyfrą dziesiętną, a @p false
+ * w przeciwnym przypadku.
  */
-static bool line_split_into_tokens(char *line, char *tokens[], size_t tokens_len) {
-    char delimiters[] = " \t\v\f\r\n";
-    tokens[0] = strtok(line, delimiters);
-
-    if (strlen(tokens[0]) != 1) {
-        return false;
-    }
-    else {
-        char *token;
-        size_t split = 1;
-
-        while (split < tokens_len && (token = strtok(NULL, delimiters)) != NULL) {
-            tokens[split] = token;
-            split++;
-        }
-
-        return split == tokens_len && strtok(NULL, delimiters) == NULL;
-    }
+static inline bool char_digit(char c) {
+    return c >= '0' && c <= '9';
 }
 
-/** @brief Sprawdza, czy napis jest poprawnym zapisem liczby.
- * Sprawdza, czy napis wskazywany przez @p token reprezentuje poprawną liczbę,
- * to znaczy czy zawiera tylko cyfry.
- * @param[in] token – wskaźnik na napis do sprawdzenia.
- * @return Wartość @p true, jeżeli napis wskazywany przez @p token jest poprawnym
- * zapisem liczby, a @p false w przeciwnym przypadku.
- */
-static inline bool token_valid_number(const char *token) {
-    size_t i = 0;
+bool line_parse_arguments(const char *line, size_t line_len,
+                          uint32_t arguments[], size_t arguments_len) {
+    size_t i = 1, parsed = 0;
 
-    while (token[i] != '\0' && isdigit(token[i])) {
-        i++;
+    if (i < line_len && !char_delimiter(line[i])) {
+        return false;
     }
 
-    return token[i] == '\0';
-}
+    while (true) {
+        while (i < line_len && char_delimiter(line[i])) {
+            i++;
+        }
 
-/** @brief Sprawdza, czy wszystkie napisy w tablicy są poprawnymi zapisami liczb.
- * Sprawdza, czy dla każdego napisu @p token z tablicy @p tokens funkcja
- * @ref token_valid_number przyjmuje wartość @p true.
- * @param[in,out] tokens – tablica zawierająca napisy do sprawdzenia,
- * @param[in] tokens_len – długość tablicy @p tokens.
- * @return Wartość @p true, jeżeli każdy element tablicy @p tokens jest poprawnym
- * zapisem liczby, a @p false w przeciwnym przypadku.
- */
-static inline bool tokens_all_valid_numbers(char *tokens[], size_t tokens_len) {
-    size_t i = 0;
+        if (i == line_len) {
+            return parsed == arguments_len;
+        }
+        else if (parsed == arguments_len || !char_digit(line[i])) {
+            return false;
+        }
 
-    while (i < tokens_len && token_valid_number(tokens[i])) {
-        i++;
-    }
+        uint64_t value = 0;
 
-    return i == tokens_len;
-}
+        while (i < line_len && char_digit(line[i])) {
+            value = value * 10 + (uint64_t) (line[i] - '0');
 
-/** @brief Konwertuje napisy do liczb, sprawdzając, czy są one dozwolonymi
- * argumentami dowolnego polecenia.
- * Konwertuje każdy z napisów będących elementami tablicy @p tokens do
- * odpowiadających im wartości liczbowej. Sprawdza w ten sposób czy napisy
- * przechowywane w tablicy @p tokens stanowią dozwolone argumenty dowolnego
- * polecenia.
- * @param[in] tokens        – tablica zawierająca napisy do skonwertowania,
- * @param[in] tokens_len    – długość tablicy @p tokens,
- * @param[in,out] converted – tablica mająca zawierać skonwertowane wartości.
- * @return Wartość @p true, jeżeli każdy element tablicy @p tokens jest poprawnym
- * zapisem liczby i został poprawnie skonwertowany do nieujemnej liczby
- * nieprzekraczającej wartości @p UINT32_MAX, a @p false w przeciwnym przypadku.
- */
-static bool tokens_valid_arguments(char *tokens[], size_t tokens_len,
-                                   unsigned long converted[]) {
-    if (tokens_all_valid_numbers(tokens, tokens_len)) {
-        for (size_t i = 0; i < tokens_len; i++) {
-            errno = 0;
-            converted[i] = strtoul(tokens[i], NULL, 10);
-
-            if (errno == ERANGE || converted[i] > UINT32_MAX) {
+            if (value > UINT32_MAX) {
                 return false;
             }
+
+            i++;
         }
 
-        return true;
-    }
-    else {
-        return false;
+        if (i < line_len && !char_delimiter(line[i])) {
+            return false;
+        }
+
+        arguments[parsed++] = (uint32_t) value;
     }
 }
 
@@ -190,6 +149,10 @@ static bool tokens_valid_arguments(char *tokens[], size_t tokens_len,
  * z argumentami @p arguments.
  * Komunikaty o poprawnym wykonaniu poleceń wypisuje na standardowe wyjście,
  * a komunikaty o błędach wypisuje na standardowe wyjście diagnostyczne.
+ * Polecenia dotyczące istniejącej gry przekazuje funkcji
+ * @ref command_execute_game.
+ * @param[in,out] w     – wskaźnik na strukturę przechowującą stan modułu
+ *                        wypisującego,
  * @param[in,out] g     – wskaźnik do wskaźnika na strukturę przechowującą stan gry,
  * @param[in] line_num  – numer linii, w której wystąpiło polecenie,
  * @param[in] command   – znak określający polecenie,
@@ -198,68 +161,38 @@ static bool tokens_valid_arguments(char *tokens[], size_t tokens_len,
  *                        zdefiniowanych w wyliczeniu @ref input_mode,
  *                        określającą, w jakim trybie aktualnie pracuje program.
  */
-static void command_execute(gamma_t **g, unsigned line_num, char command,
-                            unsigned long arguments[], input_mode_t *mode) {
+static void command_execute(writer_t *w, gamma_t **g, unsigned line_num, char command,
+                            uint32_t arguments[], input_mode_t *mode) {
     switch (command) {
         case BATCH:
-        case INTERACTIVE: {
+        case INTERACTIVE:
+        case BINARY: {
             uint32_t width = arguments[0], height = arguments[1];
             uint32_t players = arguments[2], areas = arguments[3];
             *g = gamma_new(width, height, players, areas);
 
             if (*g == NULL) {
-                print_error(line_num);
+                command_print_error(w, line_num);
             }
             else {
-                *mode = command == BATCH ? BATCH_MODE : INTERACTIVE_MODE;
-
                 if (command == BATCH) {
-                    printf("OK %u\n", line_num);
+                    *mode = BATCH_MODE;
+                }
+                else {
+                    *mode = command == BINARY ? BINARY_MODE : INTERACTIVE_MODE;
                 }
-            }
-
-            break;
-        }
-        case GAMMA_MOVE: {
-            uint32_t player = arguments[0], x = arguments[1], y = arguments[2];
-            printf("%d\n", gamma_move(*g, player, x, y) ? 1 : 0);
-            break;
-        }
-        case GAMMA_GOLDEN_MOVE: {
-            uint32_t player = arguments[0], x = arguments[1], y = arguments[2];
-            printf("%d\n", gamma_golden_move(*g, player, x, y) ? 1 : 0);
-            break;
-        }
-        case GAMMA_BUSY_FIELDS: {
-            uint32_t player = arguments[0];
-            printf("%" PRIu64 "\n", gamma_busy_fields(*g, player));
-            break;
-        }
-        case GAMMA_FREE_FIELDS: {
-            uint32_t player = arguments[0];
-            printf("%" PRIu64 "\n", gamma_free_fields(*g, player));
-            break;
-        }
-        case GAMMA_GOLDEN_POSSIBLE: {
-            uint32_t player = arguments[0];
-            printf("%d\n", gamma_golden_possible(*g, player) ? 1 : 0);
-            break;
-        }
-        case GAMMA_BOARD: {
-            char *board = gamma_board(*g);
 
-            if (board == NULL) {
-                print_error(line_num);
-            }
-            else {
-                printf("%s", board);
-                free(board);
+                if (command != INTERACTIVE) {
+                    writer_put_string(w, WRITER_OUT, OK_PREFIX,
+                                      sizeof(OK_PREFIX) - 1);
+                    command_print_result(w, NULL, line_num);
+                }
             }
 
             break;
         }
         default: {
-            print_error(line_num);
+            command_execute_game(w, *g, NULL, line_num, command, arguments, 0);
         }
     }
 }
@@ -269,30 +202,57 @@ static void command_execute(gamma_t **g, unsigned line_num, char command,
  * Parsuje linię i jeśli otrzymane tokeny reprezentują poprawne polecenie,
  * wykonuje je, a w przeciwnym przypadku wypisuje komunikat o błędzie
  * na standardowe wyjście diagnostyczne.
+ * @param[in,out] w      – wskaźnik na strukturę przechowującą stan modułu
+ *                         wypisującego,
  * @param[in,out] g      – wskaźnik do wskaźnika na strukturę przechowującą stan gry,
- * @param[in,out] line   – wskaźnik do bufora zawierającego linię do interpretacji,
+ * @param[in] line       – wskaźnik do bufora zawierającego linię do interpretacji,
+ * @param[in] line_len   – długość linii bez kończącego ją znaku nowej linii,
  * @param[in] line_num   – numer linii,
  * @param[in] tokens_len – oczekiwana liczba tokenów,
  * @param[in,out] mode   – wskaźnik na zmienną przyjmującą jedną z wartości
  *                         zdefiniowanych w wyliczeniu @ref input_mode,
  *                         określającą, w jakim trybie aktualnie pracuje program.
  */
-static void command_parse_line(gamma_t **g, char *line, unsigned line_num,
+static void command_parse_line(writer_t *w, gamma_t **g, const char *line,
+                               size_t line_len, unsigned line_num,
                                size_t tokens_len, input_mode_t *mode) {
-    char *tokens[tokens_len];
+    uint32_t arguments[tokens_len];
 
-    if (line_split_into_tokens(line, tokens, tokens_len)) {
-        unsigned long converted[tokens_len - 1];
-
-        if (tokens_valid_arguments(tokens + 1, tokens_len - 1, converted)) {
-            command_execute(g, line_num, tokens[0][0], converted, mode);
-        }
-        else {
-            print_error(line_num);
-        }
+    if (line_parse_arguments(line, line_len, arguments, tokens_len - 1)) {
+        command_execute(w, g, line_num, line[0], arguments, mode);
     }
     else {
-        print_error(line_num);
+        command_print_error(w, line_num);
+    }
+}
+
+bool batch_mode_decode_line(const char *line, size_t line_len,
+                            uint32_t arguments[]) {
+    switch (line[0]) {
+        case GAMMA_MOVE:
+        case GAMMA_GOLDEN_MOVE:
+            return line_parse_arguments(line, line_len, arguments,
+                                        MOVE_COMMAND_TOKENS_NUM - 1);
+        case GAMMA_BUSY_FIELDS:
+        case GAMMA_FREE_FIELDS:
+        case GAMMA_GOLDEN_POSSIBLE:
+        case TERRITORY_PLAYER:
+            return line_parse_arguments(line, line_len, arguments,
+                                        QUERY_COMMAND_TOKENS_NUM - 1);
+        case GAMMA_BOARD:
+            return line_parse_arguments(line, line_len, arguments,
+                                        BOARD_COMMAND_TOKENS_NUM - 1);
+        case GAMMA_SAME_AREA:
+            return line_parse_arguments(line, line_len, arguments,
+                                        SAME_AREA_COMMAND_TOKENS_NUM - 1);
+        case GENERATE_RANDOM:
+            return line_parse_arguments(line, line_len, arguments,
+                                        RANDOM_COMMAND_TOKENS_NUM - 1);
+        case GENERATE_FILL:
+            return line_parse_arguments(line, line_len, arguments,
+                                        FILL_COMMAND_TOKENS_NUM - 1);
+        default:
+            return false;
     }
 }
 
@@ -302,8 +262,11 @@ static void command_parse_line(gamma_t **g, char *line, unsigned line_num,
  * Parsuje linię i jeśli otrzymane tokeny reprezentują poprawne polecenie
  * w trybie wsadowym, wykonuje je, a w przeciwnym przypadku wypisuje komunikat
  * o błędzie na standardowe wyjście diagnostyczne.
+ * @param[in,out] w      – wskaźnik na strukturę przechowującą stan modułu
+ *                         wypisującego,
  * @param[in,out] g      – wskaźnik na strukturę przechowującą stan gry,
- * @param[in,out] line   – wskaźnik do bufora zawierającego linię do interpretacji,
+ * @param[in] line       – wskaźnik do bufora zawierającego linię do interpretacji,
+ * @param[in] line_len   – długość linii bez kończącego ją znaku nowej linii,
  * @param[in] line_num   – numer linii,
  * @param[in,out] mode   – wskaźnik na zmienną przyjmującą jedną z wartości
  *                         zdefiniowanych w wyliczeniu @ref input_mode,
@@ -311,84 +274,403 @@ static void command_parse_line(gamma_t **g, char *line, unsigned line_num,
  *                         zakłada się, że w momencie wywołania funkcji wartość
  *                         zmiennej jest równa @ref input_mode::BATCH_MODE.
  */
-static void batch_mode_parse_line(gamma_t *g, char *line,
-                                  unsigned line_num, input_mode_t *mode) {
-    switch (line[0]) {
-        case GAMMA_MOVE:
-        case GAMMA_GOLDEN_MOVE:
-            command_parse_line(&g, line, line_num, MOVE_COMMAND_TOKENS_NUM, mode);
-            break;
-        case GAMMA_BUSY_FIELDS:
-        case GAMMA_FREE_FIELDS:
-        case GAMMA_GOLDEN_POSSIBLE:
-            command_parse_line(&g, line, line_num, QUERY_COMMAND_TOKENS_NUM, mode);
-            break;
-        case GAMMA_BOARD:
-            command_parse_line(&g, line, line_num, BOARD_COMMAND_TOKENS_NUM, mode);
-            break;
-        default:
-            print_error(line_num);
+static void batch_mode_parse_line(writer_t *w, gamma_t *g, const char *line,
+                                  size_t line_len, unsigned line_num,
+                                  input_mode_t *mode) {
+    uint32_t arguments[ARGUMENTS_MAX_NUM];
+
+    if (batch_mode_decode_line(line, line_len, arguments)) {
+        command_execute(w, &g, line_num, line[0], arguments, mode);
+    }
+    else {
+        command_print_error(w, line_num);
     }
 }
 
-/** @brief Parsuje linię w trybie oczekującym na polecenie @ref BATCH
- * lub @ref INTERACTIVE.
+/** @brief Parsuje polecenie @ref SESSIONS.
+ * Jeżeli linia zawiera poprawne polecenie @ref SESSIONS, przechodzi w tryb
+ * wielu gier, a w przeciwnym przypadku wypisuje komunikat o błędzie
+ * na standardowe wyjście diagnostyczne. Liczba wątków roboczych równa 0
+ * oznacza liczbę dostępnych procesorów.
+ * @param[in,out] w        – wskaźnik na strukturę przechowującą stan modułu
+ *                           wypisującego,
+ * @param[in] line         – wskaźnik do bufora zawierającego linię
+ *                           do interpretacji,
+ * @param[in] line_len     – długość linii bez kończącego ją znaku nowej linii,
+ * @param[in] line_num     – numer linii,
+ * @param[in,out] mode     – wskaźnik na zmienną przyjmującą jedną z wartości
+ *                           zdefiniowanych w wyliczeniu @ref input_mode,
+ *                           określającą, w jakim trybie aktualnie pracuje
+ *                           program,
+ * @param[out] workers_num – wskaźnik na zmienną, w której ma zostać zapisana
+ *                           liczba wątków roboczych trybu wielu gier.
+ */
+static void sessions_parse_line(writer_t *w, const char *line, size_t line_len,
+                                unsigned line_num, input_mode_t *mode,
+                                unsigned *workers_num) {
+    uint32_t arguments[SESSIONS_COMMAND_TOKENS_NUM - 1];
+
+    if (line_parse_arguments(line, line_len, arguments,
+                             SESSIONS_COMMAND_TOKENS_NUM - 1)
+        && arguments[0] <= SESSION_MAX_WORKERS) {
+        *workers_num = arguments[0] > 0 ? arguments[0]
+                                        : parallel_threads(UINT64_MAX);
+        *mode = SESSION_MODE;
+        writer_put_string(w, WRITER_OUT, OK_PREFIX, sizeof(OK_PREFIX) - 1);
+        command_print_result(w, NULL, line_num);
+    }
+    else {
+        command_print_error(w, line_num);
+    }
+}
+
+/** @brief Parsuje linię w trybie oczekującym na polecenie @ref BATCH,
+ * @ref INTERACTIVE, @ref BINARY lub @ref SESSIONS.
  * Funkcja ta jest wywoływana w momencie, kiedy program pracuje w trybie
- * oczekującym, to znaczy nie przeszedł jeszcze ani w tryb wsadowy, ani w tryb
- * interaktywny.
+ * oczekującym, to znaczy nie przeszedł jeszcze w tryb wsadowy, interaktywny,
+ * binarny ani wielu gier.
  * Parsuje linię i jeśli otrzymane tokeny reprezentują poprawne polecenie
- * @ref BATCH lub @ref INTERACTIVE, wykonuje je, a w przeciwnym przypadku
- * wypisuje komunikat o błędzie na standardowe wyjście diagnostyczne.
- * @param[in,out] g      – wskaźnik na strukturę przechowującą stan gry,
- * @param[in,out] line   – wskaźnik do bufora zawierającego linię do interpretacji,
- * @param[in] line_num   – numer linii,
- * @param[in,out] mode   – wskaźnik na zmienną przyjmującą jedną z wartości
- *                         zdefiniowanych w wyliczeniu @ref input_mode,
- *                         określającą, w jakim trybie aktualnie pracuje program,
- *                         zakłada się, że w momencie wywołania funkcji wartość
- *                         tej zmiennej jest równa @ref input_mode::PENDING_MODE.
+ * @ref BATCH, @ref INTERACTIVE, @ref BINARY lub @ref SESSIONS, wykonuje je,
+ * a w przeciwnym przypadku wypisuje komunikat o błędzie na standardowe wyjście
+ * diagnostyczne.
+ * @param[in,out] w        – wskaźnik na strukturę przechowującą stan modułu
+ *                           wypisującego,
+ * @param[in,out] g        – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in] line         – wskaźnik do bufora zawierającego linię
+ *                           do interpretacji,
+ * @param[in] line_len     – długość linii bez kończącego ją znaku nowej linii,
+ * @param[in] line_num     – numer linii,
+ * @param[in,out] mode     – wskaźnik na zmienną przyjmującą jedną z wartości
+ *                           zdefiniowanych w wyliczeniu @ref input_mode,
+ *                           określającą, w jakim trybie aktualnie pracuje
+ *                           program, zakłada się, że w momencie wywołania
+ *                           funkcji wartość tej zmiennej jest równa
+ *                           @ref input_mode::PENDING_MODE,
+ * @param[out] workers_num – wskaźnik na zmienną, w której ma zostać zapisana
+ *                           liczba wątków roboczych trybu wielu gier.
  */
-static inline void pending_mode_parse_line(gamma_t **g, char *line,
-                                           unsigned line_num, input_mode_t *mode) {
+static inline void pending_mode_parse_line(writer_t *w, gamma_t **g,
+                                           const char *line, size_t line_len,
+                                           unsigned line_num, input_mode_t *mode,
+                                           unsigned *workers_num) {
     switch (line[0]) {
         case BATCH:
         case INTERACTIVE:
-            command_parse_line(g, line, line_num, MODE_COMMAND_TOKENS_NUM, mode);
+        case BINARY:
+            command_parse_line(w, g, line, line_len, line_num,
+                               MODE_COMMAND_TOKENS_NUM, mode);
+            break;
+        case SESSIONS:
+            sessions_parse_line(w, line, line_len, line_num, mode, workers_num);
             break;
         default:
-            print_error(line_num);
+            command_print_error(w, line_num);
     }
 }
 
-bool read_lines(gamma_t **g, char **buf, size_t buffer_size, input_mode_t *mode) {
-    ssize_t line_len;
-    unsigned line_num = 0;
-    errno = 0;
+/**
+ * Liczba miejsc w kolejce zdekodowanych poleceń w potokowym trybie wsadowym.
+ */
+#define PIPELINE_CAPACITY (1 << 12)
+
+/**
+ * Typ struktury przechowującej zdekodowane polecenie.
+ */
+typedef struct parsed_command parsed_command_t;
+
+/**
+ * Struktura przechowująca zdekodowane polecenie trybu wsadowego.
+ */
+struct parsed_command {
+    uint32_t arguments[ARGUMENTS_MAX_NUM]; /**< Argumenty polecenia. */
+    unsigned line_num;                     /**< Numer linii. */
+    char command;                          /**< Znak określający polecenie
+                                            *   lub @p '\0', jeżeli linia jest
+                                            *   niepoprawna. */
+};
+
+/**
+ * Typ struktury przechowującej stan potokowego trybu wsadowego.
+ */
+typedef struct pipeline pipeline_t;
+
+/**
+ * Struktura przechowująca stan potokowego trybu wsadowego, w którym linie
+ * są dekodowane w osobnym wątku, a polecenia są wykonywane w wątku wołającym.
+ */
+struct pipeline {
+    reader_t *reader;       /**< Czytnik linii, używany tylko przez wątek
+                             *   dekodujący. */
+    ring_t ring;            /**< Kolejka zdekodowanych poleceń. */
+    unsigned line_num;      /**< Numer ostatniej wczytanej linii. */
+    reader_status_t status; /**< Wynik ostatniej próby wczytania linii. */
+};
+
+/** @brief Dekoduje linie w potokowym trybie wsadowym.
+ * Wczytuje kolejne linie do końca wejścia, dekoduje je i wstawia do kolejki
+ * zdekodowanych poleceń, pomijając linie puste i komentarze. Na koniec
+ * zamyka kolejkę.
+ * @param[in,out] data – wskaźnik na strukturę przechowującą stan potokowego
+ *                       trybu wsadowego.
+ * @return Wartość NULL.
+ */
+static void *pipeline_decode(void *data) {
+    pipeline_t *p = data;
+    const char *line;
+    size_t line_len;
+    bool newline;
+
+    while ((p->status = reader_next_line(p->reader, true, &line, &line_len,
+                                         &newline)) == READER_DATA) {
+        p->line_num++;
+
+        if (line_len > 0 && line[0] != COMMENT) {
+            parsed_command_t parsed = {.line_num = p->line_num, .command = '\0'};
+
+            if (newline
+                && batch_mode_decode_line(line, line_len, parsed.arguments)) {
+                parsed.command = line[0];
+            }
+
+            ring_push(&p->ring, &parsed);
+        }
+    }
+
+    ring_close(&p->ring);
 
-    while (*mode != INTERACTIVE_MODE
-           && (line_len = getline(buf, &buffer_size, stdin)) != -1) {
+    return NULL;
+}
 
+/** @brief Wykonuje pozostałą część wejścia w potokowym trybie wsadowym.
+ * Uruchamia wątek dekodujący linie i wykonuje zdekodowane przez niego
+ * polecenia w kolejności, w jakiej występują na wejściu, więc wypisywane
+ * komunikaty są takie same jak w zwykłym trybie wsadowym.
+ * @param[in,out] w      – wskaźnik na strukturę przechowującą stan modułu
+ *                         wypisującego,
+ * @param[in,out] g      – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in,out] reader – wskaźnik na strukturę przechowującą stan czytnika,
+ * @param[in] line_num   – numer ostatniej wczytanej linii,
+ * @param[out] status    – wskaźnik na zmienną, w której ma zostać zapisany wynik
+ *                         ostatniej próby wczytania linii.
+ * @return Wartość @p true, jeżeli wykonano polecenia do końca wejścia,
+ * a @p false, jeżeli nie udało się zaalokować kolejki lub utworzyć wątku
+ * i żadna linia nie została wczytana.
+ */
+static bool pipeline_run(writer_t *w, gamma_t *g, reader_t *reader,
+                         unsigned line_num, reader_status_t *status) {
+    pipeline_t p = {.reader = reader, .line_num = line_num, .status = READER_EOF};
+    pthread_t decoder;
+
+    if (!ring_init(&p.ring, PIPELINE_CAPACITY, sizeof(parsed_command_t))) {
+        return false;
+    }
+    else if (pthread_create(&decoder, NULL, pipeline_decode, &p) != 0) {
+        ring_free(&p.ring);
+        return false;
+    }
+    else {
+        parsed_command_t parsed;
+        input_mode_t mode = BATCH_MODE;
+
+        while (true) {
+            if (!ring_ready(&p.ring)) {
+                writer_flush(w);
+            }
+
+            if (!ring_pop(&p.ring, &parsed)) {
+                break;
+            }
+
+            if (parsed.command == '\0') {
+                command_print_error(w, parsed.line_num);
+            }
+            else {
+                command_execute(w, &g, parsed.line_num, parsed.command,
+                                parsed.arguments, &mode);
+            }
+        }
+
+        pthread_join(decoder, NULL);
+        ring_free(&p.ring);
+        *status = p.status;
+
+        return true;
+    }
+}
+
+/** @brief Dekoduje linię w trybie wielu gier.
+ * Odczytuje identyfikator gry, a następnie sprawdza, czy pozostała część linii
+ * zawiera poprawne polecenie @ref session_opcode::SESSION_NEW,
+ * @ref session_opcode::SESSION_DELETE lub polecenie trybu wsadowego.
+ * @param[in] line     – wskaźnik do bufora zawierającego linię do interpretacji,
+ * @param[in] line_len – długość linii bez kończącego ją znaku nowej linii,
+ * @param[out] command – wskaźnik na strukturę, w której mają zostać zapisane
+ *                       identyfikator gry, jeżeli jest poprawny, oraz kod
+ *                       i argumenty polecenia, jeżeli polecenie jest poprawne.
+ */
+static void sessions_decode_line(const char *line, size_t line_len,
+                                 session_command_t *command) {
+    uint64_t id = 0;
+    size_t i = 0;
+
+    while (i < line_len && char_digit(line[i])) {
+        id = id * 10 + (uint64_t) (line[i] - '0');
+
+        if (id > UINT32_MAX) {
+            return;
+        }
+
+        i++;
+    }
+
+    if (i == 0 || i == line_len || !char_delimiter(line[i])) {
+        return;
+    }
+
+    command->id = (uint32_t) id;
+
+    while (i < line_len && char_delimiter(line[i])) {
+        i++;
+    }
+
+    const char *rest = line + i;
+    size_t rest_len = line_len - i;
+    bool valid;
+
+    if (rest_len == 0) {
+        return;
+    }
+    else if (rest[0] == SESSION_NEW) {
+        valid = line_parse_arguments(rest, rest_len, command->arguments,
+                                     MODE_COMMAND_TOKENS_NUM - 1);
+    }
+    else if (rest[0] == SESSION_DELETE) {
+        valid = line_parse_arguments(rest, rest_len, command->arguments,
+                                     DELETE_COMMAND_TOKENS_NUM - 1);
+    }
+    else {
+        valid = batch_mode_decode_line(rest, rest_len, command->arguments);
+    }
+
+    if (valid) {
+        command->command = rest[0];
+    }
+}
+
+/** @brief Wykonuje pozostałą część wejścia w trybie wielu gier.
+ * Uruchamia pulę wątków roboczych, a następnie wczytuje kolejne linie do końca
+ * wejścia, dekoduje je i przekazuje puli, pomijając linie puste i komentarze.
+ * Linia, z której nie udało się odczytać identyfikatora gry, jest przekazywana
+ * jako niepoprawne polecenie dotyczące gry o identyfikatorze 0.
+ * @param[in,out] w        – wskaźnik na strukturę przechowującą stan modułu
+ *                           wypisującego,
+ * @param[in,out] reader   – wskaźnik na strukturę przechowującą stan czytnika,
+ * @param[in] line_num     – numer ostatniej wczytanej linii,
+ * @param[in] workers_num  – liczba wątków roboczych,
+ * @param[out] status      – wskaźnik na zmienną, w której ma zostać zapisany
+ *                           wynik ostatniej próby wczytania linii.
+ * @return Wartość @p true, jeżeli wykonano polecenia do końca wejścia,
+ * a @p false, jeżeli nie udało się uruchomić puli wątków roboczych.
+ */
+static bool sessions_run(writer_t *w, reader_t *reader, unsigned line_num,
+                         unsigned workers_num, reader_status_t *status) {
+    session_pool_t pool;
+    const char *line;
+    size_t line_len;
+    bool newline;
+
+    writer_flush(w);
+
+    if (!session_pool_init(&pool, workers_num)) {
+        return false;
+    }
+
+    while ((*status = reader_next_line(reader, true, &line, &line_len,
+                                       &newline)) == READER_DATA) {
         line_num++;
-        char *buffer = *buf;
 
-        if (errno == ENOMEM || errno == EINVAL) {
-            return false;
+        if (line_len > 0 && line[0] != COMMENT) {
+            session_command_t command = {
+                .id = 0,
+                .line_num = line_num,
+                .command = SESSION_INVALID
+            };
+
+            if (newline) {
+                sessions_decode_line(line, line_len, &command);
+            }
+
+            session_pool_submit(&pool, &command);
         }
+    }
+
+    session_pool_free(&pool);
+
+    return true;
+}
+
+bool read_lines(gamma_t **g, input_mode_t *mode, bool pipelined) {
+    reader_t reader;
+    writer_t writer;
+    reader_status_t status = READER_EOF;
+    unsigned line_num = 0, workers_num = 0;
+
+    if (!reader_init(&reader, fileno(stdin))) {
+        reader_free(&reader);
+        return false;
+    }
+    else if (!writer_init(&writer, fileno(stdout), fileno(stderr))) {
+        reader_free(&reader);
+        return false;
+    }
 
-        if (buffer[0] != '\n' && buffer[0] != COMMENT) {
-            if (buffer[line_len - 1] != '\n' || strlen(buffer) != (size_t) line_len) {
-                print_error(line_num);
+    while (*mode == PENDING_MODE || *mode == BATCH_MODE) {
+        if (pipelined && *mode == BATCH_MODE) {
+            if (pipeline_run(&writer, *g, &reader, line_num, &status)) {
+                break;
+            }
+
+            pipelined = false;
+        }
+
+        const char *line;
+        size_t line_len;
+        bool newline;
+
+        if (!reader_line_ready(&reader)) {
+            writer_flush(&writer);
+        }
+
+        status = reader_next_line(&reader, *mode == BATCH_MODE,
+                                  &line, &line_len, &newline);
+
+        if (status != READER_DATA) {
+            break;
+        }
+
+        line_num++;
+
+        if (line_len > 0 && line[0] != COMMENT) {
+            if (!newline) {
+                command_print_error(&writer, line_num);
             }
             else if (*mode == BATCH_MODE) {
-                batch_mode_parse_line(*g, buffer, line_num, mode);
+                batch_mode_parse_line(&writer, *g, line, line_len, line_num, mode);
             }
             else {
-                pending_mode_parse_line(g, buffer, line_num, mode);
+                pending_mode_parse_line(&writer, g, line, line_len, line_num,
+                                        mode, &workers_num);
             }
         }
+    }
 
-        errno = 0;
+    if (*mode == SESSION_MODE
+        && !sessions_run(&writer, &reader, line_num, workers_num, &status)) {
+        status = READER_ERROR;
     }
 
-    return true;
+    writer_free(&writer);
+    reader_free(&reader);
+
+    return status != READER_ERROR;
 }
@@ -14,6 +14,12 @@
 
 #include "gamma.h"
 
+/**
+ * Największa liczba argumentów polecenia, czyli tokenów następujących
+ * po tokenie określającym polecenie.
+ */
+#define ARGUMENTS_MAX_NUM 5
+
 /**
  * Typ wyliczeniowy pozwalający na przechowywanie informacji w jakim trybie pracy
  * znajduje się program.
@@ -26,33 +32,86 @@ typedef enum input_mode input_mode_t;
  */
 enum input_mode {
     PENDING_MODE,    /**< Domyślny tryb pracy programu, w którym oczekuje on
-                      *   na polecenie @ref BATCH lub @ref INTERACTIVE. */
+                      *   na polecenie @ref BATCH, @ref INTERACTIVE,
+                      *   @ref BINARY lub @ref SESSIONS. */
     BATCH_MODE,      /**< Tryb wsadowy, do którego program przechodzi w wyniku
                       *   poprawnego wykonania polecenia @ref BATCH. W trybie tym
                       *   program oczekuje poleceń, każde w osobnym wierszu. Rodzaj
                       *   polecenia jest determinowany pierwszym znakiem wiersza. */
-    INTERACTIVE_MODE /**< Tryb interaktywny, do którego program przechodzi w wyniku
+    INTERACTIVE_MODE,/**< Tryb interaktywny, do którego program przechodzi w wyniku
                       *   poprawnego wykonania polecenia @ref INTERACTIVE. W trybie
                       *   tym program wyświetla planszę, a pod nią wiersz zachęcający
                       *   gracza do wykonania ruchu. */
+    BINARY_MODE,     /**< Tryb binarny, do którego program przechodzi w wyniku
+                      *   poprawnego wykonania polecenia @ref BINARY. W trybie tym
+                      *   program oczekuje poleceń zapisanych binarnie, opisanych
+                      *   w module @ref bin_mode.h. */
+    SESSION_MODE     /**< Tryb wielu gier, do którego program przechodzi w wyniku
+                      *   poprawnego wykonania polecenia @ref SESSIONS. W trybie
+                      *   tym każde polecenie jest poprzedzone identyfikatorem
+                      *   gry, a polecenia różnych gier są wykonywane równolegle,
+                      *   jak opisano w module @ref session.h. */
 };
 
+/** @brief Dzieli linię na tokeny i konwertuje argumenty polecenia do liczb.
+ * Przechodzi linię jeden raz, bez jej modyfikowania, dzieląc ją na tokeny
+ * według białych znaków i od razu wyznaczając wartości tokenów następujących
+ * po pierwszym, jednoznakowym tokenie określającym polecenie. Znak @p '\0'
+ * nie jest ani białym znakiem, ani cyfrą, więc linia go zawierająca jest
+ * zawsze niepoprawna.
+ * @param[in] line          – wskaźnik na pierwszy znak linii, niebędący białym
+ *                            znakiem,
+ * @param[in] line_len      – długość linii bez kończącego ją znaku nowej linii,
+ * @param[out] arguments    – tablica, do której mają zostać zapisane argumenty,
+ * @param[in] arguments_len – długość tablicy @p arguments, oczekiwana liczba
+ *                            argumentów.
+ * @return Wartość @p true, jeżeli pierwszy token ma długość równą 1, liczba
+ * pozostałych tokenów jest równa @p arguments_len, a każdy z nich jest zapisem
+ * nieujemnej liczby nieprzekraczającej wartości @p UINT32_MAX, a @p false
+ * w przeciwnym przypadku.
+ */
+bool line_parse_arguments(const char *line, size_t line_len,
+                          uint32_t arguments[], size_t arguments_len);
+
+/** @brief Dekoduje linię w trybie wsadowym.
+ * Parsuje linię i sprawdza, czy otrzymane tokeny reprezentują poprawne
+ * polecenie w trybie wsadowym. Nie zależy od stanu gry, więc może być
+ * wywoływana w innym wątku niż ten, który wykonuje polecenia.
+ * @param[in] line       – wskaźnik do bufora zawierającego linię do interpretacji,
+ * @param[in] line_len   – długość linii bez kończącego ją znaku nowej linii,
+ * @param[out] arguments – tablica o długości @ref ARGUMENTS_MAX_NUM, do której
+ *                         mają zostać zapisane argumenty polecenia.
+ * @return Wartość @p true, jeżeli linia zawiera poprawne polecenie w trybie
+ * wsadowym, a @p false w przeciwnym przypadku.
+ */
+bool batch_mode_decode_line(const char *line, size_t line_len,
+                            uint32_t arguments[]);
+
 /** @brief Wczytuje kolejne linie ze standardowego wejścia i je interpretuje.
  * Wczytuje kolejne linie ze standardowego wejścia i dokonuje ich interpretacji,
  * komunikaty o poprawnym wykonaniu poleceń wypisując na standardowe wyjście,
  * a komunikaty o błędach wypisując na standardowe wyjście diagnostyczne.
+ * Jeżeli standardowe wejście jest zwykłym plikiem, jest ono odwzorowywane
+ * w pamięci, a w przeciwnym przypadku w trybie wsadowym jest wczytywane dużymi
+ * blokami. Linie są interpretowane w miejscu, bez kopiowania. Po przejściu
+ * w tryb interaktywny lub binarny pierwszy nieprzetworzony znak jest kolejnym
+ * znakiem standardowego wejścia. Komunikaty są gromadzone w buforach
+ * i wypisywane w całości przed zakończeniem działania funkcji.
+ * W trybie potokowym, po przejściu w tryb wsadowy, linie są dekodowane
+ * w osobnym wątku, a polecenia są wykonywane w wątku wołającym, przy czym
+ * wypisywane komunikaty są takie same jak w zwykłym trybie.
+ * Po przejściu w tryb wielu gier funkcja wykonuje polecenia do końca wejścia
+ * w puli wątków roboczych, a po powrocie z niej nie istnieje żadna gra.
  * @param[in,out] g       – wskaźnik na strukturę przechowującą stan gry,
- * @param[in,out] buf     – wskaźnik do wskaźnika na bufor, do którego mają być
- *                          wczytywane linie,
- * @param[in] buffer_size – rozmiar bufora wskazywanego przez wskaźnik, na który
- *                          to wskaźnik wskazuje wskaźnik @p buf,
  * @param[in,out] mode    – wskaźnik na zmienną przyjmującą jedną z wartości
  *                          zdefiniowanych w wyliczeniu @ref input_mode,
- *                          określającą, w jakim trybie aktualnie pracuje program.
+ *                          określającą, w jakim trybie aktualnie pracuje program,
+ * @param[in] pipelined   – wartość @p true, jeżeli tryb wsadowy ma działać
+ *                          potokowo.
  * @return Wartość @p false, gdy podczas wczytywania linii wystąpił błąd krytyczny
  * uniemożliwiający dalsze działania programu, na przykład spowodowany brakiem
  * pamięci, a @p true w przeciwnym przypadku.
  */
-bool read_lines(gamma_t **g, char **buf, size_t buffer_size, input_mode_t *mode);
+bool read_lines(gamma_t **g, input_mode_t *mode, bool pipelined);
 
 #endif // PARSER_H
@@ -10,6 +10,23 @@
 
 #include <stdbool.h>
 
+struct field;
+
+/**
+ * Typ struktury przechowującej wpis na liście obserwatorów gracza.
+ */
+typedef struct player_watch player_watch_t;
+
+/**
+ * Struktura przechowująca wpis na liście obserwatorów gracza.
+ */
+struct player_watch {
+    uint32_t player; /**< Numer gracza obserwującego. */
+    uint64_t stamp;  /**< Znacznik przeglądu sąsiadów, w którym dopisano wpis.
+                      *   Wpis jest aktualny, jeżeli jest równy wartości
+                      *   @p watch_stamp gracza obserwującego. */
+};
+
 /**
  * Typ struktury przechowującej stan gracza.
  */
@@ -24,9 +41,53 @@ struct player {
     uint64_t busy_fields; /**< Liczba pól zajętych przez gracza. */
     uint32_t areas;       /**< Liczba obszarów zajętych przez gracza. */
     uint64_t perimeter;   /**< Obwód gracza, liczba wolnych pól sąsiadujących
-                           *   z przynajmniej jednym polem gracza. */
+                           *   z przynajmniej jednym polem gracza, równa liczbie
+                           *   elementów tablicy @p perimeter_fields, jeżeli
+                           *   gra utrzymuje zbiory pól. */
+    struct field **perimeter_fields; /**< Tablica wolnych pól sąsiadujących
+                                      *   z przynajmniej jednym polem gracza,
+                                      *   w dowolnej kolejności, aktualna tylko
+                                      *   wtedy, gdy gra utrzymuje zbiory pól. */
+    uint64_t perimeter_capacity;     /**< Liczba elementów, które mieszczą się
+                                      *   w tablicy @p perimeter_fields. */
     bool golden_possible; /**< Wartość @p true, jeżeli gracz nie wykonał jeszcze
                            *   złotego ruchu, a @p false w przeciwnym przypadku. */
+    struct field *first_area; /**< Wskaźnik na korzeń pierwszego obszaru na liście
+                               *   obszarów zajętych przez gracza lub NULL, jeżeli
+                               *   gracz nie zajmuje żadnego obszaru. */
+    bool active;          /**< Wartość @p true, jeżeli gracz może wykonać ruch lub
+                           *   złoty ruch, a @p false w przeciwnym przypadku. */
+    bool dirty;           /**< Wartość @p true, jeżeli od ostatniego wyznaczenia
+                           *   wartości @p active mogła się ona zmienić. */
+    bool dependent;       /**< Wartość @p true, jeżeli gracz nie może wykonać
+                           *   zwykłego ruchu, ale nie wykonał jeszcze złotego
+                           *   ruchu, a nie udało się zapisać go jako obserwatora
+                           *   sąsiadów, więc wartość @p active trzeba wyznaczać
+                           *   po każdym ruchu. */
+    player_watch_t *watchers; /**< Tablica wpisów graczy, których możliwość
+                               *   wykonania złotego ruchu zależy od obszarów
+                               *   tego gracza, bo sąsiadują z jego polami. */
+    uint32_t watchers_num;    /**< Liczba elementów tablicy @p watchers. */
+    uint32_t watchers_capacity; /**< Liczba elementów, które mieszczą się
+                                 *   w tablicy @p watchers. */
+    uint64_t watch_stamp; /**< Znacznik ostatniego przeglądu sąsiadów gracza,
+                           *   w którym dopisał się on do list obserwatorów,
+                           *   lub 0, jeżeli jego wpisy nie są aktualne. */
+    uint64_t watched_stamp; /**< Znacznik ostatniego przeglądu sąsiadów, który
+                             *   dopisał obserwatora do listy tego gracza. */
+    uint32_t next_active; /**< Numer następnego aktywnego gracza na cyklicznej
+                           *   liście aktywnych graczy. */
+    uint32_t prev_active; /**< Numer poprzedniego aktywnego gracza na cyklicznej
+                           *   liście aktywnych graczy. */
+    uint64_t golden_memo_stamp; /**< Znacznik stanu gry, dla którego zapamiętano
+                                 *   wartość @p golden_memo, lub 0, jeżeli
+                                 *   żadnej wartości nie zapamiętano. */
+    bool golden_memo;     /**< Zapamiętany wynik funkcji
+                           *   @ref gamma_golden_possible. */
+    uint64_t free_memo_stamp; /**< Znacznik stanu gry, dla którego zapamiętano
+                               *   wartość @p free_memo, lub 0, jeżeli żadnej
+                               *   wartości nie zapamiętano. */
+    uint64_t free_memo;   /**< Zapamiętany wynik funkcji @ref gamma_free_fields. */
 };
 
 /** @brief Inicjuje strukturę przechowującą stan gracza.
@@ -41,7 +102,24 @@ static inline void player_init(player_t *p, uint32_t number) {
     p->busy_fields = 0;
     p->areas = 0;
     p->perimeter = 0;
+    p->perimeter_fields = NULL;
+    p->perimeter_capacity = 0;
     p->golden_possible = true;
+    p->first_area = NULL;
+    p->active = false;
+    p->dirty = false;
+    p->dependent = false;
+    p->watchers = NULL;
+    p->watchers_num = 0;
+    p->watchers_capacity = 0;
+    p->watch_stamp = 0;
+    p->watched_stamp = 0;
+    p->next_active = number;
+    p->prev_active = number;
+    p->golden_memo_stamp = 0;
+    p->golden_memo = false;
+    p->free_memo_stamp = 0;
+    p->free_memo = 0;
 }
 
 /** @brief Podaje numer gracza.
@@ -115,6 +193,36 @@ static inline void player_set_perimeter(player_t *p, uint64_t perimeter) {
     p->perimeter = perimeter;
 }
 
+/** @brief Podaje tablicę pól obwodu gracza.
+ * @param[in] p               – wskaźnik na strukturę przechowującą stan gracza.
+ * @return Tablica wolnych pól sąsiadujących z co najmniej jednym polem zajętym
+ * przez gracza wskazywanego przez @p p, o długości równej jego obwodowi.
+ */
+static inline struct field **player_perimeter_fields(player_t *p) {
+    return p->perimeter_fields;
+}
+
+/** @brief Podaje pojemność tablicy pól obwodu gracza.
+ * @param[in] p               – wskaźnik na strukturę przechowującą stan gracza.
+ * @return Liczba elementów, które mieszczą się w tablicy pól obwodu gracza
+ * wskazywanego przez @p p.
+ */
+static inline uint64_t player_perimeter_capacity(player_t *p) {
+    return p->perimeter_capacity;
+}
+
+/** @brief Aktualizuje tablicę pól obwodu gracza.
+ * @param[in,out] p           – wskaźnik na strukturę przechowującą stan gracza,
+ * @param[in] fields          – tablica pól obwodu gracza,
+ * @param[in] capacity        – liczba elementów, które mieszczą się w tablicy
+ *                              @p fields.
+ */
+static inline void player_set_perimeter_fields(player_t *p, struct field **fields,
+                                               uint64_t capacity) {
+    p->perimeter_fields = fields;
+    p->perimeter_capacity = capacity;
+}
+
 /** @brief Sprawdza, czy gracz nie wykonał jeszcze złotego ruchu.
  * Sprawdza, czy gracz wskazywany przez @p p nie wykonał w tej rozgrywce
  * złotego ruchu.
@@ -138,4 +246,247 @@ static inline void player_set_golden_possible(player_t *p, bool golden_possible)
     p->golden_possible = golden_possible;
 }
 
+/** @brief Podaje korzeń pierwszego obszaru gracza.
+ * Podaje wskaźnik @p first_area gracza wskazywanego przez @p p.
+ * @param[in] p               – wskaźnik na strukturę przechowującą stan gracza.
+ * @return Wskaźnik na korzeń pierwszego obszaru na liście obszarów gracza
+ * lub NULL, jeżeli gracz nie zajmuje żadnego obszaru.
+ */
+static inline struct field *player_first_area(player_t *p) {
+    return p->first_area;
+}
+
+/** @brief Aktualizuje korzeń pierwszego obszaru gracza.
+ * Przypisuje składowej @p first_area gracza wskazywanego przez @p p wartość
+ * zmiennej @p first_area będącej parametrem procedury.
+ * @param[in,out] p           – wskaźnik na strukturę przechowującą stan gracza,
+ * @param[in] first_area      – wskaźnik na korzeń pierwszego obszaru na liście
+ *                              obszarów gracza lub NULL.
+ */
+static inline void player_set_first_area(player_t *p, struct field *first_area) {
+    p->first_area = first_area;
+}
+
+/** @brief Sprawdza, czy gracz może wykonać ruch.
+ * @param[in] p               – wskaźnik na strukturę przechowującą stan gracza.
+ * @return Wartość @p true, jeżeli gracz wskazywany przez @p p był aktywny
+ * przy ostatnim wyznaczeniu tej wartości, a @p false w przeciwnym przypadku.
+ */
+static inline bool player_active(player_t *p) {
+    return p->active;
+}
+
+/** @brief Aktualizuje informację, czy gracz może wykonać ruch.
+ * @param[in,out] p           – wskaźnik na strukturę przechowującą stan gracza,
+ * @param[in] active          – wartość @p true, jeżeli gracz jest aktywny,
+ *                              a @p false w przeciwnym przypadku.
+ */
+static inline void player_set_active(player_t *p, bool active) {
+    p->active = active;
+}
+
+/** @brief Sprawdza, czy aktywność gracza wymaga ponownego wyznaczenia.
+ * @param[in] p               – wskaźnik na strukturę przechowującą stan gracza.
+ * @return Wartość składowej @p dirty gracza wskazywanego przez @p p.
+ */
+static inline bool player_dirty(player_t *p) {
+    return p->dirty;
+}
+
+/** @brief Oznacza, czy aktywność gracza wymaga ponownego wyznaczenia.
+ * @param[in,out] p           – wskaźnik na strukturę przechowującą stan gracza,
+ * @param[in] dirty           – nowa wartość składowej @p dirty.
+ */
+static inline void player_set_dirty(player_t *p, bool dirty) {
+    p->dirty = dirty;
+}
+
+/** @brief Sprawdza, czy aktywność gracza zależy tylko od złotego ruchu.
+ * @param[in] p               – wskaźnik na strukturę przechowującą stan gracza.
+ * @return Wartość składowej @p dependent gracza wskazywanego przez @p p.
+ */
+static inline bool player_dependent(player_t *p) {
+    return p->dependent;
+}
+
+/** @brief Oznacza, czy aktywność gracza zależy tylko od złotego ruchu.
+ * @param[in,out] p           – wskaźnik na strukturę przechowującą stan gracza,
+ * @param[in] dependent       – nowa wartość składowej @p dependent.
+ */
+static inline void player_set_dependent(player_t *p, bool dependent) {
+    p->dependent = dependent;
+}
+
+/** @brief Podaje tablicę wpisów na liście obserwatorów gracza.
+ * @param[in] p               – wskaźnik na strukturę przechowującą stan gracza.
+ * @return Tablica wpisów na liście obserwatorów gracza wskazywanego przez @p p.
+ */
+static inline player_watch_t *player_watchers(player_t *p) {
+    return p->watchers;
+}
+
+/** @brief Podaje liczbę wpisów na liście obserwatorów gracza.
+ * @param[in] p               – wskaźnik na strukturę przechowującą stan gracza.
+ * @return Liczba elementów tablicy wpisów na liście obserwatorów gracza
+ * wskazywanego przez @p p, wliczając wpisy nieaktualne.
+ */
+static inline uint32_t player_watchers_num(player_t *p) {
+    return p->watchers_num;
+}
+
+/** @brief Aktualizuje liczbę wpisów na liście obserwatorów gracza.
+ * @param[in,out] p           – wskaźnik na strukturę przechowującą stan gracza,
+ * @param[in] watchers_num    – nowa liczba elementów tablicy wpisów.
+ */
+static inline void player_set_watchers_num(player_t *p, uint32_t watchers_num) {
+    p->watchers_num = watchers_num;
+}
+
+/** @brief Podaje pojemność tablicy wpisów na liście obserwatorów gracza.
+ * @param[in] p               – wskaźnik na strukturę przechowującą stan gracza.
+ * @return Liczba elementów, które mieszczą się w tablicy wpisów na liście
+ * obserwatorów gracza wskazywanego przez @p p.
+ */
+static inline uint32_t player_watchers_capacity(player_t *p) {
+    return p->watchers_capacity;
+}
+
+/** @brief Aktualizuje tablicę wpisów na liście obserwatorów gracza.
+ * @param[in,out] p           – wskaźnik na strukturę przechowującą stan gracza,
+ * @param[in] watchers        – tablica wpisów,
+ * @param[in] capacity        – liczba elementów, które mieszczą się w tablicy
+ *                              @p watchers.
+ */
+static inline void player_set_watchers(player_t *p, player_watch_t *watchers,
+                                       uint32_t capacity) {
+    p->watchers = watchers;
+    p->watchers_capacity = capacity;
+}
+
+/** @brief Podaje znacznik ostatniego przeglądu sąsiadów gracza.
+ * @param[in] p               – wskaźnik na strukturę przechowującą stan gracza.
+ * @return Wartość składowej @p watch_stamp gracza wskazywanego przez @p p.
+ */
+static inline uint64_t player_watch_stamp(player_t *p) {
+    return p->watch_stamp;
+}
+
+/** @brief Aktualizuje znacznik ostatniego przeglądu sąsiadów gracza.
+ * @param[in,out] p           – wskaźnik na strukturę przechowującą stan gracza,
+ * @param[in] watch_stamp     – nowa wartość składowej @p watch_stamp.
+ */
+static inline void player_set_watch_stamp(player_t *p, uint64_t watch_stamp) {
+    p->watch_stamp = watch_stamp;
+}
+
+/** @brief Podaje znacznik przeglądu, który ostatnio dopisał obserwatora gracza.
+ * @param[in] p               – wskaźnik na strukturę przechowującą stan gracza.
+ * @return Wartość składowej @p watched_stamp gracza wskazywanego przez @p p.
+ */
+static inline uint64_t player_watched_stamp(player_t *p) {
+    return p->watched_stamp;
+}
+
+/** @brief Aktualizuje znacznik przeglądu, który ostatnio dopisał obserwatora.
+ * @param[in,out] p           – wskaźnik na strukturę przechowującą stan gracza,
+ * @param[in] watched_stamp   – nowa wartość składowej @p watched_stamp.
+ */
+static inline void player_set_watched_stamp(player_t *p, uint64_t watched_stamp) {
+    p->watched_stamp = watched_stamp;
+}
+
+/** @brief Podaje numer następnego gracza na liście aktywnych graczy.
+ * Dla gracza usuniętego z listy podaje numer gracza, który był jego następnikiem
+ * w chwili usunięcia.
+ * @param[in] p               – wskaźnik na strukturę przechowującą stan gracza.
+ * @return Numer następnego gracza na liście aktywnych graczy.
+ */
+static inline uint32_t player_next_active(player_t *p) {
+    return p->next_active;
+}
+
+/** @brief Podaje numer poprzedniego gracza na liście aktywnych graczy.
+ * Dla gracza usuniętego z listy podaje numer gracza, który był jego poprzednikiem
+ * w chwili usunięcia.
+ * @param[in] p               – wskaźnik na strukturę przechowującą stan gracza.
+ * @return Numer poprzedniego gracza na liście aktywnych graczy.
+ */
+static inline uint32_t player_prev_active(player_t *p) {
+    return p->prev_active;
+}
+
+/** @brief Aktualizuje numer następnego gracza na liście aktywnych graczy.
+ * @param[in,out] p           – wskaźnik na strukturę przechowującą stan gracza,
+ * @param[in] next_active     – numer następnego gracza.
+ */
+static inline void player_set_next_active(player_t *p, uint32_t next_active) {
+    p->next_active = next_active;
+}
+
+/** @brief Aktualizuje numer poprzedniego gracza na liście aktywnych graczy.
+ * @param[in,out] p           – wskaźnik na strukturę przechowującą stan gracza,
+ * @param[in] prev_active     – numer poprzedniego gracza.
+ */
+static inline void player_set_prev_active(player_t *p, uint32_t prev_active) {
+    p->prev_active = prev_active;
+}
+
+/** @brief Sprawdza, czy zapamiętano wynik funkcji @ref gamma_golden_possible.
+ * @param[in] p               – wskaźnik na strukturę przechowującą stan gracza,
+ * @param[in] stamp           – znacznik bieżącego stanu gry, liczba dodatnia.
+ * @return Wartość @p true, jeżeli wynik zapamiętano dla stanu gry o znaczniku
+ * @p stamp, a @p false w przeciwnym przypadku.
+ */
+static inline bool player_golden_memo_valid(player_t *p, uint64_t stamp) {
+    return p->golden_memo_stamp == stamp;
+}
+
+/** @brief Podaje zapamiętany wynik funkcji @ref gamma_golden_possible.
+ * @param[in] p               – wskaźnik na strukturę przechowującą stan gracza.
+ * @return Zapamiętany wynik.
+ */
+static inline bool player_golden_memo(player_t *p) {
+    return p->golden_memo;
+}
+
+/** @brief Zapamiętuje wynik funkcji @ref gamma_golden_possible.
+ * @param[in,out] p           – wskaźnik na strukturę przechowującą stan gracza,
+ * @param[in] stamp           – znacznik bieżącego stanu gry, liczba dodatnia,
+ * @param[in] golden_memo     – zapamiętywany wynik.
+ */
+static inline void player_set_golden_memo(player_t *p, uint64_t stamp,
+                                          bool golden_memo) {
+    p->golden_memo_stamp = stamp;
+    p->golden_memo = golden_memo;
+}
+
+/** @brief Sprawdza, czy zapamiętano wynik funkcji @ref gamma_free_fields.
+ * @param[in] p               – wskaźnik na strukturę przechowującą stan gracza,
+ * @param[in] stamp           – znacznik bieżącego stanu gry, liczba dodatnia.
+ * @return Wartość @p true, jeżeli wynik zapamiętano dla stanu gry o znaczniku
+ * @p stamp, a @p false w przeciwnym przypadku.
+ */
+static inline bool player_free_memo_valid(player_t *p, uint64_t stamp) {
+    return p->free_memo_stamp == stamp;
+}
+
+/** @brief Podaje zapamiętany wynik funkcji @ref gamma_free_fields.
+ * @param[in] p               – wskaźnik na strukturę przechowującą stan gracza.
+ * @return Zapamiętany wynik.
+ */
+static inline uint64_t player_free_memo(player_t *p) {
+    return p->free_memo;
+}
+
+/** @brief Zapamiętuje wynik funkcji @ref gamma_free_fields.
+ * @param[in,out] p           – wskaźnik na strukturę przechowującą stan gracza,
+ * @param[in] stamp           – znacznik bieżącego stanu gry, liczba dodatnia,
+ * @param[in] free_memo       – zapamiętywany wynik.
+ */
+static inline void player_set_free_memo(player_t *p, uint64_t stamp,
+                                        uint64_t free_memo) {
+    p->free_memo_stamp = stamp;
+    p->free_memo = free_memo;
+}
+
 #endif // PLAYER_H
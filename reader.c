@@ -0,0 +1,229 @@
+/** @file
+ * Implementacja modułu odpowiedzialnego za wczytywanie linii z deskryptora pliku
+ * bez kopiowania ich do osobnych buforów
+ *
+ * @author Szymon Czyżmański 417797
+ * @date 21.05.2020
+ */
+
+/**
+ * Dostęp do funkcji madvise.
+ */
+#define _GNU_SOURCE
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "reader.h"
+
+/**
+ * Początkowy rozmiar bufora, a zarazem największa liczba znaków wczytywanych
+ * jednym wywołaniem funkcji @p read.
+ */
+#define READER_BLOCK_SIZE (1 << 20)
+
+/** @brief Odwzorowuje w pamięci nieprzeczytaną część zwykłego pliku.
+ * @param[in,out] r  – wskaźnik na strukturę przechowującą stan czytnika,
+ * @param[in] st     – wskaźnik na strukturę opisującą plik.
+ * @return Wartość @p true, jeżeli odwzorowano plik lub nie ma w nim danych
+ * do przeczytania, a @p false w przeciwnym przypadku.
+ */
+static bool reader_map(reader_t *r, const struct stat *st) {
+    off_t position = lseek(r->fd, 0, SEEK_CUR);
+    long page = sysconf(_SC_PAGESIZE);
+
+    if (position < 0 || page <= 0) {
+        return false;
+    }
+    else if (position >= st->st_size) {
+        r->origin = position;
+        r->eof = true;
+        return true;
+    }
+    else {
+        off_t aligned = position - position % page;
+
+        if ((uintmax_t) (st->st_size - aligned) > SIZE_MAX) {
+            return false;
+        }
+
+        size_t length = st->st_size - aligned;
+        void *map = mmap(NULL, length, PROT_READ, MAP_PRIVATE, r->fd, aligned);
+
+        if (map == MAP_FAILED) {
+            return false;
+        }
+        else {
+            madvise(map, length, MADV_SEQUENTIAL);
+            r->data = map;
+            r->begin = position - aligned;
+            r->end = length;
+            r->origin = aligned;
+            r->eof = true;
+            return true;
+        }
+    }
+}
+
+bool reader_init(reader_t *r, int fd) {
+    struct stat st;
+
+    *r = (reader_t) {
+        .fd = fd,
+        .data = NULL,
+        .begin = 0,
+        .checked = 0,
+        .end = 0,
+        .capacity = 0,
+        .origin = 0,
+        .regular = fstat(fd, &st) == 0 && S_ISREG(st.st_mode),
+        .eof = false
+    };
+
+    if (r->regular && reader_map(r, &st)) {
+        return true;
+    }
+    else {
+        r->origin = r->regular ? lseek(fd, 0, SEEK_CUR) : 0;
+        r->data = malloc(READER_BLOCK_SIZE);
+        r->capacity = READER_BLOCK_SIZE;
+
+        return r->data != NULL;
+    }
+}
+
+/** @brief Wczytuje kolejną porcję danych do bufora.
+ * Przesuwa nieprzetworzone dane na początek bufora, w razie potrzeby
+ * podwajając jego rozmiar, i dopisuje za nimi dane wczytane z deskryptora.
+ * @param[in,out] r    – wskaźnik na strukturę przechowującą stan czytnika,
+ * @param[in] greedy   – wartość @p true, jeżeli wolno wczytać cały blok,
+ *                       a @p false, jeżeli należy wczytać jeden znak.
+ * @return Wartość @p true, jeżeli wczytano dane lub napotkano koniec danych,
+ * a @p false, gdy nie udało się zaalokować pamięci.
+ */
+static bool reader_fill(reader_t *r, bool greedy) {
+    if (r->begin > 0) {
+        memmove(r->data, r->data + r->begin, r->end - r->begin);
+        r->origin += r->begin;
+        r->end -= r->begin;
+        r->begin = 0;
+    }
+
+    if (r->end == r->capacity) {
+        char *grown = r->capacity <= SIZE_MAX / 2 ? realloc(r->data, 2 * r->capacity)
+                                                  : NULL;
+
+        if (grown == NULL) {
+            return false;
+        }
+
+        r->data = grown;
+        r->capacity *= 2;
+    }
+
+    size_t wanted = greedy ? r->capacity - r->end : 1;
+    ssize_t got;
+
+    do {
+        got = read(r->fd, r->data + r->end, wanted);
+    } while (got < 0 && errno == EINTR);
+
+    if (got <= 0) {
+        r->eof = true;
+    }
+    else {
+        r->end += got;
+    }
+
+    return true;
+}
+
+bool reader_line_ready(const reader_t *r) {
+    size_t from = r->begin + r->checked;
+
+    return r->regular || r->eof
+           || (from < r->end && memchr(r->data + from, '\n', r->end - from));
+}
+
+reader_status_t reader_next_line(reader_t *r, bool greedy, const char **line,
+                                 size_t *len, bool *newline) {
+    greedy = greedy || r->regular;
+
+    while (true) {
+        size_t from = r->begin + r->checked;
+        const char *found = NULL;
+
+        if (from < r->end) {
+            found = memchr(r->data + from, '\n', r->end - from);
+        }
+
+        if (found != NULL) {
+            *line = r->data + r->begin;
+            *len = found - *line;
+            *newline = true;
+            r->begin += *len + 1;
+            r->checked = 0;
+            return READER_DATA;
+        }
+        else if (r->eof) {
+            if (r->begin == r->end) {
+                return READER_EOF;
+            }
+
+            *line = r->data + r->begin;
+            *len = r->end - r->begin;
+            *newline = false;
+            r->begin = r->end;
+            r->checked = 0;
+            return READER_DATA;
+        }
+        else {
+            r->checked = r->end - r->begin;
+
+            if (!reader_fill(r, greedy)) {
+                return READER_ERROR;
+            }
+        }
+    }
+}
+
+reader_status_t reader_next_bytes(reader_t *r, size_t len, const char **data) {
+    while (r->end - r->begin < len) {
+        if (r->eof) {
+            r->begin = r->end;
+            r->checked = 0;
+            return READER_EOF;
+        }
+        else if (!reader_fill(r, true)) {
+            return READER_ERROR;
+        }
+    }
+
+    *data = r->data + r->begin;
+    r->begin += len;
+    r->checked = 0;
+
+    return READER_DATA;
+}
+
+void reader_free(reader_t *r) {
+    if (r->regular) {
+        lseek(r->fd, r->origin + (off_t) r->begin, SEEK_SET);
+    }
+
+    if (r->capacity == 0) {
+        if (r->data != NULL) {
+            munmap(r->data, r->end);
+        }
+    }
+    else {
+        free(r->data);
+    }
+
+    r->data = NULL;
+}
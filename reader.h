@@ -0,0 +1,129 @@
+/** @file
+ * Interfejs modułu odpowiedzialnego za wczytywanie linii z deskryptora pliku
+ * bez kopiowania ich do osobnych buforów
+ *
+ * @author Szymon Czyżmański 417797
+ * @date 21.05.2020
+ */
+
+#ifndef READER_H
+#define READER_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <sys/types.h>
+
+/**
+ * Typ struktury przechowującej stan czytnika linii.
+ */
+typedef struct reader reader_t;
+
+/**
+ * Struktura przechowująca stan czytnika linii. Dane są albo odwzorowane
+ * w pamięci za pomocą funkcji @p mmap, jeżeli deskryptor wskazuje na zwykły
+ * plik, albo wczytywane dużymi blokami do bufora.
+ */
+struct reader {
+    int fd;           /**< Deskryptor, z którego są wczytywane dane. */
+    char *data;       /**< Odwzorowany plik lub bufor z wczytanymi danymi. */
+    size_t begin;     /**< Indeks pierwszego nieprzetworzonego znaku. */
+    size_t checked;   /**< Liczba znaków od indeksu @p begin, o których
+                       *   wiadomo, że nie są znakiem nowej linii. */
+    size_t end;       /**< Indeks za ostatnim wczytanym znakiem. */
+    size_t capacity;  /**< Rozmiar bufora lub 0, jeżeli plik jest odwzorowany
+                       *   w pamięci. */
+    off_t origin;     /**< Pozycja w pliku odpowiadająca znakowi @p data[0]. */
+    bool regular;     /**< Wartość @p true, jeżeli deskryptor wskazuje na zwykły
+                       *   plik, którego pozycję można przestawić. */
+    bool eof;         /**< Wartość @p true, jeżeli wczytano już wszystkie dane. */
+};
+
+/**
+ * Typ wyliczeniowy opisujący wynik próby wczytania linii.
+ */
+typedef enum reader_status reader_status_t;
+
+/**
+ * Wyliczenia opisujące wynik próby wczytania linii.
+ */
+enum reader_status {
+    READER_DATA,  /**< Wczytano linię lub blok danych. */
+    READER_EOF,   /**< Nie ma więcej danych. */
+    READER_ERROR  /**< Nie udało się zaalokować pamięci na bufor. */
+};
+
+/** @brief Inicjuje czytnik linii.
+ * Jeżeli deskryptor @p fd wskazuje na zwykły plik, odwzorowuje w pamięci jego
+ * nieprzeczytaną część, a w przeciwnym przypadku alokuje bufor na bloki danych.
+ * @param[out] r  – wskaźnik na strukturę przechowującą stan czytnika,
+ * @param[in] fd  – deskryptor, z którego mają być wczytywane dane.
+ * @return Wartość @p true, jeżeli zainicjowano czytnik, a @p false, gdy nie
+ * udało się zaalokować pamięci.
+ */
+bool reader_init(reader_t *r, int fd);
+
+/** @brief Podaje kolejną linię.
+ * Wyszukuje kolejną linię, w razie potrzeby wczytując dane. Linia pozostaje
+ * w buforze czytnika i jest ważna do następnego wywołania tej funkcji.
+ * Jeżeli @p greedy jest równe @p false, a pozycji deskryptora nie można
+ * przestawić, dane są wczytywane po jednym znaku, tak aby nie pobrać z deskryptora
+ * żadnego znaku spoza zwracanej linii.
+ * @param[in,out] r    – wskaźnik na strukturę przechowującą stan czytnika,
+ * @param[in] greedy   – wartość @p true, jeżeli wolno wczytać dane spoza linii,
+ * @param[out] line    – wskaźnik na zmienną, w której ma zostać zapisany
+ *                       wskaźnik na pierwszy znak linii,
+ * @param[out] len     – wskaźnik na zmienną, w której ma zostać zapisana
+ *                       długość linii bez kończącego ją znaku nowej linii,
+ * @param[out] newline – wskaźnik na zmienną, w której ma zostać zapisana
+ *                       informacja, czy linia kończy się znakiem nowej linii.
+ * @return Wartość @ref reader_status::READER_DATA, jeżeli wczytano linię,
+ * @ref reader_status::READER_EOF, jeżeli nie ma więcej danych lub wystąpił błąd
+ * odczytu, a @ref reader_status::READER_ERROR, gdy nie udało się zaalokować
+ * pamięci.
+ */
+reader_status_t reader_next_line(reader_t *r, bool greedy, const char **line,
+                                 size_t *len, bool *newline);
+
+/** @brief Sprawdza, czy linię można pobrać bez czekania na dane.
+ * @param[in] r – wskaźnik na strukturę przechowującą stan czytnika.
+ * @return Wartość @p true, jeżeli w buforze czytnika jest cała linia,
+ * wczytano już wszystkie dane lub deskryptor wskazuje na zwykły plik,
+ * a @p false, jeżeli pobranie linii mogłoby wymagać czekania na dane.
+ */
+bool reader_line_ready(const reader_t *r);
+
+/** @brief Podaje kolejny blok danych o zadanej długości.
+ * Wczytuje dane, dopóki w buforze czytnika nie znajdzie się @p len
+ * nieprzetworzonych znaków. Blok pozostaje w buforze czytnika i jest ważny
+ * do następnego wywołania funkcji wczytującej.
+ * @param[in,out] r – wskaźnik na strukturę przechowującą stan czytnika,
+ * @param[in] len   – długość bloku,
+ * @param[out] data – wskaźnik na zmienną, w której ma zostać zapisany
+ *                    wskaźnik na pierwszy znak bloku.
+ * @return Wartość @ref reader_status::READER_DATA, jeżeli wczytano blok,
+ * @ref reader_status::READER_EOF, jeżeli dane skończyły się przed końcem bloku
+ * lub wystąpił błąd odczytu, a @ref reader_status::READER_ERROR, gdy nie udało
+ * się zaalokować pamięci.
+ */
+reader_status_t reader_next_bytes(reader_t *r, size_t len, const char **data);
+
+/** @brief Sprawdza, czy blok danych można pobrać bez czekania na dane.
+ * @param[in] r   – wskaźnik na strukturę przechowującą stan czytnika,
+ * @param[in] len – długość bloku.
+ * @return Wartość @p true, jeżeli w buforze czytnika jest co najmniej @p len
+ * nieprzetworzonych znaków lub wczytano już wszystkie dane, a @p false, jeżeli
+ * pobranie bloku wymagałoby odczytu z deskryptora.
+ */
+static inline bool reader_ready(const reader_t *r, size_t len) {
+    return r->eof || r->end - r->begin >= len;
+}
+
+/** @brief Zwalnia zasoby czytnika.
+ * Jeżeli pozycję deskryptora można przestawić, ustawia ją za ostatnią zwróconą
+ * linią, tak aby dalsze wczytywanie, na przykład przez standardowy strumień,
+ * rozpoczęło się od pierwszego nieprzetworzonego znaku.
+ * @param[in,out] r – wskaźnik na strukturę przechowującą stan czytnika.
+ */
+void reader_free(reader_t *r);
+
+#endif // READER_H
@@ -0,0 +1,166 @@
+/** @file
+ * Implementacja modułu implementującego kolejkę cykliczną o jednym producencie
+ * i jednym konsumencie
+ *
+ * @author Szymon Czyżmański 417797
+ * @date 22.05.2020
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <sched.h>
+
+#include "ring.h"
+
+/**
+ * Liczba prób, po których czekający wątek przestaje oddawać procesor
+ * i zasypia.
+ */
+#define RING_SPINS 32
+
+bool ring_init(ring_t *r, size_t capacity, size_t element_size) {
+    r->data = malloc(capacity * element_size);
+    r->mask = capacity - 1;
+    r->element_size = element_size;
+    atomic_init(&r->head, 0);
+    r->tail_cache = 0;
+    atomic_init(&r->consumer_sleeping, false);
+    atomic_init(&r->tail, 0);
+    r->head_cache = 0;
+    atomic_init(&r->producer_sleeping, false);
+    atomic_init(&r->closed, false);
+
+    if (r->data == NULL) {
+        return false;
+    }
+    else if (pthread_mutex_init(&r->lock, NULL) != 0) {
+        free(r->data);
+        return false;
+    }
+    else if (pthread_cond_init(&r->wakeup, NULL) != 0) {
+        pthread_mutex_destroy(&r->lock);
+        free(r->data);
+        return false;
+    }
+    else {
+        return true;
+    }
+}
+
+/** @brief Sprawdza, czy konsument może kontynuować.
+ * Odświeża zapamiętaną przez konsumenta wartość pola @p tail.
+ * @param[in,out] r – wskaźnik na strukturę przechowującą kolejkę.
+ * @return Wartość @p true, jeżeli kolejka nie jest pusta lub jest zamknięta,
+ * a @p false w przeciwnym przypadku.
+ */
+static bool ring_consumer_ready(ring_t *r) {
+    bool closed = atomic_load_explicit(&r->closed, memory_order_acquire);
+    r->tail_cache = atomic_load_explicit(&r->tail, memory_order_acquire);
+
+    return closed || r->tail_cache != atomic_load_explicit(&r->head,
+                                                           memory_order_relaxed);
+}
+
+/** @brief Sprawdza, czy producent może kontynuować.
+ * Odświeża zapamiętaną przez producenta wartość pola @p head.
+ * @param[in,out] r – wskaźnik na strukturę przechowującą kolejkę.
+ * @return Wartość @p true, jeżeli kolejka nie jest pełna, a @p false
+ * w przeciwnym przypadku.
+ */
+static bool ring_producer_ready(ring_t *r) {
+    r->head_cache = atomic_load_explicit(&r->head, memory_order_acquire);
+
+    return atomic_load_explicit(&r->tail, memory_order_relaxed) - r->head_cache
+           <= r->mask;
+}
+
+/** @brief Czeka, aż wątek będzie mógł kontynuować.
+ * Najpierw kilkukrotnie oddaje procesor, a potem zasypia na zmiennej
+ * warunkowej, ustawiając flagę @p sleeping, którą drugi wątek sprawdza po
+ * każdej zmianie kolejki.
+ * @param[in,out] r        – wskaźnik na strukturę przechowującą kolejkę,
+ * @param[in,out] sleeping – flaga informująca, że wątek śpi,
+ * @param[in] ready        – funkcja sprawdzająca, czy wątek może kontynuować.
+ */
+static void ring_wait(ring_t *r, _Atomic bool *sleeping, bool (*ready)(ring_t *)) {
+    for (int i = 0; i < RING_SPINS; i++) {
+        if (ready(r)) {
+            return;
+        }
+
+        sched_yield();
+    }
+
+    pthread_mutex_lock(&r->lock);
+    atomic_store_explicit(sleeping, true, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+
+    while (!ready(r)) {
+        pthread_cond_wait(&r->wakeup, &r->lock);
+    }
+
+    atomic_store_explicit(sleeping, false, memory_order_relaxed);
+    pthread_mutex_unlock(&r->lock);
+}
+
+/** @brief Budzi drugi wątek, jeżeli ten śpi.
+ * @param[in,out] r        – wskaźnik na strukturę przechowującą kolejkę,
+ * @param[in,out] sleeping – flaga informująca, że drugi wątek śpi.
+ */
+static void ring_wake(ring_t *r, _Atomic bool *sleeping) {
+    atomic_thread_fence(memory_order_seq_cst);
+
+    if (atomic_load_explicit(sleeping, memory_order_relaxed)) {
+        pthread_mutex_lock(&r->lock);
+        pthread_cond_broadcast(&r->wakeup);
+        pthread_mutex_unlock(&r->lock);
+    }
+}
+
+void ring_push(ring_t *r, const void *element) {
+    size_t tail = atomic_load_explicit(&r->tail, memory_order_relaxed);
+
+    if (tail - r->head_cache > r->mask && !ring_producer_ready(r)) {
+        ring_wait(r, &r->producer_sleeping, ring_producer_ready);
+    }
+
+    memcpy(r->data + (tail & r->mask) * r->element_size, element, r->element_size);
+    atomic_store_explicit(&r->tail, tail + 1, memory_order_release);
+    ring_wake(r, &r->consumer_sleeping);
+}
+
+bool ring_ready(ring_t *r) {
+    size_t head = atomic_load_explicit(&r->head, memory_order_relaxed);
+
+    return head != r->tail_cache || ring_consumer_ready(r);
+}
+
+bool ring_pop(ring_t *r, void *element) {
+    size_t head = atomic_load_explicit(&r->head, memory_order_relaxed);
+
+    if (head == r->tail_cache && !ring_consumer_ready(r)) {
+        ring_wait(r, &r->consumer_sleeping, ring_consumer_ready);
+    }
+
+    if (head == r->tail_cache) {
+        return false;
+    }
+    else {
+        memcpy(element, r->data + (head & r->mask) * r->element_size,
+               r->element_size);
+        atomic_store_explicit(&r->head, head + 1, memory_order_release);
+        ring_wake(r, &r->producer_sleeping);
+        return true;
+    }
+}
+
+void ring_close(ring_t *r) {
+    atomic_store_explicit(&r->closed, true, memory_order_release);
+    ring_wake(r, &r->consumer_sleeping);
+}
+
+void ring_free(ring_t *r) {
+    pthread_cond_destroy(&r->wakeup);
+    pthread_mutex_destroy(&r->lock);
+    free(r->data);
+}
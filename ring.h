@@ -0,0 +1,108 @@
+/** @file
+ * Interfejs modułu implementującego kolejkę cykliczną o jednym producencie
+ * i jednym konsumencie
+ *
+ * @author Szymon Czyżmański 417797
+ * @date 22.05.2020
+ */
+
+#ifndef RING_H
+#define RING_H
+
+#include <stdalign.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <pthread.h>
+
+/**
+ * Rozmiar linii pamięci podręcznej, według którego są wyrównywane pola
+ * modyfikowane przez różne wątki.
+ */
+#define RING_CACHE_LINE 64
+
+/**
+ * Typ struktury przechowującej kolejkę.
+ */
+typedef struct ring ring_t;
+
+/**
+ * Struktura przechowująca kolejkę cykliczną o jednym producencie i jednym
+ * konsumencie. Wstawianie i pobieranie elementów nie wymaga blokad, dopóki
+ * kolejka nie jest pełna ani pusta. Wątek, który musi czekać, zasypia na
+ * zmiennej warunkowej, a drugi wątek budzi go tylko wtedy, gdy wie, że
+ * ten śpi.
+ */
+struct ring {
+    char *data;                       /**< Tablica elementów. */
+    size_t mask;                      /**< Liczba miejsc w kolejce pomniejszona
+                                       *   o 1, liczba miejsc jest potęgą 2. */
+    size_t element_size;              /**< Rozmiar elementu. */
+    alignas(RING_CACHE_LINE)
+    _Atomic size_t head;              /**< Liczba pobranych elementów. */
+    size_t tail_cache;                /**< Ostatnia odczytana przez konsumenta
+                                       *   wartość pola @p tail. */
+    _Atomic bool consumer_sleeping;   /**< Wartość @p true, jeżeli konsument
+                                       *   czeka na element. */
+    alignas(RING_CACHE_LINE)
+    _Atomic size_t tail;              /**< Liczba wstawionych elementów. */
+    size_t head_cache;                /**< Ostatnia odczytana przez producenta
+                                       *   wartość pola @p head. */
+    _Atomic bool producer_sleeping;   /**< Wartość @p true, jeżeli producent
+                                       *   czeka na wolne miejsce. */
+    _Atomic bool closed;              /**< Wartość @p true, jeżeli producent
+                                       *   nie wstawi więcej elementów. */
+    alignas(RING_CACHE_LINE)
+    pthread_mutex_t lock;             /**< Blokada chroniąca zasypianie. */
+    pthread_cond_t wakeup;            /**< Zmienna warunkowa, na której
+                                       *   zasypiają wątki. */
+};
+
+/** @brief Inicjuje kolejkę.
+ * @param[out] r           – wskaźnik na strukturę przechowującą kolejkę,
+ * @param[in] capacity     – liczba miejsc w kolejce, potęga 2,
+ * @param[in] element_size – rozmiar elementu.
+ * @return Wartość @p true, jeżeli zainicjowano kolejkę, a @p false, gdy nie
+ * udało się zaalokować pamięci lub zainicjować blokady.
+ */
+bool ring_init(ring_t *r, size_t capacity, size_t element_size);
+
+/** @brief Wstawia element na koniec kolejki.
+ * Jeżeli kolejka jest pełna, czeka, aż konsument pobierze element.
+ * Może ją wywoływać tylko jeden wątek, producent.
+ * @param[in,out] r   – wskaźnik na strukturę przechowującą kolejkę,
+ * @param[in] element – wskaźnik na wstawiany element.
+ */
+void ring_push(ring_t *r, const void *element);
+
+/** @brief Pobiera element z początku kolejki.
+ * Jeżeli kolejka jest pusta, czeka, aż producent wstawi element lub zamknie
+ * kolejkę. Może ją wywoływać tylko jeden wątek, konsument.
+ * @param[in,out] r    – wskaźnik na strukturę przechowującą kolejkę,
+ * @param[out] element – wskaźnik na miejsce, do którego ma zostać skopiowany
+ *                       pobrany element.
+ * @return Wartość @p true, jeżeli pobrano element, a @p false, jeżeli kolejka
+ * jest pusta i zamknięta.
+ */
+bool ring_pop(ring_t *r, void *element);
+
+/** @brief Sprawdza, czy element można pobrać bez czekania.
+ * Może ją wywoływać tylko konsument.
+ * @param[in,out] r – wskaźnik na strukturę przechowującą kolejkę.
+ * @return Wartość @p true, jeżeli kolejka nie jest pusta lub jest zamknięta,
+ * a @p false, jeżeli funkcja @ref ring_pop musiałaby czekać na producenta.
+ */
+bool ring_ready(ring_t *r);
+
+/** @brief Zamyka kolejkę.
+ * Informuje konsumenta, że producent nie wstawi więcej elementów.
+ * @param[in,out] r – wskaźnik na strukturę przechowującą kolejkę.
+ */
+void ring_close(ring_t *r);
+
+/** @brief Zwalnia pamięć kolejki.
+ * @param[in,out] r – wskaźnik na strukturę przechowującą kolejkę.
+ */
+void ring_free(ring_t *r);
+
+#endif // RING_H
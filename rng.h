@@ -0,0 +1,55 @@
+/** @file
+ * Generator liczb pseudolosowych xorshift64 wspólny dla gry, generatora ruchów
+ * i programu mierzącego przepustowość
+ *
+ * @author Szymon Czyżmański 417797
+ * @date 22.05.2020
+ */
+
+#ifndef RNG_H
+#define RNG_H
+
+#include <stdint.h>
+
+/**
+ * Stan, którym generator zastępuje stan zerowy, z którego by nie wyszedł.
+ */
+#define RNG_ZERO_STATE UINT64_C(88172645463325252)
+
+/** @brief Losuje kolejną liczbę pseudolosową.
+ * Przesuwa stan generatora xorshift64 wskazywany przez @p state i podaje
+ * kolejną liczbę pseudolosową. Zerowy stan, z którego generator nie wychodzi,
+ * zastępuje wartością @ref RNG_ZERO_STATE.
+ * @param[in,out] state – wskaźnik na stan generatora.
+ * @return Kolejna liczba pseudolosowa.
+ */
+static inline uint64_t rng_next(uint64_t *state) {
+    uint64_t x = *state == 0 ? RNG_ZERO_STATE : *state;
+
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    *state = x;
+
+    return x;
+}
+
+/** @brief Losuje liczbę z przedziału [0, @p bound).
+ * Odrzuca liczby pseudolosowe z niepełnego ostatniego przedziału długości
+ * @p bound, dzięki czemu rozkład wyniku jest jednostajny.
+ * @param[in,out] state – wskaźnik na stan generatora,
+ * @param[in] bound     – liczba dodatnia.
+ * @return Liczba nieujemna mniejsza od @p bound.
+ */
+static inline uint64_t rng_below(uint64_t *state, uint64_t bound) {
+    uint64_t limit = UINT64_MAX - UINT64_MAX % bound;
+    uint64_t r;
+
+    do {
+        r = rng_next(state);
+    } while (r >= limit);
+
+    return r % bound;
+}
+
+#endif // RNG_H
@@ -0,0 +1,994 @@
+/** @file
+ * Implementacja modułu obsługującego serwer gier na gnieździe domeny uniksowej
+ *
+ * @author Szymon Czyżmański 417797
+ * @date 22.05.2020
+ */
+
+/**
+ * Dostęp do funkcji accept4.
+ */
+#define _GNU_SOURCE
+
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <signal.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+
+#include "server.h"
+#include "command.h"
+#include "gamma.h"
+#include "generator.h"
+#include "parallel.h"
+#include "parser.h"
+#include "session.h"
+#include "territory.h"
+#include "writer.h"
+
+/**
+ * Znak oznaczający początek komentarza, jeśli występuje on jako pierwszy
+ * znak w linii.
+ */
+#define COMMENT '#'
+/**
+ * Liczba argumentów polecenia tworzącego grę.
+ */
+#define NEW_GAME_ARGUMENTS_NUM 4
+
+/**
+ * Początek komunikatu o poprawnym utworzeniu gry.
+ */
+#define OK_PREFIX "OK "
+
+/**
+ * Liczba znaków, o którą jest powiększany bufor wejściowy przed odczytem.
+ */
+#define SERVER_READ_CHUNK (1 << 16)
+/**
+ * Największa liczba nieprzetworzonych znaków w buforze wejściowym. Dłuższa
+ * linia jest pomijana i traktowana jako niepoprawna.
+ */
+#define SERVER_MAX_INPUT (1 << 20)
+/**
+ * Liczba niewysłanych znaków w buforze wyjściowym, po przekroczeniu której
+ * serwer wstrzymuje wykonywanie poleceń z połączenia.
+ */
+#define SERVER_MAX_OUTPUT (1 << 20)
+/**
+ * Najmniejsza liczba pól planszy, od której polecenia @p q i @p p są
+ * wykonywane w puli wątków roboczych.
+ */
+#define SERVER_OFFLOAD_MIN_FIELDS PARALLEL_MIN_WORK
+/**
+ * Największa liczba zdarzeń odbieranych jednym wywołaniem funkcji
+ * epoll_pwait.
+ */
+#define SERVER_MAX_EVENTS 256
+
+/**
+ * Wartość różna od 0, jeżeli serwer otrzymał sygnał nakazujący zakończenie
+ * działania.
+ */
+static volatile sig_atomic_t server_stopped = 0;
+
+/**
+ * Typ struktury przechowującej bufor połączenia.
+ */
+typedef struct server_buffer server_buffer_t;
+
+/**
+ * Struktura przechowująca bufor połączenia. Dane oczekujące na przetworzenie
+ * zajmują przedział [@p begin, @p end).
+ */
+struct server_buffer {
+    char *data;         /**< Bufor. */
+    size_t begin;       /**< Indeks pierwszego nieprzetworzonego znaku. */
+    size_t end;         /**< Indeks za ostatnim znakiem. */
+    size_t capacity;    /**< Rozmiar bufora. */
+};
+
+/**
+ * Typ struktury przechowującej stan połączenia.
+ */
+typedef struct server_conn server_conn_t;
+
+/**
+ * Struktura przechowująca stan połączenia.
+ */
+struct server_conn {
+    int fd;                 /**< Deskryptor gniazda połączenia. */
+    gamma_t *g;             /**< Gra lub NULL, jeżeli jej jeszcze
+                             *   nie utworzono. */
+    server_buffer_t in;     /**< Bufor odebranych danych. */
+    server_buffer_t out;    /**< Bufor danych do wysłania. */
+    unsigned line_num;      /**< Numer ostatniej przetworzonej linii. */
+    uint32_t events;        /**< Zdarzenia, na które czeka połączenie. */
+    bool busy;              /**< Wartość @p true, jeżeli polecenie z tego
+                             *   połączenia jest wykonywane w puli. */
+    bool eof;               /**< Wartość @p true, jeżeli klient zakończył
+                             *   wysyłanie danych. */
+    bool broken;            /**< Wartość @p true, jeżeli wystąpił błąd
+                             *   i połączenie należy zamknąć. */
+    bool skipping;          /**< Wartość @p true, jeżeli pomijana jest zbyt
+                             *   długa linia. */
+    bool skipping_comment;  /**< Wartość @p true, jeżeli pomijana linia jest
+                             *   komentarzem. */
+    bool closed;            /**< Wartość @p true, jeżeli połączenie zostało
+                             *   zamknięte i czeka na zwolnienie pamięci. */
+    server_conn_t *prev;    /**< Poprzednie połączenie na liście. */
+    server_conn_t *next;    /**< Następne połączenie na liście. */
+};
+
+/**
+ * Typ struktury przechowującej polecenie.
+ */
+typedef struct server_job server_job_t;
+
+/**
+ * Struktura przechowująca polecenie trybu wsadowego wraz z jego wynikiem.
+ */
+struct server_job {
+    server_conn_t *conn;                   /**< Połączenie, z którego
+                                            *   pochodzi polecenie. */
+    uint32_t arguments[ARGUMENTS_MAX_NUM]; /**< Argumenty polecenia. */
+    unsigned line_num;                     /**< Numer linii. */
+    char command;                          /**< Znak określający polecenie. */
+    bool ok;                               /**< Wartość @p false, jeżeli
+                                            *   polecenie zakończyło się
+                                            *   błędem. */
+    uint64_t value;                        /**< Wynik polecenia. */
+    char *text;                            /**< Wynik polecenia w postaci
+                                            *   napisu lub NULL. */
+    server_job_t *next;                    /**< Następne polecenie
+                                            *   w kolejce. */
+};
+
+/**
+ * Typ struktury przechowującej stan serwera.
+ */
+typedef struct server server_t;
+
+/**
+ * Struktura przechowująca stan serwera. Zdarzenia z gniazda nasłuchującego
+ * są oznaczone wskaźnikiem NULL, zdarzenia z deskryptora @p event_fd
+ * wskaźnikiem na tę strukturę, a zdarzenia z gniazd połączeń wskaźnikiem
+ * na strukturę połączenia.
+ */
+struct server {
+    int listen_fd;              /**< Deskryptor gniazda nasłuchującego. */
+    int epoll_fd;               /**< Deskryptor instancji epoll. */
+    int event_fd;               /**< Deskryptor, przez który wątki robocze
+                                 *   informują o wykonaniu polecenia. */
+    server_conn_t *conns;       /**< Lista otwartych połączeń. */
+    server_conn_t *closed;      /**< Lista zamkniętych połączeń, których
+                                 *   pamięć zostanie zwolniona po obsłużeniu
+                                 *   bieżących zdarzeń. */
+    pthread_mutex_t lock;       /**< Blokada chroniąca kolejki poleceń. */
+    pthread_cond_t ready;       /**< Zmienna warunkowa, na której wątki
+                                 *   robocze czekają na polecenia. */
+    server_job_t *queue_head;   /**< Początek kolejki poleceń do wykonania. */
+    server_job_t *queue_tail;   /**< Koniec kolejki poleceń do wykonania. */
+    server_job_t *done;         /**< Lista wykonanych poleceń. */
+    bool stopping;              /**< Wartość @p true, jeżeli wątki robocze
+                                 *   mają zakończyć działanie. */
+    pthread_t *threads;         /**< Tablica wątków roboczych. */
+    unsigned threads_num;       /**< Liczba wątków roboczych. */
+};
+
+/** @brief Obsługuje sygnał nakazujący zakończenie działania serwera.
+ * @param[in] signal_num – numer sygnału.
+ */
+static void server_signal(int signal_num) {
+    (void) signal_num;
+    server_stopped = 1;
+}
+
+/** @brief Zapewnia miejsce w buforze.
+ * Przesuwa nieprzetworzone dane na początek bufora, a jeżeli to nie wystarcza,
+ * powiększa bufor.
+ * @param[in,out] b – wskaźnik na strukturę przechowującą bufor,
+ * @param[in] len   – liczba znaków, które mają się zmieścić za danymi.
+ * @return Wartość @p true, jeżeli za danymi jest co najmniej @p len wolnych
+ * miejsc, a @p false, gdy nie udało się zaalokować pamięci.
+ */
+static bool buffer_reserve(server_buffer_t *b, size_t len) {
+    if (b->capacity - b->end >= len) {
+        return true;
+    }
+
+    if (b->begin > 0) {
+        memmove(b->data, b->data + b->begin, b->end - b->begin);
+        b->end -= b->begin;
+        b->begin = 0;
+
+        if (b->capacity - b->end >= len) {
+            return true;
+        }
+    }
+
+    size_t capacity = b->capacity > 0 ? b->capacity : SERVER_READ_CHUNK;
+
+    while (capacity - b->end < len) {
+        capacity *= 2;
+    }
+
+    char *data = realloc(b->data, capacity);
+
+    if (data == NULL) {
+        return false;
+    }
+    else {
+        b->data = data;
+        b->capacity = capacity;
+        return true;
+    }
+}
+
+/** @brief Podaje liczbę znaków oczekujących w buforze.
+ * @param[in] b – wskaźnik na strukturę przechowującą bufor.
+ * @return Liczba znaków oczekujących na przetworzenie.
+ */
+static inline size_t buffer_pending(const server_buffer_t *b) {
+    return b->end - b->begin;
+}
+
+/** @brief Dopisuje napis do bufora wyjściowego połączenia.
+ * Jeżeli nie udało się zaalokować pamięci, oznacza połączenie do zamknięcia.
+ * @param[in,out] conn – wskaźnik na strukturę przechowującą stan połączenia,
+ * @param[in] str      – wskaźnik na pierwszy znak napisu,
+ * @param[in] len      – długość napisu.
+ */
+static void conn_put_string(server_conn_t *conn, const char *str, size_t len) {
+    if (buffer_reserve(&conn->out, len)) {
+        memcpy(conn->out.data + conn->out.end, str, len);
+        conn->out.end += len;
+    }
+    else {
+        conn->broken = true;
+    }
+}
+
+/** @brief Dopisuje liczbę w zapisie dziesiętnym, a po niej znak nowej linii,
+ * do bufora wyjściowego połączenia.
+ * @param[in,out] conn – wskaźnik na strukturę przechowującą stan połączenia,
+ * @param[in] value    – liczba.
+ */
+static void conn_put_number(server_conn_t *conn, uint64_t value) {
+    if (buffer_reserve(&conn->out, WRITER_NUMBER_LEN + 1)) {
+        conn->out.end += writer_format_number(conn->out.data + conn->out.end,
+                                              value, '\n');
+    }
+    else {
+        conn->broken = true;
+    }
+}
+
+/** @brief Dopisuje komunikat o błędzie do bufora wyjściowego połączenia.
+ * @param[in,out] conn – wskaźnik na strukturę przechowującą stan połączenia,
+ * @param[in] line_num – numer linii, w której wystąpił błąd.
+ */
+static void conn_put_error(server_conn_t *conn, unsigned line_num) {
+    conn_put_string(conn, ERROR_PREFIX, sizeof(ERROR_PREFIX) - 1);
+    conn_put_number(conn, line_num);
+}
+
+/** @brief Sprawdza, czy polecenie należy wykonać w puli wątków roboczych.
+ * @param[in] g       – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in] command – znak określający polecenie.
+ * @return Wartość @p true, jeżeli wykonanie polecenia może trwać długo,
+ * a @p false w przeciwnym przypadku.
+ */
+static bool job_expensive(gamma_t *g, char command) {
+    switch (command) {
+        case SESSION_RANDOM:
+        case SESSION_FILL:
+            return true;
+        case SESSION_GOLDEN_POSSIBLE:
+        case SESSION_BOARD:
+        case SESSION_TERRITORY:
+            return (uint64_t) gamma_width(g) * gamma_board_height(g)
+                   >= SERVER_OFFLOAD_MIN_FIELDS;
+        default:
+            return false;
+    }
+}
+
+/** @brief Wykonuje polecenie trybu wsadowego.
+ * Zapisuje wynik polecenia w strukturze polecenia, nie modyfikując stanu
+ * połączenia poza grą, więc może być wywoływana w wątku roboczym.
+ * @param[in,out] job – wskaźnik na strukturę przechowującą polecenie.
+ */
+static void job_execute(server_job_t *job) {
+    gamma_t *g = job->conn->g;
+    const uint32_t *arguments = job->arguments;
+    generator_stats_t stats;
+
+    job->ok = true;
+    job->text = NULL;
+
+    switch (job->command) {
+        case SESSION_MOVE:
+            job->value = gamma_move(g, arguments[0], arguments[1], arguments[2]);
+            break;
+        case SESSION_GOLDEN_MOVE:
+            job->value = gamma_golden_move(g, arguments[0], arguments[1],
+                                           arguments[2]);
+            break;
+        case SESSION_BUSY_FIELDS:
+            job->value = gamma_busy_fields(g, arguments[0]);
+            break;
+        case SESSION_FREE_FIELDS:
+            job->value = gamma_free_fields(g, arguments[0]);
+            break;
+        case SESSION_GOLDEN_POSSIBLE:
+            job->value = gamma_golden_possible(g, arguments[0]);
+            break;
+        case SESSION_SAME_AREA:
+            job->value = gamma_same_area(g, arguments[0], arguments[1],
+                                         arguments[2], arguments[3]);
+            break;
+        case SESSION_RANDOM:
+            job->ok = generator_random_moves(g, arguments[0], arguments[1],
+                                             &stats);
+            job->value = stats.moves + stats.golden_moves;
+            break;
+        case SESSION_FILL:
+            job->ok = generator_fill(g, arguments[0], arguments[1], arguments[2],
+                                     arguments[3], arguments[4], &stats);
+            job->value = stats.moves + stats.golden_moves;
+            break;
+        case SESSION_TERRITORY:
+            job->value = territory_player(g, arguments[0], 1);
+            job->ok = job->value != UINT64_MAX;
+            break;
+        default:
+            job->text = gamma_board(g);
+            job->ok = job->text != NULL;
+    }
+}
+
+/** @brief Dopisuje wynik polecenia do bufora wyjściowego połączenia.
+ * @param[in,out] job – wskaźnik na strukturę przechowującą polecenie.
+ */
+static void job_finish(server_job_t *job) {
+    server_conn_t *conn = job->conn;
+
+    if (!job->ok) {
+        conn_put_error(conn, job->line_num);
+    }
+    else if (job->text != NULL) {
+        conn_put_string(conn, job->text, strlen(job->text));
+    }
+    else {
+        conn_put_number(conn, job->value);
+    }
+
+    free(job->text);
+    job->text = NULL;
+}
+
+/** @brief Wykonuje polecenia w wątku roboczym.
+ * Pobiera polecenia z kolejki, dopóki serwer nie zacznie kończyć działania
+ * i kolejka nie będzie pusta. Po wykonaniu polecenia dopisuje je do listy
+ * wykonanych poleceń i powiadamia o tym wątek obsługujący połączenia.
+ * @param[in,out] data – wskaźnik na strukturę przechowującą stan serwera.
+ * @return Wartość NULL.
+ */
+static void *server_worker_run(void *data) {
+    server_t *s = data;
+    uint64_t one = 1;
+
+    pthread_mutex_lock(&s->lock);
+
+    while (true) {
+        while (s->queue_head == NULL && !s->stopping) {
+            pthread_cond_wait(&s->ready, &s->lock);
+        }
+
+        server_job_t *job = s->queue_head;
+
+        if (job == NULL) {
+            break;
+        }
+
+        s->queue_head = job->next;
+
+        if (s->queue_head == NULL) {
+            s->queue_tail = NULL;
+        }
+
+        pthread_mutex_unlock(&s->lock);
+        job_execute(job);
+        pthread_mutex_lock(&s->lock);
+
+        job->next = s->done;
+        s->done = job;
+
+        while (write(s->event_fd, &one, sizeof(one)) < 0 && errno == EINTR) {
+        }
+    }
+
+    pthread_mutex_unlock(&s->lock);
+
+    return NULL;
+}
+
+/** @brief Przekazuje polecenie do wykonania w puli wątków roboczych.
+ * @param[in,out] s   – wskaźnik na strukturę przechowującą stan serwera,
+ * @param[in] job     – wskaźnik na polecenie zaalokowane na stercie.
+ */
+static void server_submit(server_t *s, server_job_t *job) {
+    job->next = NULL;
+    pthread_mutex_lock(&s->lock);
+
+    if (s->queue_tail == NULL) {
+        s->queue_head = job;
+    }
+    else {
+        s->queue_tail->next = job;
+    }
+
+    s->queue_tail = job;
+    pthread_cond_signal(&s->ready);
+    pthread_mutex_unlock(&s->lock);
+}
+
+/** @brief Wykonuje polecenie z linii.
+ * Polecenia, których wykonanie może trwać długo, przekazuje do puli wątków
+ * roboczych, a pozostałe wykonuje od razu.
+ * @param[in,out] s    – wskaźnik na strukturę przechowującą stan serwera,
+ * @param[in,out] conn – wskaźnik na strukturę przechowującą stan połączenia,
+ * @param[in] line     – wskaźnik na pierwszy znak linii,
+ * @param[in] line_len – długość linii bez kończącego ją znaku nowej linii.
+ */
+static void conn_execute(server_t *s, server_conn_t *conn, const char *line,
+                         size_t line_len) {
+    server_job_t job = {.conn = conn, .line_num = conn->line_num,
+                        .command = line[0]};
+
+    if (conn->g == NULL) {
+        uint32_t *arguments = job.arguments;
+
+        if (line[0] == SESSION_NEW
+            && line_parse_arguments(line, line_len, arguments,
+                                    NEW_GAME_ARGUMENTS_NUM)
+            && (conn->g = gamma_new(arguments[0], arguments[1], arguments[2],
+                                    arguments[3])) != NULL) {
+            conn_put_string(conn, OK_PREFIX, sizeof(OK_PREFIX) - 1);
+            conn_put_number(conn, conn->line_num);
+        }
+        else {
+            conn_put_error(conn, conn->line_num);
+        }
+    }
+    else if (!batch_mode_decode_line(line, line_len, job.arguments)) {
+        conn_put_error(conn, conn->line_num);
+    }
+    else if (job_expensive(conn->g, job.command)) {
+        server_job_t *heap_job = malloc(sizeof(server_job_t));
+
+        if (heap_job == NULL) {
+            conn->broken = true;
+        }
+        else {
+            *heap_job = job;
+            conn->busy = true;
+            server_submit(s, heap_job);
+        }
+    }
+    else {
+        job_execute(&job);
+        job_finish(&job);
+    }
+}
+
+/** @brief Wykonuje polecenia z odebranych linii.
+ * Przetwarza kolejne pełne linie z bufora wejściowego, dopóki żadne polecenie
+ * z połączenia nie jest wykonywane w puli, a w buforze wyjściowym nie zebrało
+ * się za dużo danych. Zbyt długą linię pomija, a niepełną linię na końcu
+ * danych od klienta traktuje tak jak tryb wsadowy.
+ * @param[in,out] s    – wskaźnik na strukturę przechowującą stan serwera,
+ * @param[in,out] conn – wskaźnik na strukturę przechowującą stan połączenia.
+ */
+static void conn_process(server_t *s, server_conn_t *conn) {
+    server_buffer_t *in = &conn->in;
+
+    while (!conn->busy && !conn->broken
+           && buffer_pending(&conn->out) < SERVER_MAX_OUTPUT) {
+        char *line = in->data + in->begin;
+        size_t pending = buffer_pending(in);
+        char *newline = pending > 0 ? memchr(line, '\n', pending) : NULL;
+
+        if (newline == NULL) {
+            if (conn->eof && (pending > 0 || conn->skipping)) {
+                conn->line_num++;
+
+                if (conn->skipping ? !conn->skipping_comment
+                                   : line[0] != COMMENT) {
+                    conn_put_error(conn, conn->line_num);
+                }
+
+                conn->skipping = false;
+                in->begin = in->end;
+            }
+            else if (pending >= SERVER_MAX_INPUT) {
+                if (!conn->skipping) {
+                    conn->skipping = true;
+                    conn->skipping_comment = line[0] == COMMENT;
+                }
+
+                in->begin = in->end;
+            }
+
+            break;
+        }
+
+        size_t line_len = newline - line;
+        in->begin += line_len + 1;
+        conn->line_num++;
+
+        if (conn->skipping) {
+            conn->skipping = false;
+
+            if (!conn->skipping_comment) {
+                conn_put_error(conn, conn->line_num);
+            }
+        }
+        else if (line_len > 0 && line[0] != COMMENT) {
+            conn_execute(s, conn, line, line_len);
+        }
+    }
+
+    if (buffer_pending(in) == 0) {
+        in->begin = in->end = 0;
+    }
+}
+
+/** @brief Odbiera dane od klienta.
+ * Odbiera dane, dopóki są dostępne i bufor wejściowy nie jest przepełniony.
+ * @param[in,out] conn – wskaźnik na strukturę przechowującą stan połączenia.
+ */
+static void conn_read(server_conn_t *conn) {
+    while (!conn->eof && !conn->broken
+           && buffer_pending(&conn->in) < SERVER_MAX_INPUT) {
+        if (!buffer_reserve(&conn->in, SERVER_READ_CHUNK)) {
+            conn->broken = true;
+            return;
+        }
+
+        ssize_t received = read(conn->fd, conn->in.data + conn->in.end,
+                                conn->in.capacity - conn->in.end);
+
+        if (received > 0) {
+            conn->in.end += received;
+        }
+        else if (received == 0) {
+            conn->eof = true;
+        }
+        else if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            return;
+        }
+        else if (errno != EINTR) {
+            conn->broken = true;
+        }
+    }
+}
+
+/** @brief Wysyła dane do klienta.
+ * Wysyła dane z bufora wyjściowego, dopóki gniazdo je przyjmuje.
+ * @param[in,out] conn – wskaźnik na strukturę przechowującą stan połączenia.
+ */
+static void conn_write(server_conn_t *conn) {
+    server_buffer_t *out = &conn->out;
+
+    while (buffer_pending(out) > 0 && !conn->broken) {
+        ssize_t sent = send(conn->fd, out->data + out->begin, buffer_pending(out),
+                            MSG_NOSIGNAL);
+
+        if (sent > 0) {
+            out->begin += sent;
+        }
+        else if (sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            return;
+        }
+        else if (sent < 0 && errno != EINTR) {
+            conn->broken = true;
+        }
+    }
+
+    out->begin = out->end = 0;
+}
+
+/** @brief Zamyka połączenie.
+ * Usuwa połączenie z listy otwartych połączeń, zamyka gniazdo, usuwa grę
+ * i zwalnia bufory. Strukturę połączenia przenosi na listę zamkniętych
+ * połączeń, ponieważ mogą się do niej jeszcze odnosić odebrane zdarzenia.
+ * @param[in,out] s    – wskaźnik na strukturę przechowującą stan serwera,
+ * @param[in,out] conn – wskaźnik na strukturę przechowującą stan połączenia.
+ */
+static void conn_close(server_t *s, server_conn_t *conn) {
+    if (conn->prev == NULL) {
+        s->conns = conn->next;
+    }
+    else {
+        conn->prev->next = conn->next;
+    }
+
+    if (conn->next != NULL) {
+        conn->next->prev = conn->prev;
+    }
+
+    close(conn->fd);
+    gamma_delete(conn->g);
+    free(conn->in.data);
+    free(conn->out.data);
+    conn->closed = true;
+    conn->next = s->closed;
+    s->closed = conn;
+}
+
+/** @brief Zwalnia pamięć zamkniętych połączeń.
+ * @param[in,out] s – wskaźnik na strukturę przechowującą stan serwera.
+ */
+static void server_reap(server_t *s) {
+    while (s->closed != NULL) {
+        server_conn_t *next = s->closed->next;
+        free(s->closed);
+        s->closed = next;
+    }
+}
+
+/** @brief Uaktualnia zdarzenia, na które czeka połączenie.
+ * Zamyka połączenie, jeżeli żadne jego polecenie nie jest wykonywane w puli,
+ * a wystąpił w nim błąd lub wszystkie polecenia od klienta zostały wykonane
+ * i odpowiedzi wysłane. W przeciwnym przypadku czeka na dane od klienta,
+ * jeżeli może je przetworzyć, oraz na możliwość wysłania danych, jeżeli jakieś
+ * na to czekają. Połączenie, które nie czeka na żadne zdarzenie, jest
+ * wyrejestrowywane, aby epoll nie zgłaszał stale zerwania połączenia przez
+ * klienta, dopóki wykonuje się jego polecenie.
+ * @param[in,out] s    – wskaźnik na strukturę przechowującą stan serwera,
+ * @param[in,out] conn – wskaźnik na strukturę przechowującą stan połączenia.
+ */
+static void conn_update(server_t *s, server_conn_t *conn) {
+    uint32_t events = 0;
+
+    if (!conn->busy
+        && (conn->broken
+            || (conn->eof && buffer_pending(&conn->in) == 0
+                && buffer_pending(&conn->out) == 0))) {
+        conn_close(s, conn);
+        return;
+    }
+
+    if (!conn->broken && !conn->eof
+        && buffer_pending(&conn->in) < SERVER_MAX_INPUT
+        && buffer_pending(&conn->out) < SERVER_MAX_OUTPUT) {
+        events |= EPOLLIN;
+    }
+
+    if (!conn->broken && buffer_pending(&conn->out) > 0) {
+        events |= EPOLLOUT;
+    }
+
+    if (events != conn->events) {
+        struct epoll_event event = {.events = events, .data.ptr = conn};
+        int op = conn->events == 0 ? EPOLL_CTL_ADD
+                 : events == 0 ? EPOLL_CTL_DEL : EPOLL_CTL_MOD;
+
+        if (epoll_ctl(s->epoll_fd, op, conn->fd, &event) == 0) {
+            conn->events = events;
+        }
+        else if (!conn->busy) {
+            conn_close(s, conn);
+        }
+        else {
+            conn->broken = true;
+        }
+    }
+}
+
+/** @brief Obsługuje zdarzenia połączenia.
+ * @param[in,out] s    – wskaźnik na strukturę przechowującą stan serwera,
+ * @param[in,out] conn – wskaźnik na strukturę przechowującą stan połączenia,
+ * @param[in] events   – zdarzenia zgłoszone przez epoll.
+ */
+static void conn_handle(server_t *s, server_conn_t *conn, uint32_t events) {
+    if (conn->closed) {
+        return;
+    }
+
+    if (events & (EPOLLIN | EPOLLHUP | EPOLLERR)) {
+        conn_read(conn);
+    }
+
+    if (!conn->busy) {
+        conn_process(s, conn);
+    }
+
+    conn_write(conn);
+    conn_update(s, conn);
+}
+
+/** @brief Przyjmuje oczekujące połączenia.
+ * @param[in,out] s – wskaźnik na strukturę przechowującą stan serwera.
+ */
+static void server_accept(server_t *s) {
+    while (true) {
+        int fd = accept4(s->listen_fd, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC);
+
+        if (fd < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) {
+                continue;
+            }
+
+            return;
+        }
+
+        server_conn_t *conn = calloc(1, sizeof(server_conn_t));
+        struct epoll_event event = {.events = EPOLLIN, .data.ptr = conn};
+
+        if (conn == NULL) {
+            close(fd);
+            continue;
+        }
+
+        conn->fd = fd;
+        conn->events = EPOLLIN;
+
+        if (epoll_ctl(s->epoll_fd, EPOLL_CTL_ADD, fd, &event) != 0) {
+            close(fd);
+            free(conn);
+            continue;
+        }
+
+        conn->next = s->conns;
+
+        if (s->conns != NULL) {
+            s->conns->prev = conn;
+        }
+
+        s->conns = conn;
+    }
+}
+
+/** @brief Obsługuje polecenia wykonane w puli wątków roboczych.
+ * Dopisuje ich wyniki do buforów wyjściowych połączeń i wznawia
+ * przetwarzanie kolejnych poleceń z tych połączeń.
+ * @param[in,out] s – wskaźnik na strukturę przechowującą stan serwera.
+ */
+static void server_complete(server_t *s) {
+    uint64_t count;
+
+    while (read(s->event_fd, &count, sizeof(count)) < 0 && errno == EINTR) {
+    }
+
+    pthread_mutex_lock(&s->lock);
+    server_job_t *job = s->done;
+    s->done = NULL;
+    pthread_mutex_unlock(&s->lock);
+
+    while (job != NULL) {
+        server_job_t *next = job->next;
+        server_conn_t *conn = job->conn;
+
+        conn->busy = false;
+        job_finish(job);
+        free(job);
+        conn_handle(s, conn, 0);
+        job = next;
+    }
+}
+
+/** @brief Usuwa gniazdo pozostawione przez zakończony serwer.
+ * Próbuje połączyć się z gniazdem o podanym adresie i usuwa je tylko wtedy, gdy
+ * połączenie zostało odrzucone, bo żaden proces go nie nasłuchuje. Gniazda,
+ * z którym udało się połączyć lub którego stanu nie udało się ustalić, nie
+ * usuwa.
+ * @param[in] address – adres gniazda.
+ * @return Wartość @p true, jeżeli gniazdo zostało usunięte, a @p false
+ * w przeciwnym przypadku.
+ */
+static bool server_remove_stale(const struct sockaddr_un *address) {
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+
+    if (fd < 0) {
+        return false;
+    }
+    else {
+        bool stale = connect(fd, (const struct sockaddr *) address,
+                             sizeof(*address)) != 0 && errno == ECONNREFUSED;
+        close(fd);
+
+        return stale && unlink(address->sun_path) == 0;
+    }
+}
+
+/** @brief Tworzy gniazdo nasłuchujące.
+ * Jeżeli pod podaną ścieżką istnieje gniazdo, zastępuje je tylko wtedy, gdy
+ * żaden proces go nie nasłuchuje.
+ * @param[in] path – ścieżka gniazda.
+ * @return Deskryptor gniazda lub -1, jeżeli nie udało się go utworzyć, w tym
+ * gdy ścieżka jest zajęta przez inny plik lub działający serwer.
+ */
+static int server_listen(const char *path) {
+    struct sockaddr_un address = {.sun_family = AF_UNIX};
+    struct stat st;
+
+    if (strlen(path) >= sizeof(address.sun_path)) {
+        return -1;
+    }
+
+    strcpy(address.sun_path, path);
+
+    if (lstat(path, &st) == 0
+        && (!S_ISSOCK(st.st_mode) || !server_remove_stale(&address))) {
+        return -1;
+    }
+
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+
+    if (fd < 0) {
+        return -1;
+    }
+    else if (bind(fd, (struct sockaddr *) &address, sizeof(address)) != 0
+             || listen(fd, SOMAXCONN) != 0) {
+        close(fd);
+        return -1;
+    }
+    else {
+        return fd;
+    }
+}
+
+/** @brief Rejestruje deskryptor w instancji epoll.
+ * @param[in] epoll_fd – deskryptor instancji epoll,
+ * @param[in] fd       – rejestrowany deskryptor,
+ * @param[in] ptr      – wskaźnik zgłaszany wraz ze zdarzeniami deskryptora.
+ * @return Wartość @p true, jeżeli zarejestrowano deskryptor, a @p false
+ * w przeciwnym przypadku.
+ */
+static bool server_watch(int epoll_fd, int fd, void *ptr) {
+    struct epoll_event event = {.events = EPOLLIN, .data.ptr = ptr};
+
+    return epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &event) == 0;
+}
+
+/** @brief Uruchamia wątki robocze.
+ * @param[in,out] s       – wskaźnik na strukturę przechowującą stan serwera,
+ * @param[in] workers_num – liczba wątków roboczych.
+ * @return Wartość @p true, jeżeli uruchomiono wszystkie wątki, a @p false
+ * w przeciwnym przypadku.
+ */
+static bool server_start_workers(server_t *s, unsigned workers_num) {
+    s->threads = malloc(workers_num * sizeof(pthread_t));
+
+    if (s->threads == NULL) {
+        return false;
+    }
+
+    while (s->threads_num < workers_num) {
+        if (pthread_create(&s->threads[s->threads_num], NULL,
+                           server_worker_run, s) != 0) {
+            return false;
+        }
+
+        s->threads_num++;
+    }
+
+    return true;
+}
+
+/** @brief Zatrzymuje wątki robocze i zwalnia zasoby serwera.
+ * Czeka, aż wątki robocze wykonają przekazane im polecenia, a następnie
+ * zamyka wszystkie połączenia i deskryptory.
+ * @param[in,out] s – wskaźnik na strukturę przechowującą stan serwera.
+ */
+static void server_free(server_t *s) {
+    pthread_mutex_lock(&s->lock);
+    s->stopping = true;
+    pthread_cond_broadcast(&s->ready);
+    pthread_mutex_unlock(&s->lock);
+
+    for (unsigned i = 0; i < s->threads_num; i++) {
+        pthread_join(s->threads[i], NULL);
+    }
+
+    while (s->done != NULL) {
+        server_job_t *next = s->done->next;
+        free(s->done->text);
+        free(s->done);
+        s->done = next;
+    }
+
+    while (s->conns != NULL) {
+        conn_close(s, s->conns);
+    }
+
+    server_reap(s);
+
+    free(s->threads);
+    pthread_cond_destroy(&s->ready);
+    pthread_mutex_destroy(&s->lock);
+
+    if (s->event_fd >= 0) {
+        close(s->event_fd);
+    }
+
+    if (s->epoll_fd >= 0) {
+        close(s->epoll_fd);
+    }
+
+    if (s->listen_fd >= 0) {
+        close(s->listen_fd);
+    }
+}
+
+bool server_run(const char *path, unsigned workers_num) {
+    server_t s = {.listen_fd = -1, .epoll_fd = -1, .event_fd = -1};
+    struct sigaction action = {.sa_handler = server_signal};
+    struct epoll_event events[SERVER_MAX_EVENTS];
+    sigset_t blocked, unblocked;
+    bool ok = true;
+
+    sigemptyset(&blocked);
+    sigaddset(&blocked, SIGINT);
+    sigaddset(&blocked, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &blocked, &unblocked);
+    sigaction(SIGINT, &action, NULL);
+    sigaction(SIGTERM, &action, NULL);
+    signal(SIGPIPE, SIG_IGN);
+
+    pthread_mutex_init(&s.lock, NULL);
+    pthread_cond_init(&s.ready, NULL);
+    s.listen_fd = server_listen(path);
+    s.epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    s.event_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+    if (s.listen_fd < 0 || s.epoll_fd < 0 || s.event_fd < 0
+        || !server_watch(s.epoll_fd, s.listen_fd, NULL)
+        || !server_watch(s.epoll_fd, s.event_fd, &s)
+        || !server_start_workers(&s, workers_num)) {
+        ok = false;
+    }
+
+    while (ok && !server_stopped) {
+        int ready = epoll_pwait(s.epoll_fd, events, SERVER_MAX_EVENTS, -1,
+                                &unblocked);
+
+        if (ready < 0) {
+            ok = errno == EINTR;
+            continue;
+        }
+
+        for (int i = 0; i < ready; i++) {
+            if (events[i].data.ptr == NULL) {
+                server_accept(&s);
+            }
+            else if (events[i].data.ptr == &s) {
+                server_complete(&s);
+            }
+            else {
+                conn_handle(&s, events[i].data.ptr, events[i].events);
+            }
+        }
+
+        server_reap(&s);
+    }
+
+    server_free(&s);
+
+    if (s.listen_fd >= 0) {
+        unlink(path);
+    }
+
+    pthread_sigmask(SIG_SETMASK, &unblocked, NULL);
+
+    return ok;
+}
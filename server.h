@@ -0,0 +1,43 @@
+/** @file
+ * Interfejs modułu obsługującego serwer gier na gnieździe domeny uniksowej
+ *
+ * Serwer przyjmuje połączenia na gnieździe strumieniowym domeny uniksowej.
+ * Każde połączenie obsługuje jedną grę, a klient posługuje się takimi samymi
+ * poleceniami jak w trybie wsadowym: najpierw tworzy grę poleceniem @p B,
+ * a potem wysyła polecenia trybu wsadowego, każde w osobnym wierszu.
+ * Odpowiedzi są takie same jak w trybie wsadowym i są wysyłane w kolejności
+ * poleceń, przy czym komunikaty o błędach trafiają do tego samego połączenia
+ * co wyniki poleceń. Polecenia @p I i @p C oraz raporty o wydajności
+ * generowania ruchów nie są obsługiwane.
+ *
+ * Wszystkie połączenia są obsługiwane przez jeden wątek, który nie blokuje się
+ * na operacjach wejścia-wyjścia. Polecenia, których wykonanie może trwać
+ * długo, to znaczy @p q i @p p na dużych planszach oraz @p r i @p w, są
+ * wykonywane w puli wątków roboczych, a do czasu ich zakończenia kolejne
+ * polecenia z tego samego połączenia czekają.
+ *
+ * @author Szymon Czyżmański 417797
+ * @date 22.05.2020
+ */
+
+#ifndef SERVER_H
+#define SERVER_H
+
+#include <stdbool.h>
+
+/** @brief Uruchamia serwer.
+ * Tworzy gniazdo o podanej ścieżce i obsługuje połączenia do czasu otrzymania
+ * sygnału @p SIGINT lub @p SIGTERM. Następnie kończy wykonywane polecenia,
+ * zamyka połączenia, usuwa gry i gniazdo. Istniejące gniazdo o tej ścieżce
+ * zastępuje tylko wtedy, gdy żaden proces go nie nasłuchuje, a w przeciwnym
+ * przypadku, tak jak wtedy, gdy ścieżka wskazuje na plik innego rodzaju, nie
+ * uruchamia się.
+ * @param[in] path        – ścieżka gniazda,
+ * @param[in] workers_num – liczba wątków roboczych, liczba dodatnia.
+ * @return Wartość @p true, jeżeli serwer zakończył działanie po otrzymaniu
+ * sygnału, a @p false, gdy nie udało się utworzyć gniazda, zaalokować pamięci
+ * lub utworzyć wątku.
+ */
+bool server_run(const char *path, unsigned workers_num);
+
+#endif // SERVER_H
@@ -0,0 +1,341 @@
+/** @file
+ * Implementacja modułu wykonującego polecenia wielu gier jednocześnie
+ *
+ * @author Szymon Czyżmański 417797
+ * @date 22.05.2020
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "session.h"
+#include "command.h"
+#include "gamma.h"
+#include "ring.h"
+#include "writer.h"
+
+/**
+ * Liczba miejsc w kolejce poleceń jednego wątku roboczego.
+ */
+#define SESSION_QUEUE_CAPACITY (1 << 10)
+/**
+ * Logarytm o podstawie 2 z początkowej liczby miejsc w tablicy gier jednego
+ * wątku roboczego.
+ */
+#define SESSION_TABLE_INITIAL_BITS 4
+/**
+ * Mnożnik używany do mieszania identyfikatorów gier, najbliższa liczba
+ * nieparzysta do 2^64 podzielonego przez złotą proporcję.
+ */
+#define SESSION_HASH_MULTIPLIER UINT64_C(11400714819323198485)
+
+/**
+ * Napis wypisywany po utworzeniu lub usunięciu gry.
+ */
+#define OK_INFIX "OK "
+
+/**
+ * Typ struktury przechowującej jedno miejsce w tablicy gier.
+ */
+typedef struct session_slot session_slot_t;
+
+/**
+ * Struktura przechowująca jedno miejsce w tablicy gier.
+ */
+struct session_slot {
+    gamma_t *g;     /**< Wskaźnik na strukturę przechowującą stan gry lub NULL,
+                     *   jeżeli miejsce jest wolne. */
+    uint32_t id;    /**< Identyfikator gry. */
+};
+
+/**
+ * Struktura przechowująca gry jednego wątku roboczego. Gry są przechowywane
+ * w tablicy z adresowaniem otwartym, do której ma dostęp tylko ten wątek.
+ */
+struct session_worker {
+    ring_t queue;           /**< Kolejka poleceń do wykonania. */
+    writer_t writer;        /**< Moduł wypisujący wyniki poleceń. */
+    session_slot_t *slots;  /**< Tablica gier. */
+    size_t mask;            /**< Liczba miejsc w tablicy gier pomniejszona
+                             *   o 1, liczba miejsc jest potęgą 2. */
+    unsigned bits;          /**< Logarytm o podstawie 2 z liczby miejsc
+                             *   w tablicy gier. */
+    size_t count;           /**< Liczba gier. */
+    pthread_t thread;       /**< Identyfikator wątku. */
+};
+
+/** @brief Podaje miejsce, od którego zaczyna się szukanie gry.
+ * Wątek dostaje tylko gry o identyfikatorach przystających do siebie modulo
+ * liczba wątków, więc miejsce wyznaczają najstarsze bity iloczynu, zależne
+ * od wszystkich bitów identyfikatora, a nie najmłodsze.
+ * @param[in] worker – wskaźnik na strukturę przechowującą gry wątku,
+ * @param[in] id     – identyfikator gry.
+ * @return Indeks miejsca w tablicy gier.
+ */
+static inline size_t session_home(const session_worker_t *worker, uint32_t id) {
+    return (size_t) ((id * SESSION_HASH_MULTIPLIER) >> (64 - worker->bits));
+}
+
+/** @brief Szuka gry w tablicy gier.
+ * @param[in] worker – wskaźnik na strukturę przechowującą gry wątku,
+ * @param[in] id     – identyfikator gry.
+ * @return Indeks miejsca zajmowanego przez grę lub, jeżeli gry nie ma
+ * w tablicy, indeks wolnego miejsca, w którym należy ją umieścić.
+ */
+static size_t session_find(const session_worker_t *worker, uint32_t id) {
+    size_t i = session_home(worker, id);
+
+    while (worker->slots[i].g != NULL && worker->slots[i].id != id) {
+        i = (i + 1) & worker->mask;
+    }
+
+    return i;
+}
+
+/** @brief Podwaja rozmiar tablicy gier.
+ * @param[in,out] worker – wskaźnik na strukturę przechowującą gry wątku.
+ * @return Wartość @p true, jeżeli powiększono tablicę, a @p false, gdy nie
+ * udało się zaalokować pamięci.
+ */
+static bool session_grow(session_worker_t *worker) {
+    session_slot_t *old_slots = worker->slots;
+    size_t old_capacity = worker->mask + 1;
+    session_slot_t *slots = calloc(2 * old_capacity, sizeof(session_slot_t));
+
+    if (slots == NULL) {
+        return false;
+    }
+
+    worker->slots = slots;
+    worker->mask = 2 * old_capacity - 1;
+    worker->bits++;
+
+    for (size_t i = 0; i < old_capacity; i++) {
+        if (old_slots[i].g != NULL) {
+            worker->slots[session_find(worker, old_slots[i].id)] = old_slots[i];
+        }
+    }
+
+    free(old_slots);
+
+    return true;
+}
+
+/** @brief Usuwa grę z tablicy gier.
+ * Przesuwa gry następujące po zwolnionym miejscu tak, aby każdą z nich dalej
+ * można było znaleźć, zaczynając od jej miejsca początkowego.
+ * @param[in,out] worker – wskaźnik na strukturę przechowującą gry wątku,
+ * @param[in] i          – indeks miejsca zajmowanego przez grę.
+ */
+static void session_remove(session_worker_t *worker, size_t i) {
+    size_t j = i;
+
+    worker->slots[i].g = NULL;
+    worker->count--;
+
+    while (true) {
+        j = (j + 1) & worker->mask;
+
+        if (worker->slots[j].g == NULL) {
+            return;
+        }
+
+        size_t home = session_home(worker, worker->slots[j].id);
+
+        if (((j - home) & worker->mask) >= ((j - i) & worker->mask)) {
+            worker->slots[i] = worker->slots[j];
+            worker->slots[j].g = NULL;
+            i = j;
+        }
+    }
+}
+
+/** @brief Wypisuje informację o utworzeniu lub usunięciu gry.
+ * @param[in,out] w    – wskaźnik na strukturę przechowującą stan modułu
+ *                       wypisującego,
+ * @param[in] id       – identyfikator gry,
+ * @param[in] line_num – numer linii, w której wystąpiło polecenie.
+ */
+static void session_print_ok(writer_t *w, uint32_t id, unsigned line_num) {
+    writer_reserve(w, WRITER_OUT, COMMAND_REPLY_MAX_LEN);
+    writer_put_number(w, WRITER_OUT, id, ' ');
+    writer_put_string(w, WRITER_OUT, OK_INFIX, sizeof(OK_INFIX) - 1);
+    writer_put_number(w, WRITER_OUT, line_num, '\n');
+}
+
+/** @brief Tworzy grę.
+ * @param[in,out] worker – wskaźnik na strukturę przechowującą gry wątku,
+ * @param[in] command    – wskaźnik na polecenie.
+ */
+static void session_new(session_worker_t *worker,
+                        const session_command_t *command) {
+    const uint32_t *arguments = command->arguments;
+    size_t i = session_find(worker, command->id);
+
+    if (worker->slots[i].g != NULL) {
+        command_print_error(&worker->writer, command->line_num);
+        return;
+    }
+
+    gamma_t *g = gamma_new(arguments[0], arguments[1], arguments[2],
+                           arguments[3]);
+
+    if (g == NULL) {
+        command_print_error(&worker->writer, command->line_num);
+    }
+    else if (2 * (worker->count + 1) > worker->mask + 1
+             && !session_grow(worker)) {
+        gamma_delete(g);
+        command_print_error(&worker->writer, command->line_num);
+    }
+    else {
+        i = session_find(worker, command->id);
+        worker->slots[i] = (session_slot_t) {.g = g, .id = command->id};
+        worker->count++;
+        session_print_ok(&worker->writer, command->id, command->line_num);
+    }
+}
+
+/** @brief Wykonuje polecenia przekazane wątkowi roboczemu.
+ * Pobiera polecenia z kolejki, dopóki nie zostanie ona zamknięta,
+ * i wykonuje je w kolejności, w jakiej zostały przekazane.
+ * @param[in,out] data – wskaźnik na strukturę przechowującą gry wątku.
+ * @return Wartość NULL.
+ */
+static void *session_worker_run(void *data) {
+    session_worker_t *worker = data;
+    session_command_t command;
+
+    while (true) {
+        if (!ring_ready(&worker->queue)) {
+            writer_flush(&worker->writer);
+        }
+
+        if (!ring_pop(&worker->queue, &command)) {
+            break;
+        }
+
+        if (command.command == SESSION_INVALID) {
+            command_print_error(&worker->writer, command.line_num);
+        }
+        else if (command.command == SESSION_NEW) {
+            session_new(worker, &command);
+        }
+        else {
+            size_t i = session_find(worker, command.id);
+            gamma_t *g = worker->slots[i].g;
+
+            if (g == NULL) {
+                command_print_error(&worker->writer, command.line_num);
+            }
+            else if (command.command == SESSION_DELETE) {
+                gamma_delete(g);
+                session_remove(worker, i);
+                session_print_ok(&worker->writer, command.id, command.line_num);
+            }
+            else {
+                command_execute_game(&worker->writer, g, &command.id,
+                                     command.line_num, command.command,
+                                     command.arguments, 1);
+            }
+        }
+    }
+
+    return NULL;
+}
+
+/** @brief Inicjuje wątek roboczy.
+ * @param[out] worker – wskaźnik na strukturę przechowującą gry wątku,
+ * @param[in] lock    – wskaźnik na blokadę chroniącą standardowe wyjście
+ *                      i standardowe wyjście diagnostyczne.
+ * @return Wartość @p true, jeżeli zainicjowano wątek, a @p false, gdy nie
+ * udało się zaalokować pamięci lub utworzyć wątku.
+ */
+static bool session_worker_init(session_worker_t *worker, pthread_mutex_t *lock) {
+    worker->slots = calloc((size_t) 1 << SESSION_TABLE_INITIAL_BITS,
+                           sizeof(session_slot_t));
+    worker->mask = ((size_t) 1 << SESSION_TABLE_INITIAL_BITS) - 1;
+    worker->bits = SESSION_TABLE_INITIAL_BITS;
+    worker->count = 0;
+
+    if (worker->slots == NULL) {
+        return false;
+    }
+    else if (!ring_init(&worker->queue, SESSION_QUEUE_CAPACITY,
+                        sizeof(session_command_t))) {
+        free(worker->slots);
+        return false;
+    }
+    else if (!writer_init(&worker->writer, fileno(stdout), fileno(stderr))) {
+        ring_free(&worker->queue);
+        free(worker->slots);
+        return false;
+    }
+
+    writer_set_lock(&worker->writer, lock);
+
+    if (pthread_create(&worker->thread, NULL, session_worker_run, worker) != 0) {
+        writer_free(&worker->writer);
+        ring_free(&worker->queue);
+        free(worker->slots);
+        return false;
+    }
+    else {
+        return true;
+    }
+}
+
+/** @brief Kończy działanie wątku roboczego.
+ * Zamyka kolejkę poleceń, czeka na zakończenie wątku, usuwa jego gry
+ * i zwalnia pamięć.
+ * @param[in,out] worker – wskaźnik na strukturę przechowującą gry wątku.
+ */
+static void session_worker_free(session_worker_t *worker) {
+    ring_close(&worker->queue);
+    pthread_join(worker->thread, NULL);
+
+    for (size_t i = 0; i <= worker->mask; i++) {
+        gamma_delete(worker->slots[i].g);
+    }
+
+    writer_free(&worker->writer);
+    ring_free(&worker->queue);
+    free(worker->slots);
+}
+
+bool session_pool_init(session_pool_t *pool, unsigned workers_num) {
+    pool->workers = malloc(workers_num * sizeof(session_worker_t));
+    pool->workers_num = 0;
+
+    if (pool->workers == NULL) {
+        return false;
+    }
+    else if (pthread_mutex_init(&pool->lock, NULL) != 0) {
+        free(pool->workers);
+        return false;
+    }
+
+    while (pool->workers_num < workers_num) {
+        if (!session_worker_init(&pool->workers[pool->workers_num], &pool->lock)) {
+            session_pool_free(pool);
+            return false;
+        }
+
+        pool->workers_num++;
+    }
+
+    return true;
+}
+
+void session_pool_submit(session_pool_t *pool, const session_command_t *command) {
+    ring_push(&pool->workers[command->id % pool->workers_num].queue, command);
+}
+
+void session_pool_free(session_pool_t *pool) {
+    for (unsigned i = 0; i < pool->workers_num; i++) {
+        session_worker_free(&pool->workers[i]);
+    }
+
+    pthread_mutex_destroy(&pool->lock);
+    free(pool->workers);
+}
@@ -0,0 +1,161 @@
+/** @file
+ * Interfejs modułu wykonującego polecenia wielu gier jednocześnie
+ *
+ * W trybie wielu gier każde polecenie jest poprzedzone identyfikatorem gry,
+ * czyli nieujemną liczbą nieprzekraczającą wartości @p UINT32_MAX. Polecenie
+ * @ref session_opcode::SESSION_NEW tworzy grę o podanym identyfikatorze,
+ * polecenie @ref session_opcode::SESSION_DELETE ją usuwa, a pozostałe polecenia
+ * mają takie same argumenty jak w trybie wsadowym i dotyczą gry o podanym
+ * identyfikatorze.
+ *
+ * Wynik polecenia jest wypisywany na standardowe wyjście w wierszu
+ * zaczynającym się od identyfikatora gry i spacji. Po utworzeniu lub usunięciu
+ * gry wypisywany jest napis @p "OK" i numer linii. Wynikiem polecenia
+ * @ref session_opcode::SESSION_BOARD jest wiersz zawierający sam identyfikator
+ * gry, po którym następuje opis planszy. Komunikaty o błędach wypisywane
+ * na standardowe wyjście diagnostyczne są takie same jak w trybie wsadowym.
+ *
+ * Gry są rozdzielone między wątki robocze, a polecenia dotyczące jednej gry
+ * są wykonywane przez jeden wątek w kolejności, w jakiej zostały przekazane.
+ * Wyniki poleceń dotyczących jednej gry są więc wypisywane w kolejności
+ * poleceń, a wyniki poleceń dotyczących różnych gier mogą się przeplatać.
+ *
+ * @author Szymon Czyżmański 417797
+ * @date 22.05.2020
+ */
+
+#ifndef SESSION_H
+#define SESSION_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <pthread.h>
+
+#include "command.h"
+
+/**
+ * Największa liczba argumentów polecenia, równa największej liczbie argumentów
+ * polecenia w trybie wsadowym.
+ */
+#define SESSION_ARGUMENTS_MAX_NUM 5
+/**
+ * Największa liczba wątków roboczych.
+ */
+#define SESSION_MAX_WORKERS 256
+
+/**
+ * Typ wyliczeniowy określający kod polecenia w trybie wielu gier.
+ */
+typedef enum session_opcode session_opcode_t;
+
+/**
+ * Wyliczenia określające kody poleceń w trybie wielu gier. Są one równe znakom
+ * oznaczającym te polecenia w liniach wejścia, a kody poleceń dotyczących
+ * istniejącej gry są równe znakom poleceń trybu wsadowego, więc polecenia te
+ * wykonuje funkcja @ref command_execute_game.
+ */
+enum session_opcode {
+    SESSION_INVALID = '\0',                         /**< Niepoprawna linia,
+                                                     *   powoduje wypisanie
+                                                     *   komunikatu o błędzie. */
+    SESSION_NEW = 'B',                              /**< Wywołanie
+                                                     *   @ref gamma_new,
+                                                     *   4 argumenty. */
+    SESSION_DELETE = 'D',                           /**< Wywołanie
+                                                     *   @ref gamma_delete,
+                                                     *   bez argumentów. */
+    SESSION_MOVE = GAMMA_MOVE,                      /**< Wywołanie
+                                                     *   @ref gamma_move,
+                                                     *   3 argumenty. */
+    SESSION_GOLDEN_MOVE = GAMMA_GOLDEN_MOVE,        /**< Wywołanie
+                                                     *   @ref gamma_golden_move,
+                                                     *   3 argumenty. */
+    SESSION_BUSY_FIELDS = GAMMA_BUSY_FIELDS,        /**< Wywołanie
+                                                     *   @ref gamma_busy_fields,
+                                                     *   1 argument. */
+    SESSION_FREE_FIELDS = GAMMA_FREE_FIELDS,        /**< Wywołanie
+                                                     *   @ref gamma_free_fields,
+                                                     *   1 argument. */
+    SESSION_GOLDEN_POSSIBLE = GAMMA_GOLDEN_POSSIBLE, /**< Wywołanie
+                                                     *   @ref gamma_golden_possible,
+                                                     *   1 argument. */
+    SESSION_SAME_AREA = GAMMA_SAME_AREA,            /**< Wywołanie
+                                                     *   @ref gamma_same_area,
+                                                     *   4 argumenty. */
+    SESSION_BOARD = GAMMA_BOARD,                    /**< Wywołanie
+                                                     *   @ref gamma_board,
+                                                     *   bez argumentów. */
+    SESSION_RANDOM = GENERATE_RANDOM,               /**< Wywołanie
+                                                     *   @ref generator_random_moves,
+                                                     *   2 argumenty. */
+    SESSION_FILL = GENERATE_FILL,                   /**< Wywołanie
+                                                     *   @ref generator_fill,
+                                                     *   5 argumentów. */
+    SESSION_TERRITORY = TERRITORY_PLAYER            /**< Wywołanie
+                                                     *   @ref territory_player,
+                                                     *   1 argument. */
+};
+
+/**
+ * Typ struktury przechowującej zdekodowane polecenie trybu wielu gier.
+ */
+typedef struct session_command session_command_t;
+
+/**
+ * Struktura przechowująca zdekodowane polecenie trybu wielu gier.
+ */
+struct session_command {
+    uint32_t arguments[SESSION_ARGUMENTS_MAX_NUM]; /**< Argumenty polecenia. */
+    uint32_t id;                                   /**< Identyfikator gry. */
+    unsigned line_num;                             /**< Numer linii. */
+    char command;                                  /**< Kod polecenia, jedna
+                                                    *   z wartości wyliczenia
+                                                    *   @ref session_opcode. */
+};
+
+/**
+ * Typ struktury przechowującej gry jednego wątku roboczego.
+ */
+typedef struct session_worker session_worker_t;
+
+/**
+ * Typ struktury przechowującej stan puli wątków roboczych.
+ */
+typedef struct session_pool session_pool_t;
+
+/**
+ * Struktura przechowująca stan puli wątków roboczych.
+ */
+struct session_pool {
+    session_worker_t *workers; /**< Tablica wątków roboczych. */
+    unsigned workers_num;      /**< Liczba wątków roboczych. */
+    pthread_mutex_t lock;      /**< Blokada chroniąca standardowe wyjście
+                                *   i standardowe wyjście diagnostyczne. */
+};
+
+/** @brief Uruchamia pulę wątków roboczych.
+ * @param[out] pool       – wskaźnik na strukturę przechowującą stan puli,
+ * @param[in] workers_num – liczba wątków roboczych, liczba dodatnia
+ *                          nie większa od @ref SESSION_MAX_WORKERS.
+ * @return Wartość @p true, jeżeli uruchomiono pulę, a @p false, gdy nie udało
+ * się zaalokować pamięci lub utworzyć wątku.
+ */
+bool session_pool_init(session_pool_t *pool, unsigned workers_num);
+
+/** @brief Przekazuje polecenie do wykonania.
+ * Przekazuje polecenie wątkowi roboczemu, do którego należy gra o podanym
+ * identyfikatorze. Jeżeli kolejka tego wątku jest pełna, czeka na wolne
+ * miejsce. Może ją wywoływać tylko jeden wątek.
+ * @param[in,out] pool  – wskaźnik na strukturę przechowującą stan puli,
+ * @param[in] command   – wskaźnik na polecenie.
+ */
+void session_pool_submit(session_pool_t *pool, const session_command_t *command);
+
+/** @brief Kończy działanie puli wątków roboczych.
+ * Czeka, aż wątki robocze wykonają wszystkie przekazane polecenia, wypisuje
+ * pozostałe wyniki, usuwa wszystkie gry i zwalnia pamięć puli.
+ * @param[in,out] pool – wskaźnik na strukturę przechowującą stan puli.
+ */
+void session_pool_free(session_pool_t *pool);
+
+#endif // SESSION_H
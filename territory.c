@@ -0,0 +1,400 @@
+/** @file
+ * Implementacja modułu wyznaczającego terytoria graczy
+ *
+ * @author Szymon Czyżmański 417797
+ * @date 20.05.2020
+ */
+
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "parallel.h"
+#include "territory.h"
+
+/**
+ * Bit stanu pola oznaczający, że pole zostało odwiedzone.
+ */
+#define TERRITORY_VISITED (UINT64_C(1) << 63)
+
+/**
+ * Bit stanu pola oznaczający, że pole jest zajęte i jest źródłem przeszukiwania.
+ */
+#define TERRITORY_SOURCE (UINT64_C(1) << 62)
+
+/**
+ * Maska numeru poziomu przeszukiwania zapisywanego w stanie pola. Numery
+ * poziomów sąsiednich pól różnią się co najwyżej o 1, więc wystarczy pamiętać
+ * numer poziomu modulo liczba o 1 większa od tej maski.
+ */
+#define TERRITORY_LEVEL_MASK ((UINT64_C(1) << 30) - 1)
+
+/**
+ * Liczba pól, które wątek zbiera przed dopisaniem ich do następnego poziomu
+ * przeszukiwania.
+ */
+#define TERRITORY_BATCH 256
+
+/**
+ * Liczba sąsiadów pola.
+ */
+#define TERRITORY_NEIGHBOURS 4
+
+/**
+ * Przesunięcia współrzędnej x sąsiadów pola.
+ */
+static const int64_t TERRITORY_DX[TERRITORY_NEIGHBOURS] = {-1, 1, 0, 0};
+
+/**
+ * Przesunięcia współrzędnej y sąsiadów pola.
+ */
+static const int64_t TERRITORY_DY[TERRITORY_NEIGHBOURS] = {0, 0, -1, 1};
+
+/**
+ * Typ struktury przechowującej stan przeszukiwania.
+ */
+typedef struct territory territory_t;
+
+/**
+ * Struktura przechowująca stan przeszukiwania. Stan pola o indeksie
+ * @p y * @p width + @p x jest równy 0, jeżeli pole nie zostało jeszcze
+ * odwiedzone, a w przeciwnym przypadku zawiera bit @ref TERRITORY_VISITED,
+ * ewentualnie bit @ref TERRITORY_SOURCE, numer poziomu, na którym pole zostało
+ * odwiedzone, w bitach od 32 oraz numer gracza, do którego należy pole, lub 0,
+ * jeżeli nie należy do nikogo, w młodszych 32 bitach.
+ */
+struct territory {
+    uint32_t width;            /**< Szerokość planszy. */
+    uint32_t height;           /**< Wysokość planszy. */
+    uint32_t players;          /**< Liczba graczy. */
+    uint32_t *owners;          /**< Macierz właścicieli pól, używana tylko przy
+                                *   inicjowaniu stanów pól. */
+    _Atomic uint64_t *state;   /**< Tablica stanów pól. */
+    uint64_t *frontier;        /**< Tablica indeksów pól bieżącego poziomu. */
+    uint64_t frontier_size;    /**< Liczba pól bieżącego poziomu. */
+    uint64_t *next;            /**< Tablica indeksów pól następnego poziomu. */
+    _Atomic uint64_t next_size; /**< Liczba pól następnego poziomu. */
+    uint64_t level;            /**< Numer bieżącego poziomu. */
+    unsigned workers;          /**< Liczba części, na które dzielony jest
+                                *   bieżący poziom. */
+    uint64_t *counts;          /**< Tablica liczników pól, o długości równej
+                                *   iloczynowi liczby wątków i liczby o 1 większej
+                                *   niż liczba graczy. */
+};
+
+/**
+ * Typ struktury przechowującej pola zebrane przez wątek.
+ */
+typedef struct territory_batch territory_batch_t;
+
+/**
+ * Struktura przechowująca pola zebrane przez wątek przed dopisaniem ich do
+ * następnego poziomu przeszukiwania.
+ */
+struct territory_batch {
+    uint64_t cells[TERRITORY_BATCH]; /**< Indeksy zebranych pól. */
+    unsigned size;                   /**< Liczba zebranych pól. */
+};
+
+/** @brief Tworzy stan odwiedzonego pola.
+ * @param[in] level – numer poziomu, na którym pole zostało odwiedzone,
+ * @param[in] label – numer gracza, do którego należy pole, lub 0.
+ * @return Stan pola.
+ */
+static inline uint64_t territory_state(uint64_t level, uint32_t label) {
+    return TERRITORY_VISITED | (level & TERRITORY_LEVEL_MASK) << 32 | label;
+}
+
+/** @brief Podaje numer poziomu zapisany w stanie pola.
+ * @param[in] state – stan odwiedzonego pola.
+ * @return Numer poziomu modulo liczba o 1 większa od @ref TERRITORY_LEVEL_MASK.
+ */
+static inline uint64_t territory_level(uint64_t state) {
+    return state >> 32 & TERRITORY_LEVEL_MASK;
+}
+
+/** @brief Dopisuje zebrane pola do następnego poziomu przeszukiwania.
+ * @param[in,out] t     – wskaźnik na stan przeszukiwania,
+ * @param[in,out] batch – wskaźnik na pola zebrane przez wątek.
+ */
+static void territory_flush(territory_t *t, territory_batch_t *batch) {
+    uint64_t pos = atomic_fetch_add_explicit(&t->next_size, batch->size,
+                                             memory_order_relaxed);
+
+    memcpy(t->next + pos, batch->cells, batch->size * sizeof(uint64_t));
+    batch->size = 0;
+}
+
+/** @brief Dodaje pole do następnego poziomu przeszukiwania.
+ * @param[in,out] t     – wskaźnik na stan przeszukiwania,
+ * @param[in,out] batch – wskaźnik na pola zebrane przez wątek,
+ * @param[in] cell      – indeks pola.
+ */
+static inline void territory_push(territory_t *t, territory_batch_t *batch,
+                                  uint64_t cell) {
+    batch->cells[batch->size++] = cell;
+
+    if (batch->size == TERRITORY_BATCH) {
+        territory_flush(t, batch);
+    }
+}
+
+/** @brief Inicjuje stany pól pasa wierszy planszy.
+ * Oznacza zajęte pola jako źródła przeszukiwania należące do ich właścicieli
+ * i dodaje do pierwszego poziomu przeszukiwania te z nich, które sąsiadują
+ * z wolnym polem.
+ * @param[in,out] arg – wskaźnik na stan przeszukiwania,
+ * @param[in] begin   – numer pierwszego wiersza pasa,
+ * @param[in] end     – numer wiersza następującego po ostatnim wierszu pasa,
+ * @param[in] worker  – numer wątku.
+ */
+static void territory_init_rows(void *arg, uint32_t begin, uint32_t end,
+                                unsigned worker) {
+    territory_t *t = arg;
+    territory_batch_t batch = {.size = 0};
+    (void) worker;
+
+    for (uint32_t y = begin; y < end; y++) {
+        for (uint32_t x = 0; x < t->width; x++) {
+            uint64_t cell = (uint64_t) y * t->width + x;
+            uint32_t owner = t->owners[cell];
+
+            if (owner == 0) {
+                atomic_init(&t->state[cell], 0);
+            }
+            else {
+                bool frontier = false;
+
+                atomic_init(&t->state[cell], territory_state(0, owner)
+                                             | TERRITORY_SOURCE);
+
+                for (unsigned dir = 0; dir < TERRITORY_NEIGHBOURS; dir++) {
+                    int64_t nx = (int64_t) x + TERRITORY_DX[dir];
+                    int64_t ny = (int64_t) y + TERRITORY_DY[dir];
+
+                    if (nx >= 0 && nx < t->width && ny >= 0 && ny < t->height
+                        && t->owners[(uint64_t) ny * t->width + nx] == 0) {
+                        frontier = true;
+                    }
+                }
+
+                if (frontier) {
+                    territory_push(t, &batch, cell);
+                }
+            }
+        }
+    }
+
+    territory_flush(t, &batch);
+}
+
+/** @brief Odwiedza wolne pole z pola bieżącego poziomu.
+ * Przypisuje nieodwiedzone pole graczowi @p label na następnym poziomie
+ * przeszukiwania i dodaje je do tego poziomu. Pole odwiedzone już na następnym
+ * poziomie z pola innego gracza przestaje należeć do kogokolwiek.
+ * @param[in,out] t     – wskaźnik na stan przeszukiwania,
+ * @param[in,out] batch – wskaźnik na pola zebrane przez wątek,
+ * @param[in] cell      – indeks odwiedzanego pola,
+ * @param[in] label     – numer gracza, do którego należy pole bieżącego
+ *                        poziomu, lub 0.
+ */
+static void territory_visit(territory_t *t, territory_batch_t *batch,
+                            uint64_t cell, uint32_t label) {
+    uint64_t level = (t->level + 1) & TERRITORY_LEVEL_MASK;
+    uint64_t state = atomic_load_explicit(&t->state[cell], memory_order_relaxed);
+
+    while (true) {
+        if (state == 0) {
+            if (atomic_compare_exchange_weak_explicit(
+                    &t->state[cell], &state, territory_state(level, label),
+                    memory_order_relaxed, memory_order_relaxed)) {
+                territory_push(t, batch, cell);
+
+                return;
+            }
+        }
+        else if ((state & TERRITORY_SOURCE) == 0
+                 && territory_level(state) == level
+                 && (uint32_t) state != label && (uint32_t) state != 0) {
+            if (atomic_compare_exchange_weak_explicit(
+                    &t->state[cell], &state, territory_state(level, 0),
+                    memory_order_relaxed, memory_order_relaxed)) {
+                return;
+            }
+        }
+        else {
+            return;
+        }
+    }
+}
+
+/** @brief Przetwarza część bieżącego poziomu przeszukiwania.
+ * Odwiedza wolnych sąsiadów pól części o numerze @p begin spośród
+ * @ref territory::workers równych części bieżącego poziomu.
+ * @param[in,out] arg – wskaźnik na stan przeszukiwania,
+ * @param[in] begin   – numer części,
+ * @param[in] end     – numer następnej części,
+ * @param[in] worker  – numer wątku.
+ */
+static void territory_expand(void *arg, uint32_t begin, uint32_t end,
+                             unsigned worker) {
+    territory_t *t = arg;
+    territory_batch_t batch = {.size = 0};
+    uint64_t first = t->frontier_size * begin / t->workers;
+    uint64_t last = t->frontier_size * end / t->workers;
+    (void) worker;
+
+    for (uint64_t i = first; i < last; i++) {
+        uint64_t cell = t->frontier[i];
+        uint32_t label = (uint32_t) atomic_load_explicit(&t->state[cell],
+                                                         memory_order_relaxed);
+        uint32_t x = (uint32_t) (cell % t->width);
+        uint32_t y = (uint32_t) (cell / t->width);
+
+        for (unsigned dir = 0; dir < TERRITORY_NEIGHBOURS; dir++) {
+            int64_t nx = (int64_t) x + TERRITORY_DX[dir];
+            int64_t ny = (int64_t) y + TERRITORY_DY[dir];
+
+            if (nx >= 0 && nx < t->width && ny >= 0 && ny < t->height) {
+                territory_visit(t, &batch, (uint64_t) ny * t->width + nx, label);
+            }
+        }
+    }
+
+    territory_flush(t, &batch);
+}
+
+/** @brief Zlicza terytoria w pasie wierszy planszy.
+ * @param[in,out] arg – wskaźnik na stan przeszukiwania,
+ * @param[in] begin   – numer pierwszego wiersza pasa,
+ * @param[in] end     – numer wiersza następującego po ostatnim wierszu pasa,
+ * @param[in] worker  – numer wątku.
+ */
+static void territory_count_rows(void *arg, uint32_t begin, uint32_t end,
+                                 unsigned worker) {
+    territory_t *t = arg;
+    uint64_t *counts = t->counts + (uint64_t) worker * (t->players + 1);
+
+    for (uint64_t cell = (uint64_t) begin * t->width;
+         cell < (uint64_t) end * t->width; cell++) {
+        uint64_t state = atomic_load_explicit(&t->state[cell],
+                                              memory_order_relaxed);
+
+        if ((state & TERRITORY_SOURCE) == 0) {
+            counts[(uint32_t) state]++;
+        }
+    }
+}
+
+/** @brief Podaje liczbę wątków dla pracy danej wielkości.
+ * Także liczbę wątków wybraną przez użytkownika ogranicza tak, aby na każdy
+ * wątek przypadało co najmniej @ref PARALLEL_MIN_WORK jednostek pracy, więc
+ * małe poziomy przeszukiwania są przetwarzane w wątku wołającym, bez
+ * tworzenia wątków.
+ * @param[in] threads – liczba wątków wybrana przez użytkownika lub 0,
+ * @param[in] work    – liczba jednostek pracy,
+ * @param[in] limit   – największa dopuszczalna liczba wątków, liczba dodatnia.
+ * @return Liczba wątków.
+ */
+static unsigned territory_threads(unsigned threads, uint64_t work, uint64_t limit) {
+    if (threads == 0) {
+        threads = parallel_threads(work);
+    }
+    if (work / PARALLEL_MIN_WORK < limit) {
+        limit = work >= PARALLEL_MIN_WORK ? work / PARALLEL_MIN_WORK : 1;
+    }
+
+    return threads > limit ? (unsigned) limit : threads;
+}
+
+/** @brief Przeprowadza przeszukiwanie wszerz ze wszystkich zajętych pól.
+ * @param[in,out] t   – wskaźnik na stan przeszukiwania z zainicjowaną macierzą
+ *                      właścicieli pól,
+ * @param[in] threads – liczba wątków lub 0.
+ */
+static void territory_search(territory_t *t, unsigned threads) {
+    uint64_t cells = (uint64_t) t->width * t->height;
+    unsigned rows_threads = territory_threads(threads, cells, t->height);
+
+    atomic_init(&t->next_size, 0);
+    parallel_for(t->height, rows_threads, territory_init_rows, t);
+
+    for (t->level = 0; atomic_load(&t->next_size) > 0; t->level++) {
+        uint64_t *frontier = t->frontier;
+
+        t->frontier = t->next;
+        t->frontier_size = atomic_load(&t->next_size);
+        t->next = frontier;
+        atomic_store(&t->next_size, 0);
+        t->workers = territory_threads(threads, t->frontier_size,
+                                       t->frontier_size);
+
+        parallel_for(t->workers, t->workers, territory_expand, t);
+    }
+}
+
+bool territory_count(gamma_t *g, unsigned threads, uint64_t *counts) {
+    if (g == NULL || counts == NULL) {
+        return false;
+    }
+
+    territory_t t = {
+        .width = gamma_width(g),
+        .height = gamma_board_height(g),
+        .players = gamma_players(g)
+    };
+    uint64_t cells = (uint64_t) t.width * t.height;
+    unsigned rows_threads = territory_threads(threads, cells, t.height);
+    bool result = false;
+
+    t.owners = malloc(cells * sizeof(uint32_t));
+    t.state = malloc(cells * sizeof(uint64_t));
+    t.frontier = malloc(cells * sizeof(uint64_t));
+    t.next = malloc(cells * sizeof(uint64_t));
+    t.counts = calloc((uint64_t) rows_threads * (t.players + 1), sizeof(uint64_t));
+
+    if (t.owners != NULL && t.state != NULL && t.frontier != NULL
+        && t.next != NULL && t.counts != NULL && gamma_board_owners(g, t.owners)) {
+
+        territory_search(&t, threads);
+        parallel_for(t.height, rows_threads, territory_count_rows, &t);
+
+        for (uint32_t player = 0; player <= t.players; player++) {
+            counts[player] = 0;
+
+            for (unsigned worker = 0; worker < rows_threads; worker++) {
+                counts[player] += t.counts[(uint64_t) worker * (t.players + 1)
+                                           + player];
+            }
+        }
+
+        result = true;
+    }
+
+    free(t.owners);
+    free((void *) t.state);
+    free(t.frontier);
+    free(t.next);
+    free(t.counts);
+
+    return result;
+}
+
+uint64_t territory_player(gamma_t *g, uint32_t player, unsigned threads) {
+    if (g == NULL || player > gamma_players(g)) {
+        return UINT64_MAX;
+    }
+    else {
+        uint64_t *counts = malloc(((uint64_t) gamma_players(g) + 1)
+                                  * sizeof(uint64_t));
+        uint64_t result = UINT64_MAX;
+
+        if (counts != NULL && territory_count(g, threads, counts)) {
+            result = counts[player];
+        }
+
+        free(counts);
+
+        return result;
+    }
+}
@@ -0,0 +1,53 @@
+/** @file
+ * Interfejs modułu wyznaczającego terytoria graczy
+ *
+ * @author Szymon Czyżmański 417797
+ * @date 20.05.2020
+ */
+
+#ifndef TERRITORY_H
+#define TERRITORY_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "gamma.h"
+
+/** @brief Wyznacza terytoria graczy.
+ * Przypisuje każde wolne pole graczowi, którego pola leżą najbliżej niego,
+ * licząc odległość jako długość najkrótszej ścieżki prowadzącej przez wolne pola
+ * do pola zajętego przez gracza. Pole, do którego najszybciej dociera więcej niż
+ * jeden gracz, lub do którego nie dociera żaden gracz, nie należy do nikogo.
+ * Odległości są wyznaczane przeszukiwaniem wszerz rozpoczynanym jednocześnie ze
+ * wszystkich zajętych pól, w którym duże poziomy przeszukiwania są dzielone
+ * między wątki.
+ * @param[in] g       – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in] threads – największa liczba wątków lub 0, jeżeli ma zostać dobrana
+ *                      automatycznie do rozmiaru każdego poziomu przeszukiwania;
+ *                      poziomy mniejsze od @ref PARALLEL_MIN_WORK pól na wątek
+ *                      dostają mniej wątków,
+ * @param[out] counts – tablica o długości o 1 większej niż liczba graczy,
+ *                      w której indeksie @p player ma zostać zapisana liczba
+ *                      wolnych pól należących do gracza @p player, a w indeksie
+ *                      0 liczba wolnych pól nienależących do nikogo.
+ * @return Wartość @p true, jeżeli wyznaczono terytoria, a @p false, gdy któryś
+ * ze wskaźników jest równy NULL lub nie udało się zaalokować pamięci.
+ */
+bool territory_count(gamma_t *g, unsigned threads, uint64_t *counts);
+
+/** @brief Podaje wielkość terytorium gracza.
+ * Wyznacza terytoria graczy funkcją @ref territory_count i podaje liczbę
+ * wolnych pól należących do gracza @p player.
+ * @param[in] g       – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in] player  – numer gracza, liczba niewiększa od wartości @p players
+ *                      z funkcji @ref gamma_new, lub 0 dla pól nienależących
+ *                      do nikogo,
+ * @param[in] threads – liczba wątków lub 0, jeżeli ma zostać dobrana
+ *                      automatycznie.
+ * @return Liczba wolnych pól należących do gracza @p player lub @p UINT64_MAX,
+ * gdy któryś z parametrów jest niepoprawny albo nie udało się zaalokować
+ * pamięci.
+ */
+uint64_t territory_player(gamma_t *g, uint32_t player, unsigned threads);
+
+#endif // TERRITORY_H
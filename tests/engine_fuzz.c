@@ -0,0 +1,529 @@
+/** @file
+ * Program porównujący silnik gry gamma z prostym modelem wzorcowym
+ *
+ * Model przechowuje samą planszę i wszystkie odpowiedzi wyznacza siłą:
+ * legalność ruchu sprawdza, stawiając pionek i licząc obszary przeszukiwaniem
+ * całej planszy. Program buduje:
+ * gcc -std=c11 -O2 -pthread -I. tests/engine_fuzz.c gamma.c parallel.c
+ *
+ * @author Szymon Czyżmański 417797
+ * @date 22.05.2020
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+
+#include "gamma.h"
+#include "rng.h"
+
+/**
+ * Liczba argumentów wywołania programu, nie licząc jego nazwy.
+ */
+#define FUZZ_ARGUMENTS_NUM 2
+/**
+ * Największa szerokość i wysokość losowanej planszy.
+ */
+#define FUZZ_MAX_SIDE 9
+/**
+ * Największa liczba losowanych graczy, większa od 9, aby sprawdzać także
+ * plansze o polach szerszych niż jeden znak.
+ */
+#define FUZZ_MAX_PLAYERS 11
+/**
+ * Liczba ruchów wykonywanych w jednej grze.
+ */
+#define FUZZ_STEPS 120
+/**
+ * Co ile ruchów są porównywane listy ruchów, mapa bitowa i plansza.
+ */
+#define FUZZ_FULL_CHECK_PERIOD 4
+
+/**
+ * Typ struktury przechowującej model wzorcowy.
+ */
+typedef struct reference reference_t;
+
+/**
+ * Struktura przechowująca model wzorcowy: planszę, informację o wykonanych
+ * złotych ruchach i pamięć na przeszukiwanie planszy.
+ */
+struct reference {
+    uint32_t width;     /**< Szerokość planszy. */
+    uint32_t height;    /**< Wysokość planszy. */
+    uint32_t players;   /**< Liczba graczy. */
+    uint32_t areas;     /**< Maksymalna liczba obszarów jednego gracza. */
+    uint32_t *owners;   /**< Numery właścicieli pól zapisane wierszami. */
+    bool *golden_used;  /**< Informacja, czy gracz wykonał złoty ruch,
+                         *   indeksowana numerem gracza. */
+    bool *visited;      /**< Pola odwiedzone przez przeszukiwanie. */
+    uint32_t *stack;    /**< Stos przeszukiwania. */
+};
+
+/**
+ * Numer rozgrywanej gry, wypisywany przy niezgodności.
+ */
+static unsigned fuzz_game;
+/**
+ * Numer wykonywanego ruchu, wypisywany przy niezgodności.
+ */
+static unsigned fuzz_step;
+
+/** @brief Kończy program, jeżeli silnik nie zgadza się z modelem.
+ * @param[in] ok   – wartość @p true, jeżeli wynik silnika jest zgodny z modelem,
+ * @param[in] what – opis porównywanej wartości.
+ */
+static void fuzz_expect(bool ok, const char *what) {
+    if (!ok) {
+        printf("FAIL game %u step %u: %s\n", fuzz_game, fuzz_step, what);
+        exit(EXIT_FAILURE);
+    }
+}
+
+/** @brief Podaje miejsce, w którym model przechowuje właściciela pola.
+ * @param[in] r – wskaźnik na model,
+ * @param[in] x – numer kolumny,
+ * @param[in] y – numer wiersza.
+ * @return Wskaźnik na numer gracza zajmującego pole, równy 0 dla wolnego pola.
+ */
+static inline uint32_t *reference_field(const reference_t *r, uint32_t x,
+                                        uint32_t y) {
+    return &r->owners[(size_t) y * r->width + x];
+}
+
+/** @brief Liczy obszary gracza przeszukiwaniem w głąb całej planszy.
+ * @param[in,out] r  – wskaźnik na model,
+ * @param[in] player – numer gracza.
+ * @return Liczba obszarów gracza @p player.
+ */
+static uint32_t reference_areas(reference_t *r, uint32_t player) {
+    static const int dx[] = {-1, 1, 0, 0}, dy[] = {0, 0, -1, 1};
+    size_t cells = (size_t) r->width * r->height;
+    uint32_t areas = 0;
+
+    memset(r->visited, 0, cells * sizeof(bool));
+
+    for (size_t i = 0; i < cells; i++) {
+        if (r->owners[i] == player && !r->visited[i]) {
+            size_t top = 0;
+
+            areas++;
+            r->visited[i] = true;
+            r->stack[top++] = (uint32_t) i;
+
+            while (top > 0) {
+                uint32_t c = r->stack[--top];
+
+                for (int d = 0; d < 4; d++) {
+                    int64_t nx = (int64_t) (c % r->width) + dx[d];
+                    int64_t ny = (int64_t) (c / r->width) + dy[d];
+                    size_t n = (size_t) ny * r->width + (size_t) nx;
+
+                    if (nx >= 0 && ny >= 0 && nx < r->width && ny < r->height
+                        && r->owners[n] == player && !r->visited[n]) {
+                        r->visited[n] = true;
+                        r->stack[top++] = (uint32_t) n;
+                    }
+                }
+            }
+        }
+    }
+
+    return areas;
+}
+
+/** @brief Sprawdza w modelu, czy pola należą do jednego obszaru.
+ * Przeszukuje w głąb obszar zawierający pierwsze pole.
+ * @param[in,out] r – wskaźnik na model,
+ * @param[in] a     – indeks pierwszego pola,
+ * @param[in] b     – indeks drugiego pola.
+ * @return Wartość @p true, jeżeli oba pola zajmuje ten sam gracz, a drugie
+ * pole leży w obszarze pierwszego.
+ */
+static bool reference_same_area(reference_t *r, size_t a, size_t b) {
+    static const int dx[] = {-1, 1, 0, 0}, dy[] = {0, 0, -1, 1};
+    uint32_t player = r->owners[a];
+    size_t cells = (size_t) r->width * r->height, top = 0;
+
+    if (player == 0 || r->owners[b] != player) {
+        return false;
+    }
+
+    memset(r->visited, 0, cells * sizeof(bool));
+    r->visited[a] = true;
+    r->stack[top++] = (uint32_t) a;
+
+    while (top > 0) {
+        uint32_t c = r->stack[--top];
+
+        for (int d = 0; d < 4; d++) {
+            int64_t nx = (int64_t) (c % r->width) + dx[d];
+            int64_t ny = (int64_t) (c / r->width) + dy[d];
+            size_t n = (size_t) ny * r->width + (size_t) nx;
+
+            if (nx >= 0 && ny >= 0 && nx < r->width && ny < r->height
+                && r->owners[n] == player && !r->visited[n]) {
+                r->visited[n] = true;
+                r->stack[top++] = (uint32_t) n;
+            }
+        }
+    }
+
+    return r->visited[b];
+}
+
+/** @brief Sprawdza w modelu legalność ruchu.
+ * @param[in,out] r  – wskaźnik na model,
+ * @param[in] player – numer gracza,
+ * @param[in] x      – numer kolumny,
+ * @param[in] y      – numer wiersza.
+ * @return Wartość @p true, jeżeli ruch jest legalny, a @p false w przeciwnym
+ * przypadku.
+ */
+static bool reference_move_legal(reference_t *r, uint32_t player, uint32_t x,
+                                 uint32_t y) {
+    if (player == 0 || player > r->players || x >= r->width || y >= r->height
+        || *reference_field(r, x, y) != 0) {
+        return false;
+    }
+
+    *reference_field(r, x, y) = player;
+    bool legal = reference_areas(r, player) <= r->areas;
+    *reference_field(r, x, y) = 0;
+
+    return legal;
+}
+
+/** @brief Sprawdza w modelu legalność złotego ruchu.
+ * @param[in,out] r  – wskaźnik na model,
+ * @param[in] player – numer gracza,
+ * @param[in] x      – numer kolumny,
+ * @param[in] y      – numer wiersza.
+ * @return Wartość @p true, jeżeli złoty ruch jest legalny, a @p false
+ * w przeciwnym przypadku.
+ */
+static bool reference_golden_legal(reference_t *r, uint32_t player, uint32_t x,
+                                   uint32_t y) {
+    if (player == 0 || player > r->players || x >= r->width || y >= r->height
+        || r->golden_used[player]) {
+        return false;
+    }
+
+    uint32_t victim = *reference_field(r, x, y);
+
+    if (victim == 0 || victim == player) {
+        return false;
+    }
+
+    *reference_field(r, x, y) = player;
+    bool legal = reference_areas(r, player) <= r->areas
+                 && reference_areas(r, victim) <= r->areas;
+    *reference_field(r, x, y) = victim;
+
+    return legal;
+}
+
+/** @brief Liczy w modelu pola zajęte przez gracza.
+ * @param[in] r      – wskaźnik na model,
+ * @param[in] player – numer gracza.
+ * @return Liczba pól zajętych przez gracza @p player.
+ */
+static uint64_t reference_busy(const reference_t *r, uint32_t player) {
+    size_t cells = (size_t) r->width * r->height;
+    uint64_t busy = 0;
+
+    for (size_t i = 0; i < cells; i++) {
+        busy += player != 0 && r->owners[i] == player;
+    }
+
+    return busy;
+}
+
+/** @brief Liczy w modelu pola, na których gracz może wykonać ruch.
+ * @param[in,out] r  – wskaźnik na model,
+ * @param[in] player – numer gracza.
+ * @return Liczba pól, na których gracz @p player może postawić pionek.
+ */
+static uint64_t reference_free(reference_t *r, uint32_t player) {
+    uint64_t free_fields = 0;
+
+    for (uint32_t y = 0; y < r->height; y++) {
+        for (uint32_t x = 0; x < r->width; x++) {
+            free_fields += reference_move_legal(r, player, x, y);
+        }
+    }
+
+    return free_fields;
+}
+
+/** @brief Liczy w modelu złote ruchy gracza.
+ * @param[in,out] r  – wskaźnik na model,
+ * @param[in] player – numer gracza.
+ * @return Liczba pól, na które gracz @p player może wykonać złoty ruch.
+ */
+static uint64_t reference_golden(reference_t *r, uint32_t player) {
+    uint64_t golden = 0;
+
+    for (uint32_t y = 0; y < r->height; y++) {
+        for (uint32_t x = 0; x < r->width; x++) {
+            golden += reference_golden_legal(r, player, x, y);
+        }
+    }
+
+    return golden;
+}
+
+/** @brief Porównuje statystyki wszystkich graczy z modelem.
+ * Sprawdza także numery graczy spoza zakresu.
+ * @param[in,out] g – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in,out] r – wskaźnik na model.
+ */
+static void fuzz_check_players(gamma_t *g, reference_t *r) {
+    for (uint32_t p = 0; p <= r->players + 1; p++) {
+        fuzz_expect(gamma_busy_fields(g, p) == reference_busy(r, p),
+                    "gamma_busy_fields");
+        fuzz_expect(gamma_free_fields(g, p) == reference_free(r, p),
+                    "gamma_free_fields");
+        fuzz_expect(gamma_golden_possible(g, p) == (reference_golden(r, p) > 0),
+                    "gamma_golden_possible");
+
+        if (p >= 1 && p <= r->players) {
+            fuzz_expect(gamma_player_areas(g, p) == reference_areas(r, p),
+                        "gamma_player_areas");
+        }
+    }
+
+    for (uint32_t y = 0; y < r->height; y++) {
+        for (uint32_t x = 0; x < r->width; x++) {
+            fuzz_expect(gamma_board_field_owner(g, x, y)
+                        == *reference_field(r, x, y),
+                        "gamma_board_field_owner");
+        }
+    }
+}
+
+/** @brief Porównuje z modelem mapę bitową i listy ruchów gracza.
+ * @param[in,out] g  – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in,out] r  – wskaźnik na model,
+ * @param[in] player – numer gracza.
+ */
+static void fuzz_check_lists(gamma_t *g, reference_t *r, uint32_t player) {
+    uint64_t bitmap[(FUZZ_MAX_SIDE * FUZZ_MAX_SIDE + 63) / 64];
+    gamma_position_t moves[FUZZ_MAX_SIDE * FUZZ_MAX_SIDE];
+    gamma_golden_move_t golden[FUZZ_MAX_SIDE * FUZZ_MAX_SIDE];
+    uint64_t free_fields = reference_free(r, player);
+    uint64_t golden_num = reference_golden(r, player);
+
+    fuzz_expect(gamma_legal_mask(g, player, bitmap) == free_fields,
+                "gamma_legal_mask count");
+    fuzz_expect(gamma_legal_moves(g, player, moves, free_fields) == free_fields,
+                "gamma_legal_moves count");
+    fuzz_expect(gamma_golden_moves(g, player, golden, golden_num) == golden_num,
+                "gamma_golden_moves count");
+
+    for (uint32_t y = 0; y < r->height; y++) {
+        for (uint32_t x = 0; x < r->width; x++) {
+            uint64_t bit = (uint64_t) y * r->width + x;
+            bool legal = reference_move_legal(r, player, x, y);
+
+            fuzz_expect(((bitmap[bit / 64] >> (bit % 64)) & 1) == legal,
+                        "gamma_legal_mask bit");
+            fuzz_expect(gamma_move_check(g, player, x, y, NULL) == legal,
+                        "gamma_move_check");
+            fuzz_expect(gamma_golden_move_check(g, player, x, y, NULL)
+                        == reference_golden_legal(r, player, x, y),
+                        "gamma_golden_move_check");
+        }
+    }
+
+    for (uint64_t i = 0; i < free_fields; i++) {
+        fuzz_expect(reference_move_legal(r, player, moves[i].x, moves[i].y),
+                    "gamma_legal_moves field");
+    }
+
+    for (uint64_t i = 0; i < golden_num; i++) {
+        fuzz_expect(reference_golden_legal(r, player, golden[i].x, golden[i].y)
+                    && golden[i].victim
+                       == *reference_field(r, golden[i].x, golden[i].y),
+                    "gamma_golden_moves field");
+    }
+}
+
+/** @brief Porównuje z modelem opis planszy i obszary losowych par pól.
+ * @param[in,out] g   – wskaźnik na strukturę przechowującą stan gry,
+ * @param[in,out] r   – wskaźnik na model,
+ * @param[in,out] rng – wskaźnik na stan generatora liczb pseudolosowych.
+ */
+static void fuzz_check_board(gamma_t *g, reference_t *r, uint64_t *rng) {
+    size_t cells = (size_t) r->width * r->height;
+    char *board = gamma_board(g);
+
+    fuzz_expect(board != NULL, "gamma_board");
+
+    if (r->players < 10) {
+        for (uint32_t y = 0; y < r->height; y++) {
+            for (uint32_t x = 0; x < r->width; x++) {
+                uint32_t owner = *reference_field(r, x, y);
+                char expected = owner == 0 ? '.' : (char) ('0' + owner);
+
+                fuzz_expect(board[(size_t) (r->height - 1 - y) * (r->width + 1)
+                                  + x] == expected, "gamma_board field");
+            }
+        }
+    }
+
+    free(board);
+
+    for (int i = 0; i < 8; i++) {
+        size_t a = (size_t) rng_below(rng, cells);
+        size_t b = (size_t) rng_below(rng, cells);
+
+        fuzz_expect(gamma_same_area(g, (uint32_t) (a % r->width),
+                                    (uint32_t) (a / r->width),
+                                    (uint32_t) (b % r->width),
+                                    (uint32_t) (b / r->width))
+                    == reference_same_area(r, a, b), "gamma_same_area");
+    }
+
+    fuzz_expect(gamma_verify(g, 1) == 0, "gamma_verify");
+}
+
+/** @brief Rozgrywa jedną losową grę i porównuje silnik z modelem.
+ * Większość ruchów jest losowana spośród wszystkich pól planszy, a część
+ * spośród legalnych ruchów modelu, tak aby gra doszła do zapełnienia planszy.
+ * @param[in,out] r   – wskaźnik na model z przydzieloną pamięcią,
+ * @param[in,out] rng – wskaźnik na stan generatora liczb pseudolosowych.
+ */
+static void fuzz_game_run(reference_t *r, uint64_t *rng) {
+    gamma_policy_t policy = fuzz_game % 2 ? GAMMA_POLICY_LAZY
+                                          : GAMMA_POLICY_EAGER;
+    gamma_t *g = gamma_new_with_policy(r->width, r->height, r->players,
+                                       r->areas, policy);
+    size_t cells = (size_t) r->width * r->height;
+
+    fuzz_expect(g != NULL, "gamma_new_with_policy");
+    memset(r->owners, 0, cells * sizeof(uint32_t));
+    memset(r->golden_used, 0, (r->players + 1) * sizeof(bool));
+
+    for (fuzz_step = 0; fuzz_step < FUZZ_STEPS; fuzz_step++) {
+        uint32_t player = 1 + (uint32_t) rng_below(rng, r->players + 1);
+        uint32_t x = (uint32_t) rng_below(rng, r->width + 1);
+        uint32_t y = (uint32_t) rng_below(rng, r->height + 1);
+        uint64_t kind = rng_below(rng, 10);
+
+        if (kind < 3 && player <= r->players) {
+            uint64_t free_fields = reference_free(r, player);
+
+            if (free_fields > 0) {
+                uint64_t k = rng_below(rng, free_fields);
+
+                for (size_t i = 0; i < cells; i++) {
+                    if (reference_move_legal(r, player, (uint32_t) (i % r->width),
+                                             (uint32_t) (i / r->width))
+                        && k-- == 0) {
+                        x = (uint32_t) (i % r->width);
+                        y = (uint32_t) (i / r->width);
+                        break;
+                    }
+                }
+            }
+        }
+
+        if (kind == 9) {
+            bool legal = reference_golden_legal(r, player, x, y);
+
+            fuzz_expect(gamma_golden_move(g, player, x, y) == legal,
+                        "gamma_golden_move");
+
+            if (legal) {
+                *reference_field(r, x, y) = player;
+                r->golden_used[player] = true;
+            }
+        }
+        else {
+            bool legal = reference_move_legal(r, player, x, y);
+
+            fuzz_expect(gamma_move(g, player, x, y) == legal, "gamma_move");
+
+            if (legal) {
+                *reference_field(r, x, y) = player;
+            }
+        }
+
+        fuzz_check_players(g, r);
+
+        if (fuzz_step % FUZZ_FULL_CHECK_PERIOD == 0) {
+            for (uint32_t p = 1; p <= r->players; p++) {
+                fuzz_check_lists(g, r, p);
+            }
+
+            fuzz_check_board(g, r, rng);
+        }
+    }
+
+    gamma_delete(g);
+}
+
+/** @brief Porównuje silnik gry z modelem wzorcowym na losowych grach.
+ * Program wywołuje się z argumentami @p GAMES @p SEED. Rozgrywa @p GAMES gier
+ * na losowych planszach, na przemian w trybach @ref GAMMA_POLICY_EAGER
+ * i @ref GAMMA_POLICY_LAZY. Po każdym ruchu porównuje wynik ruchu oraz
+ * statystyki graczy, a co @ref FUZZ_FULL_CHECK_PERIOD ruchów także mapy bitowe,
+ * listy ruchów i złotych ruchów, sprawdzenia ruchów, opis planszy, obszary
+ * i wynik @ref gamma_verify. Przy pierwszej niezgodności wypisuje jej opis.
+ * @param[in] argc – liczba argumentów wywołania programu,
+ * @param[in] argv – argumenty wywołania programu.
+ * @return Wartość @p EXIT_SUCCESS, jeżeli silnik zgadza się z modelem,
+ * a @p EXIT_FAILURE w przeciwnym przypadku lub gdy argumenty są niepoprawne.
+ */
+int main(int argc, char *argv[]) {
+    uint64_t arguments[FUZZ_ARGUMENTS_NUM];
+    char *end = NULL;
+
+    for (int i = 0; i < FUZZ_ARGUMENTS_NUM && i + 1 < argc; i++) {
+        arguments[i] = strtoull(argv[i + 1], &end, 10);
+
+        if (*end != '\0') {
+            end = NULL;
+            break;
+        }
+    }
+
+    if (argc != FUZZ_ARGUMENTS_NUM + 1 || end == NULL) {
+        fprintf(stderr, "Usage: %s GAMES SEED\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    uint64_t rng = arguments[1];
+    size_t cells = FUZZ_MAX_SIDE * FUZZ_MAX_SIDE;
+    reference_t r = {
+        .owners = malloc(cells * sizeof(uint32_t)),
+        .golden_used = malloc((FUZZ_MAX_PLAYERS + 1) * sizeof(bool)),
+        .visited = malloc(cells * sizeof(bool)),
+        .stack = malloc(cells * sizeof(uint32_t))
+    };
+
+    if (r.owners == NULL || r.golden_used == NULL || r.visited == NULL
+        || r.stack == NULL) {
+        fprintf(stderr, "malloc failed\n");
+        return EXIT_FAILURE;
+    }
+
+    for (fuzz_game = 0; fuzz_game < arguments[0]; fuzz_game++) {
+        r.width = 1 + (uint32_t) rng_below(&rng, FUZZ_MAX_SIDE);
+        r.height = 1 + (uint32_t) rng_below(&rng, FUZZ_MAX_SIDE);
+        r.players = 1 + (uint32_t) rng_below(&rng, FUZZ_MAX_PLAYERS);
+        r.areas = 1 + (uint32_t) rng_below(&rng, 4);
+        fuzz_game_run(&r, &rng);
+    }
+
+    printf("%" PRIu64 " games OK\n", arguments[0]);
+
+    free(r.owners);
+    free(r.golden_used);
+    free(r.visited);
+    free(r.stack);
+
+    return EXIT_SUCCESS;
+}
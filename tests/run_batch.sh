@@ -0,0 +1,52 @@
+#!/bin/sh
+# Odtwarza wejścia z katalogu batch i porównuje wyniki z oczekiwanymi.
+#
+# Użycie: tests/run_batch.sh <program>
+#
+# Każdy plik NAZWA.in jest podawany programowi jako zwykły plik i przez potok,
+# w zwykłym i potokowym trybie wsadowym. Standardowe wyjście musi być równe
+# plikowi NAZWA.out, a standardowe wyjście diagnostyczne, bez raportów STATS
+# zależnych od czasu, plikowi NAZWA.err.
+#
+# Autor: Szymon Czyżmański 417797, 22.05.2020
+
+if [ $# -ne 1 ] || [ ! -x "$1" ]; then
+    echo "usage: $0 <gamma binary>" >&2
+    exit 2
+fi
+
+bin=$1
+dir=$(dirname "$0")/batch
+tmp=$(mktemp -d) || exit 2
+trap 'rm -rf "$tmp"' EXIT
+failed=0
+passed=0
+
+for input in "$dir"/*.in; do
+    name=${input%.in}
+
+    for variant in file pipe file-pipeline pipe-pipeline; do
+        case $variant in
+            *-pipeline) option=--pipeline ;;
+            *) option= ;;
+        esac
+
+        case $variant in
+            file*) "$bin" $option < "$input" > "$tmp/out" 2> "$tmp/err" ;;
+            pipe*) cat "$input" | "$bin" $option > "$tmp/out" 2> "$tmp/err" ;;
+        esac
+
+        grep -v '^STATS ' "$tmp/err" > "$tmp/err.filtered"
+
+        if cmp -s "$tmp/out" "$name.out" \
+           && cmp -s "$tmp/err.filtered" "$name.err"; then
+            passed=$((passed + 1))
+        else
+            echo "FAIL $(basename "$name") ($variant)"
+            failed=$((failed + 1))
+        fi
+    done
+done
+
+echo "$passed passed, $failed failed"
+[ $failed -eq 0 ]
@@ -0,0 +1,199 @@
+/** @file
+ * Implementacja modułu odpowiedzialnego za buforowane wypisywanie komunikatów
+ * na standardowe wyjście i standardowe wyjście diagnostyczne
+ *
+ * @author Szymon Czyżmański 417797
+ * @date 21.05.2020
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include "writer.h"
+
+/**
+ * Rozmiar bufora jednego strumienia.
+ */
+#define WRITER_BUFFER_SIZE (1 << 16)
+
+/**
+ * Zapisy dziesiętne liczb od 0 do 99, każdy na dwóch znakach.
+ */
+static const char DIGIT_PAIRS[] =
+    "00010203040506070809101112131415161718192021222324252627282930313233343536"
+    "37383940414243444546474849505152535455565758596061626364656667686970717273"
+    "7475767778798081828384858687888990919293949596979899";
+
+/** @brief Sprawdza, czy dwa deskryptory wskazują na ten sam plik.
+ * @param[in] fd1 – pierwszy deskryptor,
+ * @param[in] fd2 – drugi deskryptor.
+ * @return Wartość @p true, jeżeli oba deskryptory wskazują na ten sam plik,
+ * a @p false w przeciwnym przypadku lub gdy nie udało się tego sprawdzić.
+ */
+static bool writer_same_file(int fd1, int fd2) {
+    struct stat st1, st2;
+
+    return fstat(fd1, &st1) == 0 && fstat(fd2, &st2) == 0
+           && st1.st_dev == st2.st_dev && st1.st_ino == st2.st_ino;
+}
+
+bool writer_init(writer_t *w, int out_fd, int err_fd) {
+    w->shared = writer_same_file(out_fd, err_fd);
+    w->lock = NULL;
+    w->streams[WRITER_OUT] = (writer_stream_t) {
+        .fd = out_fd,
+        .data = malloc(WRITER_BUFFER_SIZE),
+        .len = 0
+    };
+    w->streams[WRITER_ERR] = (writer_stream_t) {
+        .fd = err_fd,
+        .data = w->shared ? NULL : malloc(WRITER_BUFFER_SIZE),
+        .len = 0
+    };
+
+    if (w->streams[WRITER_OUT].data == NULL
+        || (!w->shared && w->streams[WRITER_ERR].data == NULL)) {
+        free(w->streams[WRITER_OUT].data);
+        free(w->streams[WRITER_ERR].data);
+        return false;
+    }
+    else {
+        return true;
+    }
+}
+
+/** @brief Podaje bufor, do którego trafiają dane przeznaczone dla strumienia.
+ * @param[in,out] w   – wskaźnik na strukturę przechowującą stan modułu,
+ * @param[in] target  – strumień.
+ * @return Wskaźnik na bufor strumienia.
+ */
+static inline writer_stream_t *writer_target_stream(writer_t *w,
+                                                   writer_target_t target) {
+    return &w->streams[w->shared ? WRITER_OUT : target];
+}
+
+/** @brief Zapisuje dane do deskryptora.
+ * Ponawia zapis aż do zapisania wszystkich danych lub wystąpienia błędu innego
+ * niż przerwanie przez sygnał.
+ * @param[in] fd   – deskryptor,
+ * @param[in] data – wskaźnik na dane,
+ * @param[in] len  – liczba znaków do zapisania.
+ */
+static void writer_write_all(int fd, const char *data, size_t len) {
+    while (len > 0) {
+        ssize_t written = write(fd, data, len);
+
+        if (written > 0) {
+            data += written;
+            len -= written;
+        }
+        else if (written < 0 && errno != EINTR) {
+            return;
+        }
+    }
+}
+
+/** @brief Opróżnia bufor strumienia, a potem zapisuje napis do deskryptora.
+ * Jeżeli ustawiono blokadę, wszystkie dane są zapisywane pod nią.
+ * @param[in,out] w   – wskaźnik na strukturę przechowującą stan modułu,
+ * @param[in,out] s   – wskaźnik na bufor strumienia,
+ * @param[in] str     – wskaźnik na pierwszy znak napisu,
+ * @param[in] len     – długość napisu, może być równa 0.
+ */
+static void writer_stream_flush(writer_t *w, writer_stream_t *s,
+                                const char *str, size_t len) {
+    if (w->lock != NULL) {
+        pthread_mutex_lock(w->lock);
+    }
+
+    writer_write_all(s->fd, s->data, s->len);
+    writer_write_all(s->fd, str, len);
+    s->len = 0;
+
+    if (w->lock != NULL) {
+        pthread_mutex_unlock(w->lock);
+    }
+}
+
+void writer_set_lock(writer_t *w, pthread_mutex_t *lock) {
+    w->lock = lock;
+}
+
+void writer_reserve(writer_t *w, writer_target_t target, size_t len) {
+    writer_stream_t *s = writer_target_stream(w, target);
+
+    if (WRITER_BUFFER_SIZE - s->len < len) {
+        writer_stream_flush(w, s, NULL, 0);
+    }
+}
+
+void writer_put_string(writer_t *w, writer_target_t target,
+                       const char *str, size_t len) {
+    writer_stream_t *s = writer_target_stream(w, target);
+
+    if (len > WRITER_BUFFER_SIZE) {
+        writer_stream_flush(w, s, str, len);
+    }
+    else {
+        if (WRITER_BUFFER_SIZE - s->len < len) {
+            writer_stream_flush(w, s, NULL, 0);
+        }
+
+        memcpy(s->data + s->len, str, len);
+        s->len += len;
+    }
+}
+
+void writer_put_number(writer_t *w, writer_target_t target,
+                       uint64_t value, char end) {
+    writer_stream_t *s = writer_target_stream(w, target);
+
+    if (WRITER_BUFFER_SIZE - s->len < WRITER_NUMBER_LEN + 1) {
+        writer_stream_flush(w, s, NULL, 0);
+    }
+
+    s->len += writer_format_number(s->data + s->len, value, end);
+}
+
+size_t writer_format_number(char *buf, uint64_t value, char end) {
+    char digits[WRITER_NUMBER_LEN + 1];
+    size_t i = WRITER_NUMBER_LEN;
+
+    digits[i] = end;
+
+    while (value >= 100) {
+        const char *pair = DIGIT_PAIRS + 2 * (value % 100);
+        value /= 100;
+        digits[--i] = pair[1];
+        digits[--i] = pair[0];
+    }
+
+    if (value >= 10) {
+        digits[--i] = DIGIT_PAIRS[2 * value + 1];
+        digits[--i] = DIGIT_PAIRS[2 * value];
+    }
+    else {
+        digits[--i] = (char) ('0' + value);
+    }
+
+    memcpy(buf, digits + i, sizeof(digits) - i);
+
+    return sizeof(digits) - i;
+}
+
+void writer_flush(writer_t *w) {
+    writer_stream_flush(w, &w->streams[WRITER_OUT], NULL, 0);
+
+    if (!w->shared) {
+        writer_stream_flush(w, &w->streams[WRITER_ERR], NULL, 0);
+    }
+}
+
+void writer_free(writer_t *w) {
+    writer_flush(w);
+    free(w->streams[WRITER_OUT].data);
+    free(w->streams[WRITER_ERR].data);
+}
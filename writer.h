@@ -0,0 +1,139 @@
+/** @file
+ * Interfejs modułu odpowiedzialnego za buforowane wypisywanie komunikatów
+ * na standardowe wyjście i standardowe wyjście diagnostyczne
+ *
+ * @author Szymon Czyżmański 417797
+ * @date 21.05.2020
+ */
+
+#ifndef WRITER_H
+#define WRITER_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <pthread.h>
+
+/**
+ * Największa liczba znaków zapisu dziesiętnego liczby typu @p uint64_t.
+ */
+#define WRITER_NUMBER_LEN 20
+
+/**
+ * Typ wyliczeniowy określający strumień, do którego wypisywane są dane.
+ */
+typedef enum writer_target writer_target_t;
+
+/**
+ * Wyliczenia określające strumień, do którego wypisywane są dane.
+ */
+enum writer_target {
+    WRITER_OUT, /**< Standardowe wyjście. */
+    WRITER_ERR  /**< Standardowe wyjście diagnostyczne. */
+};
+
+/**
+ * Typ struktury przechowującej bufor jednego strumienia.
+ */
+typedef struct writer_stream writer_stream_t;
+
+/**
+ * Struktura przechowująca bufor jednego strumienia.
+ */
+struct writer_stream {
+    int fd;       /**< Deskryptor, do którego trafiają dane z bufora. */
+    char *data;   /**< Bufor. */
+    size_t len;   /**< Liczba znaków w buforze. */
+};
+
+/**
+ * Typ struktury przechowującej stan modułu wypisującego.
+ */
+typedef struct writer writer_t;
+
+/**
+ * Struktura przechowująca stan modułu wypisującego. Jeżeli oba deskryptory
+ * wskazują na ten sam plik, na przykład ten sam potok, dane przeznaczone
+ * dla obu strumieni trafiają do jednego bufora, dzięki czemu zachowują
+ * kolejność, w jakiej zostały wypisane.
+ */
+struct writer {
+    writer_stream_t streams[2]; /**< Bufory strumieni indeksowane wartościami
+                                 *   wyliczenia @ref writer_target. */
+    bool shared;                /**< Wartość @p true, jeżeli oba strumienie
+                                 *   korzystają z bufora @ref WRITER_OUT. */
+    pthread_mutex_t *lock;      /**< Blokada, pod którą dane są przekazywane
+                                 *   do deskryptorów, lub NULL. */
+};
+
+/** @brief Inicjuje moduł wypisujący.
+ * @param[out] w      – wskaźnik na strukturę przechowującą stan modułu,
+ * @param[in] out_fd  – deskryptor standardowego wyjścia,
+ * @param[in] err_fd  – deskryptor standardowego wyjścia diagnostycznego.
+ * @return Wartość @p true, jeżeli zainicjowano moduł, a @p false, gdy nie
+ * udało się zaalokować pamięci.
+ */
+bool writer_init(writer_t *w, int out_fd, int err_fd);
+
+/** @brief Ustawia blokadę chroniącą deskryptory.
+ * Jeżeli do tych samych deskryptorów wypisuje wiele wątków, każdy przez własny
+ * moduł wypisujący, powinny one używać wspólnej blokady. Wtedy dane z jednego
+ * bufora trafiają do deskryptora w całości, bez przeplatania z danymi z innych
+ * buforów.
+ * @param[in,out] w – wskaźnik na strukturę przechowującą stan modułu,
+ * @param[in] lock  – wskaźnik na blokadę lub NULL.
+ */
+void writer_set_lock(writer_t *w, pthread_mutex_t *lock);
+
+/** @brief Rezerwuje miejsce w buforze.
+ * Opróżnia bufor strumienia, jeżeli nie mieści się w nim @p len znaków.
+ * Dzięki temu napisy o łącznej długości nieprzekraczającej @p len, wypisane
+ * zaraz potem do tego strumienia, trafią do deskryptora razem, nawet jeżeli
+ * ich łączna długość przekracza rozmiar bufora.
+ * @param[in,out] w   – wskaźnik na strukturę przechowującą stan modułu,
+ * @param[in] target  – strumień,
+ * @param[in] len     – liczba rezerwowanych znaków.
+ */
+void writer_reserve(writer_t *w, writer_target_t target, size_t len);
+
+/** @brief Wypisuje napis.
+ * @param[in,out] w   – wskaźnik na strukturę przechowującą stan modułu,
+ * @param[in] target  – strumień, do którego ma zostać wypisany napis,
+ * @param[in] str     – wskaźnik na pierwszy znak napisu,
+ * @param[in] len     – długość napisu.
+ */
+void writer_put_string(writer_t *w, writer_target_t target,
+                       const char *str, size_t len);
+
+/** @brief Wypisuje liczbę w zapisie dziesiętnym, a po niej znak.
+ * @param[in,out] w   – wskaźnik na strukturę przechowującą stan modułu,
+ * @param[in] target  – strumień, do którego ma zostać wypisana liczba,
+ * @param[in] value   – wypisywana liczba,
+ * @param[in] end     – znak wypisywany za liczbą.
+ */
+void writer_put_number(writer_t *w, writer_target_t target,
+                       uint64_t value, char end);
+
+/** @brief Zapisuje liczbę w zapisie dziesiętnym, a po niej znak, w buforze.
+ * Nie dopisuje znaku null.
+ * @param[out] buf    – bufor o długości co najmniej @p WRITER_NUMBER_LEN + 1,
+ * @param[in] value   – zapisywana liczba,
+ * @param[in] end     – znak zapisywany za liczbą.
+ * @return Liczba znaków zapisanych w buforze.
+ */
+size_t writer_format_number(char *buf, uint64_t value, char end);
+
+/** @brief Przekazuje zawartość buforów do deskryptorów.
+ * Wypisuje całą zawartość buforów, najpierw standardowego wyjścia, a potem
+ * standardowego wyjścia diagnostycznego. Należy ją wywołać przed wypisaniem
+ * czegokolwiek w inny sposób, na przykład przed przejściem w tryb interaktywny.
+ * @param[in,out] w – wskaźnik na strukturę przechowującą stan modułu.
+ */
+void writer_flush(writer_t *w);
+
+/** @brief Opróżnia bufory i zwalnia pamięć modułu wypisującego.
+ * @param[in,out] w – wskaźnik na strukturę przechowującą stan modułu.
+ */
+void writer_free(writer_t *w);
+
+#endif // WRITER_H